@@ -0,0 +1,278 @@
+'''
+Throughput benchmarks of ctds' hot paths, run against a local TDS stub
+server (see tdsstub.py) rather than a SQL Server.
+
+The stub runs in a child process, so its work does not compete with the
+benchmarks for the GIL. Each benchmark is run `--repeat` times, reporting the
+best throughput. It is then run once more under :py:mod:`tracemalloc`,
+reporting the peak memory allocated by Python objects, along with the peak
+native memory ctds allocated for its own buffers, e.g. of rows and
+parameters, as reported by :py:func:`ctds.memory_stats`. Memory allocated
+by FreeTDS is not included in either.
+
+Usage:
+
+.. code-block:: sh
+
+    make bench BENCH_ARGS='--rows 100000 --columns int,nvarchar(256)'
+'''
+
+from __future__ import print_function
+
+import argparse
+import datetime
+import decimal
+import gc
+import os
+import re
+import subprocess
+import sys
+import uuid
+
+try:
+    import tracemalloc
+except ImportError: # pragma: nocover
+    tracemalloc = None # pylint: disable=invalid-name
+
+try:
+    from time import perf_counter as clock
+except ImportError: # pragma: nocover
+    from time import time as clock
+
+import tdsstub
+
+
+DEFAULT_COLUMNS = 'int,bigint,float,datetime,decimal(18,4),varchar(32),nvarchar(32)'
+
+# Values for the parameters of executemany() and rows of bulk_insert(), by type.
+_VALUES = {
+    'tinyint': lambda row: row % 256,
+    'smallint': lambda row: row % 32768,
+    'int': lambda row: row,
+    'bigint': lambda row: row << 32,
+    'bit': lambda row: bool(row % 2),
+    'real': lambda row: row * 0.5,
+    'float': lambda row: row * 0.25,
+    'datetime': lambda row: datetime.datetime(2020, 1, 1) + datetime.timedelta(seconds=row),
+    'uniqueidentifier': lambda row: uuid.UUID(int=row),
+    'decimal': lambda row: decimal.Decimal(row) / 4,
+    'varchar': lambda row: 'row {0}'.format(row),
+    'nvarchar': lambda row: u'row {0} \u2603'.format(row),
+    'varbinary': lambda row: 'row {0}'.format(row).encode('ascii'),
+}
+
+
+def parse_columns(spec):
+    '''Parse a comma-separated list of column types, e.g. `int,varchar(32)`.'''
+    return [
+        tdsstub.Column('Column{0}'.format(index), type_)
+        for index, type_ in enumerate(re.findall(r'\w+(?:\([^)]*\))?', spec))
+    ]
+
+
+def serve(args):
+    '''Run the stub server, replaying the benchmarks' statements.'''
+    columns = parse_columns(args.columns)
+    rows = [tdsstub.ResultSet(columns, rows=args.rows)]
+    script = tdsstub.Script(
+        statements=[
+            (r'^\s*SELECT\s+1\s*$', [tdsstub.ResultSet([tdsstub.Column('', 'int')])]),
+            (r'\bFROM\s+Rows\b', rows),
+            (r'^\s*INSERT\s+INTO\s+Rows\b', 1),
+        ],
+        procedures={
+            'Rows': rows,
+            # executemany() executes statements using sp_executesql.
+            'sp_executesql': [],
+        },
+        tables={
+            'Rows': columns,
+        },
+    )
+    server = tdsstub.Server(script)
+    print(server.port)
+    sys.stdout.flush()
+    server.serve_forever()
+
+
+def bench_execute(connection, args):
+    '''`Cursor.execute()` latency, executing `SELECT 1`.'''
+    with connection.cursor() as cursor:
+        for _ in range(args.calls):
+            cursor.execute('SELECT 1')
+            cursor.fetchone()
+    return args.calls
+
+
+def bench_fetchall(connection, args): # pylint: disable=unused-argument
+    '''`Cursor.fetchall()` of a result set.'''
+    with connection.cursor() as cursor:
+        cursor.execute('SELECT * FROM Rows')
+        return len(cursor.fetchall())
+
+
+def bench_fetchmany(connection, args):
+    '''`Cursor.fetchmany()` of a result set, in batches of `--batch` rows.'''
+    rows = 0
+    with connection.cursor() as cursor:
+        cursor.execute('SELECT * FROM Rows')
+        while True:
+            batch = cursor.fetchmany(args.batch)
+            if not batch:
+                break
+            rows += len(batch)
+    return rows
+
+
+def bench_iterate(connection, args): # pylint: disable=unused-argument
+    '''Iteration over a result set's rows, reading each row's first column.'''
+    rows = 0
+    with connection.cursor() as cursor:
+        cursor.execute('SELECT * FROM Rows')
+        for row in cursor:
+            row[0] # pylint: disable=pointless-statement
+            rows += 1
+    return rows
+
+
+def bench_executemany(connection, args):
+    '''`Cursor.executemany()` of a parameterized INSERT.'''
+    columns = parse_columns(args.columns)
+    sql = 'INSERT INTO Rows VALUES ({0})'.format(
+        ', '.join(':{0}'.format(index) for index in range(len(columns)))
+    )
+    with connection.cursor() as cursor:
+        cursor.executemany(sql, generate_rows(columns, args.parameters))
+    return args.parameters
+
+
+def bench_callproc(connection, args): # pylint: disable=unused-argument
+    '''`Cursor.callproc()` and `Cursor.fetchall()` of the procedure's result set.'''
+    with connection.cursor() as cursor:
+        cursor.callproc('Rows', (1,))
+        return len(cursor.fetchall())
+
+
+def bench_bulk_insert(connection, args):
+    '''`Connection.bulk_insert()` of generated rows.'''
+    return connection.bulk_insert('Rows', generate_rows(parse_columns(args.columns), args.rows))
+
+
+BENCHMARKS = (
+    ('execute', bench_execute),
+    ('fetchall', bench_fetchall),
+    ('fetchmany', bench_fetchmany),
+    ('iterate', bench_iterate),
+    ('executemany', bench_executemany),
+    ('callproc', bench_callproc),
+    ('bulk_insert', bench_bulk_insert),
+)
+
+
+def generate_rows(columns, count):
+    '''Generate rows of values for the given columns.'''
+    values = [_VALUES[column.type] for column in columns]
+    for row in range(count):
+        yield tuple(value(row) for value in values)
+
+
+def measure(function, connection, args):
+    '''
+    Run a benchmark, returning the best rate in operations per second, the
+    peak memory allocated by Python objects, in bytes, or None if it can't be
+    traced, and the peak native memory allocated by ctds, in bytes.
+    '''
+    import ctds # pylint: disable=import-outside-toplevel
+
+    best = None
+    for _ in range(args.repeat):
+        gc.collect()
+        start = clock()
+        count = function(connection, args)
+        elapsed = clock() - start
+        rate = count / elapsed if elapsed else float('inf')
+        best = rate if best is None else max(best, rate)
+
+    peak = None
+    gc.collect()
+    ctds.memory_stats(reset=True)
+    if tracemalloc is not None:
+        tracemalloc.start()
+        try:
+            function(connection, args)
+            peak = tracemalloc.get_traced_memory()[1]
+        finally:
+            tracemalloc.stop()
+    else: # pragma: nocover
+        function(connection, args)
+    native = ctds.memory_stats()['total']['peak']
+
+    return best, peak, native
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark ctds against a local TDS stub server.')
+    parser.add_argument('--rows', type=int, default=10000, help='The rows per result set and bulk insert.')
+    parser.add_argument('--columns', default=DEFAULT_COLUMNS,
+                        help='The comma-separated column types of the result sets and bulk insert.')
+    parser.add_argument('--calls', type=int, default=1000, help='The statements executed by `execute`.')
+    parser.add_argument('--parameters', type=int, default=1000,
+                        help='The parameter sequences passed to `executemany`.')
+    parser.add_argument('--batch', type=int, default=1000, help='The `fetchmany` batch size.')
+    parser.add_argument('--repeat', type=int, default=5, help='The runs of each benchmark.')
+    parser.add_argument('--filter', default='', help='A regular expression selecting benchmarks to run.')
+    parser.add_argument('--tds-version', default='7.3', help='The TDS version to connect with.')
+    parser.add_argument('--serve', action='store_true', help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.serve:
+        serve(args)
+        return
+
+    import ctds # pylint: disable=import-outside-toplevel
+
+    server = subprocess.Popen(
+        [
+            sys.executable, os.path.abspath(__file__), '--serve',
+            '--rows', str(args.rows),
+            '--columns', args.columns,
+        ],
+        stdout=subprocess.PIPE
+    )
+    try:
+        port = int(server.stdout.readline())
+        connection = ctds.connect(
+            '127.0.0.1',
+            port=port,
+            user='bench',
+            password='bench',
+            database='bench',
+            autocommit=True,
+            tds_version=args.tds_version,
+        )
+        with connection:
+            print('ctds {0}, FreeTDS {1}, TDS {2}, Python {3}'.format(
+                ctds.__version__, ctds.freetds_version, connection.tds_version, sys.version.split()[0]
+            ))
+            print('{0:<12} {1:>14} {2:>12} {3:>12} {4:>12}'.format(
+                'benchmark', 'ops/s', 'us/op', 'peak KiB', 'native KiB'
+            ))
+            for name, function in BENCHMARKS:
+                if not re.search(args.filter, name):
+                    continue
+                rate, peak, native = measure(function, connection, args)
+                print('{0:<12} {1:>14,.0f} {2:>12.3f} {3:>12} {4:>12,.0f}'.format(
+                    name,
+                    rate,
+                    1e6 / rate,
+                    '-' if peak is None else '{0:,.0f}'.format(peak / 1024.0),
+                    native / 1024.0
+                ))
+                sys.stdout.flush()
+    finally:
+        server.terminate()
+        server.wait()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,180 @@
+'''
+Microbenchmarks of the conversions between TDS and Python types, run
+in-process using :py:mod:`ctds._bench`, without a database.
+
+Column conversions are benchmarked for every TDS type ctds converts, using
+synthetic raw values laid out as DB-Lib returns them. Parameter conversions
+are benchmarked for every Python type ctds accepts as a parameter, including
+the `ctds.Sql*` type wrappers.
+
+Usage:
+
+.. code-block:: sh
+
+    make bench-convert BENCH_ARGS='--filter decimal'
+'''
+
+from __future__ import print_function
+
+import argparse
+import datetime
+import decimal
+import re
+import struct
+import sys
+import uuid
+
+import ctds
+from ctds import _bench
+
+# pylint: disable=no-name-in-module,wrong-import-order
+from _tds import TDSBITN, TDSDATETIMEN, TDSFLOATN, TDSINTN
+
+# The XML type, which is not exported.
+TDSXML = 241
+
+
+def numeric(precision, scale, value):
+    '''A DBNUMERIC: precision, scale, sign and big-endian magnitude.'''
+    return (
+        struct.pack('<BBB', precision, scale, 1 if value < 0 else 0) +
+        struct.pack('>QQ', abs(value) >> 64, abs(value) & 0xFFFFFFFFFFFFFFFF) +
+        b'\x00' * 16
+    )
+
+
+def datetimeall(days=0, ticks=0, has_date=True, has_time=True):
+    '''
+    A DBDATETIMEALL: 100ns ticks since midnight, days since 1900-01-01 and
+    flags, with 7 digits of fractional second precision.
+    '''
+    flags = 7 | ((1 << 13) if has_time else 0) | ((1 << 14) if has_date else 0)
+    return struct.pack('<QihH', ticks, days, 0, flags)
+
+
+TEXT = u'The quick brown fox jumps over the lazy dog'.encode('utf-8')
+UNICODE = u'\xbfQu\xe9 tal? \u2603'.encode('utf-8')
+
+# (name, TDS type, raw values, native converter)
+COLUMNS = (
+    ('char', ctds.CHAR, TEXT[:10], None),
+    ('varchar', ctds.VARCHAR, TEXT, None),
+    ('varchar/unicode', ctds.VARCHAR, UNICODE, None),
+    ('varchar/bytes', ctds.VARCHAR, TEXT, 'bytes'),
+    ('text', ctds.TEXT, TEXT * 100, None),
+    ('xml', TDSXML, b'<a><b>' + TEXT + b'</b></a>', None),
+    ('binary', ctds.BINARY, TEXT[:16], None),
+    ('varbinary', ctds.VARBINARY, TEXT, None),
+    ('image', ctds.IMAGE, TEXT * 100, None),
+    ('bit', ctds.BIT, b'\x01', None),
+    ('bitn', TDSBITN, [None, b'\x01'], None),
+    ('intn', TDSINTN, [None, struct.pack('<i', 123456)], None),
+    ('tinyint', ctds.TINYINT, b'\xff', None),
+    ('smallint', ctds.SMALLINT, struct.pack('<h', -12345), None),
+    ('int', ctds.INT, struct.pack('<i', 123456789), None),
+    ('bigint', ctds.BIGINT, struct.pack('<q', -1234567890123), None),
+    ('float', ctds.FLOAT, struct.pack('<d', 3.14159), None),
+    ('floatn', TDSFLOATN, [None, struct.pack('<d', 3.14159)], None),
+    ('real', ctds.REAL, struct.pack('<f', 2.5), None),
+    ('smallmoney', ctds.SMALLMONEY, struct.pack('<i', 1234567), None),
+    ('smallmoney/float', ctds.SMALLMONEY, struct.pack('<i', 1234567), 'float'),
+    ('money', ctds.MONEY, struct.pack('<iI', 12, 3456789), None),
+    ('money/float', ctds.MONEY, struct.pack('<iI', 12, 3456789), 'float'),
+    ('moneyn', ctds.MONEYN, [None, struct.pack('<iI', 12, 3456789)], None),
+    ('decimal', ctds.DECIMAL, numeric(38, 4, 123456789012345678), None),
+    ('decimal/float', ctds.DECIMAL, numeric(38, 4, 123456789012345678), 'float'),
+    ('numeric', ctds.NUMERIC, numeric(38, 10, -98765432109876543210), None),
+    ('date', ctds.DATE, datetimeall(days=44000, has_time=False), None),
+    ('datetime', ctds.DATETIME, struct.pack('<iI', 44000, 12345678), None),
+    ('datetime2', ctds.DATETIME2, datetimeall(days=44000, ticks=123456789012), None),
+    ('datetimen', TDSDATETIMEN, [None, struct.pack('<iI', 44000, 12345678)], None),
+    ('smalldatetime', ctds.SMALLDATETIME, struct.pack('<HH', 44000, 1234), None),
+    ('time', ctds.TIME, datetimeall(ticks=123456789012, has_date=False), None),
+    ('guid', ctds.GUID, uuid.UUID(int=0x0123456789ABCDEF).bytes_le, None),
+    ('guid/str', ctds.GUID, uuid.UUID(int=0x0123456789ABCDEF).bytes_le, 'str'),
+    ('guid/bytes', ctds.GUID, uuid.UUID(int=0x0123456789ABCDEF).bytes_le, 'bytes'),
+)
+
+# (name, Python value)
+PARAMETERS = (
+    ('str', TEXT.decode('utf-8')),
+    ('str/unicode', UNICODE.decode('utf-8')),
+    ('str/long', TEXT.decode('utf-8') * 100),
+    ('bool', True),
+    ('int/tinyint', 123),
+    ('int/smallint', -12345),
+    ('int', 123456789),
+    ('int/bigint', -1234567890123),
+    ('bytes', TEXT),
+    ('bytes/long', TEXT * 1000),
+    ('bytearray', bytearray(TEXT)),
+    ('float', 3.14159),
+    ('decimal', decimal.Decimal('12345678901234.5678')),
+    ('date', datetime.date(2020, 6, 15)),
+    ('time', datetime.time(12, 34, 56, 789012)),
+    ('datetime', datetime.datetime(2020, 6, 15, 12, 34, 56, 789012)),
+    ('uuid', uuid.UUID(int=0x0123456789ABCDEF)),
+    ('none', None),
+    ('SqlChar', ctds.SqlChar(TEXT.decode('utf-8'))),
+    ('SqlVarChar', ctds.SqlVarChar(TEXT.decode('utf-8'))),
+    ('SqlNVarChar', ctds.SqlNVarChar(UNICODE.decode('utf-8'))),
+    ('SqlBinary', ctds.SqlBinary(TEXT)),
+    ('SqlVarBinary', ctds.SqlVarBinary(TEXT)),
+    ('SqlTinyInt', ctds.SqlTinyInt(123)),
+    ('SqlSmallInt', ctds.SqlSmallInt(-12345)),
+    ('SqlInt', ctds.SqlInt(123456789)),
+    ('SqlBigInt', ctds.SqlBigInt(-1234567890123)),
+    ('SqlDate', ctds.SqlDate(datetime.date(2020, 6, 15))),
+    ('SqlDecimal', ctds.SqlDecimal(decimal.Decimal('12345678901234.5678'), precision=18, scale=4)),
+)
+
+
+def best(function, repeat):
+    '''Run a benchmark `repeat` times, returning the fastest run and the result.'''
+    results = [function() for _ in range(repeat)]
+    return min(results, key=lambda result: result[0])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark ctds type conversions.')
+    parser.add_argument('--number', type=int, default=100000, help='The conversions per run.')
+    parser.add_argument('--repeat', type=int, default=5, help='The runs of each benchmark.')
+    parser.add_argument('--filter', default='', help='A regular expression selecting benchmarks to run.')
+    args = parser.parse_args()
+
+    print('ctds {0}, FreeTDS {1}, Python {2}'.format(
+        ctds.__version__, ctds.freetds_version, sys.version.split()[0]
+    ))
+    print('{0:<30} {1:>10} {2:>14}  {3}'.format('benchmark', 'ns/op', 'ops/s', 'result'))
+
+    benchmarks = [
+        (
+            'column/' + name,
+            lambda tdstype=tdstype, data=data, converter=converter: _bench.convert(
+                tdstype, data, args.number, converter
+            )
+        )
+        for name, tdstype, data, converter in COLUMNS
+    ] + [
+        (
+            'parameter/' + name,
+            lambda value=value: _bench.convert_parameter(value, args.number)
+        )
+        for name, value in PARAMETERS
+    ]
+
+    for name, function in benchmarks:
+        if not re.search(args.filter, name):
+            continue
+        elapsed, result = best(function, args.repeat)
+        print('{0:<30} {1:>10.1f} {2:>14,.0f}  {3}'.format(
+            name,
+            elapsed * 1e9 / args.number,
+            args.number / elapsed if elapsed else float('inf'),
+            repr(result)[:40]
+        ))
+        sys.stdout.flush()
+
+
+if __name__ == '__main__':
+    main()
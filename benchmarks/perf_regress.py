@@ -0,0 +1,286 @@
+'''
+Instruction count regression tests of ctds' hot paths, using callgrind.
+
+Each scenario runs in its own process under callgrind: once in full, and
+once performing only its setup, e.g. importing modules and connecting. The
+difference between the two is the scenario's instruction count, which,
+unlike its wall-clock time, is stable from run to run. Conversion scenarios
+use :py:mod:`ctds._bench`; the others run against a local TDS stub server
+(see tdsstub.py), which runs outside of callgrind.
+
+Counts are compared with those recorded in the baseline file, failing if
+any scenario regresses by more than the threshold. Counts vary with the
+compiler and the Python and FreeTDS versions, so baselines must be
+recorded and compared in the same environment, i.e. the release build of
+Python in the image used by `make perf-regress`. The environment is
+recorded with the baseline, and comparing against a baseline recorded in
+another environment, or a missing baseline, fails unless the baseline is
+being updated.
+
+Usage:
+
+.. code-block:: sh
+
+    # Record the baseline, then commit benchmarks/perf-baseline.json.
+    make perf-baseline
+
+    # Compare against it.
+    make perf-regress
+'''
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+import bench
+
+
+BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'perf-baseline.json')
+
+# The columns of the stub server's result sets and bulk insert table.
+COLUMNS = 'int,bigint,float,datetime,decimal(18,4),varchar(32),nvarchar(32)'
+
+# The conversion scenarios, as names of benchmarks in convert.py.
+CONVERSIONS = (
+    'column/int',
+    'column/bigint',
+    'column/float',
+    'column/varchar',
+    'column/varchar/unicode',
+    'column/decimal',
+    'column/datetime',
+    'column/datetime2',
+    'column/guid',
+    'parameter/str',
+    'parameter/str/unicode',
+    'parameter/int',
+    'parameter/bytes',
+    'parameter/decimal',
+    'parameter/datetime',
+    'parameter/uuid',
+)
+
+# The scenarios run against the stub server, as names of benchmarks in bench.py.
+STATEMENTS = (
+    'execute',
+    'fetchall',
+    'fetchmany',
+    'iterate',
+    'executemany',
+    'callproc',
+    'bulk_insert',
+)
+
+
+def run_scenario(args):
+    '''Run a scenario, in the process being profiled.'''
+    if args.scenario in STATEMENTS:
+        import ctds # pylint: disable=import-outside-toplevel
+
+        function = dict(bench.BENCHMARKS)[args.scenario]
+        connection = ctds.connect(
+            '127.0.0.1',
+            port=args.port,
+            user='bench',
+            password='bench',
+            database='bench',
+            autocommit=True
+        )
+        with connection:
+            if not args.setup_only:
+                function(connection, args)
+    else:
+        import convert # pylint: disable=import-outside-toplevel
+
+        kind, name = args.scenario.split('/', 1)
+        if kind == 'column':
+            tdstype, data, converter = dict(
+                (name_, (tdstype_, data_, converter_))
+                for name_, tdstype_, data_, converter_ in convert.COLUMNS
+            )[name]
+            if not args.setup_only:
+                convert._bench.convert(tdstype, data, args.number, converter) # pylint: disable=protected-access
+        else:
+            value = dict(convert.PARAMETERS)[name]
+            if not args.setup_only:
+                convert._bench.convert_parameter(value, args.number) # pylint: disable=protected-access
+
+
+def environment():
+    '''Get the properties of the environment which affect instruction counts.'''
+    import ctds # pylint: disable=import-outside-toplevel
+
+    return {
+        'python': platform.python_version(),
+        'python_build': 'debug' if hasattr(sys, 'gettotalrefcount') else 'release',
+        'compiler': platform.python_compiler(),
+        'machine': platform.machine(),
+        'freetds': ctds.freetds_version,
+    }
+
+
+def load_baseline(args, current):
+    '''
+    Load the baseline counts, returning None, after printing the reason,
+    if they cannot be compared with those of the current environment.
+    '''
+    if not os.path.exists(args.baseline):
+        print('No baseline found at {0}. Record one using `make perf-baseline`.'.format(args.baseline))
+        return None
+
+    with open(args.baseline) as file_:
+        baseline = json.load(file_)
+    if baseline.get('environment') != current:
+        print('The baseline was recorded in a different environment:')
+        for key in sorted(current):
+            print('    {0}: {1} (baseline: {2})'.format(
+                key, current[key], (baseline.get('environment') or {}).get(key)
+            ))
+        print('Compare in the environment of `make perf-regress`, or record a new baseline using `make perf-baseline`.')
+        return None
+    return baseline.get('counts', {})
+
+
+def callgrind(args, tmpdir, scenario, port, setup_only):
+    '''Run a scenario under callgrind, returning the instructions executed.'''
+    output = os.path.join(tmpdir, 'callgrind.out')
+    command = [
+        'valgrind',
+        '--tool=callgrind',
+        '--callgrind-out-file={0}'.format(output),
+        sys.executable, os.path.abspath(__file__),
+        '--scenario', scenario,
+        '--port', str(port),
+        '--rows', str(args.rows),
+        '--number', str(args.number),
+    ]
+    if setup_only:
+        command.append('--setup-only')
+
+    # Fix everything which may vary between the two runs.
+    env = dict(os.environ, PYTHONHASHSEED='0', PYTHONDONTWRITEBYTECODE='1')
+    process = subprocess.Popen(command, env=env, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    stdout = process.communicate()[0]
+    if process.returncode != 0:
+        raise RuntimeError('{0} failed:\n{1}'.format(scenario, stdout.decode('utf-8', 'replace')))
+
+    with open(output) as file_:
+        for line in file_:
+            match = re.match(r'(?:summary|totals):\s*(\d+)', line)
+            if match:
+                return int(match.group(1))
+    raise RuntimeError('{0}: no instruction count in callgrind output'.format(scenario))
+
+
+def main(): # pylint: disable=too-many-locals
+    parser = argparse.ArgumentParser(description='Check ctds for instruction count regressions using callgrind.')
+    parser.add_argument('--baseline', default=BASELINE, help='The baseline instruction counts file.')
+    parser.add_argument('--update', action='store_true', help='Record the instruction counts as the baseline.')
+    parser.add_argument('--threshold', type=float, default=2.0,
+                        help='The regression, in percent, above which to fail.')
+    parser.add_argument('--filter', default='', help='A regular expression selecting scenarios to run.')
+    parser.add_argument('--rows', type=int, default=2000, help='The rows per result set and bulk insert.')
+    parser.add_argument('--number', type=int, default=10000, help='The conversions per conversion scenario.')
+    parser.add_argument('--scenario', help=argparse.SUPPRESS)
+    parser.add_argument('--port', type=int, default=0, help=argparse.SUPPRESS)
+    parser.add_argument('--setup-only', action='store_true', help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    # Arguments of the stub server benchmarks.
+    args.columns = COLUMNS
+    args.calls = 100
+    args.parameters = 100
+    args.batch = 100
+
+    if args.scenario:
+        run_scenario(args)
+        return 0
+
+    current = environment()
+    if args.update:
+        baseline = {}
+    else:
+        baseline = load_baseline(args, current)
+        if baseline is None:
+            return 2
+
+    server = subprocess.Popen(
+        [
+            sys.executable, os.path.abspath(bench.__file__), '--serve',
+            '--rows', str(args.rows),
+            '--columns', args.columns,
+        ],
+        stdout=subprocess.PIPE
+    )
+    tmpdir = tempfile.mkdtemp()
+    try:
+        port = int(server.stdout.readline())
+
+        counts = {}
+        regressions = []
+        missing = []
+        print('{0:<30} {1:>16} {2:>16} {3:>9}'.format('scenario', 'instructions', 'baseline', 'change'))
+        for scenario in CONVERSIONS + STATEMENTS:
+            if not re.search(args.filter, scenario):
+                continue
+            count = (
+                callgrind(args, tmpdir, scenario, port, False) -
+                callgrind(args, tmpdir, scenario, port, True)
+            )
+            counts[scenario] = count
+
+            expected = baseline.get(scenario)
+            if expected:
+                change = 100.0 * (count - expected) / expected
+                if change > args.threshold:
+                    regressions.append(scenario)
+                print('{0:<30} {1:>16,} {2:>16,} {3:>+8.2f}%{4}'.format(
+                    scenario, count, expected, change, ' REGRESSED' if change > args.threshold else ''
+                ))
+            else:
+                missing.append(scenario)
+                print('{0:<30} {1:>16,} {2:>16} {3:>9}'.format(scenario, count, '-', '-'))
+            sys.stdout.flush()
+    finally:
+        shutil.rmtree(tmpdir)
+        server.terminate()
+        server.wait()
+
+    if args.update:
+        # Keep the counts of scenarios not run, if recorded in the same environment.
+        if os.path.exists(args.baseline):
+            with open(args.baseline) as file_:
+                previous = json.load(file_)
+            if previous.get('environment') == current:
+                baseline = previous.get('counts', {})
+        baseline.update(counts)
+        with open(args.baseline, 'w') as file_:
+            json.dump({'environment': current, 'counts': baseline}, file_, indent=4, sort_keys=True)
+            file_.write('\n')
+        print('Recorded the baseline in {0}.'.format(args.baseline))
+        return 0
+
+    if missing:
+        print('{0} scenario(s) have no baseline: {1}. Record them using --update.'.format(
+            len(missing), ', '.join(missing)
+        ))
+        return 2
+
+    if regressions:
+        print('{0} scenario(s) regressed by more than {1}%: {2}'.format(
+            len(regressions), args.threshold, ', '.join(regressions)
+        ))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
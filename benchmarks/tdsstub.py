@@ -0,0 +1,682 @@
+'''
+A minimal TDS protocol server for exercising ctds without a SQL Server.
+
+The server speaks just enough of TDS 7.1 - 7.4 to log in a FreeTDS client and
+replay scripted responses:
+
+* SQL batches are matched against the script's statements by regular
+  expression, and answered with their result sets or row count. Unmatched
+  batches, e.g. `SET` statements, complete without results.
+* RPC requests, i.e. :py:meth:`ctds.Cursor.callproc`, are answered with the
+  result sets of the script's procedure of the same name.
+* Bulk loads into the script's tables, i.e.
+  :py:meth:`ctds.Connection.bulk_insert`, report the number of rows received.
+
+Responses are encoded once and cached, so the server adds little overhead to
+a client benchmark when run in a separate process. Nothing is validated;
+this is not a test double for SQL Server's semantics.
+
+Example:
+
+.. code-block:: python
+
+    script = Script(
+        statements=[
+            (r'FROM\\s+Numbers', [ResultSet([Column('Value', 'int')], rows=1000)]),
+        ]
+    )
+    server = Server(script)
+    threading.Thread(target=server.serve_forever).start()
+    connection = ctds.connect('127.0.0.1', port=server.port, user='user', password='password')
+'''
+
+import argparse
+import re
+import struct
+import sys
+import threading
+
+try:
+    import socketserver
+except ImportError: # pragma: nocover
+    import SocketServer as socketserver # pylint: disable=import-error
+
+
+# Packet types.
+PACKET_SQL_BATCH = 0x01
+PACKET_RPC = 0x03
+PACKET_REPLY = 0x04
+PACKET_ATTENTION = 0x06
+PACKET_BULK_LOAD = 0x07
+PACKET_LOGIN7 = 0x10
+PACKET_PRELOGIN = 0x12
+
+PACKET_HEADER = struct.Struct('>BBHHBB')
+PACKET_STATUS_EOM = 0x01
+
+# Tokens.
+TOKEN_RETURNSTATUS = 0x79
+TOKEN_COLMETADATA = 0x81
+TOKEN_ERROR = 0xAA
+TOKEN_INFO = 0xAB
+TOKEN_LOGINACK = 0xAD
+TOKEN_ROW = 0xD1
+TOKEN_ENVCHANGE = 0xE3
+TOKEN_DONE = 0xFD
+TOKEN_DONEPROC = 0xFE
+TOKEN_DONEINPROC = 0xFF
+
+DONE_FINAL = 0x00
+DONE_MORE = 0x01
+DONE_ERROR = 0x02
+DONE_COUNT = 0x10
+DONE_ATTN = 0x20
+
+ENVCHANGE_DATABASE = 1
+ENVCHANGE_LANGUAGE = 2
+ENVCHANGE_PACKETSIZE = 4
+ENVCHANGE_COLLATION = 7
+
+TDS72 = 0x72090002
+
+# SQL_Latin1_General_CP1_CI_AS
+COLLATION = b'\x09\x04\xd0\x00\x34'
+
+# Column flags: nullable and updateable.
+COLUMN_FLAGS = 0x0009
+
+# TDS data types.
+TDS_GUID = 0x24
+TDS_INTN = 0x26
+TDS_BITN = 0x68
+TDS_DECIMALN = 0x6A
+TDS_FLTN = 0x6D
+TDS_DATETIMN = 0x6F
+TDS_BIGVARBIN = 0xA5
+TDS_BIGVARCHR = 0xA7
+TDS_NVARCHAR = 0xE7
+
+# Fixed length data types and their sizes.
+FIXED_TYPES = {
+    0x1F: 0, 0x30: 1, 0x32: 1, 0x34: 2, 0x38: 4, 0x3A: 4, 0x3B: 4,
+    0x3C: 8, 0x3D: 8, 0x3E: 8, 0x7A: 4, 0x7F: 8,
+}
+
+# Variable length data types with a 1 byte value length, by the size of
+# their TYPE_INFO.
+BYTELEN_TYPES = {
+    TDS_GUID: 1, TDS_INTN: 1, TDS_BITN: 1, TDS_FLTN: 1, 0x6E: 1, TDS_DATETIMN: 1,
+    TDS_DECIMALN: 3, 0x6C: 3, 0x28: 0, 0x29: 1, 0x2A: 1, 0x2B: 1,
+}
+
+# Variable length data types with a 2 byte value length, and whether they
+# have a collation.
+USHORTLEN_TYPES = {
+    TDS_BIGVARBIN: False, TDS_BIGVARCHR: True, 0xAD: False, 0xAF: True,
+    TDS_NVARCHAR: True, 0xEF: True,
+}
+
+# Text types, and whether they have a collation.
+LONGLEN_TYPES = {0x22: False, 0x23: True, 0x63: True}
+
+TDS_SSVARIANT = 0x62
+
+
+def b_varchar(value):
+    '''Encode a B_VARCHAR: a byte character count and UCS-2 characters.'''
+    return struct.pack('<B', len(value)) + value.encode('utf-16-le')
+
+
+def us_varchar(value):
+    '''Encode a US_VARCHAR: a 2 byte character count and UCS-2 characters.'''
+    return struct.pack('<H', len(value)) + value.encode('utf-16-le')
+
+
+def done(status=DONE_FINAL, rowcount=None, tds72=True, token=TOKEN_DONE):
+    '''Encode a DONE, DONEPROC or DONEINPROC token.'''
+    if rowcount is not None:
+        status |= DONE_COUNT
+    return struct.pack('<BHH', token, status, 0) + struct.pack(
+        '<Q' if tds72 else '<I',
+        rowcount or 0
+    )
+
+
+def message(number, text, severity=0, tds72=True, token=TOKEN_INFO):
+    '''Encode an INFO or ERROR token.'''
+    body = (
+        struct.pack('<iBB', number, 1, severity) +
+        us_varchar(text) +
+        b_varchar('tdsstub') +
+        b_varchar('') +
+        struct.pack('<i' if tds72 else '<H', 1)
+    )
+    return struct.pack('<BH', token, len(body)) + body
+
+
+def envchange(type_, new, old=''):
+    '''Encode an ENVCHANGE token with a string value.'''
+    body = struct.pack('<B', type_) + b_varchar(new) + b_varchar(old)
+    return struct.pack('<BH', TOKEN_ENVCHANGE, len(body)) + body
+
+
+class Column(object):
+    '''
+    A result set column.
+
+    :param str name: The column name.
+    :param str type_: The SQL type, one of `tinyint`, `smallint`, `int`,
+        `bigint`, `bit`, `real`, `float`, `datetime`, `uniqueidentifier`,
+        `decimal(p, s)`, `varchar(n)`, `nvarchar(n)` or `varbinary(n)`.
+        Values of character and binary columns are `n` wide.
+    :param int null_every: Return NULL for every `null_every`th row.
+    '''
+
+    _TYPE = re.compile(r'^\s*(\w+)\s*(?:\(\s*(\d+)\s*(?:,\s*(\d+)\s*)?\))?\s*$')
+
+    _INTEGERS = {'tinyint': 1, 'smallint': 2, 'int': 4, 'bigint': 8}
+
+    def __init__(self, name, type_, null_every=None):
+        match = self._TYPE.match(type_)
+        if not match:
+            raise ValueError(type_)
+        self.name = name
+        self.type = match.group(1).lower()
+        self.size = int(match.group(2) or 0)
+        self.scale = int(match.group(3) or 0)
+        self.null_every = null_every
+
+        if self.type in self._INTEGERS:
+            self._typeinfo = struct.pack('<BB', TDS_INTN, self._INTEGERS[self.type])
+        elif self.type == 'bit':
+            self._typeinfo = struct.pack('<BB', TDS_BITN, 1)
+        elif self.type in ('real', 'float'):
+            self._typeinfo = struct.pack('<BB', TDS_FLTN, 4 if self.type == 'real' else 8)
+        elif self.type == 'datetime':
+            self._typeinfo = struct.pack('<BB', TDS_DATETIMN, 8)
+        elif self.type == 'uniqueidentifier':
+            self._typeinfo = struct.pack('<BB', TDS_GUID, 16)
+        elif self.type == 'decimal':
+            self.size = self.size or 18
+            self._typeinfo = struct.pack('<BBBB', TDS_DECIMALN, 17, self.size, self.scale)
+        elif self.type == 'varchar':
+            self._typeinfo = struct.pack('<BH', TDS_BIGVARCHR, self.size) + COLLATION
+        elif self.type == 'nvarchar':
+            self._typeinfo = struct.pack('<BH', TDS_NVARCHAR, self.size * 2) + COLLATION
+        elif self.type == 'varbinary':
+            self._typeinfo = struct.pack('<BH', TDS_BIGVARBIN, self.size)
+        else:
+            raise ValueError(type_)
+
+    def metadata(self, tds72):
+        '''Encode the column's COLMETADATA entry.'''
+        return (
+            struct.pack('<IH' if tds72 else '<HH', 0, COLUMN_FLAGS) +
+            self._typeinfo +
+            b_varchar(self.name)
+        )
+
+    def value(self, row): # pylint: disable=too-many-return-statements
+        '''Encode the column's value for a given row number.'''
+        if self.null_every and (row % self.null_every) == 0:
+            return b'\xff\xff' if self.type in ('varchar', 'nvarchar', 'varbinary') else b'\x00'
+
+        if self.type in self._INTEGERS:
+            size = self._INTEGERS[self.type]
+            fmt = {1: '<BB', 2: '<Bh', 4: '<Bi', 8: '<Bq'}[size]
+            return struct.pack(fmt, size, row % (1 << (size * 8 - 1)))
+        if self.type == 'bit':
+            return struct.pack('<BB', 1, row % 2)
+        if self.type == 'real':
+            return struct.pack('<Bf', 4, row * 0.5)
+        if self.type == 'float':
+            return struct.pack('<Bd', 8, row * 0.25)
+        if self.type == 'datetime':
+            # Days since 1900-01-01 and 1/300ths of a second since midnight.
+            return struct.pack('<BiI', 8, 44000 + row // 86400, (row % 86400) * 300)
+        if self.type == 'uniqueidentifier':
+            return struct.pack('<BQQ', 16, row, 0x0123456789ABCDEF)
+        if self.type == 'decimal':
+            unscaled = row * (10 ** self.scale) + row % (10 ** self.scale)
+            return struct.pack('<BBQQ', 17, 1, unscaled & 0xFFFFFFFFFFFFFFFF, unscaled >> 64)
+
+        text = ('{0}:'.format(row) + 'x' * self.size)[:self.size]
+        data = text.encode('utf-16-le' if self.type == 'nvarchar' else 'ascii')
+        return struct.pack('<H', len(data)) + data
+
+
+class ResultSet(object):
+    '''
+    A result set, with rows generated from the row number.
+
+    :param columns: The result set columns.
+    :type columns: list(Column)
+    :param int rows: The number of rows.
+    :param int distinct: The number of distinct rows to generate before
+        repeating them, bounding the time taken to encode large result sets.
+    '''
+
+    def __init__(self, columns, rows=1, distinct=1024):
+        self.columns = columns
+        self.rows = rows
+        self.distinct = distinct
+        self._tokens = {}
+
+    def tokens(self, tds72):
+        '''Encode the result set's COLMETADATA and ROW tokens.'''
+        tokens = self._tokens.get(tds72)
+        if tokens is None:
+            metadata = (
+                struct.pack('<BH', TOKEN_COLMETADATA, len(self.columns)) +
+                b''.join(column.metadata(tds72) for column in self.columns)
+            )
+            rows = [
+                struct.pack('<B', TOKEN_ROW) + b''.join(column.value(row) for column in self.columns)
+                for row in range(min(self.rows, self.distinct))
+            ]
+            repeats, remainder = divmod(self.rows, len(rows)) if rows else (0, 0)
+            tokens = metadata + b''.join(rows) * repeats + b''.join(rows[:remainder])
+            self._tokens[tds72] = tokens
+        return tokens
+
+
+class Script(object):
+    '''
+    The responses of a :py:class:`Server`.
+
+    :param statements: The responses to SQL batches, as
+        `(pattern, result sets)` or `(pattern, row count)` tuples. The first
+        statement whose regular expression pattern is found in the batch is
+        used.
+    :type statements: list(tuple)
+    :param dict procedures: The result sets of stored procedures, by name.
+    :param dict tables: The columns of tables available for bulk insert, by
+        name.
+    '''
+
+    def __init__(self, statements=(), procedures=None, tables=None):
+        self.statements = [
+            (re.compile(pattern, re.IGNORECASE), response)
+            for pattern, response in statements
+        ]
+        self.procedures = dict(
+            (self.normalize(name), resultsets)
+            for name, resultsets in (procedures or {}).items()
+        )
+        self.tables = dict(
+            (self.normalize(name), columns)
+            for name, columns in (tables or {}).items()
+        )
+
+    @staticmethod
+    def normalize(name):
+        '''Normalize an object name for lookup.'''
+        return name.split('.')[-1].replace('[', '').replace(']', '').lower()
+
+    def statement(self, sql):
+        '''Find the response to a SQL batch, or None.'''
+        for pattern, response in self.statements:
+            if pattern.search(sql):
+                return response
+        return None
+
+
+class Handler(socketserver.StreamRequestHandler):
+    '''A client connection.'''
+
+    _USE = re.compile(r'\buse\s+\[?([^\]\s;]+)\]?', re.IGNORECASE)
+    _FMTONLY = re.compile(r'select\s+\*\s+from\s+(\S+)', re.IGNORECASE)
+    _INSERT_BULK = re.compile(r'^\s*insert\s+bulk\s+(\S+)', re.IGNORECASE)
+
+    # Well-known procedures an RPC request may name by ID.
+    _PROCIDS = {10: 'sp_executesql', 11: 'sp_prepare', 12: 'sp_execute', 13: 'sp_prepexec'}
+
+    def setup(self):
+        socketserver.StreamRequestHandler.setup(self)
+        self.tds72 = True
+        self.packet_size = 4096
+        self.packet_id = 0
+        self.database = 'master'
+        self.spid = self.server.next_spid()
+
+    def handle(self):
+        handlers = {
+            PACKET_PRELOGIN: self.on_prelogin,
+            PACKET_LOGIN7: self.on_login,
+            PACKET_SQL_BATCH: self.on_sql_batch,
+            PACKET_RPC: self.on_rpc,
+            PACKET_BULK_LOAD: self.on_bulk_load,
+            PACKET_ATTENTION: self.on_attention,
+        }
+        while True:
+            type_, payload = self.read_message()
+            if type_ is None:
+                break
+            handler = handlers.get(type_)
+            if handler is None:
+                self.send(
+                    message(50000, 'unsupported packet type {0}'.format(type_), 16, self.tds72, TOKEN_ERROR) +
+                    done(DONE_ERROR, tds72=self.tds72)
+                )
+            else:
+                handler(payload)
+
+    def read_message(self):
+        '''Read a message from the client, which may span multiple packets.'''
+        chunks = []
+        while True:
+            header = self.rfile.read(PACKET_HEADER.size)
+            if len(header) < PACKET_HEADER.size:
+                return None, None
+            type_, status, length, _, _, _ = PACKET_HEADER.unpack(header)
+            chunks.append(self.rfile.read(length - PACKET_HEADER.size))
+            if status & PACKET_STATUS_EOM:
+                return type_, b''.join(chunks)
+
+    def send(self, payload):
+        '''Send a reply to the client, split into packets.'''
+        view = memoryview(payload)
+        size = self.packet_size - PACKET_HEADER.size
+        chunks = []
+        offset = 0
+        while True:
+            chunk = view[offset:offset + size]
+            offset += size
+            last = offset >= len(payload)
+            chunks.append(
+                PACKET_HEADER.pack(
+                    PACKET_REPLY,
+                    PACKET_STATUS_EOM if last else 0,
+                    len(chunk) + PACKET_HEADER.size,
+                    self.spid,
+                    self.packet_id,
+                    0
+                )
+            )
+            chunks.append(chunk)
+            self.packet_id = (self.packet_id + 1) % 256
+            if last or len(chunks) >= 512:
+                self.wfile.write(b''.join(chunks))
+                chunks = []
+            if last:
+                break
+        self.wfile.flush()
+
+    def on_prelogin(self, payload): # pylint: disable=unused-argument
+        # VERSION, ENCRYPTION (not supported), INSTOPT and MARS.
+        options = (
+            (0x00, b'\x0f\x00\x07\xd0\x00\x00'),
+            (0x01, b'\x02'),
+            (0x02, b'\x00'),
+            (0x04, b'\x00'),
+        )
+        offset = len(options) * 5 + 1
+        header = b''
+        data = b''
+        for option, value in options:
+            header += struct.pack('>BHH', option, offset + len(data), len(value))
+            data += value
+        self.send(header + b'\xff' + data)
+
+    def on_login(self, payload):
+        version, packet_size = struct.unpack('<II', payload[4:12])
+        self.tds72 = version >= TDS72
+        if packet_size:
+            self.packet_size = min(max(packet_size, 512), 32767)
+
+        offset, length = struct.unpack('<HH', payload[68:72])
+        if length:
+            self.database = payload[offset:offset + length * 2].decode('utf-16-le')
+
+        collation = struct.pack('<BB', ENVCHANGE_COLLATION, len(COLLATION)) + COLLATION + b'\x00'
+        loginack = (
+            struct.pack('>BI', 1, version) +
+            b_varchar('Microsoft SQL Server') +
+            b'\x0f\x00\x07\xd0'
+        )
+        self.send(
+            envchange(ENVCHANGE_DATABASE, self.database, 'master') +
+            struct.pack('<BH', TOKEN_ENVCHANGE, len(collation)) + collation +
+            envchange(ENVCHANGE_LANGUAGE, 'us_english') +
+            envchange(ENVCHANGE_PACKETSIZE, str(self.packet_size), str(self.packet_size)) +
+            struct.pack('<BH', TOKEN_LOGINACK, len(loginack)) + loginack +
+            done(tds72=self.tds72)
+        )
+
+    def _skip_headers(self, payload):
+        # TDS 7.2+ requests start with ALL_HEADERS.
+        if self.tds72:
+            return payload[struct.unpack('<I', payload[:4])[0]:]
+        return payload
+
+    def on_sql_batch(self, payload):
+        sql = self._skip_headers(payload).decode('utf-16-le')
+        script = self.server.script
+
+        # bcp_sendrow() starts a bulk load with `insert bulk ...`.
+        if self._INSERT_BULK.match(sql):
+            self.send(done(tds72=self.tds72))
+            return
+
+        # bcp_init() reads a table's columns using `SET FMTONLY ON select * from ...`.
+        match = self._FMTONLY.search(sql)
+        if match and 'fmtonly' in sql.lower():
+            columns = script.tables.get(Script.normalize(match.group(1)))
+            if columns is None:
+                self.send(
+                    message(208, 'Invalid object name \'{0}\'.'.format(match.group(1)), 16, self.tds72,
+                            TOKEN_ERROR) +
+                    done(DONE_ERROR, tds72=self.tds72)
+                )
+            else:
+                self.send(ResultSet(columns, rows=0).tokens(self.tds72) + done(tds72=self.tds72))
+            return
+
+        response = script.statement(sql)
+        if isinstance(response, int):
+            self.send(done(rowcount=response, tds72=self.tds72))
+        elif response:
+            self.send(b''.join(
+                resultset.tokens(self.tds72) +
+                done(DONE_MORE if index < len(response) - 1 else DONE_FINAL,
+                     rowcount=resultset.rows, tds72=self.tds72)
+                for index, resultset in enumerate(response)
+            ))
+        else:
+            tokens = b''
+            match = self._USE.search(sql)
+            if match:
+                previous, self.database = self.database, match.group(1)
+                tokens += envchange(ENVCHANGE_DATABASE, self.database, previous)
+            self.send(tokens + done(tds72=self.tds72))
+
+    def on_rpc(self, payload):
+        payload = self._skip_headers(payload)
+        length = struct.unpack('<H', payload[:2])[0]
+        if length == 0xFFFF:
+            procid = struct.unpack('<H', payload[2:4])[0]
+            name = self._PROCIDS.get(procid, 'procid {0}'.format(procid))
+        else:
+            name = payload[2:2 + length * 2].decode('utf-16-le')
+
+        resultsets = self.server.script.procedures.get(Script.normalize(name))
+        if resultsets is None:
+            self.send(
+                message(2812, 'Could not find stored procedure \'{0}\'.'.format(name), 16, self.tds72,
+                        TOKEN_ERROR) +
+                done(DONE_ERROR, tds72=self.tds72, token=TOKEN_DONEPROC)
+            )
+            return
+
+        self.send(
+            b''.join(
+                resultset.tokens(self.tds72) +
+                done(DONE_MORE, rowcount=resultset.rows, tds72=self.tds72, token=TOKEN_DONEINPROC)
+                for resultset in resultsets
+            ) +
+            struct.pack('<Bi', TOKEN_RETURNSTATUS, 0) +
+            done(tds72=self.tds72, token=TOKEN_DONEPROC)
+        )
+
+    def on_bulk_load(self, payload):
+        try:
+            rows = BulkReader(payload, self.tds72).count()
+        except (IndexError, KeyError, ValueError, struct.error):
+            rows = 0
+        self.send(done(rowcount=rows, tds72=self.tds72))
+
+    def on_attention(self, payload): # pylint: disable=unused-argument
+        # All replies have been sent in full, so the client only waits for
+        # the acknowledgement.
+        self.send(done(DONE_ATTN, tds72=self.tds72))
+
+
+class BulkReader(object):
+    '''Count the rows of a bulk load message.'''
+
+    def __init__(self, payload, tds72):
+        self.payload = payload
+        self.tds72 = tds72
+        self.offset = 0
+
+    def read(self, fmt):
+        '''Read a struct from the message.'''
+        values = struct.unpack_from(fmt, self.payload, self.offset)
+        self.offset += struct.calcsize(fmt)
+        return values[0] if len(values) == 1 else values
+
+    def skip(self, fmt, size=1):
+        '''Skip a value prefixed by its length, in units of `size` bytes.'''
+        length = self.read(fmt)
+        self.offset += length * size
+        return length
+
+    def count(self):
+        '''Count the rows in the message.'''
+        columns = []
+        rows = 0
+        while self.offset < len(self.payload):
+            token = self.read('<B')
+            if token == TOKEN_COLMETADATA:
+                columns = [self.typeinfo() for _ in range(self.read('<H'))]
+            elif token == TOKEN_ROW:
+                for column in columns:
+                    self.skip_value(column)
+                rows += 1
+            elif token == TOKEN_DONE:
+                break
+            else:
+                raise ValueError(token)
+        return rows
+
+    def typeinfo(self):
+        '''Read a COLMETADATA entry, returning (type, max length).'''
+        self.read('<IH' if self.tds72 else '<HH')
+        type_ = self.read('<B')
+        maxlen = None
+        if type_ in FIXED_TYPES:
+            pass
+        elif type_ in BYTELEN_TYPES:
+            self.offset += BYTELEN_TYPES[type_]
+        elif type_ in USHORTLEN_TYPES:
+            maxlen = self.read('<H')
+            if USHORTLEN_TYPES[type_]:
+                self.offset += len(COLLATION)
+        elif type_ in LONGLEN_TYPES:
+            self.read('<i')
+            if LONGLEN_TYPES[type_]:
+                self.offset += len(COLLATION)
+            for _ in range(self.read('<B') if self.tds72 else 1):
+                self.skip('<H', 2)
+        elif type_ == TDS_SSVARIANT:
+            self.read('<i')
+        else:
+            raise ValueError(type_)
+        self.skip('<B', 2) # column name
+        return type_, maxlen
+
+    def skip_value(self, column):
+        '''Skip a column value of a ROW token.'''
+        type_, maxlen = column
+        if type_ in FIXED_TYPES:
+            self.offset += FIXED_TYPES[type_]
+        elif type_ in BYTELEN_TYPES:
+            self.skip('<B')
+        elif type_ in USHORTLEN_TYPES:
+            if maxlen == 0xFFFF:
+                # PLP: the total length followed by length-prefixed chunks.
+                if self.read('<Q') != 0xFFFFFFFFFFFFFFFF:
+                    chunk = self.read('<I')
+                    while chunk:
+                        self.offset += chunk
+                        chunk = self.read('<I')
+            else:
+                length = self.read('<H')
+                if length != 0xFFFF:
+                    self.offset += length
+        elif type_ in LONGLEN_TYPES:
+            textptr = self.read('<B')
+            if textptr:
+                self.offset += textptr + 8 # text pointer and timestamp
+                self.skip('<i')
+        else:
+            self.skip('<i')
+
+
+class Server(socketserver.ThreadingTCPServer):
+    '''
+    A TDS stub server, handling each connection in a thread.
+
+    :param Script script: The responses to replay.
+    :param str host: The address to listen on.
+    :param int port: The port to listen on, or 0 to pick a free port.
+    '''
+
+    allow_reuse_address = True
+    daemon_threads = True
+
+    def __init__(self, script, host='127.0.0.1', port=0):
+        socketserver.ThreadingTCPServer.__init__(self, (host, port), Handler)
+        self.script = script
+        self._spid = 50
+        self._lock = threading.Lock()
+
+    @property
+    def port(self):
+        '''The port the server is listening on.'''
+        return self.server_address[1]
+
+    def next_spid(self):
+        '''Allocate a session ID for a new connection.'''
+        with self._lock:
+            self._spid += 1
+            return self._spid
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run a TDS stub server with a sample script.')
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=1433)
+    parser.add_argument('--rows', type=int, default=1000, help='The rows returned by `SELECT ... FROM Rows`.')
+    args = parser.parse_args()
+
+    script = Script(
+        statements=[
+            (r'\bFROM\s+Rows\b', [ResultSet([Column('Id', 'int'), Column('Name', 'varchar(32)')], rows=args.rows)]),
+            (r'^\s*SELECT\s+1\b', [ResultSet([Column('', 'int')])]),
+        ],
+        procedures={
+            'Rows': [ResultSet([Column('Id', 'int'), Column('Name', 'varchar(32)')], rows=args.rows)],
+        },
+        tables={
+            'Rows': [Column('Id', 'int'), Column('Name', 'varchar(32)')],
+        },
+    )
+    server = Server(script, args.host, args.port)
+    print('listening on {0}:{1}'.format(args.host, server.port))
+    sys.stdout.flush()
+    server.serve_forever()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,12 @@
+#!/bin/sh -e
+
+if [ -e '/usr/local/bin/python3' ]; then
+    PYTHON=python3
+else
+    PYTHON=python
+fi
+
+# Install using setuptools directly so the local setup.cfg is used.
+CTDS_STRICT=1 /usr/local/bin/$PYTHON setup.py -v install
+
+/usr/local/bin/$PYTHON benchmarks/perf_regress.py $PERF_ARGS
@@ -32,6 +32,20 @@ LIBRARIES = [
 
 EXTRA_COMPILE_ARGS = []
 EXTRA_LINK_ARGS = []
+DEFINE_MACROS = []
+
+
+def splitdirs(name):
+    dirs = os.environ.get(name)
+    return dirs.split(os.pathsep) if dirs else []
+
+
+def has_header(header):
+    '''Determine if a header is present in any of the include directories.'''
+    return any(
+        os.path.isfile(os.path.join(dir_, header))
+        for dir_ in splitdirs('CTDS_INCLUDE_DIRS') + ['/usr/local/include', '/usr/include']
+    )
 
 
 if not WINDOWS:
@@ -58,6 +72,10 @@ if not WINDOWS:
         EXTRA_COMPILE_ARGS += ['-fprofile-arcs', '-ftest-coverage']
         EXTRA_LINK_ARGS.append('-fprofile-arcs')
 
+    # Compile in the USDT probes if the SystemTap SDT header is available.
+    if sys.platform.startswith('linux') and has_header(os.path.join('sys', 'sdt.h')):
+        DEFINE_MACROS.append(('CTDS_HAVE_SYS_SDT_H', '1'))
+
     # pthread is required on OS X for thread-local storage support.
     if sys.platform == 'darwin':
         EXTRA_LINK_ARGS.append('-lpthread')
@@ -97,11 +115,6 @@ else:
     ]
 
 
-def splitdirs(name):
-    dirs = os.environ.get(name)
-    return dirs.split(os.pathsep) if dirs else []
-
-
 def read(*names, **kwargs):
     with io.open(
         os.path.join(os.path.dirname(__file__), *names),
@@ -181,7 +194,7 @@ setuptools.setup(
                 ('CTDS_PATCH_VERSION', CTDS_PATCH_VERSION),
                 ('PY_SSIZE_T_CLEAN', '1'),
                 ('MSDBLIB', '1'),
-            ],
+            ] + DEFINE_MACROS,
             include_dirs=splitdirs('CTDS_INCLUDE_DIRS'),
             library_dirs=splitdirs('CTDS_LIBRARY_DIRS'),
             # runtime_library_dirs is not supported on Windows.
@@ -8,7 +8,15 @@ import logging
 from _tds import (
     apilevel,
     connect,
+    execute_parallel,
+    latency_histograms,
+    memory_stats,
     paramstyle,
+    set_memory_limit,
+    set_slow_query_log,
+    set_statement_stats,
+    set_trace_hooks,
+    statement_stats,
     threadsafety,
 
     Date,
@@ -32,6 +40,8 @@ from _tds import (
     NotSupportedError,
 
     Parameter,
+    Pool,
+    ResultCache,
     Row,
     RowList,
 
@@ -84,6 +94,9 @@ from _tds import (
     SqlVarChar,
 )
 
+from .extract import parallel_extract
+from .metrics import prometheus_metrics
+
 
 class NullHandler(logging.Handler):
     def emit(self, record):
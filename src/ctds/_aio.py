@@ -0,0 +1,102 @@
+'''
+:py:mod:`asyncio` integration for :py:meth:`ctds.Cursor.execute_async` and
+:py:meth:`ctds.Cursor.fetch_async`.
+'''
+import asyncio # pylint: disable=import-error
+import weakref
+
+
+def _get_loop():
+    try:
+        return asyncio.get_running_loop()
+    except AttributeError: # Python < 3.7
+        return asyncio.get_event_loop()
+    except RuntimeError: # No running loop.
+        return asyncio.get_event_loop()
+
+
+def reader_loop():
+    '''
+    Get the event loop, which must support monitoring file descriptors for
+    readability.
+
+    :raises NotImplementedError: The loop does not support
+        :py:meth:`asyncio.loop.add_reader`.
+    :rtype: asyncio.AbstractEventLoop
+    '''
+    loop = _get_loop()
+    proactor = getattr(asyncio, 'ProactorEventLoop', None) # Windows only
+    if proactor is not None and isinstance(loop, proactor):
+        raise NotImplementedError(
+            'execute_async() is not supported by the ProactorEventLoop; '
+            'use a SelectorEventLoop'
+        )
+    return loop
+
+
+def wait(loop, fd, complete, cancel):
+    '''
+    Wait for a file descriptor to become readable, then call `complete` in
+    the loop's default executor and resolve the returned future with its
+    result. If the future is cancelled or garbage collected first, `cancel`
+    is called instead, or once `complete` returns if it is already running.
+
+    :param asyncio.AbstractEventLoop loop: The event loop.
+    :param int fd: The file descriptor to wait on.
+    :param callable complete: The function to call once `fd` is readable.
+    :param callable cancel: The function to call if the future is cancelled.
+        It is passed the function returned to stop waiting, which identifies
+        the statement to cancel.
+    :return: The future and a function, callable from any thread, to stop
+        waiting and fail the future with the exception it is passed.
+    :rtype: tuple(asyncio.Future, callable)
+    '''
+    future = loop.create_future()
+    reference = weakref.ref(future)
+    running = []
+
+    def _completed(task):
+        if future.cancelled() or task.cancelled():
+            cancel(_abandon)
+            future.cancel()
+        elif task.exception() is not None:
+            future.set_exception(task.exception())
+        else:
+            future.set_result(task.result())
+
+    def _ready():
+        loop.remove_reader(fd)
+        if not future.done():
+            running.append(True)
+            loop.run_in_executor(None, complete).add_done_callback(_completed)
+
+    def _done(_):
+        loop.remove_reader(fd)
+        if future.cancelled() and not running:
+            cancel(_abandon)
+
+    def _abandon(exception):
+        def _fail():
+            loop.remove_reader(fd)
+            waiting = reference()
+            if waiting is not None and not waiting.done():
+                waiting.set_exception(exception)
+        try:
+            loop.call_soon_threadsafe(_fail)
+        except RuntimeError: # The loop is closed.
+            pass
+
+    loop.add_reader(fd, _ready)
+    future.add_done_callback(_done)
+    weakref.finalize(future, cancel, _abandon).atexit = False
+    return future, _abandon
+
+
+def run(function, *args):
+    '''
+    Run a blocking function in the event loop's default executor.
+
+    :param callable function: The function to run.
+    :rtype: asyncio.Future
+    '''
+    return _get_loop().run_in_executor(None, function, *args)
@@ -0,0 +1,18 @@
+'''
+Internal entry points for benchmarking the conversions between TDS and
+Python types without a database. This is not a public API.
+
+* :py:func:`convert` converts raw column data to Python objects, as done
+  when fetching rows.
+* :py:func:`convert_parameter` converts Python objects to their TDS
+  representation, as done when binding statement parameters.
+
+Both return the elapsed time, in seconds, of `n` conversions, along with
+the result of the conversion.
+'''
+
+# pylint: disable=no-name-in-module,unused-import
+from _tds import (
+    _bench_convert as convert,
+    _bench_parameter as convert_parameter,
+)
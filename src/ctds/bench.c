@@ -0,0 +1,230 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include "include/pop_warnings.h"
+
+#include "include/bench.h"
+#include "include/c99bool.h"
+#include "include/clock.h"
+#include "include/parameter.h"
+#include "include/tds.h"
+
+/* A raw value to convert. */
+struct Buffer
+{
+    const void* data;
+    size_t ndata;
+};
+
+/*
+    Check the width of a non-NULL raw value. The converters read fixed-width
+    types without checking the width, as FreeTDS always provides values of
+    the correct width.
+*/
+static bool Buffer_width_valid(enum TdsType tdstype, size_t ndata)
+{
+    switch (tdstype)
+    {
+        case TDSBIT:
+        case TDSBITN:
+        case TDSTINYINT:
+        {
+            return (1 == ndata);
+        }
+        case TDSSMALLINT:
+        {
+            return (2 == ndata);
+        }
+        case TDSINT:
+        case TDSREAL:
+        case TDSSMALLMONEY:
+        case TDSSMALLDATETIME:
+        {
+            return (4 == ndata);
+        }
+        case TDSBIGINT:
+        case TDSFLOAT:
+        case TDSMONEY:
+        {
+            return (8 == ndata);
+        }
+        case TDSINTN:
+        {
+            return (1 == ndata) || (2 == ndata) || (4 == ndata) || (8 == ndata);
+        }
+        case TDSFLOATN:
+        case TDSMONEYN:
+        {
+            return (4 == ndata) || (8 == ndata);
+        }
+        case TDSDATETIME:
+        case TDSDATETIMEN:
+        {
+            return (sizeof(DBDATETIME) == ndata);
+        }
+#if defined(CTDS_HAVE_TDS73_SUPPORT)
+        case TDSDATE:
+        case TDSTIME:
+        case TDSDATETIME2:
+        {
+            return (sizeof(DBDATETIMEALL) == ndata);
+        }
+#endif /* if defined(CTDS_HAVE_TDS73_SUPPORT) */
+        case TDSGUID:
+        {
+            return (16 == ndata);
+        }
+        default:
+        {
+            /* Variable-width types. */
+            return true;
+        }
+    }
+}
+
+PyObject* Bench_convert(enum TdsType tdstype, PyObject* data, Py_ssize_t n, PyObject* converter)
+{
+    sql_topython topython = NULL;
+    PyObject* sequence = NULL;
+    struct Buffer* buffers = NULL;
+    PyObject* value = NULL;
+    PyObject* result = NULL;
+
+    do
+    {
+        Py_ssize_t nbuffers;
+        Py_ssize_t ix;
+        Py_ssize_t ixbuffer;
+        double start;
+        double elapsed;
+
+        if (Py_None == converter)
+        {
+            topython = sql_topython_lookup(tdstype);
+        }
+        else if (0 != sql_topython_native_lookup(converter, tdstype, &topython))
+        {
+            PyErr_SetObject(PyExc_ValueError, converter);
+            break;
+        }
+        if (!topython)
+        {
+            PyErr_Format(PyExc_tds_NotSupportedError, "unsupported type %d", tdstype);
+            break;
+        }
+
+        if (PyBytes_Check(data))
+        {
+            sequence = PyTuple_Pack(1, data);
+        }
+        else
+        {
+            sequence = PySequence_Fast(data, "data must be bytes or a sequence of bytes");
+        }
+        if (!sequence)
+        {
+            break;
+        }
+
+        nbuffers = PySequence_Fast_GET_SIZE(sequence);
+        if (0 == nbuffers)
+        {
+            PyErr_SetObject(PyExc_ValueError, data);
+            break;
+        }
+
+        /* Resolve the buffers up front, so only the conversions are timed. */
+        buffers = tds_mem_malloc((size_t)nbuffers * sizeof(struct Buffer));
+        if (!buffers)
+        {
+            PyErr_NoMemory();
+            break;
+        }
+        for (ix = 0; ix < nbuffers; ++ix)
+        {
+            PyObject* item = PySequence_Fast_GET_ITEM(sequence, ix);
+            if (Py_None == item)
+            {
+                buffers[ix].data = NULL;
+                buffers[ix].ndata = 0;
+            }
+            else if (PyBytes_Check(item))
+            {
+                buffers[ix].data = PyBytes_AS_STRING(item);
+                buffers[ix].ndata = (size_t)PyBytes_GET_SIZE(item);
+                if (!Buffer_width_valid(tdstype, buffers[ix].ndata))
+                {
+                    PyErr_Format(PyExc_ValueError, "invalid width %ld for type %d",
+                                 (long)buffers[ix].ndata, tdstype);
+                    break;
+                }
+            }
+            else
+            {
+                PyErr_SetObject(PyExc_TypeError, item);
+                break;
+            }
+        }
+        if (ix < nbuffers)
+        {
+            break;
+        }
+
+        start = Clock_monotonic();
+        for (ix = 0, ixbuffer = 0; ix < n; ++ix)
+        {
+            Py_XDECREF(value);
+            value = topython(tdstype, buffers[ixbuffer].data, buffers[ixbuffer].ndata);
+            if (!value)
+            {
+                break;
+            }
+            if (++ixbuffer == nbuffers)
+            {
+                ixbuffer = 0;
+            }
+        }
+        elapsed = Clock_monotonic() - start;
+
+        if (value)
+        {
+            result = Py_BuildValue("(dO)", elapsed, value);
+        }
+    }
+    while (0);
+
+    Py_XDECREF(value);
+    Py_XDECREF(sequence);
+    tds_mem_free(buffers);
+
+    return result;
+}
+
+PyObject* Bench_convert_parameter(PyObject* value, Py_ssize_t n)
+{
+    PyObject* result = NULL;
+    struct Parameter* parameter = Parameter_create(value, false);
+    if (parameter)
+    {
+        Py_ssize_t ix;
+        double elapsed;
+        double start = Clock_monotonic();
+        for (ix = 0; ix < n; ++ix)
+        {
+            /* No connection is required to convert a parameter. */
+            if (0 != Parameter_bind(parameter, NULL))
+            {
+                break;
+            }
+        }
+        elapsed = Clock_monotonic() - start;
+
+        if (ix == n)
+        {
+            char* sqltype = Parameter_sqltype(parameter, false);
+            result = Py_BuildValue("(ds)", elapsed, sqltype);
+            tds_mem_free(sqltype);
+        }
+        Py_DECREF((PyObject*)parameter);
+    }
+    return result;
+}
@@ -0,0 +1,40 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+/* clock_gettime() requires POSIX.1b. */
+#  define _POSIX_C_SOURCE 199309L
+#endif /* if !defined(_WIN32) && !defined(_POSIX_C_SOURCE) */
+
+#include <time.h>
+
+#if defined(_WIN32)
+#  include "include/push_warnings.h"
+#  include <Windows.h>
+#  include "include/pop_warnings.h"
+#endif /* if defined(_WIN32) */
+
+#include "include/clock.h"
+
+double Clock_monotonic(void)
+{
+#if defined(_WIN32)
+    return (double)GetTickCount64() / 1000.0;
+#else /* if defined(_WIN32) */
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1000000000.0);
+#endif /* else if defined(_WIN32) */
+}
+
+uint64_t Clock_monotonic_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    (void)QueryPerformanceCounter(&counter);
+    (void)QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * (1000000000.0 / (double)frequency.QuadPart));
+#else /* if defined(_WIN32) */
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+#endif /* else if defined(_WIN32) */
+}
@@ -3,14 +3,21 @@
 #include <sybdb.h>
 #include "include/pop_warnings.h"
 
+#include <ctype.h>
 #include <stddef.h>
 
+#include "include/clock.h"
+#include "include/latency.h"
 #include "include/macros.h"
 #include "include/tds.h"
 #include "include/connection.h"
 #include "include/cursor.h"
+#include "include/probes.h"
 #include "include/pyutils.h"
 #include "include/parameter.h"
+#include "include/resultcache.h"
+#include "include/trace.h"
+#include "include/type.h"
 
 #ifdef __GNUC__
 /*
@@ -181,6 +188,60 @@ static void DatabaseMsg_clear(struct DatabaseMsg* dbmsg)
 
 TLS_DECLARE(LastMsg, struct DatabaseMsg, DatabaseMsg_clear)
 
+/* Insert a message into a list in order of descending severity. */
+static void DatabaseMsg_insert(struct DatabaseMsg** messages, struct DatabaseMsg* msg)
+{
+    struct DatabaseMsg* prev = NULL;
+    struct DatabaseMsg* curr = *messages;
+    while (NULL != curr && curr->severity >= msg->severity)
+    {
+        prev = curr;
+        curr = curr->next;
+    }
+
+    msg->next = curr;
+    if (!prev)
+    {
+        *messages = msg;
+    }
+    else
+    {
+        prev->next = msg;
+    }
+}
+
+/*
+    The output of the message and error handlers buffered for a connection
+    read from by a background thread. See Connection_redirect_messages().
+*/
+struct ConnectionMessages
+{
+    /* Was an error reported? */
+    bool error;
+    struct LastError lasterror;
+
+    struct DatabaseMsg* messages;
+};
+
+static void ConnectionMessages_clear(struct ConnectionMessages* buffer)
+{
+    buffer->error = false;
+    LastError_clear(&buffer->lasterror);
+
+    DatabaseMsg_clear(buffer->messages);
+    tds_mem_free(buffer->messages);
+    buffer->messages = NULL;
+}
+
+/* Unset the redirection on thread exit. The buffer is owned by its creator. */
+static void Redirect_clear(struct ConnectionMessages** redirect)
+{
+    *redirect = NULL;
+}
+
+/* The buffer the handlers' output is redirected to on the current thread. */
+TLS_DECLARE(Redirect, struct ConnectionMessages*, Redirect_clear)
+
 #if defined(__GNUC__)
 __attribute__((destructor)) void fini(void)
 {
@@ -199,6 +260,13 @@ struct Connection {
     /* Should execute calls be auto-committed? */
     bool autocommit;
 
+    /*
+        Has a statement been sent since the last commit or rollback while
+        auto-commit was disabled? If not, there is no implicit transaction
+        to commit or rollback and the round trip to the server is skipped.
+    */
+    bool in_transaction;
+
     /* Last seen error, as set by the error handler: Connection_dberrhandler. */
     struct LastError lasterror;
 
@@ -220,8 +288,91 @@ struct Connection {
         by this connection.
     */
     enum ParamStyle paramstyle;
+
+    /*
+        The default output converters for ctds.Cursor() objects created by
+        this connection. This may be NULL.
+    */
+    PyObject* converters;
+
+    /* The result cache for ctds.Cursor.execute() calls. This may be NULL. */
+    PyObject* result_cache;
+
+    /*
+        The server and login the connection was made to, which along with
+        the current database identify the data visible to the connection.
+    */
+    PyObject* identity;
+
+    /*
+        A background operation reading from `dbproc` without the GIL, such as
+        a cursor's row prefetch, and the function to stop it. These are NULL
+        if there is no background operation.
+    */
+    void (*background_stop)(void*);
+    void* background;
+
+    /* The id of the `ctds.Pool` the connection is acquired from, or 0. */
+    uint64_t pool;
+
+    /* The session state at connection time, restored by a session reset. */
+    char* database;
+    bool ansi_defaults;
+
+    /*
+        The statements resetting the session state, sent before the next
+        command, or NULL if no reset is pending. `reset_sent` is set once the
+        statements are sent and cleared if the command fails before the
+        server executes them, in which case the reset remains pending.
+        `reset_inline` indicates the statements may be prepended to a SQL
+        batch.
+    */
+    char* reset;
+    bool reset_sent;
+    bool reset_inline;
+
+    /* The performance counters. */
+    struct ConnectionStats* stats;
+
+    /*
+        Should the time spent converting the column data of result sets be
+        added to the performance counters? Timing each value costs two clock
+        reads, so this is opt-in.
+    */
+    bool time_conversions;
 };
 
+/*
+    These settings could easily be passed via the login packet, though that
+    requires an update to freetds' dbopen method to actually pass the flag.
+*/
+/* Mimic the settings used by ODBC connections. */
+static const char s_ansi_default_stmt[] =
+    /* https://msdn.microsoft.com/en-us/library/ms190306.aspx */
+    "SET ARITHABORT ON;"
+
+    /* https://msdn.microsoft.com/en-us/library/ms188340.aspx */
+    "SET ANSI_DEFAULTS ON;"
+
+    /* https://msdn.microsoft.com/en-us/library/ms176056.aspx */
+    "SET CONCAT_NULL_YIELDS_NULL ON;"
+
+    /* https://msdn.microsoft.com/en-us/library/ms186238.aspx */
+    "SET TEXTSIZE 2147483647;";
+
+/*
+    Session options which may be changed by a client and are restored to the
+    server defaults by a session reset.
+*/
+static const char s_reset_stmt[] =
+    "IF @@TRANCOUNT > 0 ROLLBACK TRANSACTION;"
+    "SET NOCOUNT OFF;"
+    "SET XACT_ABORT OFF;"
+    "SET ROWCOUNT 0;"
+    "SET LOCK_TIMEOUT -1;"
+    "SET DEADLOCK_PRIORITY NORMAL;"
+    "SET TRANSACTION ISOLATION LEVEL READ COMMITTED;";
+
 static PyObject* build_lastdberr_dict(const struct LastError* lasterror)
 {
     PyObject* dict = PyDict_New();
@@ -365,18 +516,139 @@ DBPROCESS* Connection_DBPROCESS(struct Connection* connection)
     return connection->dbproc;
 }
 
+struct ConnectionStats* Connection_stats(struct Connection* connection)
+{
+    return connection->stats;
+}
+
+bool Connection_time_conversions(struct Connection* connection)
+{
+    return connection->time_conversions;
+}
+
+void ConnectionStats_decrement(struct ConnectionStats* stats)
+{
+    stats->_refs--;
+    if (0 == stats->_refs)
+    {
+        tds_mem_free(stats);
+    }
+}
+
+PyObject* Connection_result_cache(struct Connection* connection)
+{
+    return connection->result_cache;
+}
+
+PyObject* Connection_identity(struct Connection* connection)
+{
+    return connection->identity;
+}
+
+uint64_t Connection_pool(struct Connection* connection)
+{
+    return connection->pool;
+}
+
+void Connection_set_pool(struct Connection* connection, uint64_t pool)
+{
+    connection->pool = pool;
+}
+
 int Connection_closed(struct Connection* connection)
 {
     return (!connection->dbproc);
 }
 
+void Connection_set_background(struct Connection* connection, void (*stop)(void*), void* background)
+{
+    connection->background_stop = stop;
+    connection->background = background;
+}
+
+void Connection_stop_background(struct Connection* connection)
+{
+    void (*stop)(void*) = connection->background_stop;
+    if (stop)
+    {
+        void* background = connection->background;
+        Connection_set_background(connection, NULL, NULL);
+        stop(background);
+    }
+}
+
+struct ConnectionMessages* ConnectionMessages_create(void)
+{
+    return tds_mem_tagged_calloc(messages, 1, sizeof(struct ConnectionMessages));
+}
+
+void ConnectionMessages_free(struct ConnectionMessages* buffer)
+{
+    if (buffer)
+    {
+        ConnectionMessages_clear(buffer);
+        tds_mem_free(buffer);
+    }
+}
+
+void Connection_redirect_messages(struct ConnectionMessages* buffer)
+{
+    struct ConnectionMessages** redirect = Redirect_get();
+    if (redirect)
+    {
+        if (buffer)
+        {
+            *redirect = buffer;
+        }
+        else
+        {
+            Redirect_clear(redirect);
+        }
+    }
+}
+
+/* Move the buffered messages and error, if any, to another list and error. */
+static void ConnectionMessages_move_to(struct ConnectionMessages* buffer,
+                                       struct LastError* lasterror,
+                                       struct DatabaseMsg** messages)
+{
+    if (buffer->error)
+    {
+        LastError_clear(lasterror);
+        *lasterror = buffer->lasterror; /* claim the error strings */
+        memset(&buffer->lasterror, 0, sizeof(buffer->lasterror));
+        buffer->error = false;
+    }
+
+    while (buffer->messages)
+    {
+        struct DatabaseMsg* msg = buffer->messages;
+        buffer->messages = msg->next;
+        DatabaseMsg_insert(messages, msg);
+    }
+}
+
+void ConnectionMessages_move(struct ConnectionMessages* to, struct ConnectionMessages* from)
+{
+    to->error = to->error || from->error;
+    ConnectionMessages_move_to(from, &to->lasterror, &to->messages);
+}
+
+void Connection_merge_messages(struct Connection* connection, struct ConnectionMessages* buffer)
+{
+    ConnectionMessages_move_to(buffer, &connection->lasterror, &connection->messages);
+}
+
 /* Close a connection, cancelling any currently executing command. */
-static void Connection_close_internal(struct Connection* connection)
+void Connection_close_internal(struct Connection* connection)
 {
+    Connection_stop_background(connection);
+
     Py_BEGIN_ALLOW_THREADS
 
         if (!Connection_closed(connection))
         {
+            PROBE1(connection_close, connection);
             dbclose(connection->dbproc);
             connection->dbproc = NULL;
         }
@@ -411,6 +683,27 @@ static void Connection_free(struct Connection* connection)
 
         LastError_clear(&connection->lasterror);
         Connection_clear_messages(connection);
+
+        Py_XDECREF(connection->converters);
+        connection->converters = NULL;
+
+        Py_XDECREF(connection->result_cache);
+        connection->result_cache = NULL;
+
+        Py_XDECREF(connection->identity);
+        connection->identity = NULL;
+
+        tds_mem_free(connection->database);
+        connection->database = NULL;
+
+        tds_mem_free(connection->reset);
+        connection->reset = NULL;
+
+        if (connection->stats)
+        {
+            ConnectionStats_decrement(connection->stats);
+            connection->stats = NULL;
+        }
     }
 }
 
@@ -636,6 +929,18 @@ int Connection_raise_lastwarning(struct Connection* connection)
 static int Connection_use_internal(struct Connection* connection, const char* database)
 {
     RETCODE retcode;
+    double start;
+    double elapsed;
+
+    Connection_stop_background(connection);
+
+    /* Apply any pending reset first, as it may change the database. */
+    if (0 != Connection_reset_prepare(connection, NULL))
+    {
+        return -1;
+    }
+
+    start = Clock_monotonic();
 
     Py_BEGIN_ALLOW_THREADS
 
@@ -643,6 +948,12 @@ static int Connection_use_internal(struct Connection* connection, const char* da
 
     Py_END_ALLOW_THREADS
 
+    elapsed = Clock_monotonic() - start;
+    connection->stats->round_trips++;
+    connection->stats->bytes_sent += strlen(database);
+    connection->stats->response_time += elapsed;
+    Latency_record_seconds(LatencyMetric_round_trip, elapsed);
+
     if (FAIL == retcode)
     {
         Connection_raise_lasterror(connection);
@@ -659,12 +970,24 @@ int Connection_dberrhandler(DBPROCESS* dbproc, int severity, int dberr,
                             int oserr, char *dberrstr, char *oserrstr)
 {
     struct LastError* lasterror = NULL;
+
+    PROBE4(error, dbproc, severity, dberr, oserr);
+
     if (dbproc)
     {
         struct Connection* connection = (struct Connection*)dbgetuserdata(dbproc);
         if (connection)
         {
-            lasterror = &connection->lasterror;
+            struct ConnectionMessages** redirect = Redirect_get();
+            if (redirect && *redirect)
+            {
+                (*redirect)->error = true;
+                lasterror = &(*redirect)->lasterror;
+            }
+            else
+            {
+                lasterror = &connection->lasterror;
+            }
         }
     }
     if (!lasterror)
@@ -677,8 +1000,8 @@ int Connection_dberrhandler(DBPROCESS* dbproc, int severity, int dberr,
     lasterror->severity = severity;
     lasterror->dberr = dberr;
     lasterror->oserr = oserr;
-    lasterror->dberrstr = (dberrstr) ? tds_mem_strdup(dberrstr) : NULL;
-    lasterror->oserrstr = (oserrstr) ? tds_mem_strdup(oserrstr) : NULL;
+    lasterror->dberrstr = (dberrstr) ? tds_mem_tagged_strdup(messages, dberrstr) : NULL;
+    lasterror->oserrstr = (oserrstr) ? tds_mem_tagged_strdup(messages, oserrstr) : NULL;
 
     /*
         Possible return values included:
@@ -709,40 +1032,22 @@ int Connection_dbmsghandler(DBPROCESS* dbproc, DBINT msgno, int msgstate,
     struct Connection* connection = (struct Connection*)dbgetuserdata(dbproc);
     if (connection)
     {
-        struct DatabaseMsg* msg = tds_mem_malloc(sizeof(struct DatabaseMsg));
+        struct DatabaseMsg* msg = tds_mem_tagged_malloc(messages, sizeof(struct DatabaseMsg));
         if (msg)
         {
-            struct DatabaseMsg* prev;
-            struct DatabaseMsg* curr;
+            struct ConnectionMessages** redirect = Redirect_get();
 
             memset(msg, 0, sizeof(struct DatabaseMsg));
 
             msg->msgno = msgno;
             msg->msgstate = msgstate;
             msg->severity = severity;
-            msg->msgtext = (msgtext) ? tds_mem_strdup(msgtext) : NULL;
-            msg->srvname = (srvname) ? tds_mem_strdup(srvname) : NULL;
-            msg->proc = (proc) ? tds_mem_strdup(proc) : NULL;
+            msg->msgtext = (msgtext) ? tds_mem_tagged_strdup(messages, msgtext) : NULL;
+            msg->srvname = (srvname) ? tds_mem_tagged_strdup(messages, srvname) : NULL;
+            msg->proc = (proc) ? tds_mem_tagged_strdup(messages, proc) : NULL;
             msg->line = line;
 
-            /* Insert the message into the list in order of descending severity. */
-            prev = NULL;
-            curr = connection->messages;
-            while (NULL != curr && curr->severity >= severity)
-            {
-                prev = curr;
-                curr = curr->next;
-            }
-
-            msg->next = curr;
-            if (!prev)
-            {
-                connection->messages = msg;
-            }
-            else
-            {
-                prev->next = msg;
-            }
+            DatabaseMsg_insert((redirect && *redirect) ? &(*redirect)->messages : &connection->messages, msg);
         }
     }
     else
@@ -754,23 +1059,125 @@ int Connection_dbmsghandler(DBPROCESS* dbproc, DBINT msgno, int msgstate,
         lastmsg->msgno = msgno;
         lastmsg->msgstate = msgstate;
         lastmsg->severity = severity;
-        lastmsg->msgtext = (msgtext) ? tds_mem_strdup(msgtext) : NULL;
-        lastmsg->srvname = (srvname) ? tds_mem_strdup(srvname) : NULL;
-        lastmsg->proc = (proc) ? tds_mem_strdup(proc) : NULL;
+        lastmsg->msgtext = (msgtext) ? tds_mem_tagged_strdup(messages, msgtext) : NULL;
+        lastmsg->srvname = (srvname) ? tds_mem_tagged_strdup(messages, srvname) : NULL;
+        lastmsg->proc = (proc) ? tds_mem_tagged_strdup(messages, proc) : NULL;
         lastmsg->line = line;
     }
 
     return 0;
 }
 
+/*
+    Discard the session reset statements if they were sent with the previous
+    command. This must be called before sending another command.
+*/
+static void Connection_reset_settle(struct Connection* connection)
+{
+    if (connection->reset_sent)
+    {
+        /* The previous command including the reset succeeded. */
+        tds_mem_free(connection->reset);
+        connection->reset = NULL;
+        connection->reset_sent = false;
+    }
+}
+
+/*
+    Get the pending session reset statements, if any, and mark them as sent.
+
+    @return The statements, or NULL if no reset is pending.
+*/
+static const char* Connection_reset_take(struct Connection* connection)
+{
+    Connection_reset_settle(connection);
+    if (connection->reset)
+    {
+        connection->reset_sent = true;
+    }
+    return connection->reset;
+}
+
+void Connection_reset_retry(struct Connection* connection)
+{
+    connection->reset_sent = false;
+}
+
+/*
+    The timing of a SQL batch sent by Connection_execute().
+*/
+struct ConnectionBatch
+{
+    size_t nsent;
+    double start;
+    double sent;
+    double responded;
+};
+
+/*
+    Send the SQL batch in the command buffer and discard any results.
+
+    @note This method does not manipulate the GIL. Callers should release
+        the GIL when calling this method.
+*/
+static RETCODE Connection_execute_batch(DBPROCESS* dbproc, struct ConnectionBatch* batch)
+{
+    RETCODE retcode;
+
+    batch->start = Clock_monotonic();
+    retcode = dbsqlsend(dbproc);
+    batch->sent = Clock_monotonic();
+    if (FAIL == retcode)
+    {
+        return retcode;
+    }
+    retcode = dbsqlok(dbproc);
+    if (FAIL == retcode)
+    {
+        return retcode;
+    }
+    while (NO_MORE_RESULTS != (retcode = dbresults(dbproc)))
+    {
+        if (FAIL == retcode)
+        {
+            return retcode;
+        }
+        while (NO_MORE_ROWS != (retcode = dbnextrow(dbproc)))
+        {
+            if (FAIL == retcode)
+            {
+                return retcode;
+            }
+        }
+    }
+    batch->responded = Clock_monotonic();
+    return retcode;
+}
+
 /*
     Execute a static SQL statement and discard any results.
+
+    Any pending session reset is first executed in a separate batch, so its
+    failure is distinguished from that of the statement. A reset which fails
+    remains pending.
 */
 static int Connection_execute(struct Connection* connection, size_t ncmds, ...)
 {
     va_list vargs;
     RETCODE retcode;
     size_t ix;
+    const char* reset;
+
+    /* The reset and command batches. */
+    struct ConnectionBatch batches[2];
+    size_t nbatches = 0;
+    bool reset_succeeded = false;
+
+    memset(batches, 0, sizeof(batches));
+
+    Connection_stop_background(connection);
+
+    reset = Connection_reset_take(connection);
 
     va_start(vargs, ncmds);
 
@@ -783,6 +1190,25 @@ static int Connection_execute(struct Connection* connection, size_t ncmds, ...)
             {
                 break;
             }
+            if (reset)
+            {
+                retcode = dbcmd(connection->dbproc, reset);
+                if (FAIL == retcode)
+                {
+                    break;
+                }
+                batches[nbatches].nsent = strlen(reset);
+                retcode = Connection_execute_batch(connection->dbproc, &batches[nbatches++]);
+                if (FAIL == retcode)
+                {
+                    break;
+                }
+                reset_succeeded = true;
+            }
+            if (!ncmds)
+            {
+                break;
+            }
             for (ix = 0; ix < ncmds; ++ix)
             {
                 const char* cmd = va_arg(vargs, char*);
@@ -791,58 +1217,250 @@ static int Connection_execute(struct Connection* connection, size_t ncmds, ...)
                 {
                     break;
                 }
+                batches[nbatches].nsent += strlen(cmd);
             }
             if (FAIL == retcode)
             {
                 break;
             }
+            retcode = Connection_execute_batch(connection->dbproc, &batches[nbatches++]);
+        } while (0);
 
-            retcode = dbsqlexec(connection->dbproc);
-            if (FAIL == retcode)
+    Py_END_ALLOW_THREADS
+
+    va_end(vargs);
+
+    for (ix = 0; ix < nbatches; ++ix)
+    {
+        const struct ConnectionBatch* batch = &batches[ix];
+        if (batch->sent)
+        {
+            connection->stats->round_trips++;
+            connection->stats->bytes_sent += batch->nsent;
+            connection->stats->send_time += batch->sent - batch->start;
+            if (batch->responded)
             {
-                break;
+                connection->stats->response_time += batch->responded - batch->sent;
+                Latency_record_seconds(LatencyMetric_round_trip, batch->responded - batch->start);
+            }
+        }
+    }
+
+    if (reset)
+    {
+        if (reset_succeeded)
+        {
+            Connection_reset_settle(connection);
+
+            /* The reset rolled back any pending transaction. */
+            connection->in_transaction = false;
+        }
+        else
+        {
+            Connection_reset_retry(connection);
+        }
+    }
+
+    if (FAIL == retcode)
+    {
+        Connection_raise_lasterror(connection);
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+    Check if the statements of a session reset may be prepended to a SQL
+    batch. Some statements, e.g. `CREATE PROCEDURE`, must be the first in a
+    batch, so the reset is never prepended to batches beginning with
+    `CREATE` or `ALTER`.
+*/
+static bool Connection_reset_prependable(const char* sql)
+{
+    static const char* const s_keywords[] = { "CREATE", "ALTER" };
+    size_t ix;
+
+    /* Skip leading whitespace and comments. */
+    for (;;)
+    {
+        while (isspace((unsigned char)*sql))
+        {
+            ++sql;
+        }
+        if (('-' == sql[0]) && ('-' == sql[1]))
+        {
+            while (*sql && ('\n' != *sql))
+            {
+                ++sql;
             }
-            while (NO_MORE_RESULTS != (retcode = dbresults(connection->dbproc)))
+        }
+        else if (('/' == sql[0]) && ('*' == sql[1]))
+        {
+            const char* end = strstr(sql + 2, "*/");
+            if (!end)
             {
-                if (FAIL == retcode)
-                {
-                    break;
-                }
-                while (NO_MORE_ROWS != (retcode = dbnextrow(connection->dbproc)))
-                {
-                    if (FAIL == retcode)
-                    {
-                        break;
-                    }
-                }
-                if (FAIL == retcode)
-                {
-                    break;
-                }
+                return false;
+            }
+            sql = end + 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    for (ix = 0; ix < ARRAYSIZE(s_keywords); ++ix)
+    {
+        size_t nkeyword = strlen(s_keywords[ix]);
+        size_t ch;
+        for (ch = 0; ch < nkeyword; ++ch)
+        {
+            if (toupper((unsigned char)sql[ch]) != s_keywords[ix][ch])
+            {
+                break;
+            }
+        }
+        if ((ch == nkeyword) && !isalnum((unsigned char)sql[ch]) && ('_' != sql[ch]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int Connection_reset_prepare(struct Connection* connection, const char* sql)
+{
+    Connection_reset_settle(connection);
+    if (!connection->reset)
+    {
+        return 0;
+    }
+
+    if (sql && connection->reset_inline && Connection_reset_prependable(sql))
+    {
+        if (FAIL == dbcmd(connection->dbproc, Connection_reset_take(connection)))
+        {
+            Connection_reset_retry(connection);
+            Connection_raise_lasterror(connection);
+            return -1;
+        }
+        return 0;
+    }
+
+    /* Send the reset in a separate batch. */
+    if (0 != Connection_execute(connection, 0))
+    {
+        return -1;
+    }
+
+    /* Discard informational messages, e.g. for a database change. */
+    Connection_clear_messages(connection);
+    return 0;
+}
+
+int Connection_reset_session(struct Connection* connection)
+{
+    const char* database = dbname(connection->dbproc);
+    bool use = (database && connection->database && (0 != strcmp(database, connection->database)));
+    size_t nreset = ARRAYSIZE(s_reset_stmt) + ARRAYSIZE(s_ansi_default_stmt) +
+        STRLEN("SET IMPLICIT_TRANSACTIONS OFF;");
+    char* reset;
+    size_t written;
+
+    if (use)
+    {
+        const char* ch;
+        nreset += STRLEN("USE [];");
+        for (ch = connection->database; *ch; ++ch)
+        {
+            /* Closing brackets are escaped by doubling them. */
+            nreset += (']' == *ch) ? 2 : 1;
+        }
+    }
+
+    reset = tds_mem_malloc(nreset);
+    if (!reset)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    written = (size_t)PyOS_snprintf(reset, nreset, "%s%sSET IMPLICIT_TRANSACTIONS %s;",
+                                    s_reset_stmt,
+                                    (connection->ansi_defaults) ? s_ansi_default_stmt : "",
+                                    (connection->autocommit) ? "OFF" : "ON");
+    if (use)
+    {
+        const char* ch;
+        reset[written++] = 'U';
+        reset[written++] = 'S';
+        reset[written++] = 'E';
+        reset[written++] = ' ';
+        reset[written++] = '[';
+        for (ch = connection->database; *ch; ++ch)
+        {
+            reset[written++] = *ch;
+            if (']' == *ch)
+            {
+                reset[written++] = ']';
             }
-        } while (0);
+        }
+        reset[written++] = ']';
+        reset[written++] = ';';
+        reset[written] = '\0';
+    }
+    assert(written < nreset);
 
-    Py_END_ALLOW_THREADS
+    tds_mem_free(connection->reset);
+    connection->reset = reset;
+    connection->reset_sent = false;
 
-    va_end(vargs);
+    /*
+        Changing the database generates an informational message, which would
+        be reported as a warning if prepended to a cursor's SQL batch, so the
+        reset is sent separately.
+    */
+    connection->reset_inline = !use;
+    return 0;
+}
 
-    if (FAIL == retcode)
+int Connection_transaction_commit(struct Connection* connection)
+{
+    if (0 != Connection_execute(connection, 1, "IF @@TRANCOUNT > 0 COMMIT TRANSACTION"))
     {
-        Connection_raise_lasterror(connection);
         return -1;
     }
+    connection->in_transaction = false;
+    return 0;
+}
 
+int Connection_transaction_rollback(struct Connection* connection)
+{
+    if (0 != Connection_execute(connection, 1, "IF @@TRANCOUNT > 0 ROLLBACK TRANSACTION"))
+    {
+        return -1;
+    }
+    connection->in_transaction = false;
     return 0;
 }
 
-int Connection_transaction_commit(struct Connection* connection)
+bool Connection_in_transaction(struct Connection* connection)
 {
-    return Connection_execute(connection, 1, "IF @@TRANCOUNT > 0 COMMIT TRANSACTION");
+    /*
+        Always report a transaction on a dead connection to ensure the
+        client is notified of it by the commit or rollback.
+    */
+    return (connection->in_transaction || DBDEAD(connection->dbproc));
 }
 
-int Connection_transaction_rollback(struct Connection* connection)
+void Connection_statement_sent(struct Connection* connection)
 {
-    return Connection_execute(connection, 1, "IF @@TRANCOUNT > 0 ROLLBACK TRANSACTION");
+    /* With auto-commit disabled, IMPLICIT_TRANSACTIONS is ON. */
+    if (!connection->autocommit)
+    {
+        connection->in_transaction = true;
+    }
 }
 
 /*
@@ -915,6 +1533,10 @@ static int Connection_autocommit_set(PyObject* self, PyObject* value, void* clos
         if (!error)
         {
             connection->autocommit = autocommit;
+            if (autocommit)
+            {
+                connection->in_transaction = false;
+            }
         }
     }
     return error;
@@ -922,6 +1544,101 @@ static int Connection_autocommit_set(PyObject* self, PyObject* value, void* clos
     UNUSED(closure);
 }
 
+static const char s_Connection_converters_doc[] =
+    "The default output converters for :py:class:`ctds.Cursor` objects\n"
+    "created by this connection, or :py:data:`None`.\n"
+    "See :py:attr:`ctds.Cursor.converters`. As for the cursor's converters,\n"
+    "the :py:class:`dict` is copied when set and when read.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":rtype: dict\n";
+
+static PyObject* Connection_converters_get(PyObject* self, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+
+    if (connection->converters)
+    {
+        /* Return a copy so changes to it cannot bypass validation. */
+        return PyDict_Copy(connection->converters);
+    }
+    Py_RETURN_NONE;
+
+    UNUSED(closure);
+}
+
+static int Connection_converters_set(PyObject* self, PyObject* value, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+    PyObject* converters = NULL;
+
+    if (value && (Py_None != value))
+    {
+        if (0 != converters_validate(value))
+        {
+            return -1;
+        }
+        converters = PyDict_Copy(value);
+        if (!converters)
+        {
+            return -1;
+        }
+    }
+
+    Py_XDECREF(connection->converters);
+    connection->converters = converters;
+    return 0;
+
+    UNUSED(closure);
+}
+
+static const char s_Connection_result_cache_doc[] =
+    "The :py:class:`ctds.ResultCache` used to cache the results of\n"
+    ":py:meth:`ctds.Cursor.execute` calls on this connection, or\n"
+    ":py:data:`None`.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":rtype: ctds.ResultCache\n";
+
+static PyObject* Connection_result_cache_get(PyObject* self, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+
+    if (connection->result_cache)
+    {
+        Py_INCREF(connection->result_cache);
+        return connection->result_cache;
+    }
+    Py_RETURN_NONE;
+
+    UNUSED(closure);
+}
+
+static int Connection_result_cache_set(PyObject* self, PyObject* value, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+    PyObject* result_cache = NULL;
+
+    if (value && (Py_None != value))
+    {
+        if (!PyObject_TypeCheck(value, &ResultCacheType))
+        {
+            PyErr_SetObject(PyExc_TypeError, value);
+            return -1;
+        }
+        Py_INCREF(value);
+        result_cache = value;
+    }
+
+    Py_XDECREF(connection->result_cache);
+    connection->result_cache = result_cache;
+    return 0;
+
+    UNUSED(closure);
+}
+
 static const char s_Connection_database_doc[] =
     "The current database or :py:data:`None` if the connection is closed.\n"
     "\n"
@@ -985,6 +1702,28 @@ static int Connection_database_set(PyObject* self, PyObject* value, void* closur
     UNUSED(closure);
 }
 
+static const char s_Connection_in_transaction_doc[] =
+    "Whether a transaction may be pending on the connection, i.e. auto-commit\n"
+    "is disabled and a statement has been executed since the last\n"
+    ":py:meth:`.commit` or :py:meth:`.rollback`. If not, :py:meth:`.commit`\n"
+    "and :py:meth:`.rollback` return without a round trip to the server.\n"
+    "\n"
+    ".. note::\n"
+    "\n"
+    "    Transactions started explicitly, e.g. using `BEGIN TRANSACTION`, while\n"
+    "    auto-commit is enabled are not tracked.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":rtype: bool\n";
+
+static PyObject* Connection_in_transaction_get(PyObject* self, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+    return PyBool_FromLong(connection->in_transaction);
+    UNUSED(closure);
+}
+
 static const char s_Connection_messages_doc[] =
     "A list of any informational messages received from the last\n"
     ":py:meth:`ctds.Cursor.execute`, :py:meth:`ctds.Cursor.executemany`, or\n"
@@ -1000,15 +1739,8 @@ static const char s_Connection_messages_doc[] =
     "\n"
     ":rtype: list(dict)\n";
 
-static PyObject* Connection_messages_get(PyObject* self, void* closure)
+PyObject* Connection_messages(struct Connection* connection)
 {
-    struct Connection* connection = (struct Connection*)self;
-
-    if (0 != PyErr_WarnEx(PyExc_Warning, "DB-API extension connection.messages used", 1))
-    {
-        return NULL;
-    }
-
     if (!Connection_closed(connection))
     {
         PyObject* messages = NULL;
@@ -1060,6 +1792,18 @@ static PyObject* Connection_messages_get(PyObject* self, void* closure)
     {
         Py_RETURN_NONE;
     }
+}
+
+static PyObject* Connection_messages_get(PyObject* self, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+
+    if (0 != PyErr_WarnEx(PyExc_Warning, "DB-API extension connection.messages used", 1))
+    {
+        return NULL;
+    }
+
+    return Connection_messages(connection);
 
     UNUSED(closure);
 }
@@ -1086,6 +1830,81 @@ static PyObject* Connection_spid_get(PyObject* self, void* closure)
     UNUSED(closure);
 }
 
+static const char s_Connection_stats_doc[] =
+    "A snapshot of the connection's cumulative performance counters, for\n"
+    "telling apart time spent on the network, in the server and converting\n"
+    "results. The counters are kept since the connection was opened or\n"
+    "last reset using :py:meth:`.reset_stats`.\n"
+    "\n"
+    "* ``round_trips``: The number of requests sent to the server and\n"
+    "  awaited, including SQL batches, stored procedure calls and bulk\n"
+    "  insert batches.\n"
+    "* ``bytes_sent``: The bytes of SQL text and parameter data sent. This\n"
+    "  excludes TDS protocol overhead and encoding.\n"
+    "* ``bytes_received``: The bytes of column data received.\n"
+    "* ``rows``: The number of rows fetched.\n"
+    "* ``send_time``: The time, in seconds, spent sending requests.\n"
+    "* ``response_time``: The time, in seconds, spent waiting for the\n"
+    "  server to respond to requests.\n"
+    "* ``fetch_time``: The time, in seconds, spent reading rows.\n"
+    "* ``conversion_time``: The time, in seconds, spent converting column\n"
+    "  data to Python objects, if enabled using :py:attr:`.time_conversions`.\n"
+    "  Rows fetched from the connection continue to add to this after the\n"
+    "  connection is closed.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":rtype: dict\n";
+
+static PyObject* Connection_stats_get(PyObject* self, void* closure)
+{
+    const struct ConnectionStats* stats = ((struct Connection*)self)->stats;
+    return Py_BuildValue("{sKsKsKsKsdsdsdsd}",
+                         "round_trips",     stats->round_trips,
+                         "bytes_sent",      stats->bytes_sent,
+                         "bytes_received",  stats->bytes_received,
+                         "rows",            stats->rows,
+                         "send_time",       stats->send_time,
+                         "response_time",   stats->response_time,
+                         "fetch_time",      stats->fetch_time,
+                         "conversion_time", stats->conversion_time);
+    UNUSED(closure);
+}
+
+static const char s_Connection_time_conversions_doc[] =
+    "Whether the time spent converting column data to Python objects is\n"
+    "added to the ``conversion_time`` of :py:attr:`.stats`. Timing costs\n"
+    "two clock reads for each value converted, which may exceed the cost of\n"
+    "the conversion itself, so it is disabled by default. It applies to the\n"
+    "result sets of statements executed once it is enabled.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":rtype: bool\n";
+
+static PyObject* Connection_time_conversions_get(PyObject* self, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+    return PyBool_FromLong(connection->time_conversions);
+    UNUSED(closure);
+}
+
+static int Connection_time_conversions_set(PyObject* self, PyObject* value, void* closure)
+{
+    struct Connection* connection = (struct Connection*)self;
+
+    if (!value || !PyBool_Check(value))
+    {
+        PyErr_SetObject(PyExc_TypeError, (value) ? value : Py_None);
+        return -1;
+    }
+
+    connection->time_conversions = (Py_True == value);
+    return 0;
+
+    UNUSED(closure);
+}
+
 static const char s_Connection_tds_version_doc[] =
     "The TDS version in use for the connection or :py:data:`None` if the\n"
     "connection is closed.\n"
@@ -1220,6 +2039,7 @@ static int Connection_timeout_set(PyObject* self, PyObject* value, void* closure
             /* The timeout must be passed as a string. */
             char str[ARRAYSIZE("2147483648")];
             (void)PyOS_snprintf(str, sizeof(str), "%d", (int)timeout);
+            Connection_stop_background(connection);
             if (FAIL == dbsetopt(connection->dbproc, DBSETTIME, str, (int)timeout))
             {
                 Connection_raise_lasterror(connection);
@@ -1247,13 +2067,18 @@ static int Connection_timeout_set(PyObject* self, PyObject* value, void* closure
 
 static PyGetSetDef Connection_getset[] = {
     /* name, get, set, doc, closure */
-    { (char*)"autocommit",  Connection_autocommit_get,  Connection_autocommit_set, (char*)s_Connection_autocommit_doc,  NULL },
-    { (char*)"database",    Connection_database_get,    Connection_database_set,   (char*)s_Connection_database_doc,    NULL },
-    { (char*)"messages",    Connection_messages_get,    NULL,                      (char*)s_Connection_messages_doc,    NULL },
-    { (char*)"spid",        Connection_spid_get,        NULL,                      (char*)s_Connection_spid_doc,        NULL },
-    { (char*)"tds_version", Connection_tds_version_get, NULL,                      (char*)s_Connection_tds_version_doc, NULL },
-    { (char*)"timeout",     Connection_timeout_get,     Connection_timeout_set,    (char*)s_Connection_timeout_doc,     NULL },
-    { NULL,                 NULL,                       NULL,                      NULL,                                NULL }
+    { (char*)"autocommit",       Connection_autocommit_get,       Connection_autocommit_set,       (char*)s_Connection_autocommit_doc,       NULL },
+    { (char*)"converters",       Connection_converters_get,       Connection_converters_set,       (char*)s_Connection_converters_doc,       NULL },
+    { (char*)"database",         Connection_database_get,         Connection_database_set,         (char*)s_Connection_database_doc,         NULL },
+    { (char*)"in_transaction",   Connection_in_transaction_get,   NULL,                            (char*)s_Connection_in_transaction_doc,   NULL },
+    { (char*)"messages",         Connection_messages_get,         NULL,                            (char*)s_Connection_messages_doc,         NULL },
+    { (char*)"result_cache",     Connection_result_cache_get,     Connection_result_cache_set,     (char*)s_Connection_result_cache_doc,     NULL },
+    { (char*)"spid",             Connection_spid_get,             NULL,                            (char*)s_Connection_spid_doc,             NULL },
+    { (char*)"stats",            Connection_stats_get,            NULL,                            (char*)s_Connection_stats_doc,            NULL },
+    { (char*)"tds_version",      Connection_tds_version_get,      NULL,                            (char*)s_Connection_tds_version_doc,      NULL },
+    { (char*)"time_conversions", Connection_time_conversions_get, Connection_time_conversions_set, (char*)s_Connection_time_conversions_doc, NULL },
+    { (char*)"timeout",          Connection_timeout_get,          Connection_timeout_set,          (char*)s_Connection_timeout_doc,          NULL },
+    { NULL,                      NULL,                            NULL,                            NULL,                                     NULL }
 };
 
 /*
@@ -1304,11 +2129,12 @@ static PyObject* Connection_commit(PyObject* self, PyObject* args)
     }
 
     /*
-        Only commit transactions if autocommit is disabled or the connection
+        Only commit transactions if autocommit is disabled and a statement
+        has been executed since the last commit or rollback, or the connection
         is dead. The later should always occur to ensure the client is notified
         of a dead connection.
     */
-    if (!connection->autocommit || DBDEAD(connection->dbproc))
+    if ((!connection->autocommit && connection->in_transaction) || DBDEAD(connection->dbproc))
     {
         if (0 != Connection_transaction_commit(connection))
         {
@@ -1338,11 +2164,12 @@ static PyObject* Connection_rollback(PyObject* self, PyObject* args)
     }
 
     /*
-        Only commit transactions if autocommit is disabled or the connection
+        Only rollback transactions if autocommit is disabled and a statement
+        has been executed since the last commit or rollback, or the connection
         is dead. The later should always occur to ensure the client is notified
         of a dead connection.
     */
-    if (!connection->autocommit || DBDEAD(connection->dbproc))
+    if ((!connection->autocommit && connection->in_transaction) || DBDEAD(connection->dbproc))
     {
         if (0 != Connection_transaction_rollback(connection))
         {
@@ -1386,7 +2213,7 @@ static PyObject* Connection_cursor(PyObject* self, PyObject* args)
         return NULL;
     }
 
-    return Cursor_create(connection, connection->paramstyle);
+    return Cursor_create(connection, connection->paramstyle, connection->converters);
     UNUSED(args);
 }
 
@@ -1429,8 +2256,9 @@ static DBINT Connection_bulk_insert_sendrow(struct Connection* connection,
     do
     {
         RETCODE retcode;
+        double start, sent, responded = 0;
 
-        rpcparams = tds_mem_calloc((size_t)size, sizeof(struct Parameter*));
+        rpcparams = tds_mem_tagged_calloc(bulk, (size_t)size, sizeof(struct Parameter*));
         if (!rpcparams)
         {
             PyErr_NoMemory();
@@ -1479,6 +2307,8 @@ static DBINT Connection_bulk_insert_sendrow(struct Connection* connection,
                 Connection_raise_lasterror(connection);
                 break;
             }
+
+            connection->stats->bytes_sent += Parameter_size(rpcparams[ix]);
         }
 
         if (PyErr_Occurred())
@@ -1486,11 +2316,15 @@ static DBINT Connection_bulk_insert_sendrow(struct Connection* connection,
             break;
         }
 
+        start = Clock_monotonic();
+
         Py_BEGIN_ALLOW_THREADS
 
             do
             {
+                PROBE1(bcp_sendrow, connection);
                 retcode = bcp_sendrow(connection->dbproc);
+                sent = Clock_monotonic();
                 if (FAIL == retcode)
                 {
                     break;
@@ -1499,6 +2333,8 @@ static DBINT Connection_bulk_insert_sendrow(struct Connection* connection,
                 if (send_batch)
                 {
                     saved = bcp_batch(connection->dbproc);
+                    responded = Clock_monotonic();
+                    PROBE2(bcp_batch, connection, saved);
                     if (-1 == saved)
                     {
                         retcode = FAIL;
@@ -1510,6 +2346,18 @@ static DBINT Connection_bulk_insert_sendrow(struct Connection* connection,
 
         Py_END_ALLOW_THREADS
 
+        connection->stats->send_time += sent - start;
+        if (send_batch)
+        {
+            /* Each batch is committed by the server before continuing. */
+            connection->stats->round_trips++;
+            if (responded)
+            {
+                connection->stats->response_time += responded - sent;
+                Latency_record_seconds(LatencyMetric_round_trip, responded - start);
+            }
+        }
+
         if (FAIL == retcode)
         {
             Connection_raise_lasterror(connection);
@@ -1530,7 +2378,7 @@ static DBINT Connection_bulk_insert_sendrow(struct Connection* connection,
     return (PyErr_Occurred()) ? -1 : saved;
 }
 
-static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject* kwargs)
+static PyObject* Connection_bulk_insert_untraced(PyObject* self, PyObject* args, PyObject* kwargs)
 {
     struct Connection* connection = (struct Connection*)self;
 
@@ -1620,6 +2468,15 @@ static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject
             break;
         }
 
+        Connection_stop_background(connection);
+
+        if (0 != Connection_reset_prepare(connection, NULL))
+        {
+            break;
+        }
+
+        Connection_statement_sent(connection);
+
         do
         {
             PyObject* row;
@@ -1648,6 +2505,8 @@ static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject
                 if (!initialized)
                 {
                     size_t column;
+                    double start = Clock_monotonic();
+                    double elapsed;
 
                     Py_BEGIN_ALLOW_THREADS
 
@@ -1678,6 +2537,13 @@ static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject
 
                     Py_END_ALLOW_THREADS
 
+                    /* bcp_init() reads the table's metadata from the server. */
+                    elapsed = Clock_monotonic() - start;
+                    connection->stats->round_trips++;
+                    connection->stats->bytes_sent += strlen(table);
+                    connection->stats->response_time += elapsed;
+                    Latency_record_seconds(LatencyMetric_round_trip, elapsed);
+
                     if (FAIL == retcode)
                     {
                         Connection_raise_lasterror(connection);
@@ -1690,7 +2556,7 @@ static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject
                     */
                     ncolumns = dbnumcols(connection->dbproc);
                     assert(ncolumns > 0);
-                    columns = tds_mem_calloc((size_t)ncolumns, sizeof(*columns));
+                    columns = tds_mem_tagged_calloc(bulk, (size_t)ncolumns, sizeof(*columns));
                     if (!columns)
                     {
                         PyErr_NoMemory();
@@ -1710,7 +2576,7 @@ static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject
 
                         columns[column].nullable = dbcol.Null;
                         columns[column].identity = dbcol.Identity;
-                        columns[column].name = tds_mem_strdup(dbcol.ActualName);
+                        columns[column].name = tds_mem_tagged_strdup(bulk, dbcol.ActualName);
                         if (!columns[column].name)
                         {
                             PyErr_NoMemory();
@@ -1800,12 +2666,20 @@ static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject
 
             if (initialized)
             {
+                double start = Clock_monotonic();
+                double elapsed;
+
                 /* Always call bcp_done() regardless of previous errors. */
                 Py_BEGIN_ALLOW_THREADS
 
                     processed = bcp_done(connection->dbproc);
 
                 Py_END_ALLOW_THREADS
+
+                elapsed = Clock_monotonic() - start;
+                connection->stats->round_trips++;
+                connection->stats->response_time += elapsed;
+                Latency_record_seconds(LatencyMetric_round_trip, elapsed);
             }
 
             if (-1 != processed)
@@ -1836,6 +2710,57 @@ static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject
     return PyLong_FromLong(saved);
 }
 
+static PyObject* Connection_bulk_insert(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    struct TraceSpan span;
+    PyObject* table = NULL;
+    PyObject* result;
+
+    if (!Trace_hooks)
+    {
+        return Connection_bulk_insert_untraced(self, args, kwargs);
+    }
+
+    if (PyTuple_GET_SIZE(args) > 0)
+    {
+        table = PyTuple_GET_ITEM(args, 0);
+    }
+    else if (kwargs)
+    {
+        table = PyDict_GetItemString(kwargs, "table"); /* borrowed reference */
+    }
+
+    Trace_begin(&span, TraceOperation_bulk_insert, table, (struct Connection*)self);
+    result = Connection_bulk_insert_untraced(self, args, kwargs);
+    Trace_end(&span, (result) ? PyLong_AsSsize_t(result) : -1);
+
+    return result;
+}
+
+static const char s_Connection_fileno_doc[] =
+    "fileno()\n"
+    "\n"
+    "Get the file descriptor of the connection's socket. This allows the\n"
+    "connection to be monitored for readability, e.g. by an event loop.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":return: The file descriptor.\n"
+    ":rtype: int\n";
+
+static PyObject* Connection_fileno(PyObject* self, PyObject* args)
+{
+    struct Connection* connection = (struct Connection*)self;
+    if (Connection_closed(connection))
+    {
+        Connection_raise_closed(connection);
+        return NULL;
+    }
+
+    return PyLong_FromLong((long)dbiordesc(connection->dbproc));
+    UNUSED(args);
+}
+
 static const char s_Connection_use_doc[] =
     "use(database)\n"
     "\n"
@@ -1861,6 +2786,66 @@ static PyObject* Connection_use(PyObject* self, PyObject* args)
     }
 }
 
+static const char s_Connection_reset_doc[] =
+    "reset()\n"
+    "\n"
+    "Reset the connection's session state to that after it was opened. Any\n"
+    "pending transaction is rolled back, session options changed by ``SET``\n"
+    "statements are restored and the initial database is restored.\n"
+    "\n"
+    "No request is made to the server by this method. Instead, the reset is\n"
+    "sent ahead of the next SQL batch executed on the connection, avoiding\n"
+    "an additional round trip. A separate batch is used if the next command\n"
+    "is a stored procedure call or bulk insert, if the reset must change the\n"
+    "database, or if the SQL must be the first statement in its batch, e.g.\n"
+    "``CREATE PROCEDURE``.\n"
+    "\n"
+    ".. note:: Unlike the ``sp_reset_connection`` stored procedure, temporary\n"
+    "    tables are not dropped.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":returns: :py:data:`None`\n";
+
+static PyObject* Connection_reset(PyObject* self, PyObject* args)
+{
+    struct Connection* connection = (struct Connection*)self;
+    if (Connection_closed(connection))
+    {
+        Connection_raise_closed(connection);
+        return NULL;
+    }
+
+    if (0 != Connection_reset_session(connection))
+    {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+    UNUSED(args);
+}
+
+
+static const char s_Connection_reset_stats_doc[] =
+    "reset_stats()\n"
+    "\n"
+    "Reset the connection's performance counters, :py:attr:`.stats`, to zero.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":returns: :py:data:`None`\n";
+
+static PyObject* Connection_reset_stats(PyObject* self, PyObject* args)
+{
+    struct ConnectionStats* stats = ((struct Connection*)self)->stats;
+    size_t refs = stats->_refs;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->_refs = refs;
+
+    Py_RETURN_NONE;
+    UNUSED(args);
+}
 
 static const char s_Connection___enter___doc[] =
     "__enter__()\n"
@@ -1909,7 +2894,7 @@ static PyObject* Connection___exit__(PyObject* self, PyObject* args)
     }
     if (Py_None == exc_type && !PyErr_Occurred())
     {
-        if (!connection->autocommit)
+        if (!connection->autocommit && Connection_in_transaction(connection))
         {
             if (0 != Connection_transaction_commit(connection))
             {
@@ -1936,6 +2921,9 @@ static PyMethodDef Connection_methods[] = {
 
     /* Non-DB API 2.0 methods. */
     { "bulk_insert", (PyCFunction)Connection_bulk_insert, METH_VARARGS | METH_KEYWORDS, s_Connection_bulk_insert_doc },
+    { "fileno",      Connection_fileno,                   METH_NOARGS,                  s_Connection_fileno_doc },
+    { "reset",       Connection_reset,                    METH_NOARGS,                  s_Connection_reset_doc },
+    { "reset_stats", Connection_reset_stats,              METH_NOARGS,                  s_Connection_reset_stats_doc },
     { "use",         Connection_use,                      METH_VARARGS,                 s_Connection_use_doc },
     { "__enter__",   Connection___enter__,                METH_NOARGS,                  s_Connection___enter___doc },
     { "__exit__",    Connection___exit__,                 METH_VARARGS,                 s_Connection___exit___doc },
@@ -1959,6 +2947,7 @@ PyObject* Connection_create(const char* server, uint16_t port, const char* insta
     if (NULL != connection)
     {
         char* servername = NULL;
+        uint64_t login;
 
         memset((((char*)connection) + offsetof(struct Connection, login)),
                0,
@@ -1988,24 +2977,6 @@ PyObject* Connection_create(const char* server, uint16_t port, const char* insta
 #endif
             };
 
-            /*
-                These settings could easily be passed via the login packet, though that
-                requires an update to freetds' dbopen method to actually pass the flag.
-            */
-            /* Mimic the settings used by ODBC connections. */
-            static const char s_ansi_default_stmt[] =
-                /* https://msdn.microsoft.com/en-us/library/ms190306.aspx */
-                "SET ARITHABORT ON;"
-
-                /* https://msdn.microsoft.com/en-us/library/ms188340.aspx */
-                "SET ANSI_DEFAULTS ON;"
-
-                /* https://msdn.microsoft.com/en-us/library/ms176056.aspx */
-                "SET CONCAT_NULL_YIELDS_NULL ON;"
-
-                /* https://msdn.microsoft.com/en-us/library/ms186238.aspx */
-                "SET TEXTSIZE 2147483647;";
-
             DBINT dbversion = DBVERSION_UNKNOWN;
 
             int flag;
@@ -2035,6 +3006,20 @@ PyObject* Connection_create(const char* server, uint16_t port, const char* insta
                 (void)PyOS_snprintf(&servername[written], nservername - (size_t)written, ":%d", port);
             }
 
+            connection->identity = Py_BuildValue("(sz)", servername, username);
+            if (!connection->identity)
+            {
+                break;
+            }
+
+            connection->stats = tds_mem_calloc(1, sizeof(struct ConnectionStats));
+            if (!connection->stats)
+            {
+                PyErr_NoMemory();
+                break;
+            }
+            connection->stats->_refs = 1;
+
             connection->login = dblogin();
             if (!connection->login)
             {
@@ -2200,6 +3185,8 @@ PyObject* Connection_create(const char* server, uint16_t port, const char* insta
             assert(bcp_getl(connection->login) == enable_bcp);
 
             connection->autocommit = autocommit;
+            connection->in_transaction = false;
+            connection->ansi_defaults = ansi_defaults;
 
             /*
                 $TODO: this is global. Setting a per-connection login timeout will
@@ -2208,6 +3195,8 @@ PyObject* Connection_create(const char* server, uint16_t port, const char* insta
             (void)dbsetlogintime((int)login_timeout);
             (void)dbsettime((int)timeout);
 
+            login = Clock_monotonic_ns();
+
             Py_BEGIN_ALLOW_THREADS
 
                 /* Clear last error prior to the connection attempt. */
@@ -2225,6 +3214,9 @@ PyObject* Connection_create(const char* server, uint16_t port, const char* insta
                 break;
             }
 
+            Latency_record(LatencyMetric_login, Clock_monotonic_ns() - login);
+            PROBE2(connection_open, connection, servername);
+
             connection->query_timeout = (int)timeout;
             connection->paramstyle = paramstyle;
 
@@ -2247,6 +3239,13 @@ PyObject* Connection_create(const char* server, uint16_t port, const char* insta
                     break;
                 }
             }
+
+            connection->database = tds_mem_strdup(dbname(connection->dbproc));
+            if (!connection->database)
+            {
+                PyErr_NoMemory();
+                break;
+            }
         } while (0);
 
         tds_mem_free(servername);
@@ -2331,7 +3330,8 @@ PyTypeObject ConnectionType = {
 PyTypeObject* ConnectionType_init(void)
 {
     if ((0 != LastError_init()) ||
-        (0 != LastMsg_init()))
+        (0 != LastMsg_init()) ||
+        (0 != Redirect_init()))
     {
         return NULL;
     }
@@ -1,18 +1,38 @@
 #include "include/push_warnings.h"
 #include <Python.h>
+#include <pythread.h>
 #include <sybdb.h>
 #include "include/pop_warnings.h"
 
 #include <assert.h>
+#include <errno.h>
 #include <stddef.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#  include "include/push_warnings.h"
+#  include <Windows.h>
+#  include <io.h>
+#  include "include/pop_warnings.h"
+#else /* if defined(_WIN32) */
+#  include <sys/mman.h>
+#endif /* else if defined(_WIN32) */
 
 #include "include/c99int.h"
+#include "include/clock.h"
 #include "include/cursor.h"
 #include "include/connection.h"
+#include "include/latency.h"
 #include "include/macros.h"
+#include "include/mem.h"
 #include "include/parameter.h"
+#include "include/probes.h"
 #include "include/pyutils.h"
+#include "include/resultcache.h"
+#include "include/slowlog.h"
+#include "include/statements.h"
 #include "include/tds.h"
+#include "include/trace.h"
 #include "include/type.h"
 
 #if defined(__GNUC__) && (__GNUC__ > 4)
@@ -35,10 +55,57 @@
 #endif /* ifdef __clang__ */
 
 
+struct ColumnBuffer
+{
+    /* The size of this column, in bytes. */
+    size_t size;
+
+    /*
+        The TDS type of this column. This is necessary for COMPUTE columns
+        which may have a different type than the regular column.
+    */
+    enum TdsType tdstype;
+
+    /* The column data. This member must always be last. */
+    union {
+        /* Allocated separately on heap. */
+        void* variable;
+
+        /* Allocated as part of this structure. */
+        uint8_t* fixed;
+    } data;
+};
+
+/*
+    Check whether a database column is variable length or not.
+
+    @param _dbcol [in] A DBCOL* describing the column.
+*/
+#define Column_IsVariableLength(_dbcol) \
+    !!(_dbcol)->VarLength
+
+/*
+    Determine the column buffer size required for a database column.
+
+    @param _dbcol [in] A DBCOL* describing the column.
+*/
+#define ColumnBuffer_size(_dbcol) \
+    ((Column_IsVariableLength(_dbcol)) ? \
+        sizeof(struct ColumnBuffer) : ((size_t)(_dbcol)->MaxLength + offsetof(struct ColumnBuffer, data)))
+
 struct Column {
     DBCOL dbcol;
 
+    /* The offset of this column's ColumnBuffer in a RowBuffer. */
+    size_t offset;
+
     sql_topython topython;
+
+    /*
+        An optional, user-registered Python callable applied to the value
+        returned by `topython`.
+    */
+    PyObject* converter;
 };
 
 /* A description of the columns in a result set. */
@@ -52,6 +119,12 @@ struct ResultSetDescription {
     */
     PyObject* _obj;
 
+    /*
+        The performance counters of the connection the result set was read
+        from, updated as rows are converted. This may be NULL.
+    */
+    struct ConnectionStats* stats;
+
     /*
         Number of columns in the current resultset. This will be 0 if there
         is no current result set.
@@ -87,6 +160,7 @@ struct ResultSetDescription* ResultSetDescription_create(size_t ncolumns)
     {
         description->_refs = 1;
         description->_obj = NULL;
+        description->stats = NULL;
         description->ncolumns = ncolumns;
         memset(description->columns, 0, sizeof(struct Column) * ncolumns);
     }
@@ -101,11 +175,46 @@ static void ResultSetDescription_decrement(struct ResultSetDescription* descript
     description->_refs--;
     if (0 == description->_refs)
     {
+        size_t ix;
+        for (ix = 0; ix < description->ncolumns; ++ix)
+        {
+            Py_XDECREF(description->columns[ix].converter);
+        }
         Py_XDECREF(description->_obj);
+        if (description->stats)
+        {
+            ConnectionStats_decrement(description->stats);
+        }
         tds_mem_free(description);
     }
 }
 
+/*
+    Copy a result set description, excluding any user-registered converters
+    resolved for its columns.
+
+    @param description [in] The description to copy.
+
+    @return The new description.
+    @return NULL on failure.
+*/
+static struct ResultSetDescription* ResultSetDescription_copy(const struct ResultSetDescription* description)
+{
+    struct ResultSetDescription* copy = ResultSetDescription_create(description->ncolumns);
+    if (copy)
+    {
+        size_t ix;
+        for (ix = 0; ix < description->ncolumns; ++ix)
+        {
+            const struct Column* column = &description->columns[ix];
+            copy->columns[ix].dbcol = column->dbcol;
+            copy->columns[ix].offset = column->offset;
+            copy->columns[ix].topython = sql_topython_lookup((enum TdsType)column->dbcol.Type);
+        }
+    }
+    return copy;
+}
+
 
 struct Cursor {
     PyObject_VAR_HEAD
@@ -130,12 +239,126 @@ struct Cursor {
     /* The number of rows read from the current result set. */
     size_t rowsread;
 
+    /*
+        The time, in seconds, spent fetching rows of the current result set.
+        This is negative once the result set has been read in full.
+    */
+    double fetchtime;
+
     /*
         The paramstyle to use on .execute*() calls.
     */
     enum ParamStyle paramstyle;
+
+    /*
+        User-registered output converters, keyed by TDS type or column name.
+        This may be NULL.
+    */
+    PyObject* converters;
+
+    /*
+        The result cache key of the current result set, if it is cacheable.
+        Copies of the fetched rows are recorded in `cacherows` while
+        `caching` is set, and the result set is added to the connection's
+        result cache once all rows have been fetched and the statement is
+        found to produce no further result sets.
+    */
+    PyObject* cachekey;
+    bool caching;
+    struct RowBuffer* cacherows;
+    struct RowBuffer* cachelast;
+    size_t ncacherows;
+    size_t cachesize;
+
+    /*
+        The rows of the current result set when served from the result cache.
+        Rows are returned starting at `rowsread`.
+    */
+    struct RowList* cached;
+
+    /*
+        Set once the statement's responses following the current result set
+        have been read, to confirm it is the statement's last result set
+        before caching it. `peekretcode` is the dbresults() result, which
+        Cursor_next_resultset() uses rather than reading further, and
+        `peekcount` the current result set's row count.
+    */
+    bool peeked;
+    RETCODE peekretcode;
+    DBINT peekcount;
+
+    /*
+        Should statement execution stop once the statement has been sent?
+        The server's response is then read by Cursor_execute_complete().
+    */
+    bool deferred;
+
+    /*
+        Is a statement sent by execute_async() awaiting the server's
+        response? It is registered as the connection's background operation,
+        and cancelled if the connection is used for another operation first.
+        `completing` is set while Cursor_execute_complete() reads the
+        response without the GIL, during which `completion` is held.
+        `abandoned` fails the statement's awaitable if it is cancelled
+        otherwise.
+    */
+    bool outstanding;
+    bool completing;
+    PyThread_type_lock completion;
+    PyObject* abandoned;
+
+    /*
+        The measurement of the outstanding statement sent by execute_async(),
+        recorded by Cursor_execute_async_end() once its response is read or
+        it is abandoned. `args` are the arguments execute_async() was called
+        with, which own `sql`. `start` is the start time returned by
+        Cursor_statement_begin() and `sent` the time the statement was sent,
+        from which its round trip is measured. `span` is the statement's
+        trace, if `traced` is set.
+    */
+    struct
+    {
+        PyObject* args;
+        const char* sql;
+        uint64_t start;
+        double sent;
+        struct TraceSpan span;
+        bool traced;
+    } pending;
+
+    /*
+        The number of batches of `arraysize` rows to read ahead of the
+        caller in a background thread. Prefetching is disabled if 0.
+    */
+    unsigned PY_LONG_LONG prefetch;
+
+    /* The background reader of the current result set. This may be NULL. */
+    struct Prefetch* prefetcher;
+
+    /*
+        The reason rows of the current result set were discarded, e.g. when
+        another operation used the connection while they were read by the
+        background reader. This is NULL if no rows were discarded.
+    */
+    const char* discarded;
+
+    /*
+        The statement statistics fingerprint of the last statement executed,
+        to which fetched rows are added. This is 0 if statement statistics
+        are not being collected for it.
+    */
+    uint64_t statement;
+
+    /* The last statement executed, if timed for the slow query log. */
+    struct SlowQuery slowquery;
 };
 
+/* forward decls. */
+static void ResultSetDescription_RowBuffer_free(const struct ResultSetDescription* description,
+                                                struct RowBuffer* rowbuffer);
+static int Cursor_execute_cached(struct Cursor* cursor, PyObject* cached);
+static void Cursor_prefetch_stop(void* cursor);
+
 #define warn_extension_used(_method) \
     PyErr_WarnEx(PyExc_Warning, "DB-API extension " _method " used", 1)
 
@@ -153,6 +376,41 @@ struct Cursor {
         return NULL; \
     }
 
+/*
+    Finish timing a statement for the slow query log and report it if it
+    was slow.
+
+    @param cursor [in] The cursor.
+    @param error [in] Did the statement fail?
+*/
+static void Cursor_slowlog_finish(struct Cursor* cursor, bool error)
+{
+    if (cursor->slowquery.args)
+    {
+        uint64_t elapsed = cursor->slowquery.first_row;
+        Py_ssize_t rows = -1;
+        if (cursor->slowquery.fetching)
+        {
+            if (cursor->fetchtime > 0)
+            {
+                elapsed += (uint64_t)(cursor->fetchtime * 1000000000.0);
+            }
+            rows = (Py_ssize_t)cursor->rowsread;
+        }
+        else if (!error && cursor->connection)
+        {
+            rows = (Py_ssize_t)dbcount(Connection_DBPROCESS(cursor->connection));
+        }
+
+        if (SlowLog_callback && (elapsed >= SlowLog_threshold))
+        {
+            SlowLog_report(&cursor->slowquery, cursor->connection, elapsed, rows, error);
+        }
+
+        Py_CLEAR(cursor->slowquery.args);
+    }
+}
+
 /*
     Clear a cursor's notion of the current resultset.
 
@@ -162,12 +420,40 @@ struct Cursor {
 */
 static void Cursor_clear_resultset(struct Cursor* cursor)
 {
+    /* A result set which was not read in full ends the statement. */
+    if (cursor->slowquery.fetching)
+    {
+        Cursor_slowlog_finish(cursor, false);
+    }
+
+    if (cursor->prefetcher)
+    {
+        Connection_set_background(cursor->connection, NULL, NULL);
+        Cursor_prefetch_stop(cursor);
+    }
+    cursor->discarded = NULL;
+
+    Py_XDECREF(cursor->cachekey);
+    cursor->cachekey = NULL;
+    cursor->caching = false;
+    if (cursor->cacherows)
+    {
+        ResultSetDescription_RowBuffer_free(cursor->description, cursor->cacherows);
+        cursor->cacherows = cursor->cachelast = NULL;
+    }
+    cursor->ncacherows = 0;
+    cursor->cachesize = 0;
+
+    Py_XDECREF((PyObject*)cursor->cached);
+    cursor->cached = NULL;
+
     if (cursor->description)
     {
         ResultSetDescription_decrement(cursor->description);
         cursor->description = NULL;
     }
     cursor->rowsread = 0;
+    cursor->fetchtime = 0;
 }
 
 /*
@@ -177,6 +463,11 @@ static void Cursor_clear_resultset(struct Cursor* cursor)
 */
 static void Cursor_close_connection(struct Cursor* cursor)
 {
+    /* Cancel any statement still awaiting the server's response. */
+    if (cursor->outstanding)
+    {
+        Connection_stop_background(cursor->connection);
+    }
     Cursor_clear_resultset(cursor);
     Py_XDECREF(cursor->connection);
     cursor->connection = NULL;
@@ -198,6 +489,7 @@ static int Cursor_next_resultset(struct Cursor* cursor, RETCODE* retcode)
 {
     DBINT ncolumns;
     DBINT column;
+    size_t offset = 0;
     DBPROCESS* dbproc = Connection_DBPROCESS(cursor->connection);
 
 #if PY_VERSION_HEX >= 0x03040000
@@ -209,20 +501,34 @@ static int Cursor_next_resultset(struct Cursor* cursor, RETCODE* retcode)
     assert(!cursor->description);
     assert(0 == cursor->rowsread);
 
-    /* Read any unprocessed rows from the database. */
-    while (dbnextrow(dbproc) != NO_MORE_ROWS) {}
-
-    /*
-        dbresults() sometimes returns SUCCEED and dbnumcols() returns 0.
-        In this case, keep looking for the next resultset.
-    */
-    for (ncolumns = 0; 0 == ncolumns; ncolumns = dbnumcols(dbproc))
+    if (cursor->peeked)
     {
-        *retcode = dbresults(dbproc);
+        /* The next resultset was already found by Cursor_cache_peek(). */
+        cursor->peeked = false;
+        *retcode = cursor->peekretcode;
         if (SUCCEED != *retcode /* retcode may be NO_MORE_RESULTS */)
         {
             return (NO_MORE_RESULTS == *retcode) ? 0 : -1;
         }
+        ncolumns = dbnumcols(dbproc);
+    }
+    else
+    {
+        /* Read any unprocessed rows from the database. */
+        while (dbnextrow(dbproc) != NO_MORE_ROWS) {}
+
+        /*
+            dbresults() sometimes returns SUCCEED and dbnumcols() returns 0.
+            In this case, keep looking for the next resultset.
+        */
+        for (ncolumns = 0; 0 == ncolumns; ncolumns = dbnumcols(dbproc))
+        {
+            *retcode = dbresults(dbproc);
+            if (SUCCEED != *retcode /* retcode may be NO_MORE_RESULTS */)
+            {
+                return (NO_MORE_RESULTS == *retcode) ? 0 : -1;
+            }
+        }
     }
 
     cursor->description = ResultSetDescription_create((size_t)ncolumns);
@@ -242,6 +548,9 @@ static int Cursor_next_resultset(struct Cursor* cursor, RETCODE* retcode)
 
         cursor->description->columns[column - 1].topython =
             sql_topython_lookup((enum TdsType)cursor->description->columns[column - 1].dbcol.Type);
+
+        cursor->description->columns[column - 1].offset = offset;
+        offset += ColumnBuffer_size(&cursor->description->columns[column - 1].dbcol);
     }
 
     if (FAIL == *retcode)
@@ -254,6 +563,109 @@ static int Cursor_next_resultset(struct Cursor* cursor, RETCODE* retcode)
     return 0;
 }
 
+/*
+    Resolve the cursor's user-registered converters for the columns in the
+    current resultset. Converters registered by column name take precedence
+    over those registered by TDS type.
+
+    Built-in native converters replace the column's `topython` method.
+    Python callables are called with the result of `topython`.
+
+    The connection's performance counters are also attached to the result
+    set, to account for the conversion of its rows, if conversions are
+    being timed.
+
+    @note This method sets an appropriate Python exception on failure.
+    @note This method requires the current thread own the GIL.
+
+    @param cursor [in] The cursor object.
+
+    @return 0 if the call succeeded, -1 if it failed.
+*/
+static int Cursor_resolve_converters(struct Cursor* cursor)
+{
+    size_t ix;
+
+    if (cursor->description && !cursor->description->stats &&
+        Connection_time_conversions(cursor->connection))
+    {
+        cursor->description->stats = Connection_stats(cursor->connection);
+        ConnectionStats_increment(cursor->description->stats);
+    }
+
+    if (!cursor->converters || !cursor->description || (0 == PyDict_Size(cursor->converters)))
+    {
+        return 0;
+    }
+
+    for (ix = 0; ix < cursor->description->ncolumns; ++ix)
+    {
+        struct Column* column = &cursor->description->columns[ix];
+        PyObject* converter;
+
+        PyObject* key = PyUnicode_DecodeUTF8(column->dbcol.ActualName,
+                                             (Py_ssize_t)strlen(column->dbcol.ActualName),
+                                             "strict");
+        if (!key)
+        {
+            return -1;
+        }
+        converter = PyDict_GetItem(cursor->converters, key); /* borrowed reference */
+        Py_DECREF(key);
+
+        if (!converter)
+        {
+            key = PyLong_FromLong((long)column->dbcol.Type);
+            if (!key)
+            {
+                return -1;
+            }
+            converter = PyDict_GetItem(cursor->converters, key); /* borrowed reference */
+            Py_DECREF(key);
+        }
+
+        if (!converter)
+        {
+            continue;
+        }
+
+        if (
+#if PY_MAJOR_VERSION < 3
+            PyString_Check(converter) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+            PyUnicode_Check(converter))
+        {
+            sql_topython topython;
+            if (0 != sql_topython_native_lookup(converter, (enum TdsType)column->dbcol.Type, &topython))
+            {
+                PyErr_SetObject(PyExc_ValueError, converter);
+                return -1;
+            }
+            if (!topython)
+            {
+                PyErr_Format(PyExc_tds_NotSupportedError,
+                             "converter is not supported for type %d of column \"%s\"",
+                             column->dbcol.Type,
+                             column->dbcol.ActualName);
+                return -1;
+            }
+            column->topython = topython;
+        }
+        else if (PyCallable_Check(converter))
+        {
+            Py_INCREF(converter);
+            column->converter = converter;
+        }
+        else
+        {
+            PyErr_SetObject(PyExc_TypeError, converter);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 
 /*
    Python tds.Cursor type definition.
@@ -268,6 +680,13 @@ static const char s_tds_Cursor_doc[] =
 static void Cursor_dealloc(PyObject* self)
 {
     Cursor_close_connection((struct Cursor*)self);
+    Py_XDECREF(((struct Cursor*)self)->converters);
+    Py_XDECREF(((struct Cursor*)self)->abandoned);
+    Py_XDECREF(((struct Cursor*)self)->pending.args);
+    if (((struct Cursor*)self)->completion)
+    {
+        PyThread_free_lock(((struct Cursor*)self)->completion);
+    }
     PyObject_Del(self);
 }
 
@@ -327,6 +746,68 @@ static int Cursor_arraysize_set(PyObject* self, PyObject* value, void* closure)
     UNUSED(closure);
 }
 
+static const char s_Cursor_prefetch_doc[] =
+    "The number of batches of :py:attr:`.arraysize` rows to read ahead of\n"
+    "the caller. When non-zero, rows of a result set are read from the\n"
+    "server in a background thread, without holding the GIL, while the\n"
+    "previously read rows are processed. At most `prefetch` batches of rows\n"
+    "are buffered. Prefetching is disabled if 0, the default.\n"
+    "\n"
+    "Prefetching starts on the first fetch from a result set. Any rows read\n"
+    "ahead are discarded when the cursor next uses the connection. If another\n"
+    "cursor on the same connection uses it before the result set is read in\n"
+    "full, the next fetch raises :py:exc:`ctds.InterfaceError` rather than\n"
+    "silently skipping the discarded rows.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* Cursor_prefetch_get(PyObject* self, void* closure)
+{
+    struct Cursor* cursor = (struct Cursor*)self;
+
+    return PyLong_FromUnsignedLongLong(cursor->prefetch);
+
+    UNUSED(closure);
+}
+
+static int Cursor_prefetch_set(PyObject* self, PyObject* value, void* closure)
+{
+    unsigned PY_LONG_LONG prefetch;
+    struct Cursor* cursor = (struct Cursor*)self;
+    if (
+        (
+#if PY_MAJOR_VERSION < 3
+        !PyInt_Check(value) &&
+#endif /* if PY_MAJOR_VERSION < 3 */
+        !PyLong_Check(value)
+        ) || PyBool_Check(value))
+    {
+        PyErr_SetString(PyExc_TypeError, "prefetch");
+        return -1;
+    }
+#if PY_MAJOR_VERSION < 3
+    if (PyInt_Check(value))
+    {
+        /* Note: This does not check for overflow. */
+        prefetch = PyInt_AsUnsignedLongLongMask(value);
+    }
+#endif /* if PY_MAJOR_VERSION < 3 */
+    else
+    {
+        prefetch = PyLong_AsUnsignedLongLong(value);
+    }
+    if (PyErr_Occurred())
+    {
+        return -1;
+    }
+    cursor->prefetch = prefetch;
+    return 0;
+
+    UNUSED(closure);
+}
+
 static const char s_Cursor_description_doc[] =
     "A description of the current result set columns.\n"
     "The description is a sequence of tuples, one tuple per column in the\n"
@@ -578,6 +1059,16 @@ static PyObject* Cursor_rowcount_get(PyObject* self, void* closure)
     struct Cursor* cursor = (struct Cursor*)self;
     Cursor_verify_open(cursor);
 
+    /* Results served from the result cache were not read from the server. */
+    if (cursor->cached)
+    {
+        return PyLong_FromSsize_t(Py_SIZE((PyObject*)cursor->cached));
+    }
+    if (cursor->peeked)
+    {
+        return PyLong_FromLong(cursor->peekcount);
+    }
+
     /*
         Note: the affected row count is always -1 after an RPC call.
         When .execute*() utilizes `sp_executesql`, this value will be -1.
@@ -664,11 +1155,77 @@ static PyObject* Cursor_spid_get(PyObject* self, void* closure)
     UNUSED(closure);
 }
 
-static const char s_Cursor_Parameter_doc[] =
-    "Convenience method to :py:class:`ctds.Parameter`.\n"
+static const char s_Cursor_converters_doc[] =
+    "A :py:class:`dict` of output converters to apply to result set values,\n"
+    "or :py:data:`None`. Converters are keyed by either a column name or a\n"
+    "TDS type code, e.g. :py:data:`ctds.DECIMAL`. Converters registered by\n"
+    "column name take precedence.\n"
     "\n"
-    ":return: A new Parameter object.\n"
-    ":rtype: ctds.Parameter\n";
+    "A converter is either a callable, which is called with each\n"
+    "non-:py:data:`None` value after the default conversion, or the name of a\n"
+    "built-in converter, which replaces the default conversion:\n"
+    "\n"
+    "* ``'bytes'``: :py:data:`ctds.CHAR`, :py:data:`ctds.VARCHAR`,\n"
+    "  :py:data:`ctds.TEXT`, **XML** and :py:data:`ctds.GUID` values as raw\n"
+    "  :py:class:`bytes`.\n"
+    "* ``'float'``: :py:data:`ctds.DECIMAL`, :py:data:`ctds.NUMERIC` and\n"
+    "  :py:data:`ctds.MONEY` values as :py:class:`float`.\n"
+    "* ``'str'``: :py:data:`ctds.GUID` values as :py:class:`str`.\n"
+    "\n"
+    "Converters are resolved once per result set and called as each value is\n"
+    "first read from its :py:class:`ctds.Row`, so any exception a converter\n"
+    "raises is raised by the column access. The :py:class:`dict` is\n"
+    "copied when set and when read, so changes to it have no effect until it\n"
+    "is assigned again.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":rtype: dict\n";
+
+static PyObject* Cursor_converters_get(PyObject* self, void* closure)
+{
+    struct Cursor* cursor = (struct Cursor*)self;
+
+    if (cursor->converters)
+    {
+        /* Return a copy so changes to it cannot bypass validation. */
+        return PyDict_Copy(cursor->converters);
+    }
+    Py_RETURN_NONE;
+
+    UNUSED(closure);
+}
+
+static int Cursor_converters_set(PyObject* self, PyObject* value, void* closure)
+{
+    struct Cursor* cursor = (struct Cursor*)self;
+    PyObject* converters = NULL;
+
+    if (value && (Py_None != value))
+    {
+        if (0 != converters_validate(value))
+        {
+            return -1;
+        }
+        converters = PyDict_Copy(value);
+        if (!converters)
+        {
+            return -1;
+        }
+    }
+
+    Py_XDECREF(cursor->converters);
+    cursor->converters = converters;
+    return 0;
+
+    UNUSED(closure);
+}
+
+static const char s_Cursor_Parameter_doc[] =
+    "Convenience method to :py:class:`ctds.Parameter`.\n"
+    "\n"
+    ":return: A new Parameter object.\n"
+    ":rtype: ctds.Parameter\n";
 
 static PyObject* Cursor_Parameter_get(PyObject* self, void* closure)
 {
@@ -681,15 +1238,17 @@ static PyObject* Cursor_Parameter_get(PyObject* self, void* closure)
 
 static PyGetSetDef Cursor_getset[] = {
     /* name, get, set, doc, closure */
-    { (char*)"arraysize",   Cursor_arraysize_get,   Cursor_arraysize_set, (char*)s_Cursor_arraysize_doc,   NULL },
-    { (char*)"description", Cursor_description_get, NULL,                 (char*)s_Cursor_description_doc, NULL },
-    { (char*)"rowcount",    Cursor_rowcount_get,    NULL,                 (char*)s_Cursor_rowcount_doc,    NULL },
-
-    { (char*)"connection",  Cursor_connection_get,  NULL,                 (char*)s_Cursor_connection_doc,  NULL },
-    { (char*)"rownumber",   Cursor_rownumber_get,   NULL,                 (char*)s_Cursor_rownumber_doc,   NULL },
-    { (char*)"spid",        Cursor_spid_get,        NULL,                 (char*)s_Cursor_spid_doc,        NULL },
-    { (char*)"Parameter",   Cursor_Parameter_get,   NULL,                 (char*)s_Cursor_Parameter_doc,   NULL },
-    { NULL,                 NULL,                   NULL,                 NULL,                            NULL }
+    { (char*)"arraysize",   Cursor_arraysize_get,   Cursor_arraysize_set,  (char*)s_Cursor_arraysize_doc,   NULL },
+    { (char*)"description", Cursor_description_get, NULL,                  (char*)s_Cursor_description_doc, NULL },
+    { (char*)"rowcount",    Cursor_rowcount_get,    NULL,                  (char*)s_Cursor_rowcount_doc,    NULL },
+
+    { (char*)"connection",  Cursor_connection_get,  NULL,                  (char*)s_Cursor_connection_doc,  NULL },
+    { (char*)"rownumber",   Cursor_rownumber_get,   NULL,                  (char*)s_Cursor_rownumber_doc,   NULL },
+    { (char*)"spid",        Cursor_spid_get,        NULL,                  (char*)s_Cursor_spid_doc,        NULL },
+    { (char*)"Parameter",   Cursor_Parameter_get,   NULL,                  (char*)s_Cursor_Parameter_doc,   NULL },
+    { (char*)"converters",  Cursor_converters_get,  Cursor_converters_set, (char*)s_Cursor_converters_doc,  NULL },
+    { (char*)"prefetch",    Cursor_prefetch_get,    Cursor_prefetch_set,   (char*)s_Cursor_prefetch_doc,    NULL },
+    { NULL,                 NULL,                   NULL,                  NULL,                            NULL }
 };
 
 /*
@@ -1096,6 +1655,38 @@ static PyObject* Cursor_unbind(PyObject* rpcparams,
     return results;
 }
 
+/*
+    Determine the bytes of input data of bound RPC parameters.
+
+    @param rpcparams [in] A Python dict or tuple object of bound parameters.
+
+    @return The bytes of input data.
+*/
+static size_t Cursor_rpcparams_size(PyObject* rpcparams)
+{
+    size_t size = 0;
+    Py_ssize_t ix;
+
+    if (PyDict_Check(rpcparams))
+    {
+        PyObject* key;
+        PyObject* value;
+        ix = 0;
+        while (PyDict_Next(rpcparams, &ix, &key, &value))
+        {
+            size += Parameter_size((struct Parameter*)value);
+        }
+    }
+    else
+    {
+        for (ix = 0; ix < PyTuple_GET_SIZE(rpcparams); ++ix)
+        {
+            size += Parameter_size((struct Parameter*)PyTuple_GET_ITEM(rpcparams, ix));
+        }
+    }
+    return size;
+}
+
 /*
     Bind input arguments to their SQL types, call a stored procedure, and
     process the resulting output values.
@@ -1121,6 +1712,10 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
     struct OutputParameter* outputparams = NULL;
     DBINT retstatus;
 
+    struct ConnectionStats* stats = Connection_stats(cursor->connection);
+    double start = 0, sent = 0, responded = 0;
+
+    Connection_stop_background(cursor->connection);
     Connection_clear_lastwarning(cursor->connection);
 
     do
@@ -1133,6 +1728,11 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
         int noutputparams = 0;
         size_t noutputs;
 
+        if (0 != Connection_reset_prepare(cursor->connection, NULL))
+        {
+            break;
+        }
+
         if (FAIL == dbrpcinit(dbproc, procname, 0 /* options */))
         {
             Connection_raise_lasterror(cursor->connection);
@@ -1148,6 +1748,8 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
         }
 
         Cursor_clear_resultset(cursor);
+        cursor->peeked = false;
+        Connection_statement_sent(cursor->connection);
 
         Py_BEGIN_ALLOW_THREADS
 
@@ -1158,18 +1760,28 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
                 {
                     break;
                 }
+                PROBE2(rpc_send, cursor, procname);
+                start = Clock_monotonic();
                 retcode = dbrpcsend(dbproc);
+                sent = Clock_monotonic();
                 if (FAIL == retcode)
                 {
                     break;
                 }
+                if (cursor->deferred)
+                {
+                    error = 0;
+                    break;
+                }
                 retcode = dbsqlok(dbproc);
                 if (FAIL == retcode)
                 {
                     break;
                 }
+                PROBE1(first_row, cursor);
 
                 error = Cursor_next_resultset(cursor, &retcode);
+                responded = Clock_monotonic();
                 if (!error)
                 {
                     noutputparams = dbnumrets(dbproc);
@@ -1178,7 +1790,7 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
                     {
                         int ix;
 
-                        outputparams = tds_mem_calloc((size_t)noutputparams, sizeof(struct OutputParameter));
+                        outputparams = tds_mem_tagged_calloc(parameters, (size_t)noutputparams, sizeof(struct OutputParameter));
                         if (!outputparams)
                         {
                             break;
@@ -1198,6 +1810,18 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
 
         Py_END_ALLOW_THREADS
 
+        if (sent)
+        {
+            stats->round_trips++;
+            stats->bytes_sent += strlen(procname) + Cursor_rpcparams_size(rpcparams);
+            stats->send_time += sent - start;
+            if (responded)
+            {
+                stats->response_time += responded - sent;
+                Latency_record_seconds(LatencyMetric_round_trip, responded - start);
+            }
+        }
+
         if (FAIL == retcode)
         {
             Connection_raise_lasterror(cursor->connection);
@@ -1210,11 +1834,16 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
             break;
         }
 
+        if (0 != Cursor_resolve_converters(cursor))
+        {
+            break;
+        }
+
         results = Cursor_unbind(rpcparams,
                                 outputparams,
                                 (size_t)noutputparams,
                                 &noutputs);
-        if ((NULL != results) && (noutputs > 0) && (NO_MORE_RESULTS != retcode))
+        if ((NULL != results) && (noutputs > 0) && (NO_MORE_RESULTS != retcode) && !cursor->deferred)
         {
             /*
                 TDS returns output parameter data (and status) only after all
@@ -1253,6 +1882,100 @@ static PyObject* Cursor_callproc_internal(struct Cursor* cursor, const char* pro
     UNUSED(retstatus);
 }
 
+/*
+    Start measuring a statement for the statement statistics, if enabled.
+
+    @param cursor [in] The cursor.
+    @param kind [in] The kind of statement.
+    @param text [in] The SQL text or stored procedure name.
+
+    @return The start time, in nanoseconds.
+*/
+static uint64_t Cursor_statement_begin(struct Cursor* cursor, enum StatementKind kind, const char* text)
+{
+    cursor->statement = 0;
+    if (!Statements_table || cursor->deferred)
+    {
+        return 0;
+    }
+    cursor->statement = Statements_fingerprint(kind, text);
+    return Clock_monotonic_ns();
+}
+
+/*
+    Record a statement started by Cursor_statement_begin() in the statement
+    statistics.
+
+    @param cursor [in] The cursor.
+    @param kind [in] The kind of statement.
+    @param text [in] The SQL text or stored procedure name.
+    @param start [in] The start time returned by Cursor_statement_begin().
+    @param error [in] Did the statement fail?
+*/
+static void Cursor_statement_end(struct Cursor* cursor, enum StatementKind kind, const char* text,
+                                 uint64_t start, bool error)
+{
+    if (cursor->statement && Statements_table)
+    {
+        Py_ssize_t rows = -1;
+        /* Rows fetched from result sets are added as they are read. */
+        if (!error && !cursor->description)
+        {
+            rows = (Py_ssize_t)dbcount(Connection_DBPROCESS(cursor->connection));
+        }
+        Statements_record(cursor->statement, kind, text, Clock_monotonic_ns() - start, rows, error);
+    }
+}
+
+/*
+    Start timing a statement for the slow query log, if enabled.
+
+    @param cursor [in] The cursor.
+    @param operation [in] The name of the method executing the statement.
+    @param args [in] The arguments passed to the method.
+*/
+static void Cursor_slowlog_begin(struct Cursor* cursor, const char* operation, PyObject* args)
+{
+    /* The previous statement's result set may still be being read. */
+    Cursor_slowlog_finish(cursor, false);
+
+    if (!SlowLog_callback || cursor->deferred)
+    {
+        return;
+    }
+
+    Py_INCREF(args);
+    cursor->slowquery.args = args;
+    cursor->slowquery.operation = operation;
+    cursor->slowquery.fetching = false;
+    cursor->slowquery.start = Clock_monotonic_ns();
+}
+
+/*
+    Stop timing the execution of a statement started by
+    Cursor_slowlog_begin(). The statement is reported once its result set, if
+    any, has been read.
+
+    @param cursor [in] The cursor.
+    @param error [in] Did the statement fail?
+*/
+static void Cursor_slowlog_end(struct Cursor* cursor, bool error)
+{
+    if (cursor->slowquery.args)
+    {
+        cursor->slowquery.first_row = Clock_monotonic_ns() - cursor->slowquery.start;
+        if (!error && cursor->description)
+        {
+            /* Add the time spent fetching the result set. */
+            cursor->slowquery.fetching = true;
+        }
+        else
+        {
+            Cursor_slowlog_finish(cursor, error);
+        }
+    }
+}
+
 /* https://www.python.org/dev/peps/pep-0249/#callproc */
 static const char s_Cursor_callproc_doc[] =
     "callproc(sproc, parameters)\n"
@@ -1284,12 +2007,14 @@ static const char s_Cursor_callproc_doc[] =
     "    the output values.\n"
     ":rtype: dict or tuple\n";
 
-static PyObject* Cursor_callproc(PyObject* self, PyObject* args)
+static PyObject* Cursor_callproc_untraced(PyObject* self, PyObject* args)
 {
     struct Cursor* cursor = (struct Cursor*)self;
 
     char* procname = NULL;
     PyObject* parameters = NULL;
+    PyObject* results;
+    uint64_t start;
     if (!PyArg_ParseTuple(args, "sO", &procname, &parameters))
     {
         return NULL;
@@ -1307,7 +2032,33 @@ static PyObject* Cursor_callproc(PyObject* self, PyObject* args)
     Cursor_verify_open(cursor);
     Cursor_verify_connection_open(cursor);
 
-    return Cursor_callproc_internal(cursor, procname, parameters, false);
+    start = Cursor_statement_begin(cursor, StatementKind_procedure, procname);
+    Cursor_slowlog_begin(cursor, "callproc", args);
+    results = Cursor_callproc_internal(cursor, procname, parameters, false);
+    Cursor_statement_end(cursor, StatementKind_procedure, procname, start, (NULL == results));
+    Cursor_slowlog_end(cursor, (NULL == results));
+
+    return results;
+}
+
+static PyObject* Cursor_callproc(PyObject* self, PyObject* args)
+{
+    struct TraceSpan span;
+    PyObject* result;
+
+    if (!Trace_hooks)
+    {
+        return Cursor_callproc_untraced(self, args);
+    }
+
+    Trace_begin(&span, TraceOperation_callproc,
+                (PyTuple_GET_SIZE(args) > 0) ? PyTuple_GET_ITEM(args, 0) : NULL,
+                ((struct Cursor*)self)->connection);
+    result = Cursor_callproc_untraced(self, args);
+    /* The affected row count is not available after an RPC call. */
+    Trace_end(&span, -1);
+
+    return result;
 }
 
 /* https://www.python.org/dev/peps/pep-0249/#Cursor.close */
@@ -1337,7 +2088,7 @@ static PyObject* Cursor_close(PyObject* self, PyObject* args)
 */
 static char* strappend(char* existing, size_t nexisting, const char* suffix, size_t nsuffix)
 {
-    char* tmp = (char*)tds_mem_realloc(existing, nexisting + nsuffix + 1 /* '\0' */);
+    char* tmp = (char*)tds_mem_tagged_realloc(parameters, existing, nexisting + nsuffix + 1 /* '\0' */);
     if (tmp)
     {
         memcpy(tmp + nexisting, suffix, nsuffix);
@@ -1441,7 +2192,7 @@ static char* build_executesql_stmt(DBPROCESS* dbproc,
 #if defined(CTDS_USE_SP_EXECUTESQL)
                     if (ParamStyle_numeric == paramstyle)
                     {
-                        param = tds_mem_malloc(ARRAYSIZE("@param" STRINGIFY(UINT64_MAX)));
+                        param = tds_mem_tagged_malloc(parameters, ARRAYSIZE("@param" STRINGIFY(UINT64_MAX)));
                         if (param)
                         {
                             assert(-1 != paramnum);
@@ -1453,7 +2204,7 @@ static char* build_executesql_stmt(DBPROCESS* dbproc,
                     {
                         assert(parammarker_end >= parammarker_start);
                         nparam = 1 /* @ */ + (size_t)(parammarker_end - parammarker_start);
-                        param = tds_mem_malloc(nparam + 1 /* '\0' */);
+                        param = tds_mem_tagged_malloc(parameters, nparam + 1 /* '\0' */);
                         if (param)
                         {
                             char* paramname;
@@ -1492,7 +2243,7 @@ static char* build_executesql_stmt(DBPROCESS* dbproc,
                         else
                         {
                             size_t nparamname = (size_t)(parammarker_end - parammarker_start);
-                            char* paramname = tds_mem_malloc(nparamname + 1 /* '\0' */);
+                            char* paramname = tds_mem_tagged_malloc(parameters, nparamname + 1 /* '\0' */);
                             if (!paramname)
                             {
                                 PyErr_NoMemory();
@@ -1620,22 +2371,37 @@ static int Cursor_execute_sql(struct Cursor* cursor, const char* sql)
     {
         bool error = false;
 
+        /* Did the server execute the batch? */
+        bool executed = false;
+
         DBPROCESS* dbproc = Connection_DBPROCESS(cursor->connection);
         RETCODE retcode;
 
+        struct ConnectionStats* stats = Connection_stats(cursor->connection);
+        double start = 0, sent = 0, responded = 0;
+
+        Connection_stop_background(cursor->connection);
         Connection_clear_lastwarning(cursor->connection);
 
         /* Clear any existing command buffer. */
         dbfreebuf(dbproc);
 
+        if (0 != Connection_reset_prepare(cursor->connection, sql))
+        {
+            break;
+        }
+
         retcode = dbcmd(dbproc, sql);
         if (FAIL == retcode)
         {
+            Connection_reset_retry(cursor->connection);
             Connection_raise_lasterror(cursor->connection);
             break;
         }
 
         Cursor_clear_resultset(cursor);
+        cursor->peeked = false;
+        Connection_statement_sent(cursor->connection);
 
         Py_BEGIN_ALLOW_THREADS
 
@@ -1646,24 +2412,45 @@ static int Cursor_execute_sql(struct Cursor* cursor, const char* sql)
                 {
                     break;
                 }
+                start = Clock_monotonic();
                 retcode = dbsqlsend(dbproc);
-                if (FAIL == retcode)
+                sent = Clock_monotonic();
+                if ((FAIL == retcode) || cursor->deferred)
                 {
                     break;
                 }
                 retcode = dbsqlok(dbproc);
-                if (FAIL == retcode)
+                if (FAIL != retcode)
                 {
-                    break;
-                }
+                    /* Any session reset prepended to the batch was executed. */
+                    executed = true;
 
-                error = (0 != Cursor_next_resultset(cursor, &retcode));
+                    PROBE1(first_row, cursor);
+                    error = (0 != Cursor_next_resultset(cursor, &retcode));
+                }
+                responded = Clock_monotonic();
             } while (0);
 
         Py_END_ALLOW_THREADS
 
+        if (sent)
+        {
+            stats->round_trips++;
+            stats->bytes_sent += strlen(sql);
+            stats->send_time += sent - start;
+            if (responded)
+            {
+                stats->response_time += responded - sent;
+                Latency_record_seconds(LatencyMetric_round_trip, responded - start);
+            }
+        }
+
         if (FAIL == retcode)
         {
+            if (!executed)
+            {
+                Connection_reset_retry(cursor->connection);
+            }
             Connection_raise_lasterror(cursor->connection);
             break;
         }
@@ -1674,6 +2461,11 @@ static int Cursor_execute_sql(struct Cursor* cursor, const char* sql)
             break;
         }
 
+        if (0 != Cursor_resolve_converters(cursor))
+        {
+            break;
+        }
+
         /* Raise any warnings that may have occurred. */
         if (0 != Connection_raise_lastwarning(cursor->connection))
         {
@@ -1750,7 +2542,7 @@ static char* make_paramname(PyObject* oname, size_t* nparamname)
 #endif /* else if PY_MAJOR_VERSION < 3 */
 
         required = nname + 1 /* '@' */ + 1 /* '\0' */;
-        paramname = tds_mem_malloc(required);
+        paramname = tds_mem_tagged_malloc(parameters, required);
         if (!paramname)
         {
             PyErr_NoMemory();
@@ -1842,7 +2634,7 @@ static PyObject* build_executesql_params(DBPROCESS* dbproc,
             else
             {
                 size_t required = STRLEN("@param" STRINGIFY(UINT64_MAX)) + 1 /* '\0' */;
-                paramname = tds_mem_malloc(required);
+                paramname = tds_mem_tagged_malloc(parameters, required);
                 if (!paramname)
                 {
                     PyErr_NoMemory();
@@ -1899,7 +2691,7 @@ static PyObject* build_executesql_params(DBPROCESS* dbproc,
                           strlen(sqltype) +
                           STRLEN(" OUTPUT") +
                           1 /* '\0' */;
-            paramdesc = tds_mem_malloc(nparamdesc);
+            paramdesc = tds_mem_tagged_malloc(parameters, nparamdesc);
             if (!paramdesc)
             {
                 PyErr_NoMemory();
@@ -2371,37 +3163,189 @@ static int Cursor_execute_internal(struct Cursor* cursor, const char* sqlfmt, Py
 #endif /* else if defined(CTDS_USE_SP_EXECUTESQL) */
 
 
+/*
+    Build the result cache key for a statement, i.e. the connection's server
+    and login, the current database, the SQL text and the parameters.
+    Parameters are keyed by type as well as value, as their type determines
+    the SQL type they are bound as.
+
+    @note This method requires the current thread own the GIL.
+    @note This method returns a new reference.
+
+    @param cursor [in] The cursor.
+    @param sqlfmt [in] The SQL text.
+    @param parameters [in] The parameters bound to `sqlfmt`. This may be NULL.
+
+    @return The key.
+    @return NULL if the statement is not cacheable, e.g. due to unhashable
+        or output parameters. No Python exception is set.
+*/
+static PyObject* Cursor_cache_key(struct Cursor* cursor, const char* sqlfmt, PyObject* parameters)
+{
+    PyObject* key = NULL;
+    PyObject* params = NULL;
+
+    do
+    {
+        const char* database = dbname(Connection_DBPROCESS(cursor->connection));
+
+        if (!parameters || (0 == PyObject_Length(parameters)))
+        {
+            Py_INCREF(Py_None);
+            params = Py_None;
+        }
+        else if (ParamStyle_numeric == cursor->paramstyle)
+        {
+            Py_ssize_t ix;
+            PyObject* sequence = PySequence_Fast(parameters, "");
+            if (!sequence)
+            {
+                break;
+            }
+            params = PyTuple_New(PySequence_Fast_GET_SIZE(sequence));
+            for (ix = 0; params && (ix < PySequence_Fast_GET_SIZE(sequence)); ++ix)
+            {
+                PyObject* value = PySequence_Fast_GET_ITEM(sequence, ix);
+                PyObject* item;
+                if (Parameter_Check(value) && Parameter_output((struct Parameter*)value))
+                {
+                    Py_CLEAR(params);
+                    break;
+                }
+                item = Py_BuildValue("(OO)", (PyObject*)Py_TYPE(value), value);
+                if (!item)
+                {
+                    Py_CLEAR(params);
+                    break;
+                }
+                PyTuple_SET_ITEM(params, ix, item); /* item reference stolen by PyTuple_SET_ITEM */
+            }
+            Py_DECREF(sequence);
+        }
+        else
+        {
+            Py_ssize_t ix;
+            PyObject* items;
+            bool output = false;
+            PyObject* mapping_items = PyMapping_Items(parameters);
+            if (!mapping_items)
+            {
+                break;
+            }
+            /* Older versions of Python 3 return a view rather than a list. */
+            items = PySequence_List(mapping_items);
+            Py_DECREF(mapping_items);
+            if (!items)
+            {
+                break;
+            }
+            for (ix = 0; ix < PyList_GET_SIZE(items); ++ix)
+            {
+                PyObject* name;
+                PyObject* value;
+                PyObject* item;
+                if (!PyArg_ParseTuple(PyList_GET_ITEM(items, ix), "OO", &name, &value))
+                {
+                    break;
+                }
+                if (Parameter_Check(value) && Parameter_output((struct Parameter*)value))
+                {
+                    output = true;
+                    break;
+                }
+                item = Py_BuildValue("(OOO)", name, (PyObject*)Py_TYPE(value), value);
+                if (!item || (0 != PyList_SetItem(items, ix, item) /* item reference stolen */))
+                {
+                    break;
+                }
+            }
+            if (!PyErr_Occurred() && !output)
+            {
+                /* Named parameters are unordered. */
+                params = PyFrozenSet_New(items);
+            }
+            Py_DECREF(items);
+        }
+        if (!params)
+        {
+            break;
+        }
+
+        key = Py_BuildValue("(OssO)",
+                            Connection_identity(cursor->connection),
+                            (database) ? database : "",
+                            sqlfmt,
+                            params);
+        if (key && (-1 == PyObject_Hash(key)))
+        {
+            Py_CLEAR(key);
+        }
+    }
+    while (0);
+
+    Py_XDECREF(params);
+
+    /* Statements which cannot be keyed are simply not cached. */
+    PyErr_Clear();
+
+    return key;
+}
+
 /* https://www.python.org/dev/peps/pep-0249/#execute */
 static const char s_Cursor_execute_doc[] =
-    "execute(sql, parameters=None)\n"
+    "execute(sql, parameters=None, cache=False)\n"
     "\n"
     "Prepare and execute a database operation.\n"
     "Parameters may be provided as sequence and will be bound to variables\n"
     "specified in the SQL statement. Parameter notation is specified by\n"
     ":py:const:`ctds.paramstyle`.\n"
     "\n"
+    "If `cache` is :py:data:`True` and the connection has a\n"
+    ":py:attr:`ctds.Connection.result_cache`, the results of a read-only\n"
+    "query are served from, or added to, the cache.\n"
+    "\n"
     ":pep:`0249#execute`\n"
     "\n"
+    ".. versionadded:: 1.15\n"
+    "    The `cache` parameter.\n"
+    "\n"
     ":param str sql: The SQL statement to execute.\n"
 
-    ":param tuple parameters: Optional variables to bind.\n";
+    ":param tuple parameters: Optional variables to bind.\n"
+    ":param bool cache: Use the connection's result cache.\n";
 
-static PyObject* Cursor_execute(PyObject* self, PyObject* args)
+static PyObject* Cursor_execute_untraced(PyObject* self, PyObject* args, PyObject* kwargs)
 {
+    static char* s_kwlist[] =
+    {
+        "sql",
+        "parameters",
+        "cache",
+        NULL
+    };
     char* sqlfmt;
     PyObject* parameters = NULL;
+    PyObject* cache = Py_False;
     PyObject* sequence;
     int error;
 
+    PyObject* result_cache;
+    PyObject* cachekey = NULL;
+
+    uint64_t start;
+
     struct Cursor* cursor = (struct Cursor*)self;
     Cursor_verify_open(cursor);
     Cursor_verify_connection_open(cursor);
 
-    if (!PyArg_ParseTuple(args, "s|O", &sqlfmt, &parameters))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|OO!", s_kwlist,
+                                     &sqlfmt, &parameters, &PyBool_Type, &cache))
     {
         return NULL;
     }
 
+    cursor->statement = 0;
+
     if (parameters)
     {
         if (((ParamStyle_numeric == cursor->paramstyle) && !PySequence_Check(parameters)) ||
@@ -2410,453 +3354,1011 @@ static PyObject* Cursor_execute(PyObject* self, PyObject* args)
             PyErr_SetObject(PyExc_TypeError, parameters);
             return NULL;
         }
+    }
 
-        sequence = PyTuple_New(PyObject_Length(parameters) ? 1 : 0);
-        if (!sequence)
+    /* Serve the statement from the result cache, if possible. */
+    result_cache = Connection_result_cache(cursor->connection);
+    if ((Py_True == cache) && result_cache && !cursor->deferred && ResultCache_cacheable(sqlfmt))
+    {
+        cachekey = Cursor_cache_key(cursor, sqlfmt, parameters);
+        if (cachekey)
         {
-            return NULL;
+            PyObject* cached = ResultCache_get((struct ResultCache*)result_cache, cachekey);
+            if (cached)
+            {
+                error = Cursor_execute_cached(cursor, cached);
+                Py_DECREF(cached);
+                Py_DECREF(cachekey);
+                if (0 != error)
+                {
+                    return NULL;
+                }
+                Py_RETURN_NONE;
+            }
+            else if (PyErr_Occurred())
+            {
+                Py_DECREF(cachekey);
+                return NULL;
+            }
         }
+    }
 
-        if (PyObject_Length(parameters))
+    start = Cursor_statement_begin(cursor, StatementKind_sql, sqlfmt);
+    Cursor_slowlog_begin(cursor, "execute", args);
+    PROBE2(execute_start, cursor, sqlfmt);
+    if (parameters)
+    {
+        sequence = PyTuple_New(PyObject_Length(parameters) ? 1 : 0);
+        if (sequence)
+        {
+            if (PyObject_Length(parameters))
+            {
+                Py_INCREF(parameters);
+                PyTuple_SET_ITEM(sequence, 0, parameters); /* parameters reference stolen by PyTuple_SET_ITEM */
+            }
+            error = Cursor_execute_internal(cursor, sqlfmt, sequence, true /* minimize_types */);
+            Py_DECREF(sequence);
+        }
+        else
         {
-            Py_INCREF(parameters);
-            PyTuple_SET_ITEM(sequence, 0, parameters); /* parameters reference stolen by PyTuple_SET_ITEM */
+            /* The statement is still ended below, as it was begun. */
+            error = -1;
         }
-        error = Cursor_execute_internal(cursor, sqlfmt, sequence, true /* minimize_types */);
-        Py_DECREF(sequence);
     }
     else
     {
         error = Cursor_execute_sql(cursor, sqlfmt);
     }
+    Cursor_statement_end(cursor, StatementKind_sql, sqlfmt, start, (0 != error));
+    Cursor_slowlog_end(cursor, (0 != error));
+    PROBE2(execute_end, cursor, error);
     if (0 != error)
     {
+        Py_XDECREF(cachekey);
         return NULL;
     }
+
+    /* Record the rows of the result set as they are fetched. */
+    if (cachekey && cursor->description)
+    {
+        cursor->cachekey = cachekey; /* claim reference */
+        cursor->caching = true;
+    }
+    else
+    {
+        Py_XDECREF(cachekey);
+    }
     Py_RETURN_NONE;
 }
 
-/* https://www.python.org/dev/peps/pep-0249/#executemany */
-static const char s_Cursor_executemany_doc[] =
-    "executemany(sql, seq_of_parameters)\n"
-    "\n"
-    "Prepare a database operation (query or command) and then execute it\n"
-    "against all parameter sequences or mappings found in the sequence\n"
-    "`seq_of_parameters`.\n"
-    "\n"
-    ":pep:`0249#executemany`\n"
-    "\n"
-    ":param str sql: The SQL statement to execute.\n"
-
-    ":param seq_of_parameters: An iterable of parameter sequences to bind.\n"
-    ":type seq_of_parameters: :ref:`typeiter <python:typeiter>`\n";
-
-PyObject* Cursor_executemany(PyObject* self, PyObject* args)
+/*
+    Get the number of rows the last statement executed on a cursor produced
+    or affected, for tracing.
+*/
+static Py_ssize_t Cursor_trace_rowcount(struct Cursor* cursor)
 {
-    char* sqlfmt;
-    PyObject* iterable;
-
-    struct Cursor* cursor = (struct Cursor*)self;
-    Cursor_verify_open(cursor);
-    Cursor_verify_connection_open(cursor);
-
-    if (!PyArg_ParseTuple(args, "sO", &sqlfmt, &iterable))
-    {
-        return NULL;
-    }
-
-    /*
-        Explicitly do not minimize SQL type widths in executemany to avoid truncation issues
-        when using sp_executesql and inferring the SQL type from the first parameter sequence.
-        If the first sequence has types that map to variable length SQL types, the minimal type
-        size may not be large enough for values in later sequences.
-    */
-    if (Cursor_execute_internal(cursor, sqlfmt, iterable, false /* minimize_types */))
+    if (cursor->cached)
     {
-        return NULL;
+        return Py_SIZE((PyObject*)cursor->cached);
     }
-    Py_RETURN_NONE;
+    return (Py_ssize_t)dbcount(Connection_DBPROCESS(cursor->connection));
 }
 
-struct ColumnBuffer
+static PyObject* Cursor_execute(PyObject* self, PyObject* args, PyObject* kwargs)
 {
-    /* The size of this column, in bytes. */
-    size_t size;
-
-    /*
-        The TDS type of this column. This is necessary for COMPUTE columns
-        which may have a different type than the regular column.
-    */
-    enum TdsType tdstype;
+    struct TraceSpan span;
+    PyObject* result;
 
-    /* The column data. This member must always be last. */
-    union {
-        /* Allocated separately on heap. */
-        void* variable;
+    struct Cursor* cursor = (struct Cursor*)self;
 
-        /* Allocated as part of this structure. */
-        uint8_t* fixed;
-    } data;
-};
+    if (!Trace_hooks)
+    {
+        return Cursor_execute_untraced(self, args, kwargs);
+    }
 
-/*
-    Check whether a database column is variable length or not.
+    Trace_begin(&span, TraceOperation_execute,
+                (PyTuple_GET_SIZE(args) > 0) ? PyTuple_GET_ITEM(args, 0) : NULL,
+                cursor->connection);
+    result = Cursor_execute_untraced(self, args, kwargs);
+    Trace_end(&span, (result) ? Cursor_trace_rowcount(cursor) : -1);
 
-    @param _dbcol [in] A DBCOL* describing the column.
-*/
-#define Column_IsVariableLength(_dbcol) \
-    !!(_dbcol)->VarLength
+    return result;
+}
 
 /*
-    Determine the column buffer size required for a database column.
+    Import the asyncio helper module and call one of its functions.
 
-    @param _dbcol [in] A DBCOL* describing the column.
+    @note This method returns a new reference.
 */
-#define ColumnBuffer_size(_dbcol) \
-    ((Column_IsVariableLength(_dbcol)) ? \
-        sizeof(struct ColumnBuffer) : ((size_t)(_dbcol)->MaxLength + offsetof(struct ColumnBuffer, data)))
-
-
-struct RowBuffer
+static PyObject* Cursor_aio_call(const char* function, PyObject* args)
 {
-    /* The next row buffer in the resultset. */
-    struct RowBuffer* next;
-
-    /*
-        A dynamically-sized block of memory large enough for all the row's
-        columns. Because columns themselves are dynamically sized, indexing
-        into this array is non-trivial.
-
-        Iterating column buffers requires use of ColumnBuffer_size() to
-        determine the actual size of the ColumnBuffer.
-    */
-
-/* Ignore "ISO C90 does not support flexible array members". */
-#if defined(__GNUC__) && (__GNUC__ > 4)
-#  pragma GCC diagnostic push
-#  pragma GCC diagnostic ignored "-Wpedantic"
-#endif /* if defined(__GNUC__) && (__GNUC__ > 4) */
-#if defined (_MSC_VER)
-#  pragma warning(disable: 4200)
-#endif /* if defined (_MSC_VER) */
-
-    struct ColumnBuffer columns[];
+    PyObject* result = NULL;
+    PyObject* aio = PyImport_ImportModule("ctds._aio");
+    if (aio)
+    {
+        PyObject* callable = PyObject_GetAttrString(aio, function);
+        if (callable)
+        {
+            result = PyObject_Call(callable, args, NULL);
+            Py_DECREF(callable);
+        }
+        Py_DECREF(aio);
+    }
+    return result;
+}
 
-#if defined (_MSC_VER)
-#  pragma warning(default: 4200)
-#endif /* if defined (_MSC_VER) */
-#if defined(__GNUC__) && (__GNUC__ > 4)
-#  pragma GCC diagnostic pop
-#endif /* if defined(__GNUC__) && (__GNUC__ > 4) */
-};
+static const char s_execute_abandoned[] = "statement cancelled by another operation";
 
 /*
-    Determine the row buffer size for the current resultset.
+    Record a statement sent by execute_async() in the statement statistics
+    and slow query log and end its trace, once its response has been read,
+    it has been abandoned or it failed to be sent. This does nothing if the
+    statement was already recorded.
 
-    @param description [in] A description of the result set.
+    @note This method requires the current thread own the GIL.
 
-    @return The size, in bytes, for a RowBuffer describing
-        the current resultset.
+    @param cursor [in] The cursor.
+    @param error [in] Did the statement fail? The exception, if any, is
+        passed to the trace hooks.
 */
-static size_t ResultSetDescription_RowBuffer_size(const struct ResultSetDescription* description)
+static void Cursor_execute_async_end(struct Cursor* cursor, bool error)
 {
-    if (description)
+    if (cursor->pending.args)
     {
-        size_t size = 0;
-        size_t ix;
-        for (ix = 0; ix < description->ncolumns; ++ix)
-        {
-            size += ColumnBuffer_size(&description->columns[ix].dbcol);
-        }
-
-        return offsetof(struct RowBuffer, columns) + size;
+        Cursor_statement_end(cursor, StatementKind_sql, cursor->pending.sql,
+                             cursor->pending.start, error);
+        Cursor_slowlog_end(cursor, error);
+        Py_CLEAR(cursor->pending.args);
     }
-    else
+    if (cursor->pending.traced)
     {
-        return 0;
+        cursor->pending.traced = false;
+        Trace_end(&cursor->pending.span, (error) ? -1 : Cursor_trace_rowcount(cursor));
     }
 }
 
 /*
-    Release all memory referenced by a RowBuffer.
+    Abandon a statement sent by execute_async() which is awaiting the
+    server's response, cancelling it. If the response is being read by
+    Cursor_execute_complete(), wait for it to be read instead.
 
-    @param description [in] A description of the result set for the `rowbuffer`.
-    @param rowbuffer [in] The first row in the resultset.
+    This is the connection's background operation stop function while the
+    statement is outstanding.
+
+    @note This method requires the current thread own the GIL.
 */
-static void ResultSetDescription_RowBuffer_free(const struct ResultSetDescription* description,
-                                                struct RowBuffer* rowbuffer)
+static void Cursor_execute_abandon(void* arg)
 {
-    while (rowbuffer)
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+
+    struct Cursor* cursor = (struct Cursor*)arg;
+
+    cursor->outstanding = false;
+    if (cursor->completing)
     {
-        struct RowBuffer* next = rowbuffer->next;
+        /* Cursor_execute_complete() fails the awaitable. */
+        Py_BEGIN_ALLOW_THREADS
 
-        struct ColumnBuffer* column = rowbuffer->columns;
-        size_t ix;
-        for (ix = 0; ix < description->ncolumns; ++ix)
+            (void)PyThread_acquire_lock(cursor->completion, WAIT_LOCK);
+            PyThread_release_lock(cursor->completion);
+
+        Py_END_ALLOW_THREADS
+    }
+    else
+    {
+        PyObject* exception;
+
+        DBPROCESS* dbproc = Connection_DBPROCESS(cursor->connection);
+
+        Py_BEGIN_ALLOW_THREADS
+
+            (void)dbcancel(dbproc);
+
+        Py_END_ALLOW_THREADS
+
+        /* Notifying the awaitable must not clobber any exception currently being raised. */
+        PyErr_Fetch(&type, &value, &traceback);
+        exception = PyObject_CallFunction(PyExc_tds_InterfaceError, "s", s_execute_abandoned);
+        if (exception && cursor->abandoned)
         {
-            const DBCOL* dbcol = &description->columns[ix].dbcol;
-            if (Column_IsVariableLength(dbcol))
-            {
-                tds_mem_free(column->data.variable);
-                column->data.variable = 0;
-            }
-            column = (struct ColumnBuffer*)((char*)column + ColumnBuffer_size(dbcol));
+            PyObject* result = PyObject_CallFunctionObjArgs(cursor->abandoned, exception, NULL);
+            Py_XDECREF(result);
         }
-        tds_mem_free(rowbuffer);
-        rowbuffer = next;
+        Py_XDECREF(exception);
+        PyErr_Clear();
+        PyErr_Restore(type, value, traceback);
     }
-}
+    Py_CLEAR(cursor->abandoned);
 
-struct Row {
-    PyObject_VAR_HEAD
+    /* Record the cancellation without clobbering any exception currently being raised. */
+    PyErr_Fetch(&type, &value, &traceback);
+    PyErr_SetString(PyExc_tds_InterfaceError, s_execute_abandoned);
+    Cursor_execute_async_end(cursor, true);
+    PyErr_Clear();
+    PyErr_Restore(type, value, traceback);
 
-    struct ResultSetDescription* description;
+    /*
+        Any session reset prepended to the statement may not have been
+        executed. Resending it is harmless.
+    */
+    Connection_reset_retry(cursor->connection);
+}
 
-    PyObject* values[1]; /* space for row data values is added by tp_alloc() */
-};
+/*
+    Read the server's response to a statement sent by execute_async().
 
-static void Row_dealloc(PyObject* self)
+    @note This is called in the event loop's executor once the connection's
+        socket is readable.
+*/
+static PyObject* Cursor_execute_complete(PyObject* self, PyObject* args)
 {
-    struct Row* row = (struct Row*)self;
-    size_t ix;
-    for (ix = 0; ix < row->description->ncolumns; ++ix)
+    int error = 0;
+    bool executed = false;
+    RETCODE retcode;
+    DBPROCESS* dbproc;
+    double elapsed;
+
+    struct Cursor* cursor = (struct Cursor*)self;
+
+    if (!cursor->outstanding)
     {
-        Py_XDECREF(row->values[ix]);
+        PyErr_SetString(PyExc_tds_InterfaceError, s_execute_abandoned);
+        return NULL;
     }
-    ResultSetDescription_decrement(row->description);
-    PyObject_Del(self);
-}
 
-PyTypeObject RowType; /* forward decl. */
-static struct Row* Row_create(struct ResultSetDescription* description,
-                              const struct RowBuffer* rowbuffer)
-{
-    struct Row* row = PyObject_NewVar(struct Row, &RowType, (Py_ssize_t)description->ncolumns);
-    if (row)
-    {
-        /* The offset to the next column buffer in the row. */
-        size_t offset = 0;
-        size_t ixcol;
+    dbproc = Connection_DBPROCESS(cursor->connection);
 
-        memset(row->values, 0, description->ncolumns * sizeof(*row->values));
-        row->description = description;
-        ResultSetDescription_increment(description);
+    /* Other operations on the connection wait for the response to be read. */
+    cursor->completing = true;
+    (void)PyThread_acquire_lock(cursor->completion, WAIT_LOCK);
 
-        for (ixcol = 0; ixcol < description->ncolumns; ++ixcol)
+    Py_BEGIN_ALLOW_THREADS
+
+        retcode = dbsqlok(dbproc);
+        if (FAIL != retcode)
         {
-            const struct Column* column = &description->columns[ixcol];
+            executed = true;
 
-            if (column->topython)
-            {
-                const struct ColumnBuffer* colbuffer = (const struct ColumnBuffer*)(((const char*)rowbuffer->columns) + offset);
+            PROBE1(first_row, cursor);
+            error = (0 != Cursor_next_resultset(cursor, &retcode));
+        }
+        PyThread_release_lock(cursor->completion);
 
-                const void* data = (Column_IsVariableLength(&column->dbcol)) ?
-                    colbuffer->data.variable : &colbuffer->data.fixed;
+    Py_END_ALLOW_THREADS
 
-                PyObject* object = NULL;
+    cursor->completing = false;
 
-                /*
-                    Used the cached column converter if the type is expected.
-                    The type may differ for COMPUTE columns, in which case the
-                    converter won't be cached.
-                */
-                if ((enum TdsType)column->dbcol.Type == colbuffer->tdstype)
-                {
-                    object = column->topython(colbuffer->tdstype,
-                                              data,
-                                              colbuffer->size);
-                }
-                else
-                {
-                    sql_topython topython = sql_topython_lookup(colbuffer->tdstype);
-                    assert(topython);
-                    object = topython(colbuffer->tdstype,
-                                      data,
-                                      colbuffer->size);
-                }
-                if (!object)
-                {
-                    break;
-                }
+    /* The connection was used for another operation while reading. */
+    if (!cursor->outstanding)
+    {
+        PyErr_SetString(PyExc_tds_InterfaceError, s_execute_abandoned);
+        return NULL;
+    }
+    cursor->outstanding = false;
+    Py_CLEAR(cursor->abandoned);
+    Connection_set_background(cursor->connection, NULL, NULL);
 
-                row->values[ixcol] = object; /* object reference stolen */
-            }
-            else
+    /* The server's response time includes the wait for the socket to be readable. */
+    elapsed = Clock_monotonic() - cursor->pending.sent;
+    Connection_stats(cursor->connection)->response_time += elapsed;
+    Latency_record_seconds(LatencyMetric_round_trip, elapsed);
+
+    do
+    {
+        if (FAIL == retcode)
+        {
+            if (!executed)
             {
-                PyErr_Format(PyExc_tds_NotSupportedError,
-                             "unsupported type %d for column \"%s\"",
-                             column->dbcol.Type,
-                             column->dbcol.ActualName);
-                break;
+                /* Any session reset prepended to the batch was not executed. */
+                Connection_reset_retry(cursor->connection);
             }
-            offset += ColumnBuffer_size(&column->dbcol);
+            Connection_raise_lasterror(cursor->connection);
+            break;
         }
-        if (PyErr_Occurred())
+        if (error)
+        {
+            PyErr_NoMemory();
+            break;
+        }
+
+        if (0 != Cursor_resolve_converters(cursor))
+        {
+            break;
+        }
+
+        /* Raise any warnings that may have occurred. */
+        if (0 != Connection_raise_lastwarning(cursor->connection))
         {
-            Py_DECREF(row);
-            row = NULL;
+            assert(PyErr_Occurred());
+            break;
         }
     }
-    else
+    while (0);
+
+    Cursor_execute_async_end(cursor, (NULL != PyErr_Occurred()));
+
+    if (PyErr_Occurred())
     {
-        PyErr_NoMemory();
+        return NULL;
     }
-    return row;
+    Py_RETURN_NONE;
+    UNUSED(args);
 }
 
-static PyObject* Row_lookup_column(PyObject* self, PyObject* item, PyObject* error)
+/*
+    Cancel a statement sent by execute_async() whose awaitable was cancelled
+    or garbage collected before the server's response was read.
+
+    @note This is called by the event loop or the awaitable's finalizer.
+*/
+static PyObject* Cursor_execute_cancel(PyObject* self, PyObject* abandoned)
 {
-    struct Row* row = (struct Row*)self;
-    PyObject* value = NULL;
-    const char* name = NULL;
-    size_t ix;
+    struct Cursor* cursor = (struct Cursor*)self;
 
-#if PY_MAJOR_VERSION < 3
-    PyObject* utf8item = NULL;
-    if (PyUnicode_Check(item))
+    /* The statement is identified by its `abandoned` callback. */
+    if (cursor->outstanding && (abandoned == cursor->abandoned))
     {
-        utf8item = PyUnicode_AsUTF8String(item);
-        if (!utf8item)
+        Connection_stop_background(cursor->connection);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef s_Cursor_execute_complete_def = {
+    "execute_complete", (PyCFunction)Cursor_execute_complete, METH_NOARGS, NULL
+};
+
+static PyMethodDef s_Cursor_execute_cancel_def = {
+    "execute_cancel", (PyCFunction)Cursor_execute_cancel, METH_O, NULL
+};
+
+static const char s_Cursor_execute_async_doc[] =
+    "execute_async(sql, parameters=None)\n"
+    "\n"
+    "Prepare and execute a database operation without blocking an\n"
+    ":py:mod:`asyncio` event loop while waiting for the server's response.\n"
+    "The statement is sent immediately and the returned awaitable completes\n"
+    "once the server has responded. The response is read in the event loop's\n"
+    "default executor. Parameters are bound as in :py:meth:`.execute`.\n"
+    "\n"
+    "If the awaitable is cancelled, or the connection is used for another\n"
+    "operation before it completes, the statement is cancelled.\n"
+    "\n"
+    ".. note:: Only one statement may be outstanding on a connection at a\n"
+    "    time. The cursor must not be used until the returned awaitable\n"
+    "    completes.\n"
+    "\n"
+    ".. note:: Requires Python 3.5 or later and an event loop supporting\n"
+    "    :py:meth:`asyncio.loop.add_reader`. The\n"
+    "    :py:class:`asyncio.ProactorEventLoop`, the default on Windows, is\n"
+    "    not supported and raises :py:exc:`NotImplementedError`.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param str sql: The SQL statement to execute.\n"
+    ":param tuple parameters: Optional variables to bind.\n"
+    ":return: An awaitable which completes when the statement has executed.\n"
+    ":rtype: asyncio.Future\n";
+
+static PyObject* Cursor_execute_async(PyObject* self, PyObject* args)
+{
+    PyObject* executed;
+    PyObject* complete;
+    PyObject* cancel;
+    PyObject* loop;
+    PyObject* aioargs;
+    PyObject* future;
+    const char* sql;
+    PyObject* parameters;
+    PyObject* cache;
+    int fd;
+
+    struct Cursor* cursor = (struct Cursor*)self;
+    Cursor_verify_open(cursor);
+    Cursor_verify_connection_open(cursor);
+
+    /* The remaining arguments are validated by Cursor_execute_untraced(). */
+    if (!PyArg_ParseTuple(args, "s|OO", &sql, &parameters, &cache))
+    {
+        return NULL;
+    }
+
+    /* Reject unsupported event loops before the statement is sent. */
+    aioargs = PyTuple_New(0);
+    if (!aioargs)
+    {
+        return NULL;
+    }
+    loop = Cursor_aio_call("reader_loop", aioargs);
+    Py_DECREF(aioargs);
+    if (!loop)
+    {
+        return NULL;
+    }
+
+    if (!cursor->completion)
+    {
+        cursor->completion = PyThread_allocate_lock();
+        if (!cursor->completion)
         {
+            Py_DECREF(loop);
+            PyErr_NoMemory();
             return NULL;
         }
-        name = PyString_AS_STRING(utf8item);
     }
-    else
+
+    /*
+        A statement still outstanding on the cursor is abandoned by sending
+        this one. Do so first, so its measurements are recorded.
+    */
+    if (cursor->outstanding)
     {
-        if (PyString_Check(item))
-        {
-            name = PyString_AS_STRING(item);
-        }
+        Connection_stop_background(cursor->connection);
     }
-#else /* if PY_MAJOR_VERSION < 3 */
-    if (PyUnicode_Check(item))
+
+    /* The statement is traced from its send until its response is read. */
+    if (Trace_hooks)
     {
-        name = PyUnicode_AsUTF8(item);
+        Trace_begin(&cursor->pending.span, TraceOperation_execute_async,
+                    PyTuple_GET_ITEM(args, 0), cursor->connection);
+        cursor->pending.traced = true;
     }
-#endif /* else if PY_MAJOR_VERSION < 3 */
 
-    if (name)
+    cursor->deferred = true;
+    executed = Cursor_execute_untraced(self, args, NULL);
+    cursor->deferred = false;
+    if (!executed)
     {
-        for (ix = 0; ix < row->description->ncolumns; ++ix)
+        Cursor_execute_async_end(cursor, true);
+        Py_DECREF(loop);
+        return NULL;
+    }
+    Py_DECREF(executed);
+
+    /*
+        The statement is measured from its send until its response is read
+        by Cursor_execute_complete().
+    */
+    cursor->pending.sent = Clock_monotonic();
+    Py_INCREF(args);
+    cursor->pending.args = args;
+    cursor->pending.sql = sql;
+    cursor->pending.start = Cursor_statement_begin(cursor, StatementKind_sql, sql);
+    Cursor_slowlog_begin(cursor, "execute_async", args);
+
+    cursor->outstanding = true;
+    Connection_set_background(cursor->connection, Cursor_execute_abandon, cursor);
+
+    fd = dbiordesc(Connection_DBPROCESS(cursor->connection));
+
+    future = NULL;
+    complete = PyCFunction_New(&s_Cursor_execute_complete_def, self);
+    cancel = PyCFunction_New(&s_Cursor_execute_cancel_def, self);
+    if (complete && cancel)
+    {
+        aioargs = Py_BuildValue("(OiOO)", loop, fd, complete, cancel);
+        if (aioargs)
         {
-            if (0 == strcmp(name, row->description->columns[ix].dbcol.ActualName))
+            PyObject* waiting = Cursor_aio_call("wait", aioargs);
+            Py_DECREF(aioargs);
+            if (waiting)
             {
-                Py_INCREF(row->values[ix]);
-                value = row->values[ix];
-                break;
+                PyObject* abandoned;
+                if (PyArg_ParseTuple(waiting, "OO", &future, &abandoned))
+                {
+                    Py_INCREF(future);
+                    Py_INCREF(abandoned);
+                    cursor->abandoned = abandoned;
+                }
+                Py_DECREF(waiting);
             }
         }
     }
+    Py_XDECREF(cancel);
+    Py_XDECREF(complete);
+    Py_DECREF(loop);
 
-#if PY_MAJOR_VERSION < 3
-    Py_XDECREF(utf8item);
-#endif /* if PY_MAJOR_VERSION < 3 */
-
-    if (!value && error != NULL)
+    /* The response will never be read. */
+    if (!future)
     {
-        PyErr_SetObject(error, item);
+        Connection_stop_background(cursor->connection);
     }
-    return value;
-}
 
-static Py_ssize_t Row_len(PyObject* self)
-{
-    struct Row* row = (struct Row*)self;
-    return (Py_ssize_t)row->description->ncolumns;
+    return future;
 }
 
-static PyObject* Row_item(PyObject* self, Py_ssize_t ix)
+/* https://www.python.org/dev/peps/pep-0249/#executemany */
+static const char s_Cursor_executemany_doc[] =
+    "executemany(sql, seq_of_parameters)\n"
+    "\n"
+    "Prepare a database operation (query or command) and then execute it\n"
+    "against all parameter sequences or mappings found in the sequence\n"
+    "`seq_of_parameters`.\n"
+    "\n"
+    ":pep:`0249#executemany`\n"
+    "\n"
+    ":param str sql: The SQL statement to execute.\n"
+
+    ":param seq_of_parameters: An iterable of parameter sequences to bind.\n"
+    ":type seq_of_parameters: :ref:`typeiter <python:typeiter>`\n";
+
+static PyObject* Cursor_executemany_untraced(PyObject* self, PyObject* args)
 {
-    struct Row* row = (struct Row*)self;
-    if (ix < 0 || ix >= (Py_ssize_t)row->description->ncolumns)
+    char* sqlfmt;
+    PyObject* iterable;
+    uint64_t start;
+    int error;
+
+    struct Cursor* cursor = (struct Cursor*)self;
+    Cursor_verify_open(cursor);
+    Cursor_verify_connection_open(cursor);
+
+    if (!PyArg_ParseTuple(args, "sO", &sqlfmt, &iterable))
     {
-        PyErr_SetString(PyExc_IndexError, "index is out of range");
         return NULL;
     }
-    Py_INCREF(row->values[ix]);
-    return row->values[ix];
-}
 
-static int Row_contains(PyObject* self, PyObject* value)
-{
-    PyObject* item = Row_lookup_column(self, value, NULL);
-    int contains = (NULL != item) ? 1 : 0;
-    Py_XDECREF(item);
-    return contains;
+    /*
+        Explicitly do not minimize SQL type widths in executemany to avoid truncation issues
+        when using sp_executesql and inferring the SQL type from the first parameter sequence.
+        If the first sequence has types that map to variable length SQL types, the minimal type
+        size may not be large enough for values in later sequences.
+    */
+    start = Cursor_statement_begin(cursor, StatementKind_sql, sqlfmt);
+    Cursor_slowlog_begin(cursor, "executemany", args);
+    error = Cursor_execute_internal(cursor, sqlfmt, iterable, false /* minimize_types */);
+    Cursor_statement_end(cursor, StatementKind_sql, sqlfmt, start, (0 != error));
+    Cursor_slowlog_end(cursor, (0 != error));
+    if (0 != error)
+    {
+        return NULL;
+    }
+    Py_RETURN_NONE;
 }
 
-PyTypeObject* RowType_init(void)
+PyObject* Cursor_executemany(PyObject* self, PyObject* args)
 {
-    if (0 != PyType_Ready(&RowType))
+    struct TraceSpan span;
+    PyObject* result;
+
+    struct Cursor* cursor = (struct Cursor*)self;
+
+    if (!Trace_hooks)
     {
-        return NULL;
+        return Cursor_executemany_untraced(self, args);
     }
-    return &RowType;
+
+    Trace_begin(&span, TraceOperation_executemany,
+                (PyTuple_GET_SIZE(args) > 0) ? PyTuple_GET_ITEM(args, 0) : NULL,
+                cursor->connection);
+    result = Cursor_executemany_untraced(self, args);
+    Trace_end(&span, (result) ? Cursor_trace_rowcount(cursor) : -1);
+
+    return result;
 }
 
-static PySequenceMethods s_Row_as_sequence = {
-    Row_len,      /* sq_length */
-    NULL,         /* sq_concat */
-    NULL,         /* sq_repeat */
-    Row_item,     /* sq_item */
-    NULL,         /* sq_ass_item */
-    NULL,         /* was_sq_slice */
-    NULL,         /* was_sq_ass_slice */
-    Row_contains, /* sq_contains */
-    NULL,         /* sq_inplace_concat */
-    NULL,         /* sq_inplace_repeat */
+
+struct RowBuffer
+{
+    /* The next row buffer in the resultset. */
+    struct RowBuffer* next;
+
+    /*
+        A dynamically-sized block of memory large enough for all the row's
+        columns. Because columns themselves are dynamically sized, indexing
+        into this array is non-trivial.
+
+        Iterating column buffers requires use of ColumnBuffer_size() to
+        determine the actual size of the ColumnBuffer.
+    */
+
+/* Ignore "ISO C90 does not support flexible array members". */
+#if defined(__GNUC__) && (__GNUC__ > 4)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wpedantic"
+#endif /* if defined(__GNUC__) && (__GNUC__ > 4) */
+#if defined (_MSC_VER)
+#  pragma warning(disable: 4200)
+#endif /* if defined (_MSC_VER) */
+
+    struct ColumnBuffer columns[];
+
+#if defined (_MSC_VER)
+#  pragma warning(default: 4200)
+#endif /* if defined (_MSC_VER) */
+#if defined(__GNUC__) && (__GNUC__ > 4)
+#  pragma GCC diagnostic pop
+#endif /* if defined(__GNUC__) && (__GNUC__ > 4) */
 };
 
-static PyObject* Row_subscript(PyObject* self, PyObject* item)
+/*
+    Determine the row buffer size for the current resultset.
+
+    @param description [in] A description of the result set.
+
+    @return The size, in bytes, for a RowBuffer describing
+        the current resultset.
+*/
+static size_t ResultSetDescription_RowBuffer_size(const struct ResultSetDescription* description)
 {
-    if (PyUnicode_Check(item)
-#if PY_MAJOR_VERSION < 3
-        || PyString_Check(item)
-#endif /* if PY_MAJOR_VERSION < 3 */
-    )
-    {
-        return Row_lookup_column(self, item, PyExc_KeyError);
-    }
-    else if (PyLong_Check(item))
+    if (description)
     {
-        Py_ssize_t ix = PyLong_AsSsize_t(item);
-        if (PyErr_Occurred())
+        size_t size = 0;
+        size_t ix;
+        for (ix = 0; ix < description->ncolumns; ++ix)
         {
-            return NULL;
+            size += ColumnBuffer_size(&description->columns[ix].dbcol);
         }
-        return Row_item(self, ix);
+
+        return offsetof(struct RowBuffer, columns) + size;
     }
-#if PY_MAJOR_VERSION < 3
-    else if (PyInt_Check(item))
+    else
     {
-        return Row_item(self, PyInt_AsSsize_t(item));
+        return 0;
     }
-#endif /* if PY_MAJOR_VERSION < 3 */
-
-    PyErr_SetObject(PyExc_KeyError, item);
-    return NULL;
 }
 
-static PyMappingMethods s_Row_as_mapping = {
-    Row_len,       /* mp_length */
-    Row_subscript, /* mp_subscript */
-    NULL,          /* mp_ass_subscript */
-};
+/*
+    Release all memory referenced by a RowBuffer.
 
-static PyObject* Row_getattro(PyObject* self, PyObject* attr)
+    @param description [in] A description of the result set for the `rowbuffer`.
+    @param rowbuffer [in] The first row in the resultset.
+*/
+static void ResultSetDescription_RowBuffer_free(const struct ResultSetDescription* description,
+                                                struct RowBuffer* rowbuffer)
 {
-    PyObject* value = Row_lookup_column(self, attr, NULL);
-    if (!value && !PyErr_Occurred())
+    while (rowbuffer)
     {
-        value = PyObject_GenericGetAttr(self, attr);
+        struct RowBuffer* next = rowbuffer->next;
+
+        struct ColumnBuffer* column = rowbuffer->columns;
+        size_t ix;
+        for (ix = 0; ix < description->ncolumns; ++ix)
+        {
+            const DBCOL* dbcol = &description->columns[ix].dbcol;
+            if (Column_IsVariableLength(dbcol))
+            {
+                tds_mem_free(column->data.variable);
+                column->data.variable = 0;
+            }
+            column = (struct ColumnBuffer*)((char*)column + ColumnBuffer_size(dbcol));
+        }
+        tds_mem_free(rowbuffer);
+        rowbuffer = next;
     }
-    return value;
 }
 
-static PyObject* Row_description_get(PyObject* self, void* closure)
-{
-    struct Row* row = (struct Row*)self;
+struct Row {
+    PyObject_VAR_HEAD
+
+    struct ResultSetDescription* description;
+
+    /*
+        The raw row data. Columns are converted to Python objects on first
+        access and the buffer is released once all columns are converted.
+    */
+    struct RowBuffer* rowbuffer;
+
+    /* The number of columns not yet converted from `rowbuffer`. */
+    size_t nunconverted;
+
+    /*
+        The converted column values. Values are NULL until converted.
+        Space for row data values is added by tp_alloc().
+    */
+    PyObject* values[1];
+};
+
+static void Row_dealloc(PyObject* self)
+{
+    struct Row* row = (struct Row*)self;
+    size_t ix;
+    for (ix = 0; ix < row->description->ncolumns; ++ix)
+    {
+        Py_XDECREF(row->values[ix]);
+    }
+    if (row->rowbuffer)
+    {
+        ResultSetDescription_RowBuffer_free(row->description, row->rowbuffer);
+    }
+    ResultSetDescription_decrement(row->description);
+    PyObject_Del(self);
+}
+
+PyTypeObject RowType; /* forward decl. */
+
+/*
+    Create a Row object for the raw row data. Columns are converted to Python
+    objects on first access.
+
+    @note This method sets an appropriate Python exception on error.
+    @note This method takes ownership of `rowbuffer` on success only.
+
+    @param description [in] A description of the result set for the `rowbuffer`.
+    @param rowbuffer [in] The raw row data.
+
+    @return The Row object.
+    @return NULL on failure.
+*/
+static struct Row* Row_create(struct ResultSetDescription* description,
+                              struct RowBuffer* rowbuffer)
+{
+    struct Row* row;
+    size_t ixcol;
+
+    /* Report unsupported columns when the row is created, not when accessed. */
+    for (ixcol = 0; ixcol < description->ncolumns; ++ixcol)
+    {
+        const struct Column* column = &description->columns[ixcol];
+        if (!column->topython)
+        {
+            PyErr_Format(PyExc_tds_NotSupportedError,
+                         "unsupported type %d for column \"%s\"",
+                         column->dbcol.Type,
+                         column->dbcol.ActualName);
+            return NULL;
+        }
+    }
+
+    row = PyObject_NewVar(struct Row, &RowType, (Py_ssize_t)description->ncolumns);
+    if (row)
+    {
+        memset(row->values, 0, description->ncolumns * sizeof(*row->values));
+        row->description = description;
+        ResultSetDescription_increment(description);
+
+        row->rowbuffer = rowbuffer;
+        row->nunconverted = description->ncolumns;
+    }
+    else
+    {
+        PyErr_NoMemory();
+    }
+    return row;
+}
+
+/*
+    Retrieve the value of a column in a row, converting it from the raw row
+    data on first access.
+
+    @note This method sets an appropriate Python exception on error.
+    @note This method returns a borrowed reference.
+
+    @param row [in] The row.
+    @param ix [in] The column index. This must be in range.
+
+    @return The column value.
+    @return NULL on failure.
+*/
+static PyObject* Row_value(struct Row* row, size_t ix)
+{
+    if (!row->values[ix])
+    {
+        const struct Column* column = &row->description->columns[ix];
+        const struct ColumnBuffer* colbuffer =
+            (const struct ColumnBuffer*)(((const char*)row->rowbuffer->columns) + column->offset);
+
+        const void* data = (Column_IsVariableLength(&column->dbcol)) ?
+            colbuffer->data.variable : &colbuffer->data.fixed;
+
+        PyObject* object = NULL;
+
+        /* This is only set if the connection times conversions. */
+        struct ConnectionStats* stats = row->description->stats;
+        double start = (stats) ? Clock_monotonic() : 0;
+
+        /*
+            Used the cached column converter if the type is expected.
+            The type may differ for COMPUTE columns, in which case the
+            converter won't be cached.
+        */
+        if ((enum TdsType)column->dbcol.Type == colbuffer->tdstype)
+        {
+            object = column->topython(colbuffer->tdstype,
+                                      data,
+                                      colbuffer->size);
+            if (object && (Py_None != object) && column->converter)
+            {
+                PyObject* converted = PyObject_CallFunctionObjArgs(column->converter, object, NULL);
+                Py_DECREF(object);
+                object = converted;
+            }
+        }
+        else
+        {
+            sql_topython topython = sql_topython_lookup(colbuffer->tdstype);
+            assert(topython);
+            object = topython(colbuffer->tdstype,
+                              data,
+                              colbuffer->size);
+        }
+
+        if (stats)
+        {
+            stats->conversion_time += Clock_monotonic() - start;
+        }
+
+        if (!object)
+        {
+            return NULL;
+        }
+
+        /* A converter may have (indirectly) accessed this column already. */
+        if (row->values[ix])
+        {
+            Py_DECREF(object);
+        }
+        else
+        {
+            row->values[ix] = object; /* object reference stolen */
+
+            /* Release the raw row data once all columns are converted. */
+            if (0 == --row->nunconverted)
+            {
+                ResultSetDescription_RowBuffer_free(row->description, row->rowbuffer);
+                row->rowbuffer = NULL;
+            }
+        }
+    }
+    return row->values[ix];
+}
+
+static PyObject* Row_lookup_column(PyObject* self, PyObject* item, PyObject* error)
+{
+    struct Row* row = (struct Row*)self;
+    PyObject* value = NULL;
+    const char* name = NULL;
+    size_t ix;
+
+#if PY_MAJOR_VERSION < 3
+    PyObject* utf8item = NULL;
+    if (PyUnicode_Check(item))
+    {
+        utf8item = PyUnicode_AsUTF8String(item);
+        if (!utf8item)
+        {
+            return NULL;
+        }
+        name = PyString_AS_STRING(utf8item);
+    }
+    else
+    {
+        if (PyString_Check(item))
+        {
+            name = PyString_AS_STRING(item);
+        }
+    }
+#else /* if PY_MAJOR_VERSION < 3 */
+    if (PyUnicode_Check(item))
+    {
+        name = PyUnicode_AsUTF8(item);
+    }
+#endif /* else if PY_MAJOR_VERSION < 3 */
+
+    if (name)
+    {
+        for (ix = 0; ix < row->description->ncolumns; ++ix)
+        {
+            if (0 == strcmp(name, row->description->columns[ix].dbcol.ActualName))
+            {
+                value = Row_value(row, ix);
+                Py_XINCREF(value);
+                break;
+            }
+        }
+    }
+
+#if PY_MAJOR_VERSION < 3
+    Py_XDECREF(utf8item);
+#endif /* if PY_MAJOR_VERSION < 3 */
+
+    if (!value && error != NULL && !PyErr_Occurred())
+    {
+        PyErr_SetObject(error, item);
+    }
+    return value;
+}
+
+static Py_ssize_t Row_len(PyObject* self)
+{
+    struct Row* row = (struct Row*)self;
+    return (Py_ssize_t)row->description->ncolumns;
+}
+
+static PyObject* Row_item(PyObject* self, Py_ssize_t ix)
+{
+    struct Row* row = (struct Row*)self;
+    PyObject* value;
+    if (ix < 0 || ix >= (Py_ssize_t)row->description->ncolumns)
+    {
+        PyErr_SetString(PyExc_IndexError, "index is out of range");
+        return NULL;
+    }
+    value = Row_value(row, (size_t)ix);
+    Py_XINCREF(value);
+    return value;
+}
+
+static int Row_contains(PyObject* self, PyObject* value)
+{
+    PyObject* item = Row_lookup_column(self, value, NULL);
+    int contains = (NULL != item) ? 1 : ((PyErr_Occurred()) ? -1 : 0);
+    Py_XDECREF(item);
+    return contains;
+}
+
+PyTypeObject* RowType_init(void)
+{
+    if (0 != PyType_Ready(&RowType))
+    {
+        return NULL;
+    }
+    return &RowType;
+}
+
+static PySequenceMethods s_Row_as_sequence = {
+    Row_len,      /* sq_length */
+    NULL,         /* sq_concat */
+    NULL,         /* sq_repeat */
+    Row_item,     /* sq_item */
+    NULL,         /* sq_ass_item */
+    NULL,         /* was_sq_slice */
+    NULL,         /* was_sq_ass_slice */
+    Row_contains, /* sq_contains */
+    NULL,         /* sq_inplace_concat */
+    NULL,         /* sq_inplace_repeat */
+};
+
+static PyObject* Row_subscript(PyObject* self, PyObject* item)
+{
+    if (PyUnicode_Check(item)
+#if PY_MAJOR_VERSION < 3
+        || PyString_Check(item)
+#endif /* if PY_MAJOR_VERSION < 3 */
+    )
+    {
+        return Row_lookup_column(self, item, PyExc_KeyError);
+    }
+    else if (PyLong_Check(item))
+    {
+        Py_ssize_t ix = PyLong_AsSsize_t(item);
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+        return Row_item(self, ix);
+    }
+#if PY_MAJOR_VERSION < 3
+    else if (PyInt_Check(item))
+    {
+        return Row_item(self, PyInt_AsSsize_t(item));
+    }
+#endif /* if PY_MAJOR_VERSION < 3 */
+
+    PyErr_SetObject(PyExc_KeyError, item);
+    return NULL;
+}
+
+static PyMappingMethods s_Row_as_mapping = {
+    Row_len,       /* mp_length */
+    Row_subscript, /* mp_subscript */
+    NULL,          /* mp_ass_subscript */
+};
+
+static PyObject* Row_getattro(PyObject* self, PyObject* attr)
+{
+    PyObject* value = Row_lookup_column(self, attr, NULL);
+    if (!value && !PyErr_Occurred())
+    {
+        value = PyObject_GenericGetAttr(self, attr);
+    }
+    return value;
+}
+
+static PyObject* Row_description_get(PyObject* self, void* closure)
+{
+    struct Row* row = (struct Row*)self;
     return ResultSetDescription_get_object(row->description);
 
     UNUSED(closure);
@@ -2892,8 +4394,12 @@ static PyObject* Row_dict(PyObject* self, PyObject* args)
             assert((Py_ssize_t)ncolumns == PyTuple_GET_SIZE(description));
             for (ix = 0; ix < ncolumns; ++ix)
             {
-                PyObject* value = row->values[ix];
+                PyObject* value = Row_value(row, ix);
                 PyObject* colname = Description_GET_ITEM(PyTuple_GET_ITEM(description, ix), 0);
+                if (!value)
+                {
+                    break;
+                }
                 if (0 == PyObject_IsTrue(colname))
                 {
                     /* Use the column number as the key for unnamed columns. */
@@ -3001,12 +4507,254 @@ PyTypeObject RowType = {
 #endif /* if PY_VERSION_HEX >= 0x03080000 */
 };
 
-/* Stores the `struct RowBuffer` for a row until requested by the client. */
-struct LazilyCreatedRow {
+/*
+    Raw row data written to a temporary file once the memory budget of
+    Cursor.fetchall() is exceeded. The file is mapped read-only and rows are
+    copied out of the mapping as they are accessed.
+
+    Each spilled row is stored as a sequence of columns, each column being the
+    header of its `struct ColumnBuffer` followed by `size` bytes of data.
+*/
+struct RowSpill {
+    /* The temporary file. It is removed automatically when closed. */
+    FILE* file;
+
+    /* The read-only mapping of `file`. */
+    const char* data;
+    size_t size;
+};
+
+/* The size of the column header written to the spill file. */
+#define RowSpill_HEADER_SIZE offsetof(struct ColumnBuffer, data)
+
+/* The column size written to the spill file for NULL variable length values. */
+#define RowSpill_NULL_SIZE ((size_t)-1)
+
+/*
+    Write a row to a spill file.
+
+    @note This method does not require the GIL.
+
+    @param file [in] The spill file.
+    @param description [in] A description of the result set for the `rowbuffer`.
+    @param rowbuffer [in] The row to write.
+
+    @return The number of bytes written.
+    @return 0 on failure; consult errno for the system failure.
+*/
+static size_t RowSpill_write(FILE* file,
+                             const struct ResultSetDescription* description,
+                             const struct RowBuffer* rowbuffer)
+{
+    size_t written = 0;
+    const struct ColumnBuffer* column = rowbuffer->columns;
+    size_t ix;
+    for (ix = 0; ix < description->ncolumns; ++ix)
+    {
+        const DBCOL* dbcol = &description->columns[ix].dbcol;
+        const void* data = (Column_IsVariableLength(dbcol)) ?
+            column->data.variable : (const void*)&column->data.fixed;
+
+        struct ColumnBuffer header;
+        memcpy(&header, column, RowSpill_HEADER_SIZE);
+        if (!data)
+        {
+            header.size = RowSpill_NULL_SIZE;
+        }
+
+        if ((1 != fwrite(&header, RowSpill_HEADER_SIZE, 1, file)) ||
+            (column->size && (1 != fwrite(data, column->size, 1, file))))
+        {
+            if (!errno)
+            {
+                errno = EIO;
+            }
+            return 0;
+        }
+        written += RowSpill_HEADER_SIZE + column->size;
+
+        column = (const struct ColumnBuffer*)((const char*)column + ColumnBuffer_size(dbcol));
+    }
+    return written;
+}
+
+/*
+    Release a spill file and its mapping.
+
+    @param spill [in] The spill file.
+*/
+static void RowSpill_free(struct RowSpill* spill)
+{
+    if (spill)
+    {
+        if (spill->data)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(spill->data);
+#else /* if defined(_WIN32) */
+            munmap((void*)spill->data, spill->size);
+#endif /* else if defined(_WIN32) */
+        }
+        fclose(spill->file);
+        tds_mem_free(spill);
+    }
+}
+
+/*
+    Map a spill file, once all rows have been written to it.
+
+    @note This method does not require the GIL.
+    @note This method takes ownership of `file` on success only.
+
+    @param file [in] The spill file.
+    @param size [in] The number of bytes written to `file`.
+
+    @return The mapped spill file.
+    @return NULL on failure; consult errno for the system failure.
+*/
+static struct RowSpill* RowSpill_map(FILE* file, size_t size)
+{
+    struct RowSpill* spill;
+    void* data;
+
+    if (0 != fflush(file))
+    {
+        return NULL;
+    }
+
+#if defined(_WIN32)
+    {
+        HANDLE mapping = CreateFileMapping((HANDLE)_get_osfhandle(_fileno(file)),
+                                           NULL,
+                                           PAGE_READONLY,
+                                           0,
+                                           0,
+                                           NULL);
+        if (!mapping)
+        {
+            errno = EIO;
+            return NULL;
+        }
+        data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+        CloseHandle(mapping);
+        if (!data)
+        {
+            errno = ENOMEM;
+            return NULL;
+        }
+    }
+#else /* if defined(_WIN32) */
+    data = mmap(NULL, size, PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (MAP_FAILED == data)
+    {
+        return NULL;
+    }
+#endif /* else if defined(_WIN32) */
+
+    spill = tds_mem_malloc(sizeof(struct RowSpill));
+    if (!spill)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+#else /* if defined(_WIN32) */
+        munmap(data, size);
+#endif /* else if defined(_WIN32) */
+        errno = ENOMEM;
+        return NULL;
+    }
+    spill->file = file;
+    spill->data = (const char*)data;
+    spill->size = size;
+    return spill;
+}
+
+/*
+    Read a row from a spill file into a new RowBuffer.
+
+    @note This method sets an appropriate Python exception on error.
+
+    @param spill [in] The spill file.
+    @param description [in] A description of the result set for the spilled row.
+    @param offset [in] The offset of the row in the spill file.
+
+    @return The RowBuffer. The caller is responsible for freeing it.
+    @return NULL on failure.
+*/
+static struct RowBuffer* RowSpill_read(const struct RowSpill* spill,
+                                       const struct ResultSetDescription* description,
+                                       size_t offset)
+{
+    size_t rowsize = ResultSetDescription_RowBuffer_size(description);
+    struct RowBuffer* rowbuffer = tds_mem_tagged_malloc(rows, rowsize);
+    if (rowbuffer)
+    {
+        const char* data = spill->data + offset;
+        struct ColumnBuffer* column = rowbuffer->columns;
+        size_t ix;
+
+        memset(rowbuffer, 0, rowsize);
+        for (ix = 0; ix < description->ncolumns; ++ix)
+        {
+            const DBCOL* dbcol = &description->columns[ix].dbcol;
+            void* dest;
+
+            assert((size_t)(data - spill->data) + RowSpill_HEADER_SIZE <= spill->size);
+            memcpy(column, data, RowSpill_HEADER_SIZE);
+            data += RowSpill_HEADER_SIZE;
+
+            if (Column_IsVariableLength(dbcol))
+            {
+                if (RowSpill_NULL_SIZE == column->size)
+                {
+                    column->size = 0;
+                }
+                else
+                {
+                    /* Empty values must still have a non-NULL buffer. */
+                    column->data.variable = tds_mem_tagged_malloc(rows, column->size ? column->size : 1);
+                    if (!column->data.variable)
+                    {
+                        ResultSetDescription_RowBuffer_free(description, rowbuffer);
+                        PyErr_NoMemory();
+                        return NULL;
+                    }
+                }
+                dest = column->data.variable;
+            }
+            else
+            {
+                dest = &column->data.fixed;
+            }
+            /* NULL values have no buffer to copy to. */
+            if (column->size)
+            {
+                memcpy(dest, data, column->size);
+                data += column->size;
+            }
+
+            column = (struct ColumnBuffer*)((char*)column + ColumnBuffer_size(dbcol));
+        }
+    }
+    else
+    {
+        PyErr_NoMemory();
+    }
+    return rowbuffer;
+}
+
+/*
+    Stores the `struct RowBuffer` for a row until requested by the client.
+    Rows spilled to the RowList's spill file are stored as an offset into the
+    file instead. Once converted, `python` is NULL if the row has been
+    consumed by RowList.drain().
+*/
+struct LazilyCreatedRow {
     bool converted;
+    bool spilled;
     union {
       PyObject* python;
       struct RowBuffer* rowbuffer;
+      size_t offset;
     } row;
 };
 
@@ -3020,6 +4768,9 @@ struct RowList {
 
     struct ResultSetDescription* description;
 
+    /* Rows spilled to disk by Cursor.fetchall(), if any. */
+    struct RowSpill* spill;
+
     struct LazilyCreatedRow rows[1]; /* space for rows is added by tp_alloc() */
 };
 
@@ -3031,24 +4782,43 @@ static void RowList_dealloc(PyObject* self)
     {
         if (rowlist->rows[ix].converted)
         {
-            Py_DECREF(rowlist->rows[ix].row.python);
+            Py_XDECREF(rowlist->rows[ix].row.python);
         }
-        else
+        else if (!rowlist->rows[ix].spilled)
         {
             ResultSetDescription_RowBuffer_free(rowlist->description,
                                                 rowlist->rows[ix].row.rowbuffer);
         }
     }
 
+    RowSpill_free(rowlist->spill);
     ResultSetDescription_decrement(rowlist->description);
 
     PyObject_Del(self);
 }
 
 PyTypeObject RowListType; /* forward decl. */
+
+/*
+    Create a RowList for buffered rows.
+
+    @note This method sets an appropriate Python exception on error.
+    @note This method takes ownership of `rowbuffers` and `spill` on success only.
+
+    @param description [in] A description of the result set.
+    @param nrows [in] The total number of rows.
+    @param rowbuffers [in] The rows buffered in memory.
+    @param spill [in] The spill file for the remaining rows, or NULL.
+    @param offsets [in] The offsets of the rows in `spill`.
+
+    @return The RowList object.
+    @return NULL on failure.
+*/
 static struct RowList* RowList_create(struct ResultSetDescription* description,
                                       size_t nrows,
-                                      struct RowBuffer* rowbuffers)
+                                      struct RowBuffer* rowbuffers,
+                                      struct RowSpill* spill,
+                                      const size_t* offsets)
 {
     struct RowList* rowlist = PyObject_NewVar(struct RowList, &RowListType, (Py_ssize_t)nrows);
     if (rowlist)
@@ -3058,14 +4828,29 @@ static struct RowList* RowList_create(struct ResultSetDescription* description,
         rowlist->description = description;
         ResultSetDescription_increment(description);
 
+        rowlist->spill = spill;
+
         while (rowbuffers)
         {
             rowlist->rows[ix].converted = false;
+            rowlist->rows[ix].spilled = false;
             rowlist->rows[ix].row.rowbuffer = rowbuffers;
             rowbuffers = rowbuffers->next;
             rowlist->rows[ix].row.rowbuffer->next = NULL;
             ++ix;
         }
+
+        /* Spilled rows always follow the rows buffered in memory. */
+        if (spill)
+        {
+            const size_t nbuffered = ix;
+            for (; ix < nrows; ++ix)
+            {
+                rowlist->rows[ix].converted = false;
+                rowlist->rows[ix].spilled = true;
+                rowlist->rows[ix].row.offset = offsets[ix - nbuffered];
+            }
+        }
         assert(ix == nrows);
     }
     else
@@ -3075,6 +4860,45 @@ static struct RowList* RowList_create(struct ResultSetDescription* description,
     return rowlist;
 }
 
+/*
+    Create the Row object for an unconverted row.
+
+    @note This method sets an appropriate Python exception on error.
+
+    @param rowlist [in] The RowList.
+    @param lazyrow [in] The unconverted row in `rowlist`.
+
+    @return The Row object.
+    @return NULL on failure.
+*/
+static struct Row* RowList_create_row(struct RowList* rowlist,
+                                      const struct LazilyCreatedRow* lazyrow)
+{
+    struct Row* row;
+    struct RowBuffer* rowbuffer;
+
+    assert(!lazyrow->converted);
+    if (lazyrow->spilled)
+    {
+        rowbuffer = RowSpill_read(rowlist->spill, rowlist->description, lazyrow->row.offset);
+        if (!rowbuffer)
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        rowbuffer = lazyrow->row.rowbuffer;
+    }
+
+    row = Row_create(rowlist->description, rowbuffer);
+    if (!row && lazyrow->spilled)
+    {
+        ResultSetDescription_RowBuffer_free(rowlist->description, rowbuffer);
+    }
+    return row;
+}
+
 static Py_ssize_t RowList_len(PyObject* self)
 {
     return Py_SIZE(self);
@@ -3096,71 +4920,96 @@ static PyObject* RowList_item(PyObject* self, Py_ssize_t ix)
     }
 
     /*
-        Convert the `struct RowBuffer` raw data to a Python object on
-        first access.
+        Wrap the `struct RowBuffer` raw data in a Python object on
+        first access. The row's columns are converted as they are accessed.
     */
     if (!rowlist->rows[ix].converted)
     {
-        struct RowBuffer* rowbuffer = rowlist->rows[ix].row.rowbuffer;
-        struct Row* row = Row_create(rowlist->description, rowbuffer);
+        struct Row* row = RowList_create_row(rowlist, &rowlist->rows[ix]);
         if (!row)
         {
             assert(PyErr_Occurred());
             return NULL;
         }
 
-        ResultSetDescription_RowBuffer_free(rowlist->description,
-                                            rowbuffer);
-
+        /* The row now owns the `struct RowBuffer`. */
         rowlist->rows[ix].row.python = (PyObject*)row; /* claim reference */
         rowlist->rows[ix].converted = true;
     }
+    else if (!rowlist->rows[ix].row.python)
+    {
+        PyErr_SetString(PyExc_tds_InterfaceError, "row has been consumed");
+        return NULL;
+    }
     Py_INCREF(rowlist->rows[ix].row.python);
     return rowlist->rows[ix].row.python;
 }
 
-static PyObject* RowList_description_get(PyObject* self, void* closure)
-{
-    struct RowList* rowlist = (struct RowList*)self;
-    return ResultSetDescription_get_object(rowlist->description);
+/* An iterator which consumes the rows of a RowList. */
+struct RowListDrain {
+    PyObject_HEAD
 
-    UNUSED(closure);
-}
+    struct RowList* rowlist;
 
-static PyGetSetDef RowList_getset[] = {
-    /* name, get, set, doc, closure */
-    { (char*)"description", RowList_description_get, NULL, (char*)s_Cursor_description_doc, NULL },
-    { NULL,                 NULL,                    NULL, NULL,                            NULL }
+    /* The index of the next row to return. */
+    Py_ssize_t ix;
 };
 
-PyTypeObject* RowListType_init(void)
+static void RowListDrain_dealloc(PyObject* self)
 {
-    if (0 != PyType_Ready(&RowListType))
+    Py_XDECREF(((struct RowListDrain*)self)->rowlist);
+    PyObject_Del(self);
+}
+
+static PyObject* RowListDrain_iter(PyObject* self)
+{
+    Py_INCREF(self);
+    return self;
+}
+
+static PyObject* RowListDrain_iternext(PyObject* self)
+{
+    struct RowListDrain* drain = (struct RowListDrain*)self;
+    struct RowList* rowlist = drain->rowlist;
+
+    while (drain->ix < Py_SIZE(rowlist))
     {
-        return NULL;
+        struct LazilyCreatedRow* lazyrow = &rowlist->rows[drain->ix];
+        PyObject* row;
+
+        if (lazyrow->converted)
+        {
+            row = lazyrow->row.python; /* claim reference */
+        }
+        else
+        {
+            row = (PyObject*)RowList_create_row(rowlist, lazyrow);
+            if (!row)
+            {
+                assert(PyErr_Occurred());
+                return NULL;
+            }
+            /* The row now owns the `struct RowBuffer`. */
+            lazyrow->converted = true;
+        }
+        lazyrow->row.python = NULL;
+
+        ++drain->ix;
+        if (row)
+        {
+            return row;
+        }
+        /* Skip rows already consumed by another iterator. */
     }
-    return &RowListType;
+    return NULL;
 }
 
-static PySequenceMethods s_RowList_as_sequence = {
-    RowList_len,  /* sq_length */
-    NULL,         /* sq_concat */
-    NULL,         /* sq_repeat */
-    RowList_item, /* sq_item */
-    NULL,         /* sq_ass_item */
-    NULL,         /* was_sq_slice */
-    NULL,         /* sq_contains */
-    NULL,         /* was_sq_ass_slice */
-    NULL,         /* sq_inplace_concat */
-    NULL,         /* sq_inplace_repeat */
-};
-
-PyTypeObject RowListType = {
+PyTypeObject RowListDrainType = {
     PyVarObject_HEAD_INIT(NULL, 0)
-    "ctds.RowList",                           /* tp_name */
-    sizeof(struct RowList),                   /* tp_basicsize */
-    sizeof(struct LazilyCreatedRow),          /* tp_itemsize */
-    RowList_dealloc,                          /* tp_dealloc */
+    "ctds.RowListDrain",                      /* tp_name */
+    sizeof(struct RowListDrain),              /* tp_basicsize */
+    0,                                        /* tp_itemsize */
+    RowListDrain_dealloc,                     /* tp_dealloc */
 #if PY_VERSION_HEX >= 0x03080000
     0,                                        /* tp_vectorcall_offset */
 #else
@@ -3171,7 +5020,7 @@ PyTypeObject RowListType = {
     NULL,                                     /* tp_reserved */
     NULL,                                     /* tp_repr */
     NULL,                                     /* tp_as_number */
-    &s_RowList_as_sequence,                   /* tp_as_sequence */
+    NULL,                                     /* tp_as_sequence */
     NULL,                                     /* tp_as_mapping */
     NULL,                                     /* tp_hash */
     NULL,                                     /* tp_call */
@@ -3180,16 +5029,16 @@ PyTypeObject RowListType = {
     NULL,                                     /* tp_setattro */
     NULL,                                     /* tp_as_buffer */
     Py_TPFLAGS_DEFAULT,                       /* tp_flags */
-    s_RowList_description_doc,                /* tp_doc */
+    NULL,                                     /* tp_doc */
     NULL,                                     /* tp_traverse */
     NULL,                                     /* tp_clear */
     NULL,                                     /* tp_richcompare */
     0,                                        /* tp_weaklistoffset */
-    NULL,                                     /* tp_iter */
-    NULL,                                     /* tp_iternext */
+    RowListDrain_iter,                        /* tp_iter */
+    RowListDrain_iternext,                    /* tp_iternext */
     NULL,                                     /* tp_methods */
     NULL,                                     /* tp_members */
-    RowList_getset,                           /* tp_getset */
+    NULL,                                     /* tp_getset */
     NULL,                                     /* tp_base */
     NULL,                                     /* tp_dict */
     NULL,                                     /* tp_descr_get */
@@ -3218,7 +5067,1001 @@ PyTypeObject RowListType = {
 #endif /* if PY_VERSION_HEX >= 0x03080000 */
 };
 
-#define FETCH_ALL ((size_t)-1)
+static const char s_RowList_drain_doc[] =
+    "drain()\n"
+    "\n"
+    "Get an iterator which consumes the rows in the list. Each row is removed\n"
+    "from the list as it is returned, allowing its memory to be released once\n"
+    "the caller no longer references it. Accessing a consumed row from the\n"
+    "list raises :py:exc:`ctds.InterfaceError`.\n"
+    "\n"
+    "This is useful for processing large result sets in a single pass without\n"
+    "retaining all rows in memory.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":return: An iterator of the rows in the list.\n";
+
+static PyObject* RowList_drain(PyObject* self, PyObject* args)
+{
+    struct RowListDrain* drain = PyObject_New(struct RowListDrain, &RowListDrainType);
+    if (!drain)
+    {
+        return PyErr_NoMemory();
+    }
+
+    Py_INCREF(self);
+    drain->rowlist = (struct RowList*)self;
+    drain->ix = 0;
+
+    return (PyObject*)drain;
+
+    UNUSED(args);
+}
+
+static PyMethodDef RowList_methods[] = {
+    /* ml_name, ml_meth, ml_flags, ml_doc */
+    { "drain", RowList_drain, METH_NOARGS, s_RowList_drain_doc },
+    { NULL,    NULL,          0,           NULL }
+};
+
+static PyObject* RowList_description_get(PyObject* self, void* closure)
+{
+    struct RowList* rowlist = (struct RowList*)self;
+    return ResultSetDescription_get_object(rowlist->description);
+
+    UNUSED(closure);
+}
+
+static PyGetSetDef RowList_getset[] = {
+    /* name, get, set, doc, closure */
+    { (char*)"description", RowList_description_get, NULL, (char*)s_Cursor_description_doc, NULL },
+    { NULL,                 NULL,                    NULL, NULL,                            NULL }
+};
+
+PyTypeObject* RowListType_init(void)
+{
+    if (0 != PyType_Ready(&RowListDrainType))
+    {
+        return NULL;
+    }
+    if (0 != PyType_Ready(&RowListType))
+    {
+        return NULL;
+    }
+    return &RowListType;
+}
+
+static PySequenceMethods s_RowList_as_sequence = {
+    RowList_len,  /* sq_length */
+    NULL,         /* sq_concat */
+    NULL,         /* sq_repeat */
+    RowList_item, /* sq_item */
+    NULL,         /* sq_ass_item */
+    NULL,         /* was_sq_slice */
+    NULL,         /* sq_contains */
+    NULL,         /* was_sq_ass_slice */
+    NULL,         /* sq_inplace_concat */
+    NULL,         /* sq_inplace_repeat */
+};
+
+PyTypeObject RowListType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "ctds.RowList",                           /* tp_name */
+    sizeof(struct RowList),                   /* tp_basicsize */
+    sizeof(struct LazilyCreatedRow),          /* tp_itemsize */
+    RowList_dealloc,                          /* tp_dealloc */
+#if PY_VERSION_HEX >= 0x03080000
+    0,                                        /* tp_vectorcall_offset */
+#else
+    NULL,                                     /* tp_print */
+#endif /* if PY_VERSION_HEX >= 0x03080000 */
+    NULL,                                     /* tp_getattr */
+    NULL,                                     /* tp_setattr */
+    NULL,                                     /* tp_reserved */
+    NULL,                                     /* tp_repr */
+    NULL,                                     /* tp_as_number */
+    &s_RowList_as_sequence,                   /* tp_as_sequence */
+    NULL,                                     /* tp_as_mapping */
+    NULL,                                     /* tp_hash */
+    NULL,                                     /* tp_call */
+    NULL,                                     /* tp_str */
+    NULL,                                     /* tp_getattro */
+    NULL,                                     /* tp_setattro */
+    NULL,                                     /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                       /* tp_flags */
+    s_RowList_description_doc,                /* tp_doc */
+    NULL,                                     /* tp_traverse */
+    NULL,                                     /* tp_clear */
+    NULL,                                     /* tp_richcompare */
+    0,                                        /* tp_weaklistoffset */
+    NULL,                                     /* tp_iter */
+    NULL,                                     /* tp_iternext */
+    RowList_methods,                          /* tp_methods */
+    NULL,                                     /* tp_members */
+    RowList_getset,                           /* tp_getset */
+    NULL,                                     /* tp_base */
+    NULL,                                     /* tp_dict */
+    NULL,                                     /* tp_descr_get */
+    NULL,                                     /* tp_descr_set */
+    0,                                        /* tp_dictoffset */
+    NULL,                                     /* tp_init */
+    NULL,                                     /* tp_alloc */
+    NULL,                                     /* tp_new */
+    NULL,                                     /* tp_free */
+    NULL,                                     /* tp_is_gc */
+    NULL,                                     /* tp_bases */
+    NULL,                                     /* tp_mro */
+    NULL,                                     /* tp_cache */
+    NULL,                                     /* tp_subclasses */
+    NULL,                                     /* tp_weaklist */
+    NULL,                                     /* tp_del */
+    0,                                        /* tp_version_tag */
+#if PY_VERSION_HEX >= 0x03040000
+    NULL,                                     /* tp_finalize */
+#endif /* if PY_VERSION_HEX >= 0x03040000 */
+#if PY_VERSION_HEX >= 0x03080000
+    NULL,                                     /* tp_vectorcall */
+#  if PY_VERSION_HEX < 0x03090000
+    NULL,                                     /* tp_print */
+#  endif /* if PY_VERSION_HEX < 0x03090000 */
+#endif /* if PY_VERSION_HEX >= 0x03080000 */
+};
+
+#define FETCH_ALL ((size_t)-1)
+#define MEMORY_UNLIMITED ((size_t)-1)
+
+/*
+    Copy a RowBuffer, including its variable length column data.
+
+    @note This method does not require the GIL.
+
+    @param description [in] A description of the result set for the `rowbuffer`.
+    @param rowbuffer [in] The row to copy.
+    @param memory [out] The bytes of memory used by the copy.
+
+    @return The copy. The caller is responsible for freeing it.
+    @return NULL on failure.
+*/
+static struct RowBuffer* RowBuffer_copy(const struct ResultSetDescription* description,
+                                        const struct RowBuffer* rowbuffer,
+                                        size_t* memory)
+{
+    size_t rowsize = ResultSetDescription_RowBuffer_size(description);
+    struct RowBuffer* copy = tds_mem_tagged_malloc(rows, rowsize);
+    if (copy)
+    {
+        size_t ix;
+
+        memcpy(copy, rowbuffer, rowsize);
+        copy->next = NULL;
+        *memory = rowsize;
+
+        /* Clear the variable length data pointers first for error cleanup. */
+        for (ix = 0; ix < description->ncolumns; ++ix)
+        {
+            if (Column_IsVariableLength(&description->columns[ix].dbcol))
+            {
+                ((struct ColumnBuffer*)((char*)copy->columns + description->columns[ix].offset))->data.variable = NULL;
+            }
+        }
+
+        for (ix = 0; ix < description->ncolumns; ++ix)
+        {
+            const struct ColumnBuffer* source =
+                (const struct ColumnBuffer*)((const char*)rowbuffer->columns + description->columns[ix].offset);
+            if (Column_IsVariableLength(&description->columns[ix].dbcol) && source->data.variable)
+            {
+                struct ColumnBuffer* column =
+                    (struct ColumnBuffer*)((char*)copy->columns + description->columns[ix].offset);
+
+                /* Empty values must still have a non-NULL buffer. */
+                column->data.variable = tds_mem_tagged_malloc(rows, (source->size) ? source->size : 1);
+                if (!column->data.variable)
+                {
+                    ResultSetDescription_RowBuffer_free(description, copy);
+                    return NULL;
+                }
+                memcpy(column->data.variable, source->data.variable, source->size);
+                *memory += source->size;
+            }
+        }
+    }
+    return copy;
+}
+
+/*
+    Serve a statement's result set from the result cache.
+
+    @note This method sets an appropriate Python exception on error.
+
+    @param cursor [in] The cursor.
+    @param cached [in] The cached rows, as returned by ResultCache_get().
+
+    @return 0 on success, -1 on error.
+*/
+static int Cursor_execute_cached(struct Cursor* cursor, PyObject* cached)
+{
+    struct RowList* rowlist = (struct RowList*)cached;
+
+    Connection_clear_lastwarning(cursor->connection);
+    Cursor_clear_resultset(cursor);
+    cursor->peeked = false;
+
+    /*
+        The cursor's converters are resolved on a copy of the description,
+        as the cached description is shared.
+    */
+    cursor->description = ResultSetDescription_copy(rowlist->description);
+    if (!cursor->description)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    Py_INCREF(cached);
+    cursor->cached = rowlist;
+
+    return Cursor_resolve_converters(cursor);
+}
+
+/*
+    Fetch rows of a result set served from the result cache.
+
+    @note This method sets an appropriate Python exception on error.
+    @note This method returns a new reference.
+
+    @param cursor [in] The cursor.
+    @param n [in] The number of rows to fetch.
+
+    @return A `struct RowList` object.
+    @return NULL on failure.
+*/
+static struct RowList* Cursor_fetch_cached(struct Cursor* cursor, size_t n)
+{
+    const struct RowList* cached = cursor->cached;
+    struct RowBuffer* rowbuffers = NULL;
+    struct RowBuffer* last_rowbuffer = NULL;
+    size_t rows = MIN(n, (size_t)Py_SIZE(cached) - cursor->rowsread);
+    size_t ix;
+
+    struct RowList* rowlist;
+
+    for (ix = cursor->rowsread; ix < cursor->rowsread + rows; ++ix)
+    {
+        size_t memory;
+        struct RowBuffer* rowbuffer = RowBuffer_copy(cached->description,
+                                                     cached->rows[ix].row.rowbuffer,
+                                                     &memory);
+        if (!rowbuffer)
+        {
+            ResultSetDescription_RowBuffer_free(cursor->description, rowbuffers);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        if (!rowbuffers)
+        {
+            rowbuffers = last_rowbuffer = rowbuffer;
+        }
+        else
+        {
+            last_rowbuffer->next = rowbuffer;
+            last_rowbuffer = rowbuffer;
+        }
+    }
+
+    rowlist = RowList_create(cursor->description, rows, rowbuffers, NULL, NULL);
+    if (!rowlist)
+    {
+        ResultSetDescription_RowBuffer_free(cursor->description, rowbuffers);
+        return NULL;
+    }
+    cursor->rowsread += rows;
+    return rowlist;
+}
+
+/*
+    Stop recording the current result set for the result cache.
+
+    @param cursor [in] The cursor.
+*/
+static void Cursor_cache_abandon(struct Cursor* cursor)
+{
+    cursor->caching = false;
+    ResultSetDescription_RowBuffer_free(cursor->description, cursor->cacherows);
+    cursor->cacherows = cursor->cachelast = NULL;
+    cursor->ncacherows = 0;
+    cursor->cachesize = 0;
+}
+
+/*
+    Read the statement's responses following the current, fully fetched,
+    result set to determine if it is the statement's last result set.
+
+    The result is recorded for Cursor_next_resultset().
+
+    @note This method requires the current thread own the GIL.
+
+    @param cursor [in] The cursor.
+
+    @return true if there are no further result sets.
+*/
+static bool Cursor_cache_peek(struct Cursor* cursor)
+{
+    DBPROCESS* dbproc = Connection_DBPROCESS(cursor->connection);
+    RETCODE retcode;
+
+    /* The prefetcher, if any, has read the last row. */
+    if (cursor->prefetcher)
+    {
+        Connection_set_background(cursor->connection, NULL, NULL);
+        Cursor_prefetch_stop(cursor);
+    }
+
+    cursor->peekcount = dbcount(dbproc);
+
+    Py_BEGIN_ALLOW_THREADS
+
+        do
+        {
+            retcode = dbresults(dbproc);
+        }
+        while ((SUCCEED == retcode) && (0 == dbnumcols(dbproc)));
+
+    Py_END_ALLOW_THREADS
+
+    cursor->peeked = true;
+    cursor->peekretcode = retcode;
+
+    return (NO_MORE_RESULTS == retcode);
+}
+
+/*
+    Record fetched rows for the result cache. Once all rows of the result
+    set have been fetched, the result set is added to the cache if it is the
+    statement's only result set.
+
+    Caching is best effort; the result set is not cached on any failure.
+
+    @note This method requires the current thread own the GIL.
+
+    @param cursor [in] The cursor.
+    @param rowbuffers [in] The fetched rows.
+    @param exhausted [in] Have all rows of the result set been fetched?
+*/
+static void Cursor_cache_rows(struct Cursor* cursor,
+                              const struct RowBuffer* rowbuffers,
+                              bool exhausted)
+{
+    struct ResultCache* result_cache = (struct ResultCache*)Connection_result_cache(cursor->connection);
+    struct RowList* rowlist;
+
+    if (!result_cache)
+    {
+        Cursor_cache_abandon(cursor);
+        return;
+    }
+
+    for (; rowbuffers; rowbuffers = rowbuffers->next)
+    {
+        size_t memory;
+        struct RowBuffer* rowbuffer = RowBuffer_copy(cursor->description, rowbuffers, &memory);
+        if (!rowbuffer)
+        {
+            Cursor_cache_abandon(cursor);
+            return;
+        }
+        if (!cursor->cacherows)
+        {
+            cursor->cacherows = cursor->cachelast = rowbuffer;
+        }
+        else
+        {
+            cursor->cachelast->next = rowbuffer;
+            cursor->cachelast = rowbuffer;
+        }
+        cursor->ncacherows++;
+        cursor->cachesize += memory;
+
+        /* Don't buffer results too large to be cached. */
+        if (cursor->cachesize > ResultCache_max_memory(result_cache))
+        {
+            Cursor_cache_abandon(cursor);
+            return;
+        }
+    }
+
+    if (exhausted)
+    {
+        if (!Cursor_cache_peek(cursor))
+        {
+            Cursor_cache_abandon(cursor);
+            return;
+        }
+
+        rowlist = RowList_create(cursor->description,
+                                 cursor->ncacherows,
+                                 cursor->cacherows,
+                                 NULL,
+                                 NULL);
+        if (rowlist)
+        {
+            /* The rowlist now owns the recorded rows. */
+            cursor->cacherows = cursor->cachelast = NULL;
+
+            if (0 != ResultCache_put(result_cache,
+                                     cursor->cachekey,
+                                     PyTuple_GET_ITEM(cursor->cachekey, 2),
+                                     (PyObject*)rowlist,
+                                     cursor->cachesize + ResultSetDescription_size(cursor->description->ncolumns)))
+            {
+                PyErr_Clear();
+            }
+            Py_DECREF(rowlist);
+        }
+        else
+        {
+            PyErr_Clear();
+        }
+        Cursor_cache_abandon(cursor);
+    }
+}
+
+/*
+    Read the current row of the result set into a new row buffer.
+
+    @note This method does not manipulate the GIL. Callers should release
+        the GIL when calling this method.
+
+    @param dbproc [in] The DB-Lib process.
+    @param description [in] A description of the result set.
+    @param rowsize [in] The row buffer size for the result set.
+    @param retcode [in] The dbnextrow() result for the current row.
+    @param memory [out] The bytes of memory used by the row.
+
+    @return The row buffer.
+    @return NULL if memory allocation failed.
+*/
+static struct RowBuffer* RowBuffer_read(DBPROCESS* dbproc,
+                                        const struct ResultSetDescription* description,
+                                        size_t rowsize,
+                                        RETCODE retcode,
+                                        size_t* memory)
+{
+    /* The offset to the next column buffer in the row. */
+    size_t offset = 0;
+
+    size_t colnum;
+
+    struct RowBuffer* rowbuffer = tds_mem_tagged_malloc(rows, rowsize);
+    if (!rowbuffer)
+    {
+        return NULL;
+    }
+    memset(rowbuffer, 0, rowsize);
+    *memory = rowsize;
+
+    for (colnum = 1; colnum <= description->ncolumns; ++colnum)
+    {
+        const struct Column* column = &description->columns[colnum - 1];
+        struct ColumnBuffer* colbuffer = (struct ColumnBuffer*)(((char*)rowbuffer->columns) + offset);
+
+        const BYTE* data;
+        DBINT ndata;
+
+        void* dest;
+
+        if (REG_ROW == retcode)
+        {
+            colbuffer->tdstype = (enum TdsType)column->dbcol.Type;
+            data = dbdata(dbproc, (DBINT)colnum);
+            ndata = dbdatlen(dbproc, (DBINT)colnum);
+        }
+        else
+        {
+            /* retcode is a compute ID. */
+            int type = dbalttype(dbproc, retcode, (DBINT)colnum);
+            if (-1 != type)
+            {
+                colbuffer->tdstype = (enum TdsType)type;
+                data = dbadata(dbproc, retcode, (DBINT)colnum);
+                ndata = dbadlen(dbproc, retcode, (DBINT)colnum);
+            }
+            else
+            {
+                /* For missing compute columns, return None. */
+                colbuffer->tdstype = (enum TdsType)column->dbcol.Type;
+                data = NULL;
+                ndata = 0;
+            }
+        }
+
+        if (Column_IsVariableLength(&column->dbcol))
+        {
+            /*
+                Allocate a buffer for the variable length data.
+                `data` will be NULL if the value is NULL.
+            */
+            if (data)
+            {
+                colbuffer->data.variable = tds_mem_tagged_malloc(rows, (size_t)ndata);
+                if (!colbuffer->data.variable)
+                {
+                    ResultSetDescription_RowBuffer_free(description, rowbuffer);
+                    return NULL;
+                }
+                *memory += (size_t)ndata;
+            }
+            dest = colbuffer->data.variable;
+        }
+        else
+        {
+            /* Fixed length data buffer was allocated as part of the row buffer. */
+            dest = &colbuffer->data.fixed;
+        }
+        colbuffer->size = (size_t)ndata;
+        memcpy(dest, data, colbuffer->size);
+
+        offset += ColumnBuffer_size(&column->dbcol);
+    }
+
+    return rowbuffer;
+}
+
+/*
+    Determine the bytes of memory used by a row buffer.
+
+    @param description [in] A description of the result set.
+    @param rowsize [in] The row buffer size for the result set.
+    @param rowbuffer [in] The row buffer.
+
+    @return The bytes of memory used by the row.
+*/
+static size_t RowBuffer_memory(const struct ResultSetDescription* description,
+                               size_t rowsize,
+                               const struct RowBuffer* rowbuffer)
+{
+    size_t memory = rowsize;
+    size_t ix;
+    for (ix = 0; ix < description->ncolumns; ++ix)
+    {
+        if (Column_IsVariableLength(&description->columns[ix].dbcol))
+        {
+            const struct ColumnBuffer* column =
+                (const struct ColumnBuffer*)((const char*)rowbuffer->columns + description->columns[ix].offset);
+            if (column->data.variable)
+            {
+                memory += column->size;
+            }
+        }
+    }
+    return memory;
+}
+
+/*
+    Determine the bytes of column data in a row buffer.
+
+    @param description [in] A description of the result set.
+    @param rowbuffer [in] The row buffer.
+
+    @return The bytes of column data.
+*/
+static size_t RowBuffer_datasize(const struct ResultSetDescription* description,
+                                 const struct RowBuffer* rowbuffer)
+{
+    size_t size = 0;
+    size_t ix;
+    for (ix = 0; ix < description->ncolumns; ++ix)
+    {
+        size += ((const struct ColumnBuffer*)((const char*)rowbuffer->columns + description->columns[ix].offset))->size;
+    }
+    return size;
+}
+
+/*
+    A background thread which reads the rows of a result set ahead of the
+    caller, so reading rows from the network overlaps with processing them
+    in Python.
+
+    Rows are read in batches and appended to a queue, which is bounded at
+    `capacity` rows. The reader thread never holds the GIL.
+
+    PyThread locks are used rather than condition variables as they are
+    available on all supported Python versions. A lock may be released by
+    any thread, so each is used as a binary event, which is only released
+    (signaled) when not already signaled. Waiters always re-check the
+    queue's state after being woken.
+*/
+struct Prefetch
+{
+    struct Connection* connection;
+    DBPROCESS* dbproc;
+    const struct ResultSetDescription* description;
+
+    /*
+        The messages and errors reported while reading rows. These are only
+        accessed by the reader thread.
+    */
+    struct ConnectionMessages* reported;
+
+    /* The number of rows read in each batch. */
+    size_t batchsize;
+
+    /* The maximum number of queued rows. */
+    size_t capacity;
+
+    /* Protects all following members. */
+    PyThread_type_lock mutex;
+
+    /* Signaled when rows are queued or the reader finishes. */
+    PyThread_type_lock ready;
+    bool ready_signaled;
+
+    /* Signaled when there is room in the queue for another batch. */
+    PyThread_type_lock space;
+    bool space_signaled;
+
+    /* The queued rows. */
+    struct RowBuffer* rowbuffers;
+    struct RowBuffer* last_rowbuffer;
+    size_t nrows;
+
+    /* Has the reader finished reading rows? */
+    bool done;
+
+    /* Should the reader stop reading rows? */
+    bool stop;
+
+    /* The final dbnextrow() result and errno-style error code of the reader. */
+    RETCODE retcode;
+    int error;
+
+    /*
+        The messages and errors reported to the reader, not yet recorded on
+        the connection.
+    */
+    struct ConnectionMessages* messages;
+
+    /* Released by the reader thread when it exits. */
+    PyThread_type_lock finished;
+};
+
+/*
+    Signal an event.
+
+    @note The prefetch mutex must be held when calling this method.
+*/
+static void Prefetch_signal(PyThread_type_lock event, bool* signaled)
+{
+    if (!*signaled)
+    {
+        *signaled = true;
+        PyThread_release_lock(event);
+    }
+}
+
+/*
+    Wait for an event to be signaled.
+
+    @note The prefetch mutex must be held when calling this method. It is
+        released while waiting.
+*/
+static void Prefetch_wait(struct Prefetch* prefetch, PyThread_type_lock event, bool* signaled)
+{
+    PyThread_release_lock(prefetch->mutex);
+    (void)PyThread_acquire_lock(event, WAIT_LOCK);
+    (void)PyThread_acquire_lock(prefetch->mutex, WAIT_LOCK);
+    *signaled = false;
+}
+
+/* The prefetch reader thread. */
+static void Prefetch_run(void* arg)
+{
+    struct Prefetch* prefetch = (struct Prefetch*)arg;
+    size_t rowsize = ResultSetDescription_RowBuffer_size(prefetch->description);
+    bool done = false;
+
+    /*
+        The message and error handlers are called by dbnextrow() on this
+        thread. Buffer their output rather than modifying the connection
+        while the GIL holder may be reading it.
+    */
+    Connection_redirect_messages(prefetch->reported);
+
+    while (!done)
+    {
+        struct RowBuffer* rowbuffers = NULL;
+        struct RowBuffer* last_rowbuffer = NULL;
+        RETCODE retcode = NO_MORE_ROWS;
+        int error = 0;
+        size_t rows;
+
+        for (rows = 0; rows < prefetch->batchsize; ++rows)
+        {
+            size_t memory;
+            struct RowBuffer* rowbuffer;
+
+            retcode = dbnextrow(prefetch->dbproc);
+            if ((NO_MORE_ROWS == retcode) || (FAIL == retcode))
+            {
+                break;
+            }
+            assert(BUF_FULL != retcode);
+
+            rowbuffer = RowBuffer_read(prefetch->dbproc, prefetch->description, rowsize, retcode, &memory);
+            if (!rowbuffer)
+            {
+                error = ENOMEM;
+                break;
+            }
+            if (!rowbuffers)
+            {
+                rowbuffers = last_rowbuffer = rowbuffer;
+            }
+            else
+            {
+                last_rowbuffer->next = rowbuffer;
+                last_rowbuffer = rowbuffer;
+            }
+        }
+
+        (void)PyThread_acquire_lock(prefetch->mutex, WAIT_LOCK);
+
+        if (rowbuffers)
+        {
+            if (!prefetch->rowbuffers)
+            {
+                prefetch->rowbuffers = rowbuffers;
+            }
+            else
+            {
+                prefetch->last_rowbuffer->next = rowbuffers;
+            }
+            prefetch->last_rowbuffer = last_rowbuffer;
+            prefetch->nrows += rows;
+        }
+        ConnectionMessages_move(prefetch->messages, prefetch->reported);
+
+        /* Wait for room in the queue for the next batch. */
+        while ((rows == prefetch->batchsize) && !prefetch->stop &&
+               (prefetch->nrows + prefetch->batchsize > prefetch->capacity))
+        {
+            Prefetch_signal(prefetch->ready, &prefetch->ready_signaled);
+            Prefetch_wait(prefetch, prefetch->space, &prefetch->space_signaled);
+        }
+
+        if ((rows < prefetch->batchsize) || prefetch->stop)
+        {
+            prefetch->done = done = true;
+            prefetch->retcode = retcode;
+            prefetch->error = error;
+        }
+        Prefetch_signal(prefetch->ready, &prefetch->ready_signaled);
+
+        PyThread_release_lock(prefetch->mutex);
+    }
+
+    Connection_redirect_messages(NULL);
+
+    /* The prefetch object may be freed once this is released. */
+    PyThread_release_lock(prefetch->finished);
+}
+
+/*
+    Record the messages and errors reported to the reader thread on the
+    connection.
+
+    @note This method requires the current thread own the GIL.
+*/
+static void Prefetch_merge_messages(struct Prefetch* prefetch)
+{
+    (void)PyThread_acquire_lock(prefetch->mutex, WAIT_LOCK);
+    Connection_merge_messages(prefetch->connection, prefetch->messages);
+    PyThread_release_lock(prefetch->mutex);
+}
+
+/*
+    Free a prefetch object, stopping the reader thread if running. Any
+    messages reported to the reader thread are recorded on the connection.
+
+    @note This method requires the current thread own the GIL. The GIL is
+        released while waiting for the reader thread to exit.
+*/
+static void Prefetch_free(struct Prefetch* prefetch, bool running)
+{
+    if (running)
+    {
+        (void)PyThread_acquire_lock(prefetch->mutex, WAIT_LOCK);
+        prefetch->stop = true;
+        Prefetch_signal(prefetch->space, &prefetch->space_signaled);
+        PyThread_release_lock(prefetch->mutex);
+
+        Py_BEGIN_ALLOW_THREADS
+
+            (void)PyThread_acquire_lock(prefetch->finished, WAIT_LOCK);
+
+        Py_END_ALLOW_THREADS
+
+        Connection_merge_messages(prefetch->connection, prefetch->messages);
+    }
+
+    ResultSetDescription_RowBuffer_free(prefetch->description, prefetch->rowbuffers);
+    ConnectionMessages_free(prefetch->reported);
+    ConnectionMessages_free(prefetch->messages);
+
+#define Prefetch_free_lock(_lock) \
+    if (_lock) \
+    { \
+        PyThread_free_lock(_lock); \
+    }
+
+    Prefetch_free_lock(prefetch->mutex);
+    Prefetch_free_lock(prefetch->ready);
+    Prefetch_free_lock(prefetch->space);
+    Prefetch_free_lock(prefetch->finished);
+
+#undef Prefetch_free_lock
+
+    tds_mem_free(prefetch);
+}
+
+/*
+    Start reading the rows of the current result set in a background thread.
+
+    @note This method requires the current thread own the GIL.
+
+    @param cursor [in] The cursor.
+    @param batchsize [in] The number of rows to read in each batch.
+    @param depth [in] The number of batches to queue.
+
+    @return The prefetch object.
+    @return NULL if the reader thread could not be started.
+*/
+static struct Prefetch* Prefetch_start(struct Cursor* cursor, size_t batchsize, size_t depth)
+{
+    struct Prefetch* prefetch = tds_mem_malloc(sizeof(struct Prefetch));
+    if (!prefetch)
+    {
+        return NULL;
+    }
+    memset(prefetch, 0, sizeof(struct Prefetch));
+
+    prefetch->connection = cursor->connection;
+    prefetch->dbproc = Connection_DBPROCESS(cursor->connection);
+    prefetch->description = cursor->description;
+    prefetch->batchsize = batchsize;
+    prefetch->capacity = (depth > ((size_t)-1) / batchsize) ? (size_t)-1 : (depth * batchsize);
+
+    do
+    {
+        prefetch->mutex = PyThread_allocate_lock();
+        prefetch->ready = PyThread_allocate_lock();
+        prefetch->space = PyThread_allocate_lock();
+        prefetch->finished = PyThread_allocate_lock();
+        if (!prefetch->mutex || !prefetch->ready || !prefetch->space || !prefetch->finished)
+        {
+            break;
+        }
+
+        prefetch->reported = ConnectionMessages_create();
+        prefetch->messages = ConnectionMessages_create();
+        if (!prefetch->reported || !prefetch->messages)
+        {
+            break;
+        }
+
+        /* Events and the `finished` lock start out unsignaled. */
+        (void)PyThread_acquire_lock(prefetch->ready, WAIT_LOCK);
+        (void)PyThread_acquire_lock(prefetch->space, WAIT_LOCK);
+        (void)PyThread_acquire_lock(prefetch->finished, WAIT_LOCK);
+
+        if (-1 == (long)PyThread_start_new_thread(Prefetch_run, prefetch))
+        {
+            break;
+        }
+
+        return prefetch;
+    }
+    while (0);
+
+    Prefetch_free(prefetch, false);
+    return NULL;
+}
+
+/*
+    Take the next row from the prefetch queue, waiting for the reader
+    thread if necessary.
+
+    @note This method does not manipulate the GIL. Callers should release
+        the GIL when calling this method.
+
+    @param prefetch [in] The prefetch object.
+    @param retcode [out] REG_ROW if a row was returned, otherwise the final
+        dbnextrow() result of the reader thread.
+    @param error [out] The errno-style error code of the reader thread, if
+        no row was returned.
+
+    @return The row buffer.
+    @return NULL if there are no more rows.
+*/
+static struct RowBuffer* Prefetch_next(struct Prefetch* prefetch, RETCODE* retcode, int* error)
+{
+    struct RowBuffer* rowbuffer = NULL;
+
+    (void)PyThread_acquire_lock(prefetch->mutex, WAIT_LOCK);
+
+    while (!prefetch->nrows && !prefetch->done)
+    {
+        Prefetch_wait(prefetch, prefetch->ready, &prefetch->ready_signaled);
+    }
+
+    if (prefetch->nrows)
+    {
+        rowbuffer = prefetch->rowbuffers;
+        prefetch->rowbuffers = rowbuffer->next;
+        rowbuffer->next = NULL;
+        prefetch->nrows--;
+        *retcode = REG_ROW;
+
+        if (prefetch->nrows + prefetch->batchsize <= prefetch->capacity)
+        {
+            Prefetch_signal(prefetch->space, &prefetch->space_signaled);
+        }
+    }
+    else
+    {
+        *retcode = prefetch->retcode;
+        *error = prefetch->error;
+    }
+
+    PyThread_release_lock(prefetch->mutex);
+
+    return rowbuffer;
+}
+
+/*
+    Stop the background reader of a cursor's current result set, discarding
+    any rows it has read.
+
+    @note This method requires the current thread own the GIL.
+
+    @param cursor [in] The cursor.
+*/
+static void Cursor_prefetch_stop(void* cursor)
+{
+    struct Prefetch* prefetcher = ((struct Cursor*)cursor)->prefetcher;
+    ((struct Cursor*)cursor)->prefetcher = NULL;
+    Prefetch_free(prefetcher, true);
+}
+
+static const char s_prefetch_discarded[] = "prefetched rows discarded by another operation on the connection";
+static const char s_memory_discarded[] = "rows discarded when the memory limit set by ctds.set_memory_limit() was exceeded";
+
+/*
+    Stop the background reader of a cursor's current result set when
+    another operation uses the connection. If any rows of the result set
+    are discarded, the next fetch from the cursor fails rather than
+    silently skipping them.
+
+    @note This method requires the current thread own the GIL.
+
+    @param cursor [in] The cursor.
+*/
+static void Cursor_prefetch_discard(void* cursor)
+{
+    struct Prefetch* prefetcher = ((struct Cursor*)cursor)->prefetcher;
+    bool discarded;
+
+    (void)PyThread_acquire_lock(prefetcher->mutex, WAIT_LOCK);
+    discarded = (prefetcher->nrows || !prefetcher->done || (NO_MORE_ROWS != prefetcher->retcode));
+    PyThread_release_lock(prefetcher->mutex);
+
+    if (discarded)
+    {
+        ((struct Cursor*)cursor)->discarded = s_prefetch_discarded;
+    }
+    Cursor_prefetch_stop(cursor);
+}
 
 /*
     Fetch rows for the current result set.
@@ -3234,11 +6077,16 @@ PyTypeObject RowListType = {
 
     @param cursor [in] The cursor.
     @param n [in] The number of rows to fetch from the server.
+    @param max_memory [in] The maximum number of bytes of raw row data to
+        buffer in memory. Any remaining rows are spilled to a temporary file.
+        Rows are also spilled once the process-wide memory limit set by
+        `ctds.set_memory_limit()` is exceeded, unless this is
+        MEMORY_UNLIMITED, in which case the fetch fails instead.
 
     @return A `struct RowList` object.
     @return NULL on failure.
 */
-static struct RowList* Cursor_fetchrows(struct Cursor* cursor, size_t n)
+static struct RowList* Cursor_fetchrows_untraced(struct Cursor* cursor, size_t n, size_t max_memory)
 {
     RETCODE retcode = NO_MORE_ROWS;
 
@@ -3247,10 +6095,29 @@ static struct RowList* Cursor_fetchrows(struct Cursor* cursor, size_t n)
     struct ResultSetDescription* description = cursor->description;
     size_t rowsize = ResultSetDescription_RowBuffer_size(description);
 
+    /* Rows which exceed `max_memory` are spilled to a temporary file. */
+    struct RowSpill* spill = NULL;
+    size_t* offsets = NULL; /* offsets of the spilled rows */
+
+    /* The errno-style error code of any failure while fetching rows. */
+    int error = 0;
+
+    /* Was the fetch stopped by the process-wide memory limit? */
+    bool limited = false;
+
     size_t rows; /* count of rows processed */
 
+    struct RowList* rowlist;
+
+    struct Prefetch* prefetcher;
+
     DBPROCESS* dbproc = Connection_DBPROCESS(cursor->connection);
 
+    struct ConnectionStats* stats;
+    size_t received = 0; /* bytes of column data read */
+    double start;
+    double elapsed;
+
     /* Verify there are results */
     if (!cursor->description)
     {
@@ -3258,137 +6125,331 @@ static struct RowList* Cursor_fetchrows(struct Cursor* cursor, size_t n)
         return NULL;
     }
 
+    if (cursor->cached)
+    {
+        return Cursor_fetch_cached(cursor, n);
+    }
+
+    if (cursor->discarded)
+    {
+        PyErr_Format(PyExc_tds_InterfaceError, "%s", cursor->discarded);
+        return NULL;
+    }
+
+    if (!cursor->prefetcher)
+    {
+        /* Another cursor may be reading from the connection in the background. */
+        Connection_stop_background(cursor->connection);
+
+        /*
+            Start reading rows ahead in the background, if enabled. If the
+            reader thread cannot be started, rows are read synchronously.
+        */
+        if (cursor->prefetch)
+        {
+            cursor->prefetcher = Prefetch_start(cursor,
+                                                (size_t)((cursor->arraysize) ? cursor->arraysize : 1),
+                                                (size_t)cursor->prefetch);
+            if (cursor->prefetcher)
+            {
+                Connection_set_background(cursor->connection, Cursor_prefetch_discard, cursor);
+            }
+        }
+    }
+    prefetcher = cursor->prefetcher;
+
+    start = Clock_monotonic();
+
     Py_BEGIN_ALLOW_THREADS
     {
         struct RowBuffer* last_rowbuffer = NULL;
-        size_t colnum;
+        size_t buffered = 0; /* bytes of row data buffered in memory */
+
+        /* Is the process-wide memory limit exceeded? */
+        bool exceeded = false;
+
+        FILE* spillfile = NULL;
+        size_t spillsize = 0;
+        size_t noffsets = 0;
+        size_t capacity = 0;
+
         for (rows = 0; rows < n || FETCH_ALL == n; ++rows)
         {
-            /* The offset to the next column buffer in the row. */
-            size_t offset = 0;
+            /* The bytes of memory used by the row. */
+            size_t rowmemory;
 
             struct RowBuffer* new_rowbuffer;
 
-            retcode = dbnextrow(dbproc);
-            if ((NO_MORE_ROWS == retcode) || (FAIL == retcode))
-            {
-                break;
-            }
-            assert(BUF_FULL != retcode);
-
-            new_rowbuffer = tds_mem_malloc(rowsize);
-            if (!new_rowbuffer)
+            /*
+                Check the process-wide memory limit before reading each row,
+                so no unread row is lost when failing.
+            */
+            if (!spillfile && Memory_limit_exceeded())
             {
-                ResultSetDescription_RowBuffer_free(description, rowbuffers);
-                rowbuffers = NULL;
-                break;
+                if (MEMORY_UNLIMITED == max_memory)
+                {
+                    /* Rows remain to be read. */
+                    retcode = REG_ROW;
+                    limited = true;
+                    break;
+                }
+                exceeded = true;
             }
-            memset(new_rowbuffer, 0, rowsize);
 
-            if (!rowbuffers)
+            if (prefetcher)
             {
-                rowbuffers = last_rowbuffer = new_rowbuffer;
+                new_rowbuffer = Prefetch_next(prefetcher, &retcode, &error);
+                if (!new_rowbuffer)
+                {
+                    break;
+                }
+                rowmemory = RowBuffer_memory(description, rowsize, new_rowbuffer);
             }
             else
             {
-                last_rowbuffer->next = new_rowbuffer;
-                last_rowbuffer = new_rowbuffer;
+                retcode = dbnextrow(dbproc);
+                if ((NO_MORE_ROWS == retcode) || (FAIL == retcode))
+                {
+                    break;
+                }
+                assert(BUF_FULL != retcode);
+
+                new_rowbuffer = RowBuffer_read(dbproc, description, rowsize, retcode, &rowmemory);
+                if (!new_rowbuffer)
+                {
+                    error = ENOMEM;
+                    break;
+                }
             }
+            received += RowBuffer_datasize(description, new_rowbuffer);
 
-            for (colnum = 1; colnum <= description->ncolumns; ++colnum)
+            /*
+                Once the memory budget or limit is exceeded, this and all
+                following rows are spilled to preserve the row order.
+            */
+            if (spillfile || exceeded || (rowmemory > (max_memory - buffered)))
             {
-                const struct Column* column = &description->columns[colnum - 1];
-                struct ColumnBuffer* colbuffer = (struct ColumnBuffer*)(((char*)last_rowbuffer->columns) + offset);
+                size_t written;
 
-                const BYTE* data;
-                DBINT ndata;
-
-                void* dest;
-
-                if (REG_ROW == retcode)
+                errno = 0;
+                if (!spillfile)
                 {
-                    colbuffer->tdstype = (enum TdsType)column->dbcol.Type;
-                    data = dbdata(dbproc, (DBINT)colnum);
-                    ndata = dbdatlen(dbproc, (DBINT)colnum);
+                    spillfile = tmpfile();
+                    if (!spillfile)
+                    {
+                        error = (errno) ? errno : EIO;
+                    }
                 }
-                else
+                if (!error && (noffsets == capacity))
                 {
-                    /* retcode is a compute ID. */
-                    int type = dbalttype(dbproc, retcode, (DBINT)colnum);
-                    if (-1 != type)
+                    size_t new_capacity = (capacity) ? (capacity * 2) : 64;
+                    size_t* new_offsets = tds_mem_realloc(offsets, new_capacity * sizeof(size_t));
+                    if (new_offsets)
                     {
-                        colbuffer->tdstype = (enum TdsType)type;
-                        data = dbadata(dbproc, retcode, (DBINT)colnum);
-                        ndata = dbadlen(dbproc, retcode, (DBINT)colnum);
+                        offsets = new_offsets;
+                        capacity = new_capacity;
                     }
                     else
                     {
-                        /* For missing compute columns, return None. */
-                        colbuffer->tdstype = (enum TdsType)column->dbcol.Type;
-                        data = NULL;
-                        ndata = 0;
+                        error = ENOMEM;
                     }
                 }
-
-                if (Column_IsVariableLength(&column->dbcol))
+                if (!error)
                 {
-                    /*
-                        Allocate a buffer for the variable length data.
-                        `data` will be NULL if the value is NULL.
-                    */
-                    if (data)
+                    written = RowSpill_write(spillfile, description, new_rowbuffer);
+                    if (written)
                     {
-                        colbuffer->data.variable = tds_mem_malloc((size_t)ndata);
-                        if (!colbuffer->data.variable)
-                        {
-                            ResultSetDescription_RowBuffer_free(description, rowbuffers);
-                            rowbuffers = NULL;
-                            break;
-                        }
+                        offsets[noffsets++] = spillsize;
+                        spillsize += written;
                     }
-                    dest = colbuffer->data.variable;
+                    else
+                    {
+                        error = errno;
+                    }
+                }
+
+                ResultSetDescription_RowBuffer_free(description, new_rowbuffer);
+                if (error)
+                {
+                    break;
+                }
+            }
+            else
+            {
+                if (!rowbuffers)
+                {
+                    rowbuffers = last_rowbuffer = new_rowbuffer;
                 }
                 else
                 {
-                    /* Fixed length data buffer was allocated as part of the row buffer. */
-                    dest = &colbuffer->data.fixed;
+                    last_rowbuffer->next = new_rowbuffer;
+                    last_rowbuffer = new_rowbuffer;
                 }
-                colbuffer->size = (size_t)ndata;
-                memcpy(dest, data, colbuffer->size);
+                buffered += rowmemory;
+            }
+        }
 
-                offset += ColumnBuffer_size(&column->dbcol);
+        if (spillfile)
+        {
+            if (!error && (FAIL != retcode))
+            {
+                errno = 0;
+                spill = RowSpill_map(spillfile, spillsize);
+                if (spill)
+                {
+                    spillfile = NULL; /* owned by `spill` */
+                }
+                else
+                {
+                    error = (errno) ? errno : EIO;
+                }
+            }
+            if (spillfile)
+            {
+                fclose(spillfile);
             }
         }
     }
     Py_END_ALLOW_THREADS
 
+    if (prefetcher)
+    {
+        /* Record any messages or errors reported to the reader thread. */
+        Prefetch_merge_messages(prefetcher);
+    }
+
+    PROBE3(fetch_batch, cursor, rows, received);
+
     /* Update the rows read count before returning any errors. */
     cursor->rowsread += rows;
 
-    if (NO_MORE_ROWS != retcode)
+    elapsed = Clock_monotonic() - start;
+
+    stats = Connection_stats(cursor->connection);
+    stats->rows += rows;
+    stats->bytes_received += received;
+    stats->fetch_time += elapsed;
+
+    if (!(cursor->fetchtime < 0))
     {
-        if (!rowbuffers)
+        cursor->fetchtime += elapsed;
+        if (NO_MORE_ROWS == retcode)
         {
-            PyErr_NoMemory();
-            return NULL;
+            Latency_record_seconds(LatencyMetric_fetch, cursor->fetchtime);
+            if (cursor->slowquery.fetching)
+            {
+                Cursor_slowlog_finish(cursor, false);
+            }
+            cursor->fetchtime = -1;
         }
     }
 
-    if (FAIL == retcode)
+    if (cursor->statement)
     {
-        ResultSetDescription_RowBuffer_free(description, rowbuffers);
-        Connection_raise_lasterror(cursor->connection);
-        return NULL;
+        Statements_add_rows(cursor->statement, rows);
     }
 
-    /* Raise any warning messages which may have occurred. */
-    if (0 != Connection_raise_lastwarning(cursor->connection))
+    do
     {
-        assert(PyErr_Occurred());
-        return NULL;
+        if (error)
+        {
+            if (ENOMEM == error)
+            {
+                PyErr_NoMemory();
+            }
+            else
+            {
+                errno = error;
+                PyErr_SetFromErrno(PyExc_OSError);
+            }
+            break;
+        }
+
+        if (FAIL == retcode)
+        {
+            Connection_raise_lasterror(cursor->connection);
+            break;
+        }
+
+        /*
+            Return the rows read before the memory limit was exceeded, if
+            any, unless all rows were requested.
+        */
+        if (limited && (!rows || (FETCH_ALL == n)))
+        {
+            if (rows)
+            {
+                /*
+                    The rows already read are freed rather than held past the
+                    limit, so fail any later fetch from the result set instead
+                    of silently returning the rows following them.
+                */
+                cursor->discarded = s_memory_discarded;
+                if (cursor->caching)
+                {
+                    Cursor_cache_abandon(cursor);
+                }
+            }
+            PyErr_SetString(PyExc_MemoryError, "memory limit set by ctds.set_memory_limit() exceeded");
+            break;
+        }
+
+        /* Raise any warning messages which may have occurred. */
+        if (0 != Connection_raise_lastwarning(cursor->connection))
+        {
+            assert(PyErr_Occurred());
+            break;
+        }
+
+        if (cursor->caching)
+        {
+            /* Results spilled to disk are not cached. */
+            if (spill)
+            {
+                Cursor_cache_abandon(cursor);
+            }
+            else
+            {
+                Cursor_cache_rows(cursor, rowbuffers, (NO_MORE_ROWS == retcode));
+            }
+        }
+
+        rowlist = RowList_create(description, rows, rowbuffers, spill, offsets);
+        if (!rowlist)
+        {
+            break;
+        }
+
+        tds_mem_free(offsets);
+        return rowlist;
+    }
+    while (0);
+
+    ResultSetDescription_RowBuffer_free(description, rowbuffers);
+    RowSpill_free(spill);
+    tds_mem_free(offsets);
+    return NULL;
+}
+
+/*
+    Fetch rows from the server, as by Cursor_fetchrows_untraced(), calling
+    the trace hooks if set.
+*/
+static struct RowList* Cursor_fetchrows(struct Cursor* cursor, size_t n, size_t max_memory)
+{
+    struct TraceSpan span;
+    struct RowList* rowlist;
+
+    if (!Trace_hooks)
+    {
+        return Cursor_fetchrows_untraced(cursor, n, max_memory);
     }
 
-    return RowList_create(description, rows, rowbuffers);
+    Trace_begin(&span, TraceOperation_fetch, NULL, cursor->connection);
+    rowlist = Cursor_fetchrows_untraced(cursor, n, max_memory);
+    Trace_end(&span, (rowlist) ? Py_SIZE((PyObject*)rowlist) : -1);
+
+    return rowlist;
 }
 
 
@@ -3412,7 +6473,7 @@ static PyObject* Cursor_fetchone(PyObject* self, PyObject* args)
     Cursor_verify_open(cursor);
     Cursor_verify_connection_open(cursor);
 
-    rowlist = Cursor_fetchrows(cursor, 1);
+    rowlist = Cursor_fetchrows(cursor, 1, MEMORY_UNLIMITED);
     if (rowlist)
     {
         if (Py_SIZE(rowlist) > 0)
@@ -3460,29 +6521,146 @@ static PyObject* Cursor_fetchmany(PyObject* self, PyObject* args, PyObject* kwar
     Cursor_verify_open(cursor);
     Cursor_verify_connection_open(cursor);
 
-    return (PyObject*)Cursor_fetchrows(cursor, (size_t)((size) ? size : cursor->arraysize));
+    return (PyObject*)Cursor_fetchrows(cursor, (size_t)((size) ? size : cursor->arraysize), MEMORY_UNLIMITED);
 }
 
 /* https://www.python.org/dev/peps/pep-0249/#fetchall */
 static const char s_Cursor_fetchall_doc[] =
-    "fetchall()\n"
+    "fetchall(max_memory=None)\n"
     "\n"
     "Fetch all (remaining) rows of a query result, returning them as a\n"
     "sequence of sequences.\n"
     "\n"
     ":pep:`0249#fetchall`\n"
     "\n"
+    "If `max_memory` is specified, at most `max_memory` bytes of raw row data\n"
+    "are buffered in memory. Any remaining rows are written to an anonymous\n"
+    "temporary file, which is memory-mapped and read from as the rows are\n"
+    "accessed.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "    The `max_memory` parameter.\n"
+    "\n"
+    ":param int max_memory: The maximum number of bytes of raw row data to\n"
+    "    buffer in memory. By default all rows are buffered in memory.\n"
     ":return: A sequence of result rows.\n"
     ":rtype: ctds.RowList\n";
 
-static PyObject* Cursor_fetchall(PyObject* self, PyObject* args)
+static PyObject* Cursor_fetchall(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    struct Cursor* cursor = (struct Cursor*)self;
+
+    static char* s_kwlist[] =
+    {
+        "max_memory",
+        NULL
+    };
+    PyObject* max_memory = Py_None;
+    size_t budget = MEMORY_UNLIMITED;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", s_kwlist, &max_memory))
+    {
+        return NULL;
+    }
+
+    if (Py_None != max_memory)
+    {
+        if (!(
+#if PY_MAJOR_VERSION < 3
+                 PyInt_Check(max_memory) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+                 PyLong_Check(max_memory)
+           ) || PyBool_Check(max_memory))
+        {
+            PyErr_SetObject(PyExc_TypeError, max_memory);
+            return NULL;
+        }
+#if PY_MAJOR_VERSION < 3
+        if (PyInt_Check(max_memory))
+        {
+            Py_ssize_t value = PyInt_AsSsize_t(max_memory);
+            if (value < 0)
+            {
+                PyErr_SetObject(PyExc_ValueError, max_memory);
+                return NULL;
+            }
+            budget = (size_t)value;
+        }
+        else
+#endif /* if PY_MAJOR_VERSION < 3 */
+        {
+            budget = PyLong_AsSize_t(max_memory);
+        }
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+    }
+
+    Cursor_verify_open(cursor);
+    Cursor_verify_connection_open(cursor);
+
+    return (PyObject*)Cursor_fetchrows(cursor, FETCH_ALL, budget);
+}
+
+static const char s_Cursor_fetch_async_doc[] =
+    "fetch_async(size=None)\n"
+    "\n"
+    "Fetch rows of a query result without blocking an :py:mod:`asyncio`\n"
+    "event loop. The rows are fetched by :py:meth:`.fetchmany` or, if `size`\n"
+    "is not specified, :py:meth:`.fetchall`, run in the event loop's default\n"
+    "executor.\n"
+    "\n"
+    ".. note:: Requires Python 3.5 or later.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param int size: The maximum number of rows to fetch. By default all\n"
+    "    remaining rows are fetched.\n"
+    ":return: An awaitable resolving to a sequence of result rows.\n"
+    ":rtype: asyncio.Future\n";
+
+static PyObject* Cursor_fetch_async(PyObject* self, PyObject* args, PyObject* kwargs)
 {
+    PyObject* fetch;
+    PyObject* aioargs;
+    PyObject* future;
+
     struct Cursor* cursor = (struct Cursor*)self;
+
+    static char* s_kwlist[] =
+    {
+        "size",
+        NULL
+    };
+    PyObject* size = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", s_kwlist, &size))
+    {
+        return NULL;
+    }
     Cursor_verify_open(cursor);
     Cursor_verify_connection_open(cursor);
 
-    return (PyObject*)Cursor_fetchrows(cursor, FETCH_ALL);
-    UNUSED(args);
+    fetch = PyObject_GetAttrString(self, (Py_None == size) ? "fetchall" : "fetchmany");
+    if (!fetch)
+    {
+        return NULL;
+    }
+    if (Py_None == size)
+    {
+        aioargs = Py_BuildValue("(N)", fetch); /* fetch reference stolen by Py_BuildValue */
+    }
+    else
+    {
+        aioargs = Py_BuildValue("(NO)", fetch, size); /* fetch reference stolen by Py_BuildValue */
+    }
+    if (!aioargs)
+    {
+        return NULL;
+    }
+    future = Cursor_aio_call("run", aioargs);
+    Py_DECREF(aioargs);
+
+    return future;
 }
 
 /* https://www.python.org/dev/peps/pep-0249/#nextset */
@@ -3503,11 +6681,23 @@ static PyObject* Cursor_nextset(PyObject* self, PyObject* args)
 {
     RETCODE retcode;
     int error;
+    double start;
 
     struct Cursor* cursor = (struct Cursor*)self;
     Cursor_verify_open(cursor);
     Cursor_verify_connection_open(cursor);
+
+    /* Only the first result set of a statement is cached. */
+    if (cursor->cached)
+    {
+        Cursor_clear_resultset(cursor);
+        Py_RETURN_NONE;
+    }
+
     Cursor_clear_resultset(cursor);
+    Connection_stop_background(cursor->connection);
+
+    start = Clock_monotonic();
 
     Py_BEGIN_ALLOW_THREADS
 
@@ -3515,6 +6705,8 @@ static PyObject* Cursor_nextset(PyObject* self, PyObject* args)
 
     Py_END_ALLOW_THREADS
 
+    Connection_stats(cursor->connection)->response_time += Clock_monotonic() - start;
+
     if (error)
     {
         if (FAIL == retcode)
@@ -3529,6 +6721,11 @@ static PyObject* Cursor_nextset(PyObject* self, PyObject* args)
         return NULL;
     }
 
+    if (0 != Cursor_resolve_converters(cursor))
+    {
+        return NULL;
+    }
+
     if (cursor->description)
     {
         Py_RETURN_TRUE;
@@ -3652,15 +6849,15 @@ static PyMethodDef Cursor_methods[] = {
     /* DB API-2.0 required methods. */
     { "callproc",      Cursor_callproc,              METH_VARARGS,                  s_Cursor_callproc_doc },
     { "close",         Cursor_close,                 METH_NOARGS,                   s_Cursor_close_doc },
-    { "execute",       Cursor_execute,               METH_VARARGS,                  s_Cursor_execute_doc },
+    { "execute",       (PyCFunction)Cursor_execute,  METH_VARARGS | METH_KEYWORDS, s_Cursor_execute_doc },
     { "executemany",   Cursor_executemany,           METH_VARARGS,                  s_Cursor_executemany_doc },
     { "fetchone",      Cursor_fetchone,              METH_NOARGS,                   s_Cursor_fetchone_doc },
     /*
-        fetchmany does not have *args, but the flag is required for kwargs to function properly.
+        fetchmany and fetchall do not have *args, but the flag is required for kwargs to function properly.
         See https://bugs.python.org/issue15657.
     */
     { "fetchmany",     (PyCFunction)Cursor_fetchmany, METH_VARARGS | METH_KEYWORDS, s_Cursor_fetchmany_doc },
-    { "fetchall",      Cursor_fetchall,               METH_NOARGS,                  s_Cursor_fetchall_doc },
+    { "fetchall",      (PyCFunction)Cursor_fetchall,  METH_VARARGS | METH_KEYWORDS, s_Cursor_fetchall_doc },
     { "nextset",       Cursor_nextset,                METH_NOARGS,                  s_Cursor_nextset_doc },
     { "setinputsizes", Cursor_setinputsizes,          METH_VARARGS,                 s_Cursor_setinputsizes_doc },
     { "setoutputsize", Cursor_setoutputsize,          METH_VARARGS,                 s_Cursor_setoutputsize_doc },
@@ -3674,6 +6871,8 @@ static PyMethodDef Cursor_methods[] = {
     /* Non-DB API 2.0 methods. */
     { "__enter__",     Cursor___enter__,             METH_NOARGS,                   s_Cursor___enter___doc },
     { "__exit__",      Cursor___exit__,              METH_VARARGS,                  s_Cursor___exit___doc },
+    { "execute_async", Cursor_execute_async,         METH_VARARGS,                  s_Cursor_execute_async_doc },
+    { "fetch_async",   (PyCFunction)Cursor_fetch_async, METH_VARARGS | METH_KEYWORDS, s_Cursor_fetch_async_doc },
     { NULL,            NULL,                         0,                             NULL }
 };
 
@@ -3696,7 +6895,398 @@ static PyObject* Cursor_iternext(PyObject* self)
     return Cursor_next_internal(self, NULL);
 }
 
-PyObject* Cursor_create(struct Connection* connection, enum ParamStyle paramstyle)
+/* A statement executed by Cursor_execute_parallel(). */
+struct ParallelQuery
+{
+    /* The cursor the statement was sent on. NULL if sending failed. */
+    struct Cursor* cursor;
+
+    /* The result of the statement, as set by Cursor_execute_parallel(). */
+    PyObject* result;
+
+    /* The buffered rows of the first result set. */
+    struct RowBuffer* rowbuffers;
+    size_t nrows;
+
+    /*
+        The bytes of column data read and the time, in seconds, spent waiting
+        for the response and reading rows, for the connection's counters.
+    */
+    size_t received;
+    double response_time;
+    double fetch_time;
+
+    /* The final dblib result and errno-style error code. */
+    RETCODE retcode;
+    int error;
+
+    /* Released when the statement has completed. */
+    PyThread_type_lock finished;
+};
+
+/*
+    Read the response to a statement sent by Cursor_execute_parallel() and
+    buffer the rows of its first result set.
+
+    @note This method does not manipulate the GIL and is run on its own
+        thread, concurrently with other statements.
+*/
+static void ParallelQuery_run(void* arg)
+{
+    struct ParallelQuery* query = (struct ParallelQuery*)arg;
+    struct Cursor* cursor = query->cursor;
+    DBPROCESS* dbproc = Connection_DBPROCESS(cursor->connection);
+    double start = Clock_monotonic();
+    double responded = 0;
+
+    do
+    {
+        struct RowBuffer* last_rowbuffer = NULL;
+        size_t rowsize;
+
+        query->retcode = dbsqlok(dbproc);
+        if (FAIL == query->retcode)
+        {
+            break;
+        }
+
+        if (0 != Cursor_next_resultset(cursor, &query->retcode))
+        {
+            if (FAIL != query->retcode)
+            {
+                query->error = ENOMEM;
+            }
+            break;
+        }
+        responded = Clock_monotonic();
+        if (!cursor->description)
+        {
+            break;
+        }
+
+        rowsize = ResultSetDescription_RowBuffer_size(cursor->description);
+        for (;;)
+        {
+            size_t memory;
+            struct RowBuffer* rowbuffer;
+
+            query->retcode = dbnextrow(dbproc);
+            if ((NO_MORE_ROWS == query->retcode) || (FAIL == query->retcode))
+            {
+                break;
+            }
+            assert(BUF_FULL != query->retcode);
+
+            rowbuffer = RowBuffer_read(dbproc, cursor->description, rowsize, query->retcode, &memory);
+            if (!rowbuffer)
+            {
+                query->error = ENOMEM;
+                break;
+            }
+            if (!query->rowbuffers)
+            {
+                query->rowbuffers = last_rowbuffer = rowbuffer;
+            }
+            else
+            {
+                last_rowbuffer->next = rowbuffer;
+                last_rowbuffer = rowbuffer;
+            }
+            query->nrows++;
+            query->received += RowBuffer_datasize(cursor->description, rowbuffer);
+        }
+    }
+    while (0);
+
+    if (responded)
+    {
+        query->response_time = responded - start;
+        query->fetch_time = Clock_monotonic() - responded;
+    }
+    else
+    {
+        query->response_time = Clock_monotonic() - start;
+    }
+
+    if (query->finished)
+    {
+        PyThread_release_lock(query->finished);
+    }
+}
+
+/*
+    Convert the current Python exception into the result of a statement.
+*/
+static void ParallelQuery_set_error(struct ParallelQuery* query)
+{
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+
+    PyErr_Fetch(&type, &value, &traceback);
+    PyErr_NormalizeException(&type, &value, &traceback);
+    Py_XDECREF(type);
+    Py_XDECREF(traceback);
+
+    Py_XDECREF(query->result);
+    query->result = value; /* claim reference */
+}
+
+/*
+    Build the result of a completed statement.
+
+    @note This method requires the current thread own the GIL.
+*/
+static void ParallelQuery_complete(struct ParallelQuery* query)
+{
+    struct Cursor* cursor = query->cursor;
+    struct ConnectionStats* stats = Connection_stats(cursor->connection);
+
+    stats->rows += query->nrows;
+    stats->bytes_received += query->received;
+    stats->response_time += query->response_time;
+    stats->fetch_time += query->fetch_time;
+    Latency_record_seconds(LatencyMetric_round_trip, query->response_time);
+
+    do
+    {
+        if (FAIL == query->retcode)
+        {
+            Connection_raise_lasterror(cursor->connection);
+            break;
+        }
+        if (query->error)
+        {
+            PyErr_NoMemory();
+            break;
+        }
+
+        if (0 != Cursor_resolve_converters(cursor))
+        {
+            break;
+        }
+
+        /* Raise any warnings that may have occurred. */
+        if (0 != Connection_raise_lastwarning(cursor->connection))
+        {
+            break;
+        }
+
+        if (cursor->description)
+        {
+            struct RowList* rowlist = RowList_create(cursor->description,
+                                                     query->nrows,
+                                                     query->rowbuffers,
+                                                     NULL,
+                                                     NULL);
+            if (!rowlist)
+            {
+                break;
+            }
+            query->rowbuffers = NULL; /* owned by `rowlist` */
+            query->result = (PyObject*)rowlist;
+        }
+        else
+        {
+            Py_INCREF(Py_None);
+            query->result = Py_None;
+        }
+    }
+    while (0);
+
+    if (PyErr_Occurred())
+    {
+        ParallelQuery_set_error(query);
+    }
+}
+
+PyObject* Cursor_execute_parallel(PyObject* queries)
+{
+    PyObject* sequence;
+    Py_ssize_t nqueries;
+    Py_ssize_t ix;
+
+    struct ParallelQuery* parallel = NULL;
+    PyObject* results = NULL;
+
+    sequence = PySequence_Fast(queries, "queries must be a sequence");
+    if (!sequence)
+    {
+        return NULL;
+    }
+    nqueries = PySequence_Fast_GET_SIZE(sequence);
+
+    do
+    {
+        /* Validate all queries before sending any statement. */
+        for (ix = 0; ix < nqueries; ++ix)
+        {
+            PyObject* query = PySequence_Fast_GET_ITEM(sequence, ix);
+            Py_ssize_t jx;
+
+            if (!PyTuple_Check(query) ||
+                (PyTuple_GET_SIZE(query) < 2) || (PyTuple_GET_SIZE(query) > 3) ||
+                !PyObject_TypeCheck(PyTuple_GET_ITEM(query, 0), &ConnectionType))
+            {
+                PyErr_SetObject(PyExc_TypeError, query);
+                break;
+            }
+
+            /* A connection can only execute one statement at a time. */
+            for (jx = 0; jx < ix; ++jx)
+            {
+                if (PyTuple_GET_ITEM(PySequence_Fast_GET_ITEM(sequence, jx), 0) ==
+                    PyTuple_GET_ITEM(query, 0))
+                {
+                    PyErr_Format(PyExc_ValueError,
+                                 "connection used by more than one query at index %ld",
+                                 (long)ix);
+                    break;
+                }
+            }
+            if (PyErr_Occurred())
+            {
+                break;
+            }
+        }
+        if (PyErr_Occurred())
+        {
+            break;
+        }
+
+        parallel = tds_mem_calloc((size_t)MAX(nqueries, 1), sizeof(struct ParallelQuery));
+        if (!parallel)
+        {
+            PyErr_NoMemory();
+            break;
+        }
+
+        /* Send each statement. Failures are reported as the query's result. */
+        for (ix = 0; ix < nqueries; ++ix)
+        {
+            PyObject* query = PySequence_Fast_GET_ITEM(sequence, ix);
+            PyObject* args;
+            PyObject* cursor;
+
+            do
+            {
+                PyObject* executed;
+
+                cursor = PyObject_CallMethod(PyTuple_GET_ITEM(query, 0), "cursor", NULL);
+                if (!cursor)
+                {
+                    break;
+                }
+
+                args = PyTuple_GetSlice(query, 1, PyTuple_GET_SIZE(query));
+                if (!args)
+                {
+                    break;
+                }
+
+                ((struct Cursor*)cursor)->deferred = true;
+                executed = Cursor_execute_untraced(cursor, args, NULL);
+                ((struct Cursor*)cursor)->deferred = false;
+                Py_DECREF(args);
+
+                if (!executed)
+                {
+                    break;
+                }
+                Py_DECREF(executed);
+
+                parallel[ix].cursor = (struct Cursor*)cursor; /* claim reference */
+                cursor = NULL;
+            }
+            while (0);
+
+            Py_XDECREF(cursor);
+            if (PyErr_Occurred())
+            {
+                ParallelQuery_set_error(&parallel[ix]);
+            }
+        }
+
+        /*
+            Read the responses concurrently, each on its own thread. If a
+            thread cannot be started, the response is read once the others
+            have been started.
+        */
+        Py_BEGIN_ALLOW_THREADS
+
+            for (ix = 0; ix < nqueries; ++ix)
+            {
+                if (parallel[ix].cursor)
+                {
+                    parallel[ix].finished = PyThread_allocate_lock();
+                    if (parallel[ix].finished)
+                    {
+                        (void)PyThread_acquire_lock(parallel[ix].finished, WAIT_LOCK);
+                        if (-1 == (long)PyThread_start_new_thread(ParallelQuery_run, &parallel[ix]))
+                        {
+                            PyThread_free_lock(parallel[ix].finished);
+                            parallel[ix].finished = NULL;
+                        }
+                    }
+                }
+            }
+
+            for (ix = 0; ix < nqueries; ++ix)
+            {
+                if (parallel[ix].cursor)
+                {
+                    if (parallel[ix].finished)
+                    {
+                        (void)PyThread_acquire_lock(parallel[ix].finished, WAIT_LOCK);
+                        PyThread_free_lock(parallel[ix].finished);
+                        parallel[ix].finished = NULL;
+                    }
+                    else
+                    {
+                        ParallelQuery_run(&parallel[ix]);
+                    }
+                }
+            }
+
+        Py_END_ALLOW_THREADS
+
+        /* Build the results on the calling thread. */
+        results = PyList_New(nqueries);
+        if (!results)
+        {
+            break;
+        }
+        for (ix = 0; ix < nqueries; ++ix)
+        {
+            if (parallel[ix].cursor)
+            {
+                ParallelQuery_complete(&parallel[ix]);
+            }
+            PyList_SET_ITEM(results, ix, parallel[ix].result); /* reference stolen by PyList_SET_ITEM */
+            parallel[ix].result = NULL;
+        }
+    }
+    while (0);
+
+    if (parallel)
+    {
+        for (ix = 0; ix < nqueries; ++ix)
+        {
+            Py_XDECREF(parallel[ix].result);
+            if (parallel[ix].cursor)
+            {
+                ResultSetDescription_RowBuffer_free(parallel[ix].cursor->description, parallel[ix].rowbuffers);
+                Py_DECREF((PyObject*)parallel[ix].cursor);
+            }
+        }
+        tds_mem_free(parallel);
+    }
+    Py_DECREF(sequence);
+
+    return results;
+}
+
+PyObject* Cursor_create(struct Connection* connection, enum ParamStyle paramstyle, PyObject* converters)
 {
     struct Cursor* cursor = PyObject_New(struct Cursor, &CursorType);
     if (NULL != cursor)
@@ -3712,6 +7302,9 @@ PyObject* Cursor_create(struct Connection* connection, enum ParamStyle paramstyl
 
         cursor->paramstyle = paramstyle;
 
+        Py_XINCREF(converters);
+        cursor->converters = converters;
+
         Py_INCREF((PyObject*)connection);
         cursor->connection = connection;
     }
@@ -0,0 +1,162 @@
+'''
+Parallel, range-partitioned extraction of large result sets.
+'''
+import csv
+import threading
+
+try:
+    import queue
+except ImportError: # pragma: nocover
+    import Queue as queue # pylint: disable=import-error
+
+
+def parallel_extract( # pylint: disable=too-many-arguments
+        connect_kwargs,
+        sql_template,
+        key_ranges,
+        workers=4,
+        sink=None,
+        batch_size=10000
+):
+    '''
+    Extract rows using multiple connections concurrently, running a SQL
+    statement once for each range of keys.
+
+    Each worker opens its own connection with :py:func:`ctds.connect` and
+    runs `sql_template` for the key ranges it takes from a shared queue.
+    Rows are fetched in batches of `batch_size` using
+    :py:meth:`ctds.Cursor.fetchmany`, which reads and buffers rows from the
+    network without holding the GIL, so reads on all connections proceed in
+    parallel. Each batch is then passed to `sink` while the next batch is
+    read, as by :py:attr:`ctds.Cursor.prefetch`.
+
+    Calls to `sink` are serialized, but batches from different key ranges
+    may be delivered in any order. If a worker fails, the remaining workers
+    stop after their current batch and the exception is raised.
+
+    .. code-block:: python
+
+        with open('table.csv', 'w') as stream:
+            ctds.parallel_extract(
+                {'server': 'my-host', 'database': 'MyDatabase'},
+                'SELECT * FROM MyTable WHERE Id >= :0 AND Id < :1',
+                [(low, low + 1000000) for low in range(0, 500000000, 1000000)],
+                workers=8,
+                sink=ctds.extract.CsvSink(stream)
+            )
+
+    .. versionadded:: 1.15
+
+    :param dict connect_kwargs: The keyword arguments to pass to
+        :py:func:`ctds.connect` when opening each connection.
+    :param str sql_template: The SQL statement to execute for each key range.
+    :param key_ranges: The parameters to execute `sql_template` with, one
+        for each range of keys.
+    :type key_ranges: :ref:`typeiter <python:typeiter>`
+    :param int workers: The number of connections to extract with.
+    :param sink: A callable called with the key range and a
+        :py:class:`ctds.RowList` for each batch of rows. If not specified,
+        rows are discarded.
+    :param int batch_size: The maximum number of rows in each batch.
+    :return: The total number of rows extracted.
+    :rtype: int
+    '''
+    import ctds # pylint: disable=import-outside-toplevel,cyclic-import
+
+    if workers < 1:
+        raise ValueError(workers)
+
+    ranges = queue.Queue()
+    for key_range in key_ranges:
+        ranges.put(key_range)
+
+    lock = threading.Lock()
+    stop = threading.Event()
+    errors = []
+    counts = []
+
+    def _work():
+        count = 0
+        try:
+            with ctds.connect(**connect_kwargs) as connection:
+                with connection.cursor() as cursor:
+                    cursor.arraysize = batch_size
+                    # Read the next batch while the sink processes the current one.
+                    cursor.prefetch = 1
+                    while not stop.is_set():
+                        try:
+                            key_range = ranges.get_nowait()
+                        except queue.Empty:
+                            break
+                        cursor.execute(sql_template, key_range)
+                        while not stop.is_set():
+                            rows = cursor.fetchmany()
+                            if not rows:
+                                break
+                            count += len(rows)
+                            if sink is not None:
+                                with lock:
+                                    sink(key_range, rows)
+        except Exception as ex: # pylint: disable=broad-except
+            stop.set()
+            with lock:
+                errors.append(ex)
+        finally:
+            with lock:
+                counts.append(count)
+
+    threads = [
+        threading.Thread(target=_work, name='ctds-extract-{0}'.format(index))
+        for index in range(min(workers, max(ranges.qsize(), 1)))
+    ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    if errors:
+        raise errors[0]
+    return sum(counts)
+
+
+class ColumnarSink(object): # pylint: disable=useless-object-inheritance,too-few-public-methods
+    '''
+    A :py:func:`parallel_extract` sink which collects rows into a list of
+    values for each column.
+
+    .. versionadded:: 1.15
+
+    :ivar dict columns: A list of values for each column, keyed by column
+        name.
+    '''
+
+    def __init__(self):
+        self.columns = {}
+        self._lists = None
+
+    def __call__(self, key_range, rows): # pylint: disable=unused-argument
+        if self._lists is None:
+            self._lists = []
+            for column in rows.description:
+                self._lists.append(self.columns.setdefault(column[0], []))
+        for row in rows:
+            for index, values in enumerate(self._lists):
+                values.append(row[index])
+
+
+class CsvSink(object): # pylint: disable=useless-object-inheritance,too-few-public-methods
+    '''
+    A :py:func:`parallel_extract` sink which writes rows to a file using a
+    :py:func:`csv.writer`.
+
+    .. versionadded:: 1.15
+
+    :param stream: The file-like object to write to.
+    :param fmtparams: Formatting parameters passed to :py:func:`csv.writer`.
+    '''
+
+    def __init__(self, stream, **fmtparams):
+        self._writer = csv.writer(stream, **fmtparams)
+
+    def __call__(self, key_range, rows): # pylint: disable=unused-argument
+        self._writer.writerows(tuple(row) for row in rows)
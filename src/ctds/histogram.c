@@ -0,0 +1,100 @@
+#include "include/histogram.h"
+
+#define HISTOGRAM_SUB_BUCKETS ((uint64_t)1 << HISTOGRAM_SUB_BITS)
+
+static size_t Histogram_bucket(uint64_t value)
+{
+    unsigned int exponent = HISTOGRAM_MIN_EXPONENT;
+
+    if (value < ((uint64_t)1 << HISTOGRAM_MIN_EXPONENT))
+    {
+        return 0;
+    }
+    if (value >= ((uint64_t)1 << HISTOGRAM_MAX_EXPONENT))
+    {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+
+    /* Find the most significant bit. */
+    while (value >> (exponent + 1))
+    {
+        ++exponent;
+    }
+
+    return 1 +
+        ((size_t)(exponent - HISTOGRAM_MIN_EXPONENT) << HISTOGRAM_SUB_BITS) +
+        (size_t)((value >> (exponent - HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+void Histogram_record(struct Histogram* histogram, uint64_t value)
+{
+    if (!histogram->count || (value < histogram->min))
+    {
+        histogram->min = value;
+    }
+    if (value > histogram->max)
+    {
+        histogram->max = value;
+    }
+    histogram->count++;
+    histogram->sum += value;
+    histogram->buckets[Histogram_bucket(value)]++;
+}
+
+uint64_t Histogram_bucket_bound(size_t bucket)
+{
+    unsigned int exponent;
+    uint64_t sub;
+
+    if (0 == bucket)
+    {
+        return (uint64_t)1 << HISTOGRAM_MIN_EXPONENT;
+    }
+    if (bucket >= HISTOGRAM_BUCKETS - 1)
+    {
+        return UINT64_MAX;
+    }
+
+    exponent = HISTOGRAM_MIN_EXPONENT + (unsigned int)((bucket - 1) >> HISTOGRAM_SUB_BITS);
+    sub = (uint64_t)((bucket - 1) & (HISTOGRAM_SUB_BUCKETS - 1));
+    return ((uint64_t)1 << exponent) + ((sub + 1) << (exponent - HISTOGRAM_SUB_BITS));
+}
+
+uint64_t Histogram_percentile(const struct Histogram* histogram, double percentile)
+{
+    uint64_t rank;
+    uint64_t seen = 0;
+    size_t ix;
+
+    if (!histogram->count)
+    {
+        return 0;
+    }
+
+    /* The rank of the value at the percentile, starting at 1. */
+    rank = (uint64_t)((percentile / 100.0) * (double)histogram->count + 0.5);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+
+    for (ix = 0; ix < HISTOGRAM_BUCKETS; ++ix)
+    {
+        seen += histogram->buckets[ix];
+        if (seen >= rank)
+        {
+            uint64_t bound = Histogram_bucket_bound(ix);
+            if (bound > histogram->max)
+            {
+                return histogram->max;
+            }
+            if (bound < histogram->min)
+            {
+                return histogram->min;
+            }
+            return bound;
+        }
+    }
+
+    return histogram->max;
+}
@@ -0,0 +1,50 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+#include "type.h"
+
+/*
+    Server-free entry points for benchmarking the type conversions, exposed
+    as the internal `ctds._bench` module.
+*/
+
+/**
+    Time the conversion of raw column data to Python objects, as done when
+    fetching rows.
+
+    @note This method sets an appropriate Python exception on failure.
+    @note This method returns a new reference.
+
+    @param tdstype [in] The TDS type of the data.
+    @param data [in] The raw data, as a bytes object, or a sequence of bytes
+        objects (or None, for NULL values) which are converted in turn.
+        Values of fixed-width types must be of the type's width.
+    @param n [in] The number of conversions. Must be at least 1.
+    @param converter [in] The name of a built-in native converter to use,
+        or None for the default conversion of `tdstype`.
+
+    @return A tuple of the elapsed time, in seconds, and the result of the
+        last conversion, or NULL on error.
+*/
+PyObject* Bench_convert(enum TdsType tdstype, PyObject* data, Py_ssize_t n, PyObject* converter);
+
+/**
+    Time the conversion of a Python object to its TDS representation, as
+    done when binding statement parameters.
+
+    @note This method sets an appropriate Python exception on failure.
+    @note This method returns a new reference.
+
+    @param value [in] The Python object, or a `ctds.Sql*` type wrapper.
+    @param n [in] The number of conversions. Must be at least 1.
+
+    @return A tuple of the elapsed time, in seconds, and the SQL type the
+        value was converted to, or NULL on error.
+*/
+PyObject* Bench_convert_parameter(PyObject* value, Py_ssize_t n);
+
+#endif /* ifndef __BENCH_H__ */
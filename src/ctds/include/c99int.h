@@ -20,6 +20,8 @@ typedef unsigned __int64 uint64_t;
 #  define INT16_MAX (32767)
 #  define INT32_MIN (-2147483647L - 1)
 #  define INT32_MAX (2147483647L)
+
+#  define UINT64_C(_value) _value ## ui64
 #else
 #  include <stdint.h>
 #endif
@@ -0,0 +1,24 @@
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+#include "c99int.h"
+
+/**
+    Get the current time, in seconds, from a monotonic clock.
+
+    @note This method does not require the GIL.
+
+    @return The current time, in seconds, relative to an arbitrary point.
+*/
+double Clock_monotonic(void);
+
+/**
+    Get the current time, in nanoseconds, from a monotonic clock.
+
+    @note This method does not require the GIL.
+
+    @return The current time, in nanoseconds, relative to an arbitrary point.
+*/
+uint64_t Clock_monotonic_ns(void);
+
+#endif /* ifndef __CLOCK_H__ */
@@ -15,6 +15,47 @@
 PyTypeObject* ConnectionType_init(void);
 extern PyTypeObject ConnectionType;
 
+/*
+    Cumulative performance counters of a connection. These are updated while
+    holding the GIL.
+
+    The counters are reference counted, as rows read from a connection may
+    outlive it and update the conversion time.
+*/
+struct ConnectionStats
+{
+    size_t _refs;
+
+    /* The number of requests sent to the server and awaited. */
+    unsigned PY_LONG_LONG round_trips;
+
+    /* The bytes of SQL text and parameter data sent. */
+    unsigned PY_LONG_LONG bytes_sent;
+
+    /* The bytes of column data received. */
+    unsigned PY_LONG_LONG bytes_received;
+
+    /* The number of rows fetched. */
+    unsigned PY_LONG_LONG rows;
+
+    /* The time, in seconds, spent sending requests. */
+    double send_time;
+
+    /* The time, in seconds, spent waiting for the server's response. */
+    double response_time;
+
+    /* The time, in seconds, spent reading rows. */
+    double fetch_time;
+
+    /* The time, in seconds, spent converting column data to Python objects. */
+    double conversion_time;
+};
+
+#define ConnectionStats_increment(_stats) \
+    (_stats)->_refs++
+
+void ConnectionStats_decrement(struct ConnectionStats* stats);
+
 /**
     Create a new connection to the database.
 
@@ -96,6 +137,16 @@ struct Connection; /* forward declaration */
  */
 int Connection_closed(struct Connection* connection);
 
+/**
+    Close a connection, cancelling any currently executing command. This is a
+    no-op if the connection is already closed.
+
+    @note This method requires the current thread own the GIL.
+
+    @param connection [in] The connection.
+*/
+void Connection_close_internal(struct Connection* connection);
+
 /**
     Raise the last error seen on this connection as a Python Exception.
 
@@ -157,6 +208,60 @@ int Connection_transaction_commit(struct Connection* connection);
 */
 int Connection_transaction_rollback(struct Connection* connection);
 
+/**
+    Check if a transaction may be pending on a connection, i.e. auto-commit
+    is disabled and a statement has been sent since the last commit or
+    rollback. This is always true for a dead connection.
+
+    @param connection [in] The connection.
+
+    @return A boolean indicating if a transaction may be pending.
+*/
+bool Connection_in_transaction(struct Connection* connection);
+
+/**
+    Note that a statement is being sent on a connection. This must be called
+    before sending any statement which may begin an implicit transaction.
+
+    @param connection [in] The connection.
+*/
+void Connection_statement_sent(struct Connection* connection);
+
+/**
+    Mark a session reset as pending on a connection. The reset is sent with
+    the next command on the connection, restoring the session state to that
+    after the connection was opened.
+
+    @param connection [in] The connection.
+
+    @return 0 on success, -1 on error.
+*/
+int Connection_reset_session(struct Connection* connection);
+
+/**
+    Send a pending session reset, if any, before a command. If `sql` is not
+    NULL, the reset may be added to the command buffer ahead of the SQL batch
+    to avoid an additional round trip to the server. Otherwise the reset is
+    sent in a separate batch.
+
+    @note The command buffer must be empty when this is called.
+
+    @param connection [in] The connection.
+    @param sql [in] The SQL batch to be sent, or NULL.
+
+    @return 0 on success, -1 on error.
+*/
+int Connection_reset_prepare(struct Connection* connection, const char* sql);
+
+/**
+    Keep a session reset added to the command buffer by
+    Connection_reset_prepare() pending, as the command failed before the
+    server executed it, i.e. it was not sent or failed to compile.
+
+    @param connection [in] The connection.
+*/
+void Connection_reset_retry(struct Connection* connection);
+
 /* dblib handlers for error/message processing. */
 int Connection_dberrhandler(DBPROCESS* dbproc, int severity, int dberr,
                             int oserr, char* dberrstr, char* oserrstr);
@@ -168,4 +273,157 @@ int Connection_dbmsghandler(DBPROCESS* dbproc, DBINT msgno, int msgstate,
 
 DBPROCESS* Connection_DBPROCESS(struct Connection* connection);
 
+/**
+    Get the performance counters of a connection.
+
+    @param connection [in] The connection.
+
+    @return The performance counters. This is a borrowed reference.
+*/
+struct ConnectionStats* Connection_stats(struct Connection* connection);
+
+/**
+    Should the conversion of result set values be timed, as set by
+    `ctds.Connection.time_conversions`?
+
+    @param connection [in] The connection.
+
+    @return true if the conversion time should be added to the connection's
+        performance counters.
+*/
+bool Connection_time_conversions(struct Connection* connection);
+
+/**
+    Register a background operation which reads from the connection's
+    DBPROCESS without holding the GIL. Only one background operation may be
+    registered on a connection at a time.
+
+    @param connection [in] The connection.
+    @param stop [in] The function to call to stop the background operation.
+        This may be NULL to unregister the background operation.
+    @param background [in] The argument to pass to `stop`.
+*/
+void Connection_set_background(struct Connection* connection, void (*stop)(void*), void* background);
+
+/**
+    Stop the connection's background operation, if any. This must be called
+    before using the connection's DBPROCESS.
+
+    @note This method requires the current thread own the GIL.
+
+    @param connection [in] The connection.
+*/
+void Connection_stop_background(struct Connection* connection);
+
+struct ConnectionMessages; /* forward decl. */
+
+/**
+    Create a buffer for the messages and errors reported while reading from a
+    connection on a background thread.
+
+    @note This method does not require the GIL.
+
+    @return The buffer, or NULL on memory allocation failure.
+*/
+struct ConnectionMessages* ConnectionMessages_create(void);
+
+/**
+    Free a buffer created by ConnectionMessages_create(), discarding any
+    buffered messages.
+
+    @note This method does not require the GIL.
+
+    @param buffer [in] The buffer. This may be NULL.
+*/
+void ConnectionMessages_free(struct ConnectionMessages* buffer);
+
+/**
+    Buffer the messages and errors reported on the current thread, rather
+    than recording them on the connection, where they may be read
+    concurrently by the thread holding the GIL. The buffered output is
+    recorded on the connection by Connection_merge_messages().
+
+    @note This method does not require the GIL.
+
+    @param buffer [in] The buffer, or NULL to stop buffering.
+*/
+void Connection_redirect_messages(struct ConnectionMessages* buffer);
+
+/**
+    Move the messages and errors buffered in one buffer to another.
+
+    @note This method does not require the GIL. The caller must serialize
+        access to both buffers.
+
+    @param to [in] The buffer to move to.
+    @param from [in] The buffer to move from. This is emptied.
+*/
+void ConnectionMessages_move(struct ConnectionMessages* to, struct ConnectionMessages* from);
+
+/**
+    Record the messages and errors buffered on a background thread on the
+    connection, emptying the buffer.
+
+    @note This method requires the current thread own the GIL. The caller
+        must serialize access to the buffer.
+
+    @param connection [in] The connection.
+    @param buffer [in] The buffer.
+*/
+void Connection_merge_messages(struct Connection* connection, struct ConnectionMessages* buffer);
+
+/**
+    Get the result cache associated with a connection.
+
+    @note This method returns a borrowed reference.
+
+    @param connection [in] The connection.
+
+    @return The `ctds.ResultCache` object, or NULL if there is none.
+*/
+PyObject* Connection_result_cache(struct Connection* connection);
+
+/**
+    Get the identity of a connection, i.e. the server and login it was made
+    to, used to key cached results.
+
+    @note This method returns a borrowed reference.
+
+    @param connection [in] The connection.
+
+    @return A tuple of the server and user names.
+*/
+PyObject* Connection_identity(struct Connection* connection);
+
+/**
+    Get the `ctds.Pool` a connection is currently acquired from.
+
+    @param connection [in] The connection.
+
+    @return The id of the pool, or 0 if the connection is not acquired from
+        a pool.
+*/
+uint64_t Connection_pool(struct Connection* connection);
+
+/**
+    Set the `ctds.Pool` a connection is currently acquired from.
+
+    @param connection [in] The connection.
+    @param pool [in] The id of the pool, or 0 once the connection is released.
+*/
+void Connection_set_pool(struct Connection* connection, uint64_t pool);
+
+/**
+    Get the informational messages received from the last statement executed
+    on a connection, as by `ctds.Connection.messages`.
+
+    @note This method returns a new reference.
+
+    @param connection [in] The connection.
+
+    @return A list of message dicts, None if the connection is closed, or
+        NULL on error.
+*/
+PyObject* Connection_messages(struct Connection* connection);
+
 #endif /* ifndef __CONNECTION_H__ */
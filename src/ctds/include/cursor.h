@@ -46,10 +46,30 @@ struct Connection; /* forward declaration */
     @note This method steals a reference to the connection object.
 
     @param connection [in] The connection object which owns this cursor.
+    @param paramstyle [in] The paramstyle to use on .execute*() calls.
+    @param converters [in] The default output converters. This may be NULL.
 
     @return NULL indicating the creation failed.
     @return The created Cursor object, with a reference count of 1.
 */
-PyObject* Cursor_create(struct Connection* connection, enum ParamStyle paramstyle);
+PyObject* Cursor_create(struct Connection* connection, enum ParamStyle paramstyle, PyObject* converters);
+
+/**
+    Execute SQL statements on multiple connections concurrently.
+
+    Each statement is sent from the calling thread. The responses are then
+    read, and the rows of each statement's first result set buffered, on
+    a native thread per statement without holding the GIL.
+
+    @note This method sets an appropriate Python exception on failure.
+    @note This method returns a new reference.
+
+    @param queries [in] A sequence of (connection, sql[, parameters]) tuples.
+
+    @return A list containing a `ctds.RowList` of the first result set, None
+        or the raised exception for each statement.
+    @return NULL on failure.
+*/
+PyObject* Cursor_execute_parallel(PyObject* queries);
 
 #endif /* ifndef __CURSOR_H__ */
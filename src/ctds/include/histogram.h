@@ -0,0 +1,66 @@
+#ifndef __HISTOGRAM_H__
+#define __HISTOGRAM_H__
+
+#include <stddef.h>
+
+#include "c99int.h"
+
+/*
+    Log-bucketed latency histograms, in nanoseconds.
+
+    Each power of two between 2^HISTOGRAM_MIN_EXPONENT and
+    2^HISTOGRAM_MAX_EXPONENT nanoseconds (~1us to ~73 minutes) is divided
+    into 2^HISTOGRAM_SUB_BITS linear buckets, bounding the relative error of
+    any reported value to 1/2^HISTOGRAM_SUB_BITS. Shorter and longer values
+    are counted in the first and last buckets.
+*/
+#define HISTOGRAM_SUB_BITS 3
+#define HISTOGRAM_MIN_EXPONENT 10
+#define HISTOGRAM_MAX_EXPONENT 42
+
+#define HISTOGRAM_BUCKETS \
+    (((HISTOGRAM_MAX_EXPONENT - HISTOGRAM_MIN_EXPONENT) << HISTOGRAM_SUB_BITS) + 2)
+
+struct Histogram
+{
+    /* The number of values recorded. */
+    uint64_t count;
+
+    /* The sum, minimum and maximum of the values recorded. */
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+
+    uint64_t buckets[HISTOGRAM_BUCKETS];
+};
+
+/**
+    Record a value in a histogram.
+
+    @param histogram [in] The histogram.
+    @param value [in] The value, in nanoseconds.
+*/
+void Histogram_record(struct Histogram* histogram, uint64_t value);
+
+/**
+    Get the (exclusive) upper bound of a histogram bucket.
+
+    @param bucket [in] The index of the bucket.
+
+    @return The upper bound of the bucket, in nanoseconds, or UINT64_MAX for
+        the last bucket.
+*/
+uint64_t Histogram_bucket_bound(size_t bucket);
+
+/**
+    Estimate a percentile of the values recorded in a histogram.
+
+    @param histogram [in] The histogram.
+    @param percentile [in] The percentile, between 0 and 100.
+
+    @return The upper bound of the bucket containing the percentile, limited
+        to the range of values recorded, or 0 if the histogram is empty.
+*/
+uint64_t Histogram_percentile(const struct Histogram* histogram, double percentile);
+
+#endif /* ifndef __HISTOGRAM_H__ */
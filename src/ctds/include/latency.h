@@ -0,0 +1,67 @@
+#ifndef __LATENCY_H__
+#define __LATENCY_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+#include "c99bool.h"
+#include "c99int.h"
+
+/*
+    Process-wide latency histograms, read using `ctds.latency_histograms()`.
+
+    Values are recorded while holding the GIL, which serializes all updates,
+    so no further synchronization is required.
+*/
+
+enum LatencyMetric
+{
+    /* The time taken to log in to the server when opening a connection. */
+    LatencyMetric_login = 0,
+
+    /* The time from sending a request until the server's first response. */
+    LatencyMetric_round_trip,
+
+    /* The time taken to fetch all rows of a result set. */
+    LatencyMetric_fetch,
+
+    /* The time taken to acquire a connection from a `ctds.Pool`. */
+    LatencyMetric_pool_acquire,
+
+    LatencyMetric_count
+};
+
+/**
+    Record a latency.
+
+    @note This method requires the current thread own the GIL.
+
+    @param metric [in] The metric to record.
+    @param elapsed [in] The latency, in nanoseconds.
+*/
+void Latency_record(enum LatencyMetric metric, uint64_t elapsed);
+
+/**
+    Record a latency measured in seconds, e.g. by Clock_monotonic().
+
+    @note This method requires the current thread own the GIL.
+
+    @param metric [in] The metric to record.
+    @param elapsed [in] The latency, in seconds.
+*/
+void Latency_record_seconds(enum LatencyMetric metric, double elapsed);
+
+/**
+    Get the latency histograms, as by `ctds.latency_histograms()`.
+
+    @note This method requires the current thread own the GIL.
+    @note This method returns a new reference.
+
+    @param reset [in] Should the histograms be reset once read?
+
+    @return A dict of histograms keyed by metric name, or NULL on error.
+*/
+PyObject* Latency_get(bool reset);
+
+#endif /* ifndef __LATENCY_H__ */
@@ -0,0 +1,136 @@
+#ifndef __MEM_H__
+#define __MEM_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+#include <stddef.h>
+
+#include "c99bool.h"
+
+/*
+    Accounting of the native memory allocated by ctds, read using
+    `ctds.memory_stats()`.
+
+    Each allocation is prefixed with a header recording its size and the
+    subsystem it is attributed to. Allocations are made without holding the
+    GIL, e.g. by prefetch threads, so the counters are updated atomically.
+
+    These methods should not be called directly; use the `tds_mem_*` macros
+    in tds.h.
+*/
+
+enum MemoryTag
+{
+    /* Allocations not attributed to another subsystem. */
+    MemoryTag_other = 0,
+
+    /* Buffered result set rows, including cached and prefetched rows. */
+    MemoryTag_rows,
+
+    /* Converted parameters and the SQL built from them. */
+    MemoryTag_parameters,
+
+    /* Messages and errors reported by the server and FreeTDS. */
+    MemoryTag_messages,
+
+    /* Rows staged for `ctds.Connection.bulk_insert()`. */
+    MemoryTag_bulk,
+
+    MemoryTag_count
+};
+
+/**
+    Allocate memory, as by malloc().
+
+    @note This method does not require the GIL.
+
+    @param tag [in] The subsystem the allocation is attributed to.
+    @param size [in] The size of the allocation, in bytes.
+
+    @return The allocation, or NULL on failure.
+*/
+void* Memory_malloc(enum MemoryTag tag, size_t size);
+
+/**
+    Allocate zeroed memory, as by calloc().
+
+    @note This method does not require the GIL.
+
+    @param tag [in] The subsystem the allocation is attributed to.
+    @param count [in] The number of elements.
+    @param size [in] The size of each element, in bytes.
+
+    @return The allocation, or NULL on failure.
+*/
+void* Memory_calloc(enum MemoryTag tag, size_t count, size_t size);
+
+/**
+    Resize an allocation, as by realloc().
+
+    @note This method does not require the GIL.
+
+    @param tag [in] The subsystem a new allocation is attributed to. The
+        subsystem of an existing allocation is retained.
+    @param ptr [in] The allocation to resize, or NULL.
+    @param size [in] The new size of the allocation, in bytes.
+
+    @return The allocation, or NULL on failure.
+*/
+void* Memory_realloc(enum MemoryTag tag, void* ptr, size_t size);
+
+/**
+    Duplicate a string, as by strdup().
+
+    @note This method does not require the GIL.
+
+    @param tag [in] The subsystem the allocation is attributed to.
+    @param str [in] The string to duplicate.
+
+    @return The copy of the string, or NULL on failure.
+*/
+char* Memory_strdup(enum MemoryTag tag, const char* str);
+
+/**
+    Free an allocation made by one of the methods above.
+
+    @note This method does not require the GIL.
+
+    @param ptr [in] The allocation, or NULL.
+*/
+void Memory_free(void* ptr);
+
+/**
+    Set the process-wide limit on the memory allocated by ctds, as by
+    `ctds.set_memory_limit()`.
+
+    @note This method requires the current thread own the GIL.
+
+    @param limit [in] The limit, in bytes, or 0 to remove the limit.
+*/
+void Memory_set_limit(size_t limit);
+
+/**
+    Has the memory allocated by ctds exceeded the process-wide limit?
+
+    @note This method does not require the GIL.
+
+    @return true if a limit is set and exceeded.
+*/
+bool Memory_limit_exceeded(void);
+
+/**
+    Get the memory usage of each subsystem, as by `ctds.memory_stats()`.
+
+    @note This method requires the current thread own the GIL.
+    @note This method returns a new reference.
+
+    @param reset [in] Should the peak usage be reset to the current usage
+        once read?
+
+    @return A dict of usage keyed by subsystem name, or NULL on error.
+*/
+PyObject* Memory_get(bool reset);
+
+#endif /* ifndef __MEM_H__ */
@@ -45,7 +45,7 @@ bool Parameter_output(struct Parameter* rpcparam);
 /**
     Get the SQL type of this parameter.
 
-    @note The caller is required to release the returned value using free().
+    @note The caller is required to release the returned value using tds_mem_free().
 
     @param minimum_width [in] Use the MAX width for variable width types instead of
       inferring it from the size of the parameter.
@@ -54,6 +54,11 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width);
 
 PyObject* Parameter_value(struct Parameter* rpcparam);
 
+/**
+    Get the size, in bytes, of the parameter's input data.
+*/
+size_t Parameter_size(struct Parameter* rpcparam);
+
 #if !defined(CTDS_USE_SP_EXECUTESQL)
 
 char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t* nserialized);
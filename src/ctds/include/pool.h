@@ -0,0 +1,11 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+PyTypeObject* PoolType_init(void);
+extern PyTypeObject PoolType;
+
+#endif /* ifndef __POOL_H__ */
@@ -0,0 +1,30 @@
+#ifndef __PROBES_H__
+#define __PROBES_H__
+
+/*
+    Statically-defined (USDT) probe points in the `ctds` provider, for use
+    with bpftrace, perf or SystemTap.
+
+    The probes are compiled in only if <sys/sdt.h> was found at build time,
+    in which case setup.py defines CTDS_HAVE_SYS_SDT_H. A probe no tracer is
+    attached to costs a single nop instruction, though its arguments are
+    still evaluated and so must be cheap to compute. Otherwise the probe
+    macros expand to nothing, so arguments must not have side effects.
+
+    Probes may fire without holding the GIL.
+*/
+#if defined(CTDS_HAVE_SYS_SDT_H)
+#  include <sys/sdt.h>
+
+#  define PROBE1(_name, _a1) DTRACE_PROBE1(ctds, _name, _a1)
+#  define PROBE2(_name, _a1, _a2) DTRACE_PROBE2(ctds, _name, _a1, _a2)
+#  define PROBE3(_name, _a1, _a2, _a3) DTRACE_PROBE3(ctds, _name, _a1, _a2, _a3)
+#  define PROBE4(_name, _a1, _a2, _a3, _a4) DTRACE_PROBE4(ctds, _name, _a1, _a2, _a3, _a4)
+#else
+#  define PROBE1(_name, _a1) ((void)0)
+#  define PROBE2(_name, _a1, _a2) ((void)0)
+#  define PROBE3(_name, _a1, _a2, _a3) ((void)0)
+#  define PROBE4(_name, _a1, _a2, _a3, _a4) ((void)0)
+#endif /* if defined(CTDS_HAVE_SYS_SDT_H) */
+
+#endif /* ifndef __PROBES_H__ */
@@ -49,6 +49,14 @@ int PyUuid_Check(PyObject* o);
 PyObject* PyUuid_FromBytes(const char* bytes, Py_ssize_t size);
 
 
+/*
+    Create a unicode object from a UTF-8 encoded string; returns NULL on failure.
+    Pure 7-bit ASCII strings are copied directly into a compact unicode object,
+    bypassing the UTF-8 decoder.
+*/
+PyObject* unicode_from_utf8(const char* str, Py_ssize_t size);
+
+
 /* Initialize the datetime module; returns 0 on failure. */
 int PyDateTimeType_init(void);
 void PyDateTimeType_free(void);
@@ -0,0 +1,71 @@
+#ifndef __RESULTCACHE_H__
+#define __RESULTCACHE_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+#include "c99bool.h"
+
+PyTypeObject* ResultCacheType_init(void);
+extern PyTypeObject ResultCacheType;
+
+struct ResultCache; /* forward decl. */
+
+/**
+    Look up a cached result. Expired results are removed from the cache.
+
+    @note This method requires the current thread own the GIL.
+    @note This method returns a new reference.
+
+    @param cache [in] The result cache.
+    @param key [in] The key of the cached result.
+
+    @return The cached result.
+    @return NULL if the result is not cached. A Python exception may be set
+        if the key could not be hashed.
+*/
+PyObject* ResultCache_get(struct ResultCache* cache, PyObject* key);
+
+/**
+    Add a result to the cache, evicting the least recently used results
+    to remain within the cache's memory limit. Results larger than the
+    memory limit are not cached.
+
+    @note This method sets an appropriate Python exception on failure.
+    @note This method requires the current thread own the GIL.
+
+    @param cache [in] The result cache.
+    @param key [in] The key of the result.
+    @param sql [in] The SQL text which produced the result, used for invalidation.
+    @param value [in] The result to cache.
+    @param size [in] The approximate size, in bytes, of `value`.
+
+    @return 0 on success, -1 on failure.
+*/
+int ResultCache_put(struct ResultCache* cache, PyObject* key, PyObject* sql,
+                    PyObject* value, size_t size);
+
+/**
+    Can the results of a statement be cached? Only queries which do not
+    modify data or the session state, e.g. `SELECT` statements without an
+    `INTO` or `OUTPUT` clause, are cacheable.
+
+    The check is conservative, and may reject some read-only queries.
+
+    @param sql [in] The SQL text of the statement.
+
+    @return true if the statement is cacheable.
+*/
+bool ResultCache_cacheable(const char* sql);
+
+/**
+    Get the maximum size, in bytes, of the results held by the cache.
+
+    @param cache [in] The result cache.
+
+    @return The maximum size, in bytes.
+*/
+size_t ResultCache_max_memory(const struct ResultCache* cache);
+
+#endif /* ifndef __RESULTCACHE_H__ */
@@ -0,0 +1,85 @@
+#ifndef __SLOWLOG_H__
+#define __SLOWLOG_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+#include "c99bool.h"
+#include "c99int.h"
+
+struct Connection; /* forward decl. */
+
+/*
+    The function called with slow statements, or NULL if the slow query log
+    is disabled. Statements check this before doing any other work, so the
+    slow query log costs a single branch when disabled, and a timestamp
+    comparison when enabled.
+*/
+extern PyObject* SlowLog_callback;
+
+/* The slow query threshold, in nanoseconds. */
+extern uint64_t SlowLog_threshold;
+
+/* A statement being timed for the slow query log. */
+struct SlowQuery
+{
+    /*
+        The arguments of the `ctds.Cursor` method executing the statement,
+        or NULL if the statement is not being timed.
+    */
+    PyObject* args;
+
+    /* The name of the `ctds.Cursor` method executing the statement. */
+    const char* operation;
+
+    /* The time the statement started, in nanoseconds. */
+    uint64_t start;
+
+    /* The time taken to execute the statement, until its first response. */
+    uint64_t first_row;
+
+    /* Is the time spent fetching the statement's result set being added? */
+    bool fetching;
+};
+
+/**
+    Release the slow query log state.
+*/
+void SlowLog_free(void);
+
+/**
+    Configure the slow query log, as by `ctds.set_slow_query_log()`.
+
+    @note This method sets an appropriate Python exception on failure.
+
+    @param threshold [in] The slow query threshold, in nanoseconds.
+    @param callback [in] The function or `logging.Logger` to report slow
+        statements to, or None to disable the slow query log.
+    @param values [in] Should parameter values be reported?
+
+    @return 0 on success, -1 on error.
+*/
+int SlowLog_set(uint64_t threshold, PyObject* callback, bool values);
+
+/**
+    Report a slow statement.
+
+    The Python exception raised by the statement, if any, remains set.
+    Exceptions raised by the callback are reported using
+    `PyErr_WriteUnraisable()`.
+
+    @note This method requires the current thread own the GIL.
+
+    @param query [in] The statement.
+    @param connection [in] The connection the statement was executed on.
+        This may be NULL if the cursor is closed.
+    @param elapsed [in] The total time taken by the statement, in nanoseconds.
+    @param rows [in] The number of rows the statement affected or fetched,
+        or -1 if unknown.
+    @param error [in] Did the statement fail?
+*/
+void SlowLog_report(const struct SlowQuery* query, struct Connection* connection,
+                    uint64_t elapsed, Py_ssize_t rows, bool error);
+
+#endif /* ifndef __SLOWLOG_H__ */
@@ -0,0 +1,100 @@
+#ifndef __STATEMENTS_H__
+#define __STATEMENTS_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+#include "c99bool.h"
+#include "c99int.h"
+
+/*
+    Aggregated client-side statistics of the statements executed, keyed by a
+    fingerprint of the normalized SQL text or stored procedure name.
+
+    The statistics are only collected when enabled using
+    `ctds.set_statement_stats()`. All methods require the current thread own
+    the GIL.
+*/
+
+struct StatementTable; /* forward decl. */
+
+/* The statement statistics table, or NULL if collection is disabled. */
+extern struct StatementTable* Statements_table;
+
+enum StatementKind
+{
+    StatementKind_sql = 0,
+    StatementKind_procedure
+};
+
+/**
+    Compute the fingerprint of a statement.
+
+    SQL text is normalized by removing comments, collapsing whitespace,
+    lower-casing ASCII characters and replacing string and numeric literals
+    with `?`, so executions differing only in their literal values share a
+    fingerprint.
+
+    @param kind [in] The kind of statement.
+    @param text [in] The SQL text or stored procedure name.
+
+    @return The fingerprint. This is never 0.
+*/
+uint64_t Statements_fingerprint(enum StatementKind kind, const char* text);
+
+/**
+    Record an execution of a statement. This must only be called when
+    `Statements_table` is set. Statistics are best effort; the execution is
+    not recorded if memory for a new statement cannot be allocated.
+
+    @param fingerprint [in] The statement's fingerprint.
+    @param kind [in] The kind of statement.
+    @param text [in] The SQL text or stored procedure name.
+    @param elapsed [in] The time, in nanoseconds, taken to execute the
+        statement.
+    @param rows [in] The number of rows affected by the statement, or -1.
+    @param error [in] Did the statement fail?
+*/
+void Statements_record(uint64_t fingerprint, enum StatementKind kind, const char* text,
+                       uint64_t elapsed, Py_ssize_t rows, bool error);
+
+/**
+    Add rows fetched from the results of a statement to its statistics. This
+    is a no-op if the statement is no longer in the table.
+
+    @param fingerprint [in] The statement's fingerprint.
+    @param rows [in] The number of rows fetched.
+*/
+void Statements_add_rows(uint64_t fingerprint, size_t rows);
+
+/**
+    Enable or resize the statement statistics table, as by
+    `ctds.set_statement_stats()`. Any existing statistics are discarded.
+
+    @note This method sets an appropriate Python exception on failure.
+
+    @param maxsize [in] The maximum number of statements to keep statistics
+        for, or 0 to disable collection.
+
+    @return 0 on success, -1 on error.
+*/
+int Statements_set_maxsize(size_t maxsize);
+
+/**
+    Get the statement statistics, as by `ctds.statement_stats()`.
+
+    @note This method returns a new reference.
+
+    @param reset [in] Should the statistics be reset once read?
+
+    @return A list of dicts, or NULL on error.
+*/
+PyObject* Statements_get(bool reset);
+
+/**
+    Release the statement statistics table.
+*/
+void Statements_free(void);
+
+#endif /* ifndef __STATEMENTS_H__ */
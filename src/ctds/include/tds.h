@@ -8,6 +8,8 @@
 
 #include <stdlib.h>
 
+#include "mem.h"
+
 extern PyObject* PyExc_tds_Warning;
 extern PyObject* PyExc_tds_Error;
 extern PyObject* PyExc_tds_InterfaceError;
@@ -19,11 +21,20 @@ extern PyObject* PyExc_tds_InternalError;
 extern PyObject* PyExc_tds_ProgrammingError;
 extern PyObject* PyExc_tds_NotSupportedError;
 
-#define tds_mem_malloc malloc
-#define tds_mem_realloc realloc
-#define tds_mem_calloc calloc
-#define tds_mem_free free
-#define tds_mem_strdup strdup
+#define tds_mem_malloc(_size) Memory_malloc(MemoryTag_other, (_size))
+#define tds_mem_realloc(_ptr, _size) Memory_realloc(MemoryTag_other, (_ptr), (_size))
+#define tds_mem_calloc(_count, _size) Memory_calloc(MemoryTag_other, (_count), (_size))
+#define tds_mem_free(_ptr) Memory_free(_ptr)
+#define tds_mem_strdup(_str) Memory_strdup(MemoryTag_other, (_str))
+
+/*
+    Allocations attributed to a subsystem in `ctds.memory_stats()`, e.g.
+    `tds_mem_tagged_malloc(rows, size)`. See enum MemoryTag.
+*/
+#define tds_mem_tagged_malloc(_tag, _size) Memory_malloc(MemoryTag_ ## _tag, (_size))
+#define tds_mem_tagged_realloc(_tag, _ptr, _size) Memory_realloc(MemoryTag_ ## _tag, (_ptr), (_size))
+#define tds_mem_tagged_calloc(_tag, _count, _size) Memory_calloc(MemoryTag_ ## _tag, (_count), (_size))
+#define tds_mem_tagged_strdup(_tag, _str) Memory_strdup(MemoryTag_ ## _tag, (_str))
 
 #define TDS_CHAR_MIN_SIZE 1
 #define TDS_CHAR_MAX_SIZE 8000
@@ -76,4 +87,19 @@ enum ParamStyle {
 #  define CTDS_SUPPORT_BCP_EMPTY_STRING 1
 #endif
 
+/**
+    Connect to a database. This implements `ctds.connect()`.
+
+    @note This method sets an appropriate Python exception on failure.
+    @note This method returns a new reference.
+
+    @param self [in] The module. This is unused and may be NULL.
+    @param args [in] The positional arguments to `ctds.connect()`.
+    @param kwargs [in] The keyword arguments to `ctds.connect()`. This may be NULL.
+
+    @return The connection object.
+    @return NULL on failure.
+*/
+PyObject* tds_connect(PyObject* self, PyObject* args, PyObject* kwargs);
+
 #endif /* ifndef __TDS_H__ */
@@ -0,0 +1,100 @@
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "push_warnings.h"
+#include <Python.h>
+#include "pop_warnings.h"
+
+#include "c99int.h"
+
+struct Connection; /* forward decl. */
+
+/*
+    The trace hooks, as an (on_start, on_end) tuple, or NULL if tracing is
+    disabled. Traced operations check this before doing any other tracing
+    work, so tracing costs a single branch when disabled.
+*/
+extern PyObject* Trace_hooks;
+
+enum TraceOperation
+{
+    TraceOperation_execute = 0,
+    TraceOperation_executemany,
+    TraceOperation_callproc,
+    TraceOperation_bulk_insert,
+    TraceOperation_fetch,
+    TraceOperation_execute_async,
+
+    TraceOperation_count
+};
+
+/* An operation being traced. */
+struct TraceSpan
+{
+    /* The hooks the operation was started with. */
+    PyObject* hooks;
+
+    /* The value returned by the `on_start` hook. */
+    PyObject* token;
+
+    /* The time the operation started, in nanoseconds. */
+    uint64_t start;
+};
+
+/**
+    Initialize the tracing module state.
+
+    @return 0 on success, -1 on error.
+*/
+int Trace_init(void);
+
+/**
+    Release the tracing module state, including the trace hooks.
+*/
+void Trace_free(void);
+
+/**
+    Set the trace hooks, as by `ctds.set_trace_hooks()`.
+
+    @note This method sets an appropriate Python exception on failure.
+
+    @param on_start [in] The callable to call when an operation starts, or None.
+    @param on_end [in] The callable to call when an operation ends, or None.
+
+    @return 0 on success, -1 on error.
+*/
+int Trace_set_hooks(PyObject* on_start, PyObject* on_end);
+
+/**
+    Start tracing an operation by calling the `on_start` hook. This must only
+    be called when `Trace_hooks` is set.
+
+    Exceptions raised by the hook are reported using
+    `PyErr_WriteUnraisable()` and do not affect the operation.
+
+    @note This method requires the current thread own the GIL.
+
+    @param span [out] The span to initialize. It must be passed to
+        `Trace_end()` once the operation completes.
+    @param operation [in] The kind of operation.
+    @param sql [in] The SQL statement, procedure or table name, or NULL.
+    @param connection [in] The connection the operation is executed on.
+        This may be NULL if the cursor is closed.
+*/
+void Trace_begin(struct TraceSpan* span, enum TraceOperation operation,
+                 PyObject* sql, struct Connection* connection);
+
+/**
+    Finish tracing an operation by calling the `on_end` hook. The Python
+    exception raised by the operation, if any, is passed to the hook and
+    remains set.
+
+    @note This method requires the current thread own the GIL.
+
+    @param span [in] The span initialized by `Trace_begin()`.
+    @param rows [in] The number of rows the operation produced or affected,
+        or -1 if unknown.
+*/
+void Trace_end(struct TraceSpan* span, Py_ssize_t rows);
+
+#endif /* ifndef __TRACE_H__ */
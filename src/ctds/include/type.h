@@ -175,6 +175,35 @@ typedef PyObject* (*sql_topython)(enum TdsType tdstype, const void* data, size_t
 
 sql_topython sql_topython_lookup(enum TdsType tdstype);
 
+/**
+    Look up a built-in native converter by name.
+
+    @param name [in] The name of the converter, as a Python string object.
+    @param tdstype [in] The TDS type of the data to convert.
+    @param topython [out] The converter for `tdstype`, or NULL if the named
+        converter does not support `tdstype`.
+
+    @retval 0 The converter name is known.
+    @retval -1 The converter name is unknown.
+*/
+int sql_topython_native_lookup(PyObject* name, enum TdsType tdstype, sql_topython* topython);
+
+/**
+    Validate a mapping of user-registered output converters.
+
+    The mapping must be a dict whose keys are TDS type codes or column
+    names and whose values are either Python callables or the name of a
+    built-in native converter.
+
+    @note This method sets an appropriate Python exception on failure.
+
+    @param converters [in] The converters mapping.
+
+    @retval 0 The mapping is valid.
+    @retval -1 The mapping is invalid.
+*/
+int converters_validate(PyObject* converters);
+
 /**
     Translate a unicode Python object another which can be represented
     in UCS2. Unicode codepoints which do not exist in UCS2 are replaced
@@ -0,0 +1,121 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include "include/pop_warnings.h"
+
+#include <string.h>
+
+#include "include/histogram.h"
+#include "include/latency.h"
+
+static struct Histogram s_histograms[LatencyMetric_count];
+
+static const char* s_names[LatencyMetric_count] =
+{
+    "login",
+    "round_trip",
+    "fetch",
+    "pool_acquire"
+};
+
+/* Convert nanoseconds to seconds. */
+#define NS_TO_S(_ns) ((double)(_ns) / 1000000000.0)
+
+void Latency_record(enum LatencyMetric metric, uint64_t elapsed)
+{
+    Histogram_record(&s_histograms[metric], elapsed);
+}
+
+void Latency_record_seconds(enum LatencyMetric metric, double elapsed)
+{
+    Histogram_record(&s_histograms[metric], (elapsed > 0) ? (uint64_t)(elapsed * 1000000000.0) : 0);
+}
+
+/*
+    Build the description of a histogram.
+
+    @note This method returns a new reference.
+*/
+static PyObject* Latency_histogram(const struct Histogram* histogram)
+{
+    PyObject* buckets;
+    PyObject* result;
+    size_t ix;
+
+    /* The non-empty buckets, as (upper bound, count) tuples. */
+    buckets = PyList_New(0);
+    if (!buckets)
+    {
+        return NULL;
+    }
+    for (ix = 0; ix < HISTOGRAM_BUCKETS; ++ix)
+    {
+        if (histogram->buckets[ix])
+        {
+            uint64_t bound = Histogram_bucket_bound(ix);
+            PyObject* bucket = Py_BuildValue(
+                "(dK)",
+                (UINT64_MAX == bound) ? Py_HUGE_VAL : NS_TO_S(bound),
+                (unsigned PY_LONG_LONG)histogram->buckets[ix]
+            );
+            if (!bucket)
+            {
+                Py_DECREF(buckets);
+                return NULL;
+            }
+            if (0 != PyList_Append(buckets, bucket))
+            {
+                Py_DECREF(bucket);
+                Py_DECREF(buckets);
+                return NULL;
+            }
+            Py_DECREF(bucket);
+        }
+    }
+
+    result = Py_BuildValue(
+        "{s:K,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:N}",
+        "count", (unsigned PY_LONG_LONG)histogram->count,
+        "sum", NS_TO_S(histogram->sum),
+        "min", NS_TO_S(histogram->min),
+        "max", NS_TO_S(histogram->max),
+        "p50", NS_TO_S(Histogram_percentile(histogram, 50.0)),
+        "p90", NS_TO_S(Histogram_percentile(histogram, 90.0)),
+        "p99", NS_TO_S(Histogram_percentile(histogram, 99.0)),
+        "p999", NS_TO_S(Histogram_percentile(histogram, 99.9)),
+        "buckets", buckets /* buckets reference stolen by Py_BuildValue */
+    );
+    return result;
+}
+
+PyObject* Latency_get(bool reset)
+{
+    size_t ix;
+    PyObject* histograms = PyDict_New();
+    if (!histograms)
+    {
+        return NULL;
+    }
+
+    for (ix = 0; ix < LatencyMetric_count; ++ix)
+    {
+        PyObject* histogram = Latency_histogram(&s_histograms[ix]);
+        if (!histogram)
+        {
+            Py_DECREF(histograms);
+            return NULL;
+        }
+        if (0 != PyDict_SetItemString(histograms, s_names[ix], histogram))
+        {
+            Py_DECREF(histogram);
+            Py_DECREF(histograms);
+            return NULL;
+        }
+        Py_DECREF(histogram);
+    }
+
+    if (reset)
+    {
+        memset(s_histograms, 0, sizeof(s_histograms));
+    }
+    return histograms;
+}
@@ -0,0 +1,230 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include "include/pop_warnings.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#  include "include/push_warnings.h"
+#  include <Windows.h>
+#  include "include/pop_warnings.h"
+#endif /* if defined(_WIN32) */
+
+#include "include/c99int.h"
+#include "include/mem.h"
+
+/* Atomic operations on the counters, returning the resulting value. */
+#if defined(_WIN32)
+#  define ATOMIC_ADD(_counter, _delta) \
+      (InterlockedExchangeAdd64((_counter), (_delta)) + (_delta))
+#  define ATOMIC_CAS(_counter, _expected, _value) \
+      (InterlockedCompareExchange64((_counter), (_value), (_expected)) == (_expected))
+typedef LONG64 counter_t;
+#else /* if defined(_WIN32) */
+#  define ATOMIC_ADD(_counter, _delta) __sync_add_and_fetch((_counter), (_delta))
+#  define ATOMIC_CAS(_counter, _expected, _value) \
+      __sync_bool_compare_and_swap((_counter), (_expected), (_value))
+typedef int64_t counter_t;
+#endif /* else if defined(_WIN32) */
+
+#define ATOMIC_READ(_counter) ATOMIC_ADD((_counter), 0)
+
+/*
+    The header prefixing each allocation. The union preserves the alignment
+    malloc() guarantees for the memory following it.
+*/
+union MemoryHeader
+{
+    struct
+    {
+        size_t size;
+        enum MemoryTag tag;
+    } allocation;
+
+    long double _ld;
+    void* _ptr;
+    uint64_t _u64;
+};
+
+struct MemoryUsage
+{
+    /* The bytes currently allocated. */
+    volatile counter_t current;
+
+    /* The most bytes allocated at once. */
+    volatile counter_t peak;
+};
+
+/* The usage of each subsystem, followed by the total. */
+static struct MemoryUsage s_usage[MemoryTag_count + 1];
+
+#define TOTAL (&s_usage[MemoryTag_count])
+
+static const char* s_names[MemoryTag_count + 1] =
+{
+    "other",
+    "rows",
+    "parameters",
+    "messages",
+    "bulk",
+    "total"
+};
+
+/* The process-wide limit, in bytes, or 0 if unlimited. */
+static volatile counter_t s_limit = 0;
+
+static void MemoryUsage_add(struct MemoryUsage* usage, counter_t delta)
+{
+    counter_t current = ATOMIC_ADD(&usage->current, delta);
+    if (delta > 0)
+    {
+        counter_t peak;
+        do
+        {
+            peak = usage->peak;
+            if (current <= peak)
+            {
+                break;
+            }
+        }
+        while (!ATOMIC_CAS(&usage->peak, peak, current));
+    }
+}
+
+static void Memory_account(enum MemoryTag tag, counter_t delta)
+{
+    MemoryUsage_add(&s_usage[tag], delta);
+    MemoryUsage_add(TOTAL, delta);
+}
+
+/* Initialize a new allocation's header, returning the memory following it. */
+static void* Memory_track(union MemoryHeader* header, enum MemoryTag tag, size_t size)
+{
+    if (!header)
+    {
+        return NULL;
+    }
+    header->allocation.size = size;
+    header->allocation.tag = tag;
+    Memory_account(tag, (counter_t)size);
+    return header + 1;
+}
+
+void* Memory_malloc(enum MemoryTag tag, size_t size)
+{
+    if (size > ((size_t)-1 - sizeof(union MemoryHeader)))
+    {
+        return NULL;
+    }
+    return Memory_track(malloc(sizeof(union MemoryHeader) + size), tag, size);
+}
+
+void* Memory_calloc(enum MemoryTag tag, size_t count, size_t size)
+{
+    size_t total = count * size;
+    if ((size && ((total / size) != count)) ||
+        (total > ((size_t)-1 - sizeof(union MemoryHeader))))
+    {
+        return NULL;
+    }
+    return Memory_track(calloc(1, sizeof(union MemoryHeader) + total), tag, total);
+}
+
+void* Memory_realloc(enum MemoryTag tag, void* ptr, size_t size)
+{
+    union MemoryHeader* header;
+    size_t existing;
+
+    if (!ptr)
+    {
+        return Memory_malloc(tag, size);
+    }
+    if (size > ((size_t)-1 - sizeof(union MemoryHeader)))
+    {
+        return NULL;
+    }
+
+    header = (union MemoryHeader*)ptr - 1;
+    existing = header->allocation.size;
+    header = realloc(header, sizeof(union MemoryHeader) + size);
+    if (!header)
+    {
+        return NULL;
+    }
+    header->allocation.size = size;
+    Memory_account(header->allocation.tag, (counter_t)size - (counter_t)existing);
+    return header + 1;
+}
+
+char* Memory_strdup(enum MemoryTag tag, const char* str)
+{
+    size_t size = strlen(str) + 1 /* '\0' */;
+    char* copy = Memory_malloc(tag, size);
+    if (copy)
+    {
+        memcpy(copy, str, size);
+    }
+    return copy;
+}
+
+void Memory_free(void* ptr)
+{
+    if (ptr)
+    {
+        union MemoryHeader* header = (union MemoryHeader*)ptr - 1;
+        Memory_account(header->allocation.tag, -(counter_t)header->allocation.size);
+        free(header);
+    }
+}
+
+void Memory_set_limit(size_t limit)
+{
+    /* Limits beyond the counters' range can never be exceeded. */
+    s_limit = ((uint64_t)limit > (uint64_t)INT64_MAX) ? 0 : (counter_t)limit;
+}
+
+bool Memory_limit_exceeded(void)
+{
+    counter_t limit = s_limit;
+    return (0 != limit) && (ATOMIC_READ(&TOTAL->current) > limit);
+}
+
+PyObject* Memory_get(bool reset)
+{
+    size_t ix;
+    PyObject* stats = PyDict_New();
+    if (!stats)
+    {
+        return NULL;
+    }
+
+    for (ix = 0; ix < MemoryTag_count + 1; ++ix)
+    {
+        counter_t current = ATOMIC_READ(&s_usage[ix].current);
+        PyObject* usage = Py_BuildValue(
+            "{s:L,s:L}",
+            "current", (PY_LONG_LONG)current,
+            "peak", (PY_LONG_LONG)ATOMIC_READ(&s_usage[ix].peak)
+        );
+        if (!usage)
+        {
+            Py_DECREF(stats);
+            return NULL;
+        }
+        if (0 != PyDict_SetItemString(stats, s_names[ix], usage))
+        {
+            Py_DECREF(usage);
+            Py_DECREF(stats);
+            return NULL;
+        }
+        Py_DECREF(usage);
+
+        if (reset)
+        {
+            /* Allocations racing the reset may be missed from the new peak. */
+            s_usage[ix].peak = current;
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,57 @@
+'''
+Export of the extension's performance metrics.
+'''
+
+# The Prometheus bucket boundaries, in seconds. These are the powers of two
+# between 2^10 and 2^42 nanoseconds, which coincide with the boundaries of the
+# histograms' logarithmic buckets.
+_BOUNDS = tuple((2 ** exponent) / 1e9 for exponent in range(10, 43))
+
+_HISTOGRAMS = (
+    ('login', 'The time taken to log in to the server.'),
+    ('round_trip', 'The time from sending a request until the first response.'),
+    ('fetch', 'The time spent fetching all rows of a result set.'),
+    ('pool_acquire', 'The time taken to acquire a connection from a ctds.Pool.'),
+)
+
+
+def prometheus_metrics(prefix='ctds', reset=False):
+    '''
+    Format the histograms returned by :py:func:`ctds.latency_histograms` in
+    the `Prometheus text format
+    <https://prometheus.io/docs/instrumenting/exposition_formats/>`_, e.g.
+    for serving from an HTTP endpoint scraped by Prometheus.
+
+    Each histogram is named `<prefix>_<operation>_duration_seconds`.
+
+    .. versionadded:: 1.15
+
+    :param str prefix: The prefix of the metric names.
+    :param bool reset: Reset the histograms once read.
+    :return: The metrics.
+    :rtype: str
+    '''
+    import ctds # pylint: disable=import-outside-toplevel,cyclic-import
+
+    histograms = ctds.latency_histograms(reset=reset)
+
+    lines = []
+    for operation, description in _HISTOGRAMS:
+        histogram = histograms[operation]
+        name = '{0}_{1}_duration_seconds'.format(prefix, operation)
+        lines.append('# HELP {0} {1}'.format(name, description))
+        lines.append('# TYPE {0} histogram'.format(name))
+
+        buckets = histogram['buckets']
+        count = 0
+        index = 0
+        for bound in _BOUNDS:
+            while index < len(buckets) and buckets[index][0] <= bound * (1 + 1e-9):
+                count += buckets[index][1]
+                index += 1
+            lines.append('{0}_bucket{{le="{1!r}"}} {2}'.format(name, bound, count))
+        lines.append('{0}_bucket{{le="+Inf"}} {1}'.format(name, histogram['count']))
+        lines.append('{0}_sum {1!r}'.format(name, histogram['sum']))
+        lines.append('{0}_count {1}'.format(name, histogram['count']))
+
+    return '\n'.join(lines) + '\n'
@@ -689,7 +689,7 @@ int Parameter_bind(struct Parameter* parameter, DBPROCESS* dbproc)
             }
 
             tds_mem_free(parameter->output);
-            parameter->output = tds_mem_malloc(parameter->noutput);
+            parameter->output = tds_mem_tagged_malloc(parameters, parameter->noutput);
             if (!parameter->output)
             {
                 PyErr_NoMemory();
@@ -807,7 +807,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
     switch (rpcparam->tdstype)
     {
 #define CONST_CASE(_type) \
-        case TDS ## _type: { sql = tds_mem_strdup(STRINGIFY(_type)); break; }
+        case TDS ## _type: { sql = tds_mem_tagged_strdup(parameters, STRINGIFY(_type)); break; }
 
         case TDSNVARCHAR:
         {
@@ -817,7 +817,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
 #endif /* if defined(__GNUC__) && (__GNUC__ > 7) */
             if ((rpcparam->tdstypesize > TDS_NCHAR_MAX_SIZE) || maximum_width)
             {
-                sql = tds_mem_strdup("NVARCHAR(MAX)");
+                sql = tds_mem_tagged_strdup(parameters, "NVARCHAR(MAX)");
                 break;
             }
 #if defined(__GNUC__) && (__GNUC__ > 7)
@@ -829,7 +829,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
         {
             /* The typesize will be 0 for NULL values, but the SQL type size must be 1. */
             assert(0 <= rpcparam->tdstypesize && rpcparam->tdstypesize <= TDS_NCHAR_MAX_SIZE);
-            sql = tds_mem_malloc(ARRAYSIZE("NVARCHAR(2147483647)"));
+            sql = tds_mem_tagged_malloc(parameters, ARRAYSIZE("NVARCHAR(2147483647)"));
             if (sql)
             {
                 (void)sprintf(sql,
@@ -847,7 +847,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
 #endif /* if defined(__GNUC__) && (__GNUC__ > 7) */
             if ((rpcparam->tdstypesize > TDS_CHAR_MAX_SIZE) || maximum_width)
             {
-                sql = tds_mem_strdup("VARCHAR(MAX)");
+                sql = tds_mem_tagged_strdup(parameters, "VARCHAR(MAX)");
                 break;
             }
 #if defined(__GNUC__) && (__GNUC__ > 7)
@@ -859,7 +859,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
         {
             /* The typesize will be 0 for NULL values, but the SQL type size must be 1. */
             assert(0 <= rpcparam->tdstypesize && rpcparam->tdstypesize <= TDS_CHAR_MAX_SIZE);
-            sql = tds_mem_malloc(ARRAYSIZE("VARCHAR(2147483647)"));
+            sql = tds_mem_tagged_malloc(parameters, ARRAYSIZE("VARCHAR(2147483647)"));
             if (sql)
             {
                 (void)sprintf(sql,
@@ -894,7 +894,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
             {
                 prefix = "SMALL";
             }
-            sql = tds_mem_malloc(ARRAYSIZE("SMALLINT"));
+            sql = tds_mem_tagged_malloc(parameters, ARRAYSIZE("SMALLINT"));
             if (sql)
             {
                 (void)sprintf(sql, "%sINT", prefix);
@@ -906,7 +906,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
         case TDSFLOATN:
         {
             /* $TODO: support variable sized floats */
-            sql = tds_mem_strdup("FLOAT");
+            sql = tds_mem_tagged_strdup(parameters, "FLOAT");
             break;
         }
         CONST_CASE(REAL)
@@ -927,7 +927,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
         case TDSNUMERIC:
         case TDSDECIMAL:
         {
-            sql = tds_mem_malloc(ARRAYSIZE("DECIMAL(255,255)"));
+            sql = tds_mem_tagged_malloc(parameters, ARRAYSIZE("DECIMAL(255,255)"));
             if (sql)
             {
                 const DBDECIMAL* dbdecimal = (const DBDECIMAL*)rpcparam->input;
@@ -948,7 +948,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
 #endif /* if defined(__GNUC__) && (__GNUC__ > 7) */
             if ((rpcparam->tdstypesize > TDS_BINARY_MAX_SIZE) || maximum_width)
             {
-                sql = tds_mem_strdup("VARBINARY(MAX)");
+                sql = tds_mem_tagged_strdup(parameters, "VARBINARY(MAX)");
                 break;
             }
 #if defined(__GNUC__) && (__GNUC__ > 7)
@@ -959,7 +959,7 @@ char* Parameter_sqltype(struct Parameter* rpcparam, bool maximum_width)
         case TDSBINARY:
         {
             assert(1 <= rpcparam->tdstypesize && rpcparam->tdstypesize <= TDS_BINARY_MAX_SIZE);
-            sql = tds_mem_malloc(ARRAYSIZE("VARBINARY(" STRINGIFY(TDS_BINARY_MAX_SIZE) ")"));
+            sql = tds_mem_tagged_malloc(parameters, ARRAYSIZE("VARBINARY(" STRINGIFY(TDS_BINARY_MAX_SIZE) ")"));
             if (sql)
             {
                 (void)sprintf(sql,
@@ -986,6 +986,11 @@ PyObject* Parameter_value(struct Parameter* rpcparam)
     return rpcparam->value;
 }
 
+size_t Parameter_size(struct Parameter* rpcparam)
+{
+    return rpcparam->ninput;
+}
+
 #if !defined(CTDS_USE_SP_EXECUTESQL)
 
 char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t* nserialized)
@@ -995,7 +1000,7 @@ char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t
     bool convert = true;
     if (NULL == rpcparam->input)
     {
-        value = tds_mem_strdup("NULL");
+        value = tds_mem_tagged_strdup(parameters, "NULL");
         if (value)
         {
             *nserialized = ARRAYSIZE("NULL") - 1;
@@ -1032,7 +1037,7 @@ char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t
                     size_t ixsrc;
                     if (write)
                     {
-                        value = tds_mem_malloc(written);
+                        value = tds_mem_tagged_malloc(parameters, written);
                         if (!value)
                         {
                             PyErr_NoMemory();
@@ -1089,7 +1094,7 @@ char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t
                 size_t ix, written = 0;
 
                 /* Large enough for the hexadecimal representation. */
-                value = tds_mem_malloc(ARRAYSIZE("0x") + rpcparam->ninput * 2 + 1 /* '\0' */);
+                value = tds_mem_tagged_malloc(parameters, ARRAYSIZE("0x") + rpcparam->ninput * 2 + 1 /* '\0' */);
                 if (!value)
                 {
                     PyErr_NoMemory();
@@ -1140,7 +1145,7 @@ char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t
                     }
                 }
 
-                value = tds_mem_malloc(nvalue);
+                value = tds_mem_tagged_malloc(parameters, nvalue);
                 if (!value)
                 {
                     PyErr_NoMemory();
@@ -1183,7 +1188,7 @@ char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t
                 } ints;
                 memset(&ints, 0, sizeof(ints));
 
-                value = tds_mem_malloc(ARRAYSIZE("-9223372036854775808"));
+                value = tds_mem_tagged_malloc(parameters, ARRAYSIZE("-9223372036854775808"));
                 if (!value)
                 {
                     PyErr_NoMemory();
@@ -1223,7 +1228,7 @@ char* Parameter_serialize(struct Parameter* rpcparam, bool maximum_width, size_t
             char* type = Parameter_sqltype(rpcparam, maximum_width);
             if (type)
             {
-                serialized = tds_mem_malloc(
+                serialized = tds_mem_tagged_malloc(parameters,
                     ARRAYSIZE("CONVERT(") + strlen(type) + ARRAYSIZE(",") + strlen(value) + ARRAYSIZE(")")
                 );
                 if (serialized)
@@ -0,0 +1,1191 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include <pythread.h>
+#include "include/pop_warnings.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "include/c99bool.h"
+#include "include/c99int.h"
+#include "include/clock.h"
+#include "include/connection.h"
+#include "include/latency.h"
+#include "include/macros.h"
+#include "include/pool.h"
+#include "include/tds.h"
+
+#ifdef __clang__
+# if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8
+/* Ignore "'tp_print' has been explicitly marked deprecated here" */
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#  endif /* if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8 */
+#endif /* ifdef __clang__ */
+
+
+#define Pool_UNLIMITED ((size_t)-1)
+
+/* The maximum time, in seconds, between runs of the maintenance thread. */
+#define Pool_MAINTENANCE_INTERVAL 1.0
+#define Pool_MAINTENANCE_INTERVAL_MIN 0.01
+
+/* The maximum number of connections opened concurrently. */
+#define Pool_CONNECT_CONCURRENCY 16
+
+/*
+    The background maintenance thread waits on a lock with a timeout, which
+    is only supported by Python 3.2+.
+*/
+#if PY_VERSION_HEX >= 0x03020000
+#  define CTDS_HAVE_POOL_MAINTENANCE 1
+#endif /* if PY_VERSION_HEX >= 0x03020000 */
+
+struct PoolEntry
+{
+    /* The idle connection. */
+    PyObject* connection;
+
+    /* The time, in seconds, the connection was released to the pool. */
+    double released;
+
+    /* The idle list links. */
+    struct PoolEntry* prev;
+    struct PoolEntry* next;
+};
+
+struct Pool
+{
+    PyObject_HEAD
+
+    /*
+        The process-unique id of the pool, with which connections acquired
+        from it are tagged. Ids are not reused, so connections outliving the
+        pool are never mistaken for those of a later pool.
+    */
+    uint64_t id;
+
+    /* The keyword arguments to `ctds.connect()` and an empty argument tuple. */
+    PyObject* params;
+    PyObject* args;
+
+    /*
+        The idle connections, from most (head) to least (tail) recently
+        released. Connections are reused from the head and expire from the
+        tail.
+    */
+    struct PoolEntry* head;
+    struct PoolEntry* tail;
+    size_t nidle;
+
+    /* Unused entries, linked by `next`, to avoid an allocation per release. */
+    struct PoolEntry* free;
+
+    /* The number of open connections created by the pool, idle or acquired. */
+    size_t nconnections;
+
+    size_t minsize;
+    size_t maxsize;
+
+    /* The maximum idle time, in seconds. Negative if connections never expire. */
+    double idlettl;
+
+    /* Reset the session state of released connections. */
+    bool reset;
+
+    bool closed;
+
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+    /*
+        Released to wake the maintenance thread. `signaled` is set while the
+        lock is released, ensuring it is released at most once per wait.
+    */
+    PyThread_type_lock wakeup;
+    bool signaled;
+
+    /* Set to stop the maintenance thread. */
+    bool stopping;
+
+    /* Released by the maintenance thread when it exits. */
+    PyThread_type_lock finished;
+
+    /* The time, in microseconds, between runs of the maintenance thread. */
+    PY_TIMEOUT_T interval;
+
+    bool running;
+
+    /* The next pool in the list of pools with a running maintenance thread. */
+    struct Pool* next_running;
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+};
+
+/* The id of the last pool created. */
+static uint64_t s_last_id = 0;
+
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+/*
+    Pools with a running maintenance thread. These threads are stopped at
+    exit, before the interpreter is finalized, as they cannot acquire the
+    GIL afterwards.
+*/
+static struct Pool* s_running = NULL;
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+
+/*
+    All access to the pool's state is serialized by the GIL, so acquiring or
+    releasing a connection requires no additional locking. Care must be taken
+    to leave the idle list consistent before any call which may release the
+    GIL, e.g. opening or closing a connection.
+*/
+
+static void Pool_unlink(struct Pool* pool, struct PoolEntry* entry)
+{
+    if (entry->prev)
+    {
+        entry->prev->next = entry->next;
+    }
+    else
+    {
+        pool->head = entry->next;
+    }
+    if (entry->next)
+    {
+        entry->next->prev = entry->prev;
+    }
+    else
+    {
+        pool->tail = entry->prev;
+    }
+    entry->prev = entry->next = NULL;
+    pool->nidle--;
+
+    /* Retain the entry for reuse. */
+    entry->connection = NULL;
+    entry->next = pool->free;
+    pool->free = entry;
+}
+
+/*
+    Add a connection to the front of the idle list.
+
+    @note This method steals the reference to `connection`.
+
+    @return 0 on success, -1 on failure.
+*/
+static int Pool_push(struct Pool* pool, PyObject* connection)
+{
+    struct PoolEntry* entry = pool->free;
+    if (entry)
+    {
+        pool->free = entry->next;
+    }
+    else
+    {
+        entry = tds_mem_malloc(sizeof(struct PoolEntry));
+        if (!entry)
+        {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+
+    entry->connection = connection;
+    entry->released = Clock_monotonic();
+    entry->prev = NULL;
+    entry->next = pool->head;
+    if (pool->head)
+    {
+        pool->head->prev = entry;
+    }
+    else
+    {
+        pool->tail = entry;
+    }
+    pool->head = entry;
+    pool->nidle++;
+    return 0;
+}
+
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+
+/*
+    Wake the maintenance thread, if running.
+
+    @note This method requires the current thread own the GIL.
+*/
+static void Pool_wake(struct Pool* pool)
+{
+    if (pool->running && !pool->signaled)
+    {
+        pool->signaled = true;
+        PyThread_release_lock(pool->wakeup);
+    }
+}
+
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+
+/*
+    Close a connection created by the pool and release the reference to it.
+
+    @note This method releases the GIL.
+    @note This method steals the reference to `connection`.
+*/
+static void Pool_discard(struct Pool* pool, PyObject* connection)
+{
+    assert(pool->nconnections > 0);
+    pool->nconnections--;
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+    /* Replace the connection without waiting for the next scheduled run. */
+    if (pool->nconnections < pool->minsize)
+    {
+        Pool_wake(pool);
+    }
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+    Connection_close_internal((struct Connection*)connection);
+    Py_DECREF(connection);
+}
+
+/*
+    Open a new connection.
+
+    @note This method releases the GIL.
+    @note This method returns a new reference.
+*/
+static PyObject* Pool_connect(struct Pool* pool)
+{
+    PyObject* connection = tds_connect(NULL, pool->args, pool->params);
+    if (connection)
+    {
+        pool->nconnections++;
+    }
+    return connection;
+}
+
+struct PoolConnect
+{
+    struct Pool* pool;
+
+    /* The new connection, or the exception raised opening it. */
+    PyObject* connection;
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+
+    /* Released when the connection attempt completes. */
+    PyThread_type_lock finished;
+};
+
+static void PoolConnect_run(void* arg)
+{
+    struct PoolConnect* connect = (struct PoolConnect*)arg;
+
+    /* tds_connect() releases the GIL while logging in. */
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    connect->connection = tds_connect(NULL, connect->pool->args, connect->pool->params);
+    if (!connect->connection)
+    {
+        PyErr_Fetch(&connect->type, &connect->value, &connect->traceback);
+    }
+    PyGILState_Release(gstate);
+
+    PyThread_release_lock(connect->finished);
+}
+
+/*
+    Open new connections concurrently, each on its own thread, and add them
+    to the idle list. Connections are opened in rounds of at most
+    `Pool_CONNECT_CONCURRENCY`, stopping after a round with any failures.
+
+    @note This method releases the GIL.
+    @note This method sets an appropriate Python exception on failure.
+
+    @param pool [in] The pool.
+    @param count [in] The number of connections to open.
+
+    @return 0 on success, -1 if any connection failed to open.
+*/
+static int Pool_connect_many(struct Pool* pool, size_t count)
+{
+    PyObject* type = NULL;
+    PyObject* value = NULL;
+    PyObject* traceback = NULL;
+
+#if PY_VERSION_HEX < 0x03070000
+    /* The connection threads acquire the GIL. */
+    PyEval_InitThreads();
+#endif /* if PY_VERSION_HEX < 0x03070000 */
+
+    while (count && !pool->closed && !type)
+    {
+        struct PoolConnect connects[Pool_CONNECT_CONCURRENCY];
+        size_t nconnects = (count < Pool_CONNECT_CONCURRENCY) ? count : Pool_CONNECT_CONCURRENCY;
+        size_t started;
+        size_t ix;
+
+        memset(connects, 0, sizeof(connects));
+        for (started = 0; started < nconnects; ++started)
+        {
+            struct PoolConnect* connect = &connects[started];
+            connect->pool = pool;
+            connect->finished = PyThread_allocate_lock();
+            if (!connect->finished)
+            {
+                break;
+            }
+            (void)PyThread_acquire_lock(connect->finished, WAIT_LOCK);
+            if (-1 == (long)PyThread_start_new_thread(PoolConnect_run, connect))
+            {
+                PyThread_free_lock(connect->finished);
+                break;
+            }
+        }
+        if (!started)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "failed to start pool connection thread");
+            return -1;
+        }
+        count -= started;
+
+        Py_BEGIN_ALLOW_THREADS
+            for (ix = 0; ix < started; ++ix)
+            {
+                (void)PyThread_acquire_lock(connects[ix].finished, WAIT_LOCK);
+            }
+        Py_END_ALLOW_THREADS
+
+        /* Add all new connections to the pool before any may release the GIL. */
+        for (ix = 0; ix < started; ++ix)
+        {
+            struct PoolConnect* connect = &connects[ix];
+            PyThread_release_lock(connect->finished);
+            PyThread_free_lock(connect->finished);
+
+            if (connect->connection)
+            {
+                pool->nconnections++;
+                if (!pool->closed && (0 == Pool_push(pool, connect->connection)))
+                {
+                    connect->connection = NULL;
+                }
+                else if (PyErr_Occurred())
+                {
+                    PyErr_Fetch(&connect->type, &connect->value, &connect->traceback);
+                }
+            }
+
+            /* Keep the first error. */
+            if (connect->type && !type)
+            {
+                type = connect->type;
+                value = connect->value;
+                traceback = connect->traceback;
+                connect->type = connect->value = connect->traceback = NULL;
+            }
+        }
+
+        for (ix = 0; ix < started; ++ix)
+        {
+            struct PoolConnect* connect = &connects[ix];
+            if (connect->connection)
+            {
+                Pool_discard(pool, connect->connection);
+            }
+            Py_XDECREF(connect->type);
+            Py_XDECREF(connect->value);
+            Py_XDECREF(connect->traceback);
+        }
+    }
+
+    if (type)
+    {
+        PyErr_Restore(type, value, traceback);
+        return -1;
+    }
+    return 0;
+}
+
+static bool Pool_expired(const struct Pool* pool, const struct PoolEntry* entry, double now)
+{
+    return (pool->idlettl >= 0) && ((entry->released + pool->idlettl) <= now);
+}
+
+/*
+    Close all idle connections.
+*/
+static void Pool_clear(struct Pool* pool)
+{
+    while (pool->head)
+    {
+        PyObject* connection = pool->head->connection;
+        Pool_unlink(pool, pool->head);
+        Pool_discard(pool, connection);
+    }
+}
+
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+
+/*
+    Close expired idle connections and open new connections until the pool
+    contains at least `minsize` connections.
+
+    @note This method requires the current thread own the GIL.
+*/
+static void Pool_maintain(struct Pool* pool)
+{
+    double now = Clock_monotonic();
+    while (!pool->closed && pool->tail && Pool_expired(pool, pool->tail, now))
+    {
+        PyObject* connection = pool->tail->connection;
+        Pool_unlink(pool, pool->tail);
+        Pool_discard(pool, connection);
+    }
+
+    if (!pool->closed && (pool->nconnections < pool->minsize))
+    {
+        if (0 != Pool_connect_many(pool, pool->minsize - pool->nconnections))
+        {
+            /* Retry on the next run. */
+            PyErr_Clear();
+        }
+    }
+}
+
+static void Pool_maintenance_run(void* arg)
+{
+    struct Pool* pool = (struct Pool*)arg;
+
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    while (!pool->stopping)
+    {
+        PyLockStatus status;
+
+        Pool_maintain(pool);
+
+        Py_BEGIN_ALLOW_THREADS
+            status = PyThread_acquire_lock_timed(pool->wakeup, pool->interval, 0);
+        Py_END_ALLOW_THREADS
+
+        if (PY_LOCK_ACQUIRED == status)
+        {
+            pool->signaled = false;
+        }
+    }
+    PyGILState_Release(gstate);
+
+    /* The pool may be freed once this is released. */
+    PyThread_release_lock(pool->finished);
+}
+
+static void Pool_maintenance_stop(struct Pool* pool); /* forward declaration */
+
+static PyObject* Pool_atexit(PyObject* self, PyObject* args)
+{
+    while (s_running)
+    {
+        Pool_maintenance_stop(s_running);
+    }
+    Py_RETURN_NONE;
+    UNUSED(self);
+    UNUSED(args);
+}
+
+static PyMethodDef s_Pool_atexit_def = {
+    "_pool_atexit", Pool_atexit, METH_NOARGS, NULL
+};
+
+static int Pool_register_atexit(void)
+{
+    static bool s_registered = false;
+    if (!s_registered)
+    {
+        PyObject* result = NULL;
+        PyObject* atexit = PyImport_ImportModule("atexit");
+        if (atexit)
+        {
+            PyObject* function = PyCFunction_New(&s_Pool_atexit_def, NULL);
+            if (function)
+            {
+                result = PyObject_CallMethod(atexit, "register", "O", function);
+                Py_DECREF(function);
+            }
+            Py_DECREF(atexit);
+        }
+        if (!result)
+        {
+            return -1;
+        }
+        Py_DECREF(result);
+        s_registered = true;
+    }
+    return 0;
+}
+
+static int Pool_maintenance_start(struct Pool* pool)
+{
+    double interval = Pool_MAINTENANCE_INTERVAL;
+    if ((pool->idlettl >= 0) && (pool->idlettl / 2 < interval))
+    {
+        interval = (pool->idlettl / 2 < Pool_MAINTENANCE_INTERVAL_MIN) ?
+            Pool_MAINTENANCE_INTERVAL_MIN : pool->idlettl / 2;
+    }
+    pool->interval = (PY_TIMEOUT_T)(interval * 1000000);
+
+    if (0 != Pool_register_atexit())
+    {
+        return -1;
+    }
+
+    pool->wakeup = PyThread_allocate_lock();
+    pool->finished = PyThread_allocate_lock();
+    if (!pool->wakeup || !pool->finished)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+    (void)PyThread_acquire_lock(pool->wakeup, WAIT_LOCK);
+    (void)PyThread_acquire_lock(pool->finished, WAIT_LOCK);
+
+#if PY_VERSION_HEX < 0x03070000
+    /* The maintenance thread acquires the GIL. */
+    PyEval_InitThreads();
+#endif /* if PY_VERSION_HEX < 0x03070000 */
+
+    if (-1 == (long)PyThread_start_new_thread(Pool_maintenance_run, pool))
+    {
+        PyErr_SetString(PyExc_RuntimeError, "failed to start pool maintenance thread");
+        return -1;
+    }
+    pool->running = true;
+    pool->next_running = s_running;
+    s_running = pool;
+    return 0;
+}
+
+static void Pool_maintenance_stop(struct Pool* pool)
+{
+    if (pool->running)
+    {
+        struct Pool** running = &s_running;
+        while (*running != pool)
+        {
+            running = &(*running)->next_running;
+        }
+        *running = pool->next_running;
+
+        pool->stopping = true;
+        Pool_wake(pool);
+        pool->running = false;
+
+        /* The maintenance thread requires the GIL to finish. */
+        Py_BEGIN_ALLOW_THREADS
+            (void)PyThread_acquire_lock(pool->finished, WAIT_LOCK);
+        Py_END_ALLOW_THREADS
+
+        PyThread_release_lock(pool->finished);
+    }
+}
+
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+
+static void Pool_close_internal(struct Pool* pool)
+{
+    pool->closed = true;
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+    Pool_maintenance_stop(pool);
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+    Pool_clear(pool);
+}
+
+static void Pool_dealloc(PyObject* self)
+{
+    struct Pool* pool = (struct Pool*)self;
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+
+    /* Closing connections must not clobber any exception currently being raised. */
+    PyErr_Fetch(&type, &value, &traceback);
+    Pool_close_internal(pool);
+    PyErr_Restore(type, value, traceback);
+
+    while (pool->free)
+    {
+        struct PoolEntry* entry = pool->free;
+        pool->free = entry->next;
+        tds_mem_free(entry);
+    }
+
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+    if (pool->wakeup)
+    {
+        PyThread_free_lock(pool->wakeup);
+    }
+    if (pool->finished)
+    {
+        PyThread_free_lock(pool->finished);
+    }
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+
+    Py_XDECREF(pool->params);
+    Py_XDECREF(pool->args);
+    PyObject_Del(self);
+}
+
+/*
+    Parse a non-negative integer pool size.
+
+    @return 0 on success, -1 on failure.
+*/
+static int Pool_parse_size(PyObject* value, size_t* size)
+{
+    if (!(
+#if PY_MAJOR_VERSION < 3
+             PyInt_Check(value) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+             PyLong_Check(value)
+       ) || PyBool_Check(value))
+    {
+        PyErr_SetObject(PyExc_TypeError, value);
+        return -1;
+    }
+#if PY_MAJOR_VERSION < 3
+    if (PyInt_Check(value))
+    {
+        Py_ssize_t value_ = PyInt_AsSsize_t(value);
+        if (value_ < 0)
+        {
+            PyErr_SetObject(PyExc_ValueError, value);
+            return -1;
+        }
+        *size = (size_t)value_;
+    }
+    else
+#endif /* if PY_MAJOR_VERSION < 3 */
+    {
+        *size = PyLong_AsSize_t(value);
+    }
+    return (PyErr_Occurred()) ? -1 : 0;
+}
+
+PyTypeObject PoolType; /* forward declaration */
+
+static PyObject* Pool_new(PyTypeObject* type, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "params",
+        "minsize",
+        "maxsize",
+        "idlettl",
+        "prewarm",
+        "reset",
+        NULL
+    };
+    PyObject* params;
+    PyObject* minsize = NULL;
+    PyObject* maxsize = Py_None;
+    PyObject* idlettl = Py_None;
+    PyObject* prewarm = Py_False;
+    PyObject* reset = Py_False;
+
+    struct Pool* pool;
+
+    size_t minsize_ = 0;
+    size_t maxsize_ = Pool_UNLIMITED;
+    double idlettl_ = -1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|OOOO!O!", s_kwlist, &PyDict_Type, &params,
+                                     &minsize, &maxsize, &idlettl, &PyBool_Type, &prewarm,
+                                     &PyBool_Type, &reset))
+    {
+        return NULL;
+    }
+
+    if (minsize && (0 != Pool_parse_size(minsize, &minsize_)))
+    {
+        return NULL;
+    }
+
+    if (Py_None != maxsize)
+    {
+        if (0 != Pool_parse_size(maxsize, &maxsize_))
+        {
+            return NULL;
+        }
+        if (maxsize_ < minsize_)
+        {
+            PyErr_SetObject(PyExc_ValueError, maxsize);
+            return NULL;
+        }
+    }
+
+    if (Py_None != idlettl)
+    {
+        if (!(
+#if PY_MAJOR_VERSION < 3
+                 PyInt_Check(idlettl) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+                 PyLong_Check(idlettl) || PyFloat_Check(idlettl)
+           ) || PyBool_Check(idlettl))
+        {
+            PyErr_SetObject(PyExc_TypeError, idlettl);
+            return NULL;
+        }
+        idlettl_ = PyFloat_AsDouble(idlettl);
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+        if (idlettl_ < 0)
+        {
+            PyErr_SetObject(PyExc_ValueError, idlettl);
+            return NULL;
+        }
+    }
+
+    pool = PyObject_New(struct Pool, &PoolType);
+    if (!pool)
+    {
+        return NULL;
+    }
+    pool->id = ++s_last_id;
+    pool->head = pool->tail = pool->free = NULL;
+    pool->nidle = pool->nconnections = 0;
+    pool->minsize = minsize_;
+    pool->maxsize = maxsize_;
+    pool->idlettl = idlettl_;
+    pool->reset = (Py_True == reset);
+    pool->closed = false;
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+    pool->wakeup = pool->finished = NULL;
+    pool->signaled = pool->stopping = false;
+    pool->interval = 0;
+    pool->running = false;
+    pool->next_running = NULL;
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+
+    /* Copy the parameters so later changes by the caller don't apply to the pool. */
+    pool->params = PyDict_Copy(params);
+    pool->args = PyTuple_New(0);
+    if (!pool->params || !pool->args)
+    {
+        Py_DECREF(pool);
+        return NULL;
+    }
+
+    if ((Py_True == prewarm) && (0 != Pool_connect_many(pool, pool->minsize)))
+    {
+        Py_DECREF(pool);
+        return NULL;
+    }
+
+#ifdef CTDS_HAVE_POOL_MAINTENANCE
+    if ((pool->minsize > 0) || (pool->idlettl >= 0))
+    {
+        if (0 != Pool_maintenance_start(pool))
+        {
+            Py_DECREF(pool);
+            return NULL;
+        }
+    }
+#endif /* ifdef CTDS_HAVE_POOL_MAINTENANCE */
+
+    return (PyObject*)pool;
+
+    UNUSED(type);
+}
+
+static Py_ssize_t Pool_len(PyObject* self)
+{
+    return (Py_ssize_t)((struct Pool*)self)->nidle;
+}
+
+static PySequenceMethods Pool_as_sequence = {
+    Pool_len,  /* sq_length */
+    NULL,      /* sq_concat */
+    NULL,      /* sq_repeat */
+    NULL,      /* sq_item */
+    NULL,      /* sq_slice */
+    NULL,      /* sq_ass_item */
+    NULL,      /* sq_ass_slice */
+    NULL,      /* sq_contains */
+    NULL,      /* sq_inplace_concat */
+    NULL       /* sq_inplace_repeat */
+};
+
+
+static const char s_Pool_closed_doc[] =
+    "Whether the pool has been closed.\n"
+    "\n"
+    ":rtype: bool\n";
+
+static PyObject* Pool_closed_get(PyObject* self, void* closure)
+{
+    PyObject* closed = (((struct Pool*)self)->closed) ? Py_True : Py_False;
+    Py_INCREF(closed);
+    return closed;
+    UNUSED(closure);
+}
+
+static const char s_Pool_idlettl_doc[] =
+    "The maximum time, in seconds, a connection can sit idle in the pool\n"
+    "before it is closed or :py:data:`None` if idle connections are retained\n"
+    "indefinitely.\n"
+    "\n"
+    ":rtype: float\n";
+
+static PyObject* Pool_idlettl_get(PyObject* self, void* closure)
+{
+    const struct Pool* pool = (const struct Pool*)self;
+    if (pool->idlettl < 0)
+    {
+        Py_RETURN_NONE;
+    }
+    return PyFloat_FromDouble(pool->idlettl);
+    UNUSED(closure);
+}
+
+static const char s_Pool_maxsize_doc[] =
+    "The maximum number of idle connections retained by the pool or\n"
+    ":py:data:`None` if unlimited.\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* Pool_maxsize_get(PyObject* self, void* closure)
+{
+    const struct Pool* pool = (const struct Pool*)self;
+    if (Pool_UNLIMITED == pool->maxsize)
+    {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromSize_t(pool->maxsize);
+    UNUSED(closure);
+}
+
+static const char s_Pool_minsize_doc[] =
+    "The minimum number of connections the pool keeps open.\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* Pool_minsize_get(PyObject* self, void* closure)
+{
+    return PyLong_FromSize_t(((struct Pool*)self)->minsize);
+    UNUSED(closure);
+}
+
+static const char s_Pool_reset_doc[] =
+    "Whether the session state of connections is reset when they are\n"
+    "released to the pool.\n"
+    "\n"
+    ":rtype: bool\n";
+
+static PyObject* Pool_reset_get(PyObject* self, void* closure)
+{
+    PyObject* reset = (((struct Pool*)self)->reset) ? Py_True : Py_False;
+    Py_INCREF(reset);
+    return reset;
+    UNUSED(closure);
+}
+
+static const char s_Pool_size_doc[] =
+    "The number of open connections created by the pool, both idle and\n"
+    "acquired.\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* Pool_size_get(PyObject* self, void* closure)
+{
+    return PyLong_FromSize_t(((struct Pool*)self)->nconnections);
+    UNUSED(closure);
+}
+
+static PyGetSetDef Pool_getset[] = {
+    /* name, get, set, doc, closure */
+    { (char*)"closed",  Pool_closed_get,  NULL, (char*)s_Pool_closed_doc,  NULL },
+    { (char*)"idlettl", Pool_idlettl_get, NULL, (char*)s_Pool_idlettl_doc, NULL },
+    { (char*)"maxsize", Pool_maxsize_get, NULL, (char*)s_Pool_maxsize_doc, NULL },
+    { (char*)"minsize", Pool_minsize_get, NULL, (char*)s_Pool_minsize_doc, NULL },
+    { (char*)"reset",   Pool_reset_get,   NULL, (char*)s_Pool_reset_doc,   NULL },
+    { (char*)"size",    Pool_size_get,    NULL, (char*)s_Pool_size_doc,    NULL },
+    { NULL,             NULL,             NULL, NULL,                      NULL }
+};
+
+
+static const char s_Pool_acquire_doc[] =
+    "acquire()\n"
+    "\n"
+    "Get a connection from the pool. The most recently released idle\n"
+    "connection is returned, if any, otherwise a new connection is created.\n"
+    "\n"
+    ":raises ctds.InterfaceError: The pool is closed.\n"
+    ":return: A connection.\n"
+    ":rtype: ctds.Connection\n";
+
+static PyObject* Pool_acquire(PyObject* self, PyObject* args)
+{
+    struct Pool* pool = (struct Pool*)self;
+    PyObject* connection = NULL;
+    double now;
+
+    if (pool->closed)
+    {
+        PyErr_SetString(PyExc_tds_InterfaceError, "pool closed");
+        return NULL;
+    }
+
+    now = Clock_monotonic();
+    while (pool->head)
+    {
+        bool expired = Pool_expired(pool, pool->head, now);
+        connection = pool->head->connection;
+        Pool_unlink(pool, pool->head);
+        if (!expired && !Connection_closed((struct Connection*)connection))
+        {
+            break;
+        }
+        Pool_discard(pool, connection);
+        connection = NULL;
+    }
+
+    if (!connection)
+    {
+        connection = Pool_connect(pool);
+    }
+    if (connection)
+    {
+        Connection_set_pool((struct Connection*)connection, pool->id);
+        Latency_record_seconds(LatencyMetric_pool_acquire, Clock_monotonic() - now);
+    }
+
+    return connection;
+    UNUSED(args);
+}
+
+static const char s_Pool_release_doc[] =
+    "release(connection)\n"
+    "\n"
+    "Return a connection acquired from the pool. Any pending transaction is\n"
+    "rolled back, unless :py:attr:`ctds.Connection.in_transaction` is\n"
+    ":py:data:`False`. If :py:attr:`.reset` is :py:data:`True`, the\n"
+    "connection's session state is then reset, as by\n"
+    ":py:meth:`ctds.Connection.reset`. The connection is closed instead if\n"
+    "the rollback fails, the pool is closed or the pool already holds\n"
+    ":py:attr:`.maxsize` idle connections.\n"
+    "\n"
+    ".. note:: This must be called once for every successful call to\n"
+    "    :py:meth:`.acquire()`.\n"
+    "\n"
+    ":param ctds.Connection connection: The connection returned by\n"
+    "    :py:meth:`.acquire()`.\n"
+    ":raises ValueError: The connection was not acquired from the pool or\n"
+    "    was already released.\n";
+
+static PyObject* Pool_release(PyObject* self, PyObject* args)
+{
+    struct Pool* pool = (struct Pool*)self;
+    PyObject* connection;
+
+    if (!PyArg_ParseTuple(args, "O!", &ConnectionType, &connection))
+    {
+        return NULL;
+    }
+
+    /* Only connections acquired, and not yet released, count towards `size`. */
+    if (pool->id != Connection_pool((struct Connection*)connection))
+    {
+        PyErr_SetString(PyExc_ValueError, "connection not acquired from this pool");
+        return NULL;
+    }
+    Connection_set_pool((struct Connection*)connection, 0);
+
+    Py_INCREF(connection);
+    if (Connection_closed((struct Connection*)connection))
+    {
+        Pool_discard(pool, connection);
+        Py_RETURN_NONE;
+    }
+
+    if (Connection_in_transaction((struct Connection*)connection) &&
+        (0 != Connection_transaction_rollback((struct Connection*)connection)))
+    {
+        PyErr_Clear();
+        Pool_discard(pool, connection);
+        Py_RETURN_NONE;
+    }
+
+    /*
+        The session reset is sent with the connection's next command. Any
+        transaction is rolled back above to release its locks immediately.
+    */
+    if (pool->reset && (0 != Connection_reset_session((struct Connection*)connection)))
+    {
+        PyErr_Clear();
+        Pool_discard(pool, connection);
+        Py_RETURN_NONE;
+    }
+
+    if (pool->closed || (pool->nidle >= pool->maxsize) || (0 != Pool_push(pool, connection)))
+    {
+        PyErr_Clear();
+        Pool_discard(pool, connection);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static const char s_Pool_close_doc[] =
+    "close()\n"
+    "\n"
+    "Close the pool and all idle connections, and stop the background\n"
+    "maintenance thread. Connections released to a closed pool are closed.\n";
+
+static PyObject* Pool_close(PyObject* self, PyObject* args)
+{
+    Pool_close_internal((struct Pool*)self);
+    Py_RETURN_NONE;
+    UNUSED(args);
+}
+
+#ifdef __GNUC__
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif /* ifdef __GNUC__ */
+
+static PyMethodDef Pool_methods[] = {
+    /* ml_name, ml_meth, ml_flags, ml_doc */
+    { "acquire", Pool_acquire, METH_NOARGS,  s_Pool_acquire_doc },
+    { "close",   Pool_close,   METH_NOARGS,  s_Pool_close_doc },
+    { "release", Pool_release, METH_VARARGS, s_Pool_release_doc },
+    { NULL,      NULL,         0,            NULL }
+};
+
+#ifdef __GNUC__
+#  pragma GCC diagnostic pop
+#endif /* ifdef __GNUC__ */
+
+static const char s_tds_Pool_doc[] =
+    "Pool(params, minsize=0, maxsize=None, idlettl=None, prewarm=False, reset=False)\n"
+    "\n"
+    "A pool of :py:class:`ctds.Connection` objects, implemented natively.\n"
+    "Acquiring and releasing a connection take constant time and require no\n"
+    "lock other than the GIL. The most recently released connection is\n"
+    "reused first, so surplus connections remain idle and expire.\n"
+    "\n"
+    "If `minsize` or `idlettl` is specified, a background thread closes\n"
+    "expired idle connections and opens connections until the pool contains\n"
+    "at least `minsize` connections. Connections are opened concurrently,\n"
+    "each on its own thread, and closed connections are replaced\n"
+    "immediately. The background thread requires Python 3.2 or later; on\n"
+    "earlier versions expired connections are only closed by\n"
+    ":py:meth:`.acquire()`.\n"
+    "\n"
+    ".. code-block:: python\n"
+    "\n"
+    "    pool = ctds.Pool({'server': 'my-host', 'autocommit': True}, minsize=4)\n"
+    "\n"
+    "    connection = pool.acquire()\n"
+    "    try:\n"
+    "        with connection.cursor() as cursor:\n"
+    "            cursor.execute('SELECT @@VERSION')\n"
+    "    finally:\n"
+    "        pool.release(connection)\n"
+    "\n"
+    "    pool.close()\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param dict params: The keyword arguments to pass to\n"
+    "    :py:func:`ctds.connect` when creating a new connection.\n"
+    ":param int minsize: The minimum number of connections, idle or\n"
+    "    acquired, to keep open.\n"
+    ":param int maxsize: The maximum number of idle connections to retain.\n"
+    "    By default the number is unlimited.\n"
+    ":param float idlettl: The maximum time, in seconds, a connection can sit\n"
+    "    idle before it is closed. By default idle connections are retained\n"
+    "    indefinitely.\n"
+    ":param bool prewarm: Open `minsize` connections, concurrently, before\n"
+    "    returning. If any connection cannot be opened, the error is raised.\n"
+    "    By default connections are opened in the background.\n"
+    ":param bool reset: Reset the session state of connections when they are\n"
+    "    released, as by :py:meth:`ctds.Connection.reset`. The reset is sent\n"
+    "    with the next command on the connection, without an additional round\n"
+    "    trip in most cases.\n";
+
+PyTypeObject PoolType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "ctds.Pool",                  /* tp_name */
+    sizeof(struct Pool),          /* tp_basicsize */
+    0,                            /* tp_itemsize */
+    Pool_dealloc,                 /* tp_dealloc */
+#if PY_VERSION_HEX >= 0x03080000
+    0,                            /* tp_vectorcall_offset */
+#else
+    NULL,                         /* tp_print */
+#endif /* if PY_VERSION_HEX >= 0x03080000 */
+    NULL,                         /* tp_getattr */
+    NULL,                         /* tp_setattr */
+    NULL,                         /* tp_reserved */
+    NULL,                         /* tp_repr */
+    NULL,                         /* tp_as_number */
+    &Pool_as_sequence,            /* tp_as_sequence */
+    NULL,                         /* tp_as_mapping */
+    NULL,                         /* tp_hash */
+    NULL,                         /* tp_call */
+    NULL,                         /* tp_str */
+    NULL,                         /* tp_getattro */
+    NULL,                         /* tp_setattro */
+    NULL,                         /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,           /* tp_flags */
+    s_tds_Pool_doc,               /* tp_doc */
+    NULL,                         /* tp_traverse */
+    NULL,                         /* tp_clear */
+    NULL,                         /* tp_richcompare */
+    0,                            /* tp_weaklistoffset */
+    NULL,                         /* tp_iter */
+    NULL,                         /* tp_iternext */
+    Pool_methods,                 /* tp_methods */
+    NULL,                         /* tp_members */
+    Pool_getset,                  /* tp_getset */
+    NULL,                         /* tp_base */
+    NULL,                         /* tp_dict */
+    NULL,                         /* tp_descr_get */
+    NULL,                         /* tp_descr_set */
+    0,                            /* tp_dictoffset */
+    NULL,                         /* tp_init */
+    NULL,                         /* tp_alloc */
+    Pool_new,                     /* tp_new */
+    NULL,                         /* tp_free */
+    NULL,                         /* tp_is_gc */
+    NULL,                         /* tp_bases */
+    NULL,                         /* tp_mro */
+    NULL,                         /* tp_cache */
+    NULL,                         /* tp_subclasses */
+    NULL,                         /* tp_weaklist */
+    NULL,                         /* tp_del */
+    0,                            /* tp_version_tag */
+#if PY_VERSION_HEX >= 0x03040000
+    NULL,                         /* tp_finalize */
+#endif /* if PY_VERSION_HEX >= 0x03040000 */
+#if PY_VERSION_HEX >= 0x03080000
+    NULL,                         /* tp_vectorcall */
+#  if PY_VERSION_HEX < 0x03090000
+    NULL,                         /* tp_print */
+#  endif /* if PY_VERSION_HEX < 0x03090000 */
+#endif /* if PY_VERSION_HEX >= 0x03080000 */
+};
+
+PyTypeObject* PoolType_init(void)
+{
+    if (0 != PyType_Ready(&PoolType))
+    {
+        return NULL;
+    }
+    return &PoolType;
+}
+
+#ifdef __clang__
+#  if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8
+#    pragma clang diagnostic pop
+#  endif /* if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8 */
+#endif /* ifdef __clang__ */
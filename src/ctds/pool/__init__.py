@@ -42,6 +42,10 @@ class ConnectionPool(object): # pylint: disable=too-many-instance-attributes,use
         :py:meth:`.acquire()` and does not happen automatically in the
         background.
 
+    .. seealso:: :py:class:`ctds.Pool`, a native pool of
+        :py:class:`ctds.Connection` objects which collects idle connections
+        in the background.
+
     :param dbapi2: The DB-API 2 module used to create connections.
         This module must implement the :pep:`0249` specification.
 
@@ -59,6 +63,13 @@ class ConnectionPool(object): # pylint: disable=too-many-instance-attributes,use
         pool? This is only applicable when a `maxsize` value is specified. If
         `False`, a new connection will be created as needed, but the number of
         connections retained in the pool will never exceed `maxsize`.
+
+    :param bool reset: Reset the session state of connections when they are
+        released to the pool by calling :py:meth:`ctds.Connection.reset()`.
+        This requires the connections to be :py:class:`ctds.Connection`
+        objects.
+
+        .. versionadded:: 1.15
     '''
 
     # Use __slots__ to minimize footprint.
@@ -71,6 +82,7 @@ class ConnectionPool(object): # pylint: disable=too-many-instance-attributes,use
         '_maxsize',
         '_nconnections',
         '_pool',
+        '_reset',
     )
 
     def __init__( # pylint: disable=too-many-arguments
@@ -80,6 +92,7 @@ class ConnectionPool(object): # pylint: disable=too-many-instance-attributes,use
             idlettl=None,
             maxsize=None,
             block=False,
+            reset=False,
     ):
         self._dbapi2 = dbapi2
         self._connection_args = params
@@ -92,6 +105,7 @@ class ConnectionPool(object): # pylint: disable=too-many-instance-attributes,use
         self._maxsize = maxsize
         self._block = block
         self._idlettl = idlettl
+        self._reset = reset
 
         # Pool of connections. Ordered from least to most recently used.
         self._pool = []
@@ -155,7 +169,8 @@ class ConnectionPool(object): # pylint: disable=too-many-instance-attributes,use
         Return a connection back to the pool.
 
         Prior to release, :py:meth:`ctds.Connection.rollback()` is called to
-        rollback any pending transaction.
+        rollback any pending transaction. If the pool was created with
+        `reset=True`, :py:meth:`ctds.Connection.reset()` is then called.
 
         .. note:: This must be called once for every successful call to
             :py:meth:`.acquire()`.
@@ -166,6 +181,8 @@ class ConnectionPool(object): # pylint: disable=too-many-instance-attributes,use
         try:
             # Rollback the existing connection, closing on failure.
             connection.rollback()
+            if self._reset:
+                connection.reset()
         except self._dbapi2.Error:
             self._close(connection)
             return
@@ -4,6 +4,7 @@
 #include <datetime.h>
 #include "include/pop_warnings.h"
 
+#include <string.h>
 #include <sys/types.h>
 
 #include "include/pyutils.h"
@@ -157,6 +158,49 @@ PyObject* PyUuid_FromBytes(const char* bytes, Py_ssize_t size)
 }
 
 
+/* Mask of the high bit of each byte in a machine word. */
+#define ASCII_WORD_MASK (((size_t)-1 / 0xFF) * 0x80)
+
+/* Returns non-zero if `str` contains only 7-bit ASCII characters. */
+static int is_ascii(const char* str, size_t size)
+{
+    const unsigned char* it = (const unsigned char*)str;
+    const unsigned char* end = it + size;
+
+    /* Check a byte at a time until aligned, then a word at a time. */
+    for (; (it < end) && ((size_t)it % sizeof(size_t)); ++it)
+    {
+        if (*it & 0x80) return 0;
+    }
+    for (; (size_t)(end - it) >= sizeof(size_t); it += sizeof(size_t))
+    {
+        if (*((const size_t*)it) & ASCII_WORD_MASK) return 0;
+    }
+    for (; it < end; ++it)
+    {
+        if (*it & 0x80) return 0;
+    }
+    return 1;
+}
+
+PyObject* unicode_from_utf8(const char* str, Py_ssize_t size)
+{
+#if PY_VERSION_HEX >= 0x03030000
+    if (is_ascii(str, (size_t)size))
+    {
+        PyObject* unicode = PyUnicode_New(size, 127);
+        if (unicode)
+        {
+            memcpy(PyUnicode_1BYTE_DATA(unicode), str, (size_t)size);
+        }
+        return unicode;
+    }
+#endif /* if PY_VERSION_HEX >= 0x03030000 */
+
+    return PyUnicode_DecodeUTF8(str, size, "strict");
+}
+
+
 int PyDateTimeType_init(void)
 {
     assert(!PyDateTimeAPI);
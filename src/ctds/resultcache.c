@@ -0,0 +1,775 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include "include/pop_warnings.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <stddef.h>
+
+#include "include/clock.h"
+#include "include/macros.h"
+#include "include/resultcache.h"
+#include "include/tds.h"
+
+#ifdef __clang__
+# if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8
+/* Ignore "'tp_print' has been explicitly marked deprecated here" */
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#  endif /* if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8 */
+#endif /* ifdef __clang__ */
+
+
+#define ResultCache_UNLIMITED ((size_t)-1)
+
+struct ResultCacheEntry
+{
+    /* The key of the entry in the cache's `entries` dictionary. */
+    PyObject* key;
+
+    /* The SQL text which produced the result. */
+    PyObject* sql;
+
+    /* The cached result. */
+    PyObject* value;
+    size_t size;
+
+    /* The time, in seconds, after which the entry is expired. */
+    double expires;
+
+    /* The least recently used list links. */
+    struct ResultCacheEntry* prev;
+    struct ResultCacheEntry* next;
+};
+
+struct ResultCache
+{
+    PyObject_HEAD
+
+    /* Mapping of keys to `struct ResultCacheEntry` pointers. */
+    PyObject* entries;
+
+    /* The most and least recently used entries. */
+    struct ResultCacheEntry* head;
+    struct ResultCacheEntry* tail;
+
+    /* The total size of all cached results, in bytes. */
+    size_t memory;
+    size_t max_memory;
+
+    /* The time-to-live of entries, in seconds. Negative if entries never expire. */
+    double ttl;
+
+    unsigned PY_LONG_LONG hits;
+    unsigned PY_LONG_LONG misses;
+};
+
+static void ResultCache_unlink(struct ResultCache* cache, struct ResultCacheEntry* entry)
+{
+    if (entry->prev)
+    {
+        entry->prev->next = entry->next;
+    }
+    else
+    {
+        cache->head = entry->next;
+    }
+    if (entry->next)
+    {
+        entry->next->prev = entry->prev;
+    }
+    else
+    {
+        cache->tail = entry->prev;
+    }
+    entry->prev = entry->next = NULL;
+}
+
+static void ResultCache_link(struct ResultCache* cache, struct ResultCacheEntry* entry)
+{
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head)
+    {
+        cache->head->prev = entry;
+    }
+    else
+    {
+        cache->tail = entry;
+    }
+    cache->head = entry;
+}
+
+/*
+    Remove an entry from the cache and release it.
+*/
+static void ResultCache_evict(struct ResultCache* cache, struct ResultCacheEntry* entry)
+{
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+
+    /* Removal must not clobber any exception currently being raised. */
+    PyErr_Fetch(&type, &value, &traceback);
+    if (0 != PyDict_DelItem(cache->entries, entry->key))
+    {
+        PyErr_Clear();
+    }
+    PyErr_Restore(type, value, traceback);
+
+    ResultCache_unlink(cache, entry);
+    cache->memory -= entry->size;
+
+    Py_DECREF(entry->key);
+    Py_DECREF(entry->sql);
+    Py_DECREF(entry->value);
+    tds_mem_free(entry);
+}
+
+static struct ResultCacheEntry* ResultCache_lookup(struct ResultCache* cache, PyObject* key)
+{
+    PyObject* pointer = PyDict_GetItem(cache->entries, key); /* borrowed reference */
+    return (pointer) ? (struct ResultCacheEntry*)PyLong_AsVoidPtr(pointer) : NULL;
+}
+
+PyObject* ResultCache_get(struct ResultCache* cache, PyObject* key)
+{
+    struct ResultCacheEntry* entry;
+
+    /* PyDict_GetItem() suppresses errors, so hash the key explicitly. */
+    if (-1 == PyObject_Hash(key))
+    {
+        return NULL;
+    }
+
+    entry = ResultCache_lookup(cache, key);
+    if (entry && (cache->ttl >= 0) && (entry->expires <= Clock_monotonic()))
+    {
+        ResultCache_evict(cache, entry);
+        entry = NULL;
+    }
+
+    if (!entry)
+    {
+        cache->misses++;
+        return NULL;
+    }
+
+    cache->hits++;
+
+    /* Move the entry to the front of the least recently used list. */
+    ResultCache_unlink(cache, entry);
+    ResultCache_link(cache, entry);
+
+    Py_INCREF(entry->value);
+    return entry->value;
+}
+
+static void ResultCache_remove(struct ResultCache* cache, PyObject* key)
+{
+    struct ResultCacheEntry* entry = ResultCache_lookup(cache, key);
+    if (entry)
+    {
+        ResultCache_evict(cache, entry);
+    }
+}
+
+int ResultCache_put(struct ResultCache* cache, PyObject* key, PyObject* sql,
+                    PyObject* value, size_t size)
+{
+    struct ResultCacheEntry* entry;
+    PyObject* pointer;
+
+    ResultCache_remove(cache, key);
+    if (size > cache->max_memory)
+    {
+        return 0;
+    }
+
+    entry = tds_mem_malloc(sizeof(struct ResultCacheEntry));
+    if (!entry)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    pointer = PyLong_FromVoidPtr(entry);
+    if (!pointer || (0 != PyDict_SetItem(cache->entries, key, pointer)))
+    {
+        Py_XDECREF(pointer);
+        tds_mem_free(entry);
+        return -1;
+    }
+    Py_DECREF(pointer);
+
+    Py_INCREF(key);
+    entry->key = key;
+    Py_INCREF(sql);
+    entry->sql = sql;
+    Py_INCREF(value);
+    entry->value = value;
+    entry->size = size;
+    entry->expires = (cache->ttl >= 0) ? (Clock_monotonic() + cache->ttl) : 0;
+
+    ResultCache_link(cache, entry);
+    cache->memory += size;
+
+    /* Evict the least recently used entries to make room. */
+    while (cache->memory > cache->max_memory)
+    {
+        assert(cache->tail && (cache->tail != entry));
+        ResultCache_evict(cache, cache->tail);
+    }
+    return 0;
+}
+
+size_t ResultCache_max_memory(const struct ResultCache* cache)
+{
+    return cache->max_memory;
+}
+
+/* Can `c` be part of a word, i.e. a keyword, identifier or variable name? */
+static bool is_word_char(char c)
+{
+    return isalnum((unsigned char)c) || ('_' == c) || ('@' == c) || ('#' == c) ||
+           ('$' == c) || ((unsigned char)c >= 0x80);
+}
+
+/* Is a word the (case-insensitive) keyword? */
+static bool is_keyword(const char* word, size_t nword, const char* keyword)
+{
+    size_t ix;
+    for (ix = 0; ix < nword; ++ix)
+    {
+        if (!keyword[ix] || (toupper((unsigned char)word[ix]) != keyword[ix]))
+        {
+            return false;
+        }
+    }
+    return ('\0' == keyword[nword]);
+}
+
+/* Skip a quoted string or identifier, including escaped closing characters. */
+static const char* skip_quoted(const char* sql, char close)
+{
+    sql++;
+    while (*sql)
+    {
+        if (close == *sql++)
+        {
+            if (close != *sql)
+            {
+                break;
+            }
+            sql++;
+        }
+    }
+    return sql;
+}
+
+bool ResultCache_cacheable(const char* sql)
+{
+    /*
+        Keywords of statements which modify data, state or the session, or
+        which produce messages which are not cached. Their presence anywhere
+        in the text, outside of literals and quoted identifiers, prevents
+        caching.
+    */
+    static const char* s_keywords[] =
+    {
+        "ALTER", "BACKUP", "BEGIN", "BULK", "COMMIT", "CREATE", "DBCC",
+        "DELETE", "DENY", "DROP", "EXEC", "EXECUTE", "GRANT", "INSERT",
+        "INTO", "KILL", "MERGE", "OPENDATASOURCE", "OPENQUERY",
+        "OPENROWSET", "OUTPUT", "PRINT", "RAISERROR", "RESTORE", "REVOKE",
+        "ROLLBACK", "SAVE", "SET", "THROW", "TRUNCATE", "UPDATE", "USE",
+        "WAITFOR"
+    };
+
+    bool first = true;
+
+    /* The previous word. */
+    const char* previous = NULL;
+    size_t nprevious = 0;
+
+    while (*sql)
+    {
+        char c = *sql;
+        if (('-' == c) && ('-' == sql[1]))
+        {
+            while (*sql && ('\n' != *sql))
+            {
+                sql++;
+            }
+        }
+        else if (('/' == c) && ('*' == sql[1]))
+        {
+            /* Comments may be nested. */
+            size_t depth = 1;
+            sql += 2;
+            while (*sql && depth)
+            {
+                if (('/' == sql[0]) && ('*' == sql[1]))
+                {
+                    depth++;
+                    sql += 2;
+                }
+                else if (('*' == sql[0]) && ('/' == sql[1]))
+                {
+                    depth--;
+                    sql += 2;
+                }
+                else
+                {
+                    sql++;
+                }
+            }
+        }
+        else if ('\'' == c)
+        {
+            sql = skip_quoted(sql, '\'');
+        }
+        else if ('[' == c)
+        {
+            sql = skip_quoted(sql, ']');
+        }
+        else if ('"' == c)
+        {
+            sql = skip_quoted(sql, '"');
+        }
+        else if (is_word_char(c))
+        {
+            size_t ix;
+            const char* word = sql;
+            size_t nword;
+            while (is_word_char(*sql))
+            {
+                sql++;
+            }
+            nword = (size_t)(sql - word);
+
+            /* Only queries are cached. */
+            if (first)
+            {
+                if (!is_keyword(word, nword, "SELECT") && !is_keyword(word, nword, "WITH"))
+                {
+                    return false;
+                }
+                first = false;
+            }
+
+            /* Temporary tables are specific to the session. */
+            if ('#' == *word)
+            {
+                return false;
+            }
+
+            for (ix = 0; ix < ARRAYSIZE(s_keywords); ++ix)
+            {
+                if (is_keyword(word, nword, s_keywords[ix]))
+                {
+                    return false;
+                }
+            }
+
+            /* `NEXT VALUE FOR` advances a sequence. */
+            if (previous && is_keyword(previous, nprevious, "NEXT") && is_keyword(word, nword, "VALUE"))
+            {
+                return false;
+            }
+            previous = word;
+            nprevious = nword;
+        }
+        else
+        {
+            sql++;
+        }
+    }
+
+    return !first;
+}
+
+static void ResultCache_dealloc(PyObject* self)
+{
+    struct ResultCache* cache = (struct ResultCache*)self;
+    while (cache->head)
+    {
+        ResultCache_evict(cache, cache->head);
+    }
+    Py_XDECREF(cache->entries);
+    PyObject_Del(self);
+}
+
+PyTypeObject ResultCacheType; /* forward declaration */
+
+static PyObject* ResultCache_new(PyTypeObject* type, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "max_memory",
+        "ttl",
+        NULL
+    };
+    PyObject* max_memory = Py_None;
+    PyObject* ttl = Py_None;
+
+    struct ResultCache* cache;
+
+    size_t max_memory_ = ResultCache_UNLIMITED;
+    double ttl_ = -1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO", s_kwlist, &max_memory, &ttl))
+    {
+        return NULL;
+    }
+
+    if (Py_None != max_memory)
+    {
+        if (!(
+#if PY_MAJOR_VERSION < 3
+                 PyInt_Check(max_memory) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+                 PyLong_Check(max_memory)
+           ) || PyBool_Check(max_memory))
+        {
+            PyErr_SetObject(PyExc_TypeError, max_memory);
+            return NULL;
+        }
+#if PY_MAJOR_VERSION < 3
+        if (PyInt_Check(max_memory))
+        {
+            Py_ssize_t value = PyInt_AsSsize_t(max_memory);
+            if (value < 0)
+            {
+                PyErr_SetObject(PyExc_ValueError, max_memory);
+                return NULL;
+            }
+            max_memory_ = (size_t)value;
+        }
+        else
+#endif /* if PY_MAJOR_VERSION < 3 */
+        {
+            max_memory_ = PyLong_AsSize_t(max_memory);
+        }
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+    }
+
+    if (Py_None != ttl)
+    {
+        if (!(
+#if PY_MAJOR_VERSION < 3
+                 PyInt_Check(ttl) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+                 PyLong_Check(ttl) || PyFloat_Check(ttl)
+           ) || PyBool_Check(ttl))
+        {
+            PyErr_SetObject(PyExc_TypeError, ttl);
+            return NULL;
+        }
+        ttl_ = PyFloat_AsDouble(ttl);
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+        if (ttl_ < 0)
+        {
+            PyErr_SetObject(PyExc_ValueError, ttl);
+            return NULL;
+        }
+    }
+
+    cache = PyObject_New(struct ResultCache, &ResultCacheType);
+    if (!cache)
+    {
+        return NULL;
+    }
+    cache->head = cache->tail = NULL;
+    cache->memory = 0;
+    cache->max_memory = max_memory_;
+    cache->ttl = ttl_;
+    cache->hits = cache->misses = 0;
+
+    cache->entries = PyDict_New();
+    if (!cache->entries)
+    {
+        Py_DECREF(cache);
+        return NULL;
+    }
+    return (PyObject*)cache;
+
+    UNUSED(type);
+}
+
+static Py_ssize_t ResultCache_len(PyObject* self)
+{
+    return PyDict_Size(((struct ResultCache*)self)->entries);
+}
+
+static PySequenceMethods ResultCache_as_sequence = {
+    ResultCache_len,  /* sq_length */
+    NULL,             /* sq_concat */
+    NULL,             /* sq_repeat */
+    NULL,             /* sq_item */
+    NULL,             /* sq_slice */
+    NULL,             /* sq_ass_item */
+    NULL,             /* sq_ass_slice */
+    NULL,             /* sq_contains */
+    NULL,             /* sq_inplace_concat */
+    NULL              /* sq_inplace_repeat */
+};
+
+
+static const char s_ResultCache_hits_doc[] =
+    "The number of executions which were served from the cache.\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* ResultCache_hits_get(PyObject* self, void* closure)
+{
+    return PyLong_FromUnsignedLongLong(((struct ResultCache*)self)->hits);
+    UNUSED(closure);
+}
+
+static const char s_ResultCache_misses_doc[] =
+    "The number of cacheable executions which were not served from the cache.\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* ResultCache_misses_get(PyObject* self, void* closure)
+{
+    return PyLong_FromUnsignedLongLong(((struct ResultCache*)self)->misses);
+    UNUSED(closure);
+}
+
+static const char s_ResultCache_memory_doc[] =
+    "The approximate size, in bytes, of all cached results.\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* ResultCache_memory_get(PyObject* self, void* closure)
+{
+    return PyLong_FromSize_t(((struct ResultCache*)self)->memory);
+    UNUSED(closure);
+}
+
+static const char s_ResultCache_max_memory_doc[] =
+    "The maximum size, in bytes, of all cached results or :py:data:`None` if\n"
+    "unlimited.\n"
+    "\n"
+    ":rtype: int\n";
+
+static PyObject* ResultCache_max_memory_get(PyObject* self, void* closure)
+{
+    const struct ResultCache* cache = (const struct ResultCache*)self;
+    if (ResultCache_UNLIMITED == cache->max_memory)
+    {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromSize_t(cache->max_memory);
+    UNUSED(closure);
+}
+
+static const char s_ResultCache_ttl_doc[] =
+    "The time, in seconds, results are cached for or :py:data:`None` if\n"
+    "results do not expire.\n"
+    "\n"
+    ":rtype: float\n";
+
+static PyObject* ResultCache_ttl_get(PyObject* self, void* closure)
+{
+    const struct ResultCache* cache = (const struct ResultCache*)self;
+    if (cache->ttl < 0)
+    {
+        Py_RETURN_NONE;
+    }
+    return PyFloat_FromDouble(cache->ttl);
+    UNUSED(closure);
+}
+
+static PyGetSetDef ResultCache_getset[] = {
+    /* name, get, set, doc, closure */
+    { (char*)"hits",       ResultCache_hits_get,       NULL, (char*)s_ResultCache_hits_doc,       NULL },
+    { (char*)"max_memory", ResultCache_max_memory_get, NULL, (char*)s_ResultCache_max_memory_doc, NULL },
+    { (char*)"memory",     ResultCache_memory_get,     NULL, (char*)s_ResultCache_memory_doc,     NULL },
+    { (char*)"misses",     ResultCache_misses_get,     NULL, (char*)s_ResultCache_misses_doc,     NULL },
+    { (char*)"ttl",        ResultCache_ttl_get,        NULL, (char*)s_ResultCache_ttl_doc,        NULL },
+    { NULL,                NULL,                       NULL, NULL,                                NULL }
+};
+
+
+static const char s_ResultCache_invalidate_doc[] =
+    "invalidate(sql=None)\n"
+    "\n"
+    "Remove cached results. If `sql` is specified, only the results of\n"
+    "statements with that SQL text are removed, regardless of their\n"
+    "parameters.\n"
+    "\n"
+    ":param str sql: The SQL text of the results to remove.\n";
+
+static PyObject* ResultCache_invalidate(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    struct ResultCache* cache = (struct ResultCache*)self;
+
+    static char* s_kwlist[] =
+    {
+        "sql",
+        NULL
+    };
+    PyObject* sql = Py_None;
+    struct ResultCacheEntry* entry;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", s_kwlist, &sql))
+    {
+        return NULL;
+    }
+
+    entry = cache->head;
+    while (entry)
+    {
+        struct ResultCacheEntry* next = entry->next;
+        if (Py_None == sql)
+        {
+            ResultCache_evict(cache, entry);
+        }
+        else
+        {
+            int equal = PyObject_RichCompareBool(entry->sql, sql, Py_EQ);
+            if (-1 == equal)
+            {
+                return NULL;
+            }
+            if (equal)
+            {
+                ResultCache_evict(cache, entry);
+            }
+        }
+        entry = next;
+    }
+
+    Py_RETURN_NONE;
+}
+
+#ifdef __GNUC__
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif /* ifdef __GNUC__ */
+
+static PyMethodDef ResultCache_methods[] = {
+    /* ml_name, ml_meth, ml_flags, ml_doc */
+    { "invalidate", (PyCFunction)ResultCache_invalidate, METH_VARARGS | METH_KEYWORDS, s_ResultCache_invalidate_doc },
+    { NULL,         NULL,                                0,                            NULL }
+};
+
+#ifdef __GNUC__
+#  pragma GCC diagnostic pop
+#endif /* ifdef __GNUC__ */
+
+static const char s_tds_ResultCache_doc[] =
+    "ResultCache(max_memory=None, ttl=None)\n"
+    "\n"
+    "A client-side cache of the results of :py:meth:`ctds.Cursor.execute`.\n"
+    "Assign a cache to :py:attr:`ctds.Connection.result_cache` and pass\n"
+    "``cache=True`` to :py:meth:`ctds.Cursor.execute` to serve repeated\n"
+    "executions of the same statement, with the same parameters, by the same\n"
+    "login on the same server and database from the cache rather than the\n"
+    "server.\n"
+    "\n"
+    "The raw result data is cached, so cached results are converted to Python\n"
+    "objects with the converters of the executing cursor. Only read-only\n"
+    "queries, i.e. ``SELECT`` statements without ``INTO`` or ``OUTPUT``\n"
+    "clauses or output parameters, which produce a single result set are\n"
+    "cached, and only once all of its rows have been fetched.\n"
+    "\n"
+    ".. warning::\n"
+    "\n"
+    "    A statement served from the cache is not executed. Only use a cache\n"
+    "    for statements without side effects, such as calls to functions\n"
+    "    which modify state.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param int max_memory: The maximum size, in bytes, of all cached results.\n"
+    "    The least recently used results are evicted to remain within this\n"
+    "    limit. By default the size is unlimited.\n"
+    ":param float ttl: The time, in seconds, to cache results for. By default\n"
+    "    results do not expire.\n";
+
+PyTypeObject ResultCacheType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "ctds.ResultCache",           /* tp_name */
+    sizeof(struct ResultCache),   /* tp_basicsize */
+    0,                            /* tp_itemsize */
+    ResultCache_dealloc,          /* tp_dealloc */
+#if PY_VERSION_HEX >= 0x03080000
+    0,                            /* tp_vectorcall_offset */
+#else
+    NULL,                         /* tp_print */
+#endif /* if PY_VERSION_HEX >= 0x03080000 */
+    NULL,                         /* tp_getattr */
+    NULL,                         /* tp_setattr */
+    NULL,                         /* tp_reserved */
+    NULL,                         /* tp_repr */
+    NULL,                         /* tp_as_number */
+    &ResultCache_as_sequence,     /* tp_as_sequence */
+    NULL,                         /* tp_as_mapping */
+    NULL,                         /* tp_hash */
+    NULL,                         /* tp_call */
+    NULL,                         /* tp_str */
+    NULL,                         /* tp_getattro */
+    NULL,                         /* tp_setattro */
+    NULL,                         /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,           /* tp_flags */
+    s_tds_ResultCache_doc,        /* tp_doc */
+    NULL,                         /* tp_traverse */
+    NULL,                         /* tp_clear */
+    NULL,                         /* tp_richcompare */
+    0,                            /* tp_weaklistoffset */
+    NULL,                         /* tp_iter */
+    NULL,                         /* tp_iternext */
+    ResultCache_methods,          /* tp_methods */
+    NULL,                         /* tp_members */
+    ResultCache_getset,           /* tp_getset */
+    NULL,                         /* tp_base */
+    NULL,                         /* tp_dict */
+    NULL,                         /* tp_descr_get */
+    NULL,                         /* tp_descr_set */
+    0,                            /* tp_dictoffset */
+    NULL,                         /* tp_init */
+    NULL,                         /* tp_alloc */
+    ResultCache_new,              /* tp_new */
+    NULL,                         /* tp_free */
+    NULL,                         /* tp_is_gc */
+    NULL,                         /* tp_bases */
+    NULL,                         /* tp_mro */
+    NULL,                         /* tp_cache */
+    NULL,                         /* tp_subclasses */
+    NULL,                         /* tp_weaklist */
+    NULL,                         /* tp_del */
+    0,                            /* tp_version_tag */
+#if PY_VERSION_HEX >= 0x03040000
+    NULL,                         /* tp_finalize */
+#endif /* if PY_VERSION_HEX >= 0x03040000 */
+#if PY_VERSION_HEX >= 0x03080000
+    NULL,                         /* tp_vectorcall */
+#  if PY_VERSION_HEX < 0x03090000
+    NULL,                         /* tp_print */
+#  endif /* if PY_VERSION_HEX < 0x03090000 */
+#endif /* if PY_VERSION_HEX >= 0x03080000 */
+};
+
+PyTypeObject* ResultCacheType_init(void)
+{
+    if (0 != PyType_Ready(&ResultCacheType))
+    {
+        return NULL;
+    }
+    return &ResultCacheType;
+}
+
+#ifdef __clang__
+#  if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8
+#    pragma clang diagnostic pop
+#  endif /* if PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION == 8 */
+#endif /* ifdef __clang__ */
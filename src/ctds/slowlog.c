@@ -0,0 +1,312 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include <sybdb.h>
+#include "include/pop_warnings.h"
+
+#include <string.h>
+
+#include "include/connection.h"
+#include "include/slowlog.h"
+
+PyObject* SlowLog_callback = NULL;
+
+uint64_t SlowLog_threshold = 0;
+
+/* Is SlowLog_callback a `logging.Logger.warning` method? */
+static bool s_logger = false;
+
+/* Should parameter values be reported? */
+static bool s_values = false;
+
+/* The message logged to a `logging.Logger`, formatted with the statement's dict. */
+static const char s_message[] =
+    "slow %(operation)s on spid %(spid)s (%(total_time).3fs, first row after "
+    "%(first_row_time).3fs, %(rows)s rows): %(sql)s";
+
+/* Convert nanoseconds to seconds. */
+#define NS_TO_S(_ns) ((double)(_ns) / 1000000000.0)
+
+void SlowLog_free(void)
+{
+    Py_CLEAR(SlowLog_callback);
+}
+
+int SlowLog_set(uint64_t threshold, PyObject* callback, bool values)
+{
+    PyObject* function = NULL;
+    PyObject* previous;
+    bool logger = false;
+
+    if (Py_None != callback)
+    {
+        if (PyCallable_Check(callback))
+        {
+            Py_INCREF(callback);
+            function = callback;
+        }
+        else
+        {
+            /* Log to anything with a `logging.Logger`-like warning() method. */
+            function = PyObject_GetAttrString(callback, "warning");
+            if (!function || !PyCallable_Check(function))
+            {
+                Py_XDECREF(function);
+                PyErr_Clear();
+                PyErr_SetObject(PyExc_TypeError, callback);
+                return -1;
+            }
+            logger = true;
+        }
+    }
+
+    /*
+        Statements in progress hold their own reference to the previous
+        callback. Dropping the last reference may run Python code which
+        executes, and so times, another statement, so update the settings
+        first.
+    */
+    previous = SlowLog_callback;
+    SlowLog_callback = function;
+    SlowLog_threshold = threshold;
+    s_logger = logger;
+    s_values = values;
+    Py_XDECREF(previous);
+    return 0;
+}
+
+/*
+    Get the type names of a statement's parameters, without their values.
+
+    @note This method returns a new reference.
+
+    @param parameters [in] The parameters passed to the statement.
+
+    @return A tuple or dict of type names, matching the parameters, None if
+        the parameter types cannot be determined, or NULL on error.
+*/
+static PyObject* SlowLog_parameter_types(PyObject* parameters)
+{
+    PyObject* types;
+
+    if (PyDict_Check(parameters))
+    {
+        PyObject* key;
+        PyObject* value;
+        Py_ssize_t pos = 0;
+
+        types = PyDict_New();
+        if (!types)
+        {
+            return NULL;
+        }
+        while (PyDict_Next(parameters, &pos, &key, &value))
+        {
+            PyObject* type = Py_BuildValue("s", Py_TYPE(value)->tp_name);
+            if (!type || (0 != PyDict_SetItem(types, key, type)))
+            {
+                Py_XDECREF(type);
+                Py_DECREF(types);
+                return NULL;
+            }
+            Py_DECREF(type);
+        }
+    }
+    else if (PyTuple_Check(parameters) || PyList_Check(parameters))
+    {
+        Py_ssize_t ix;
+        Py_ssize_t size = PySequence_Fast_GET_SIZE(parameters);
+
+        types = PyTuple_New(size);
+        if (!types)
+        {
+            return NULL;
+        }
+        for (ix = 0; ix < size; ++ix)
+        {
+            PyObject* value = PySequence_Fast_GET_ITEM(parameters, ix);
+            PyObject* type = Py_BuildValue("s", Py_TYPE(value)->tp_name);
+            if (!type)
+            {
+                Py_DECREF(types);
+                return NULL;
+            }
+            PyTuple_SET_ITEM(types, ix, type); /* type reference stolen by PyTuple_SET_ITEM */
+        }
+    }
+    else
+    {
+        Py_INCREF(Py_None);
+        types = Py_None;
+    }
+
+    return types;
+}
+
+/*
+    Set an item of a dict, releasing the value.
+
+    @param dict [in] The dict.
+    @param key [in] The key.
+    @param value [in] The value. This reference is stolen. If NULL, an error
+        is assumed to be set.
+
+    @return 0 on success, -1 on error.
+*/
+static int SlowLog_set_item(PyObject* dict, const char* key, PyObject* value)
+{
+    int result;
+    if (!value)
+    {
+        return -1;
+    }
+    result = PyDict_SetItemString(dict, key, value);
+    Py_DECREF(value);
+    return result;
+}
+
+/*
+    Build the dict describing a slow statement.
+
+    @note This method returns a new reference.
+*/
+static PyObject* SlowLog_build(const struct SlowQuery* query, struct Connection* connection,
+                               uint64_t elapsed, Py_ssize_t rows, bool error)
+{
+    PyObject* parameters = NULL;
+    PyObject* info;
+    int result;
+
+    /* executemany()'s parameters are an iterable, which may have been consumed. */
+    if ((PyTuple_GET_SIZE(query->args) > 1) && (0 != strcmp(query->operation, "executemany")))
+    {
+        parameters = PyTuple_GET_ITEM(query->args, 1);
+    }
+
+    info = PyDict_New();
+    if (!info)
+    {
+        return NULL;
+    }
+
+    Py_INCREF(PyTuple_GET_ITEM(query->args, 0));
+    result = SlowLog_set_item(info, "sql", PyTuple_GET_ITEM(query->args, 0));
+    if (0 == result)
+    {
+        result = SlowLog_set_item(info, "operation", Py_BuildValue("s", query->operation));
+    }
+    if (0 == result)
+    {
+        if (parameters)
+        {
+            result = SlowLog_set_item(info, "parameter_types", SlowLog_parameter_types(parameters));
+        }
+        else
+        {
+            result = PyDict_SetItemString(info, "parameter_types", Py_None);
+        }
+    }
+    if (0 == result)
+    {
+        result = PyDict_SetItemString(info, "parameters", (parameters && s_values) ? parameters : Py_None);
+    }
+    if (0 == result)
+    {
+        if (connection && !Connection_closed(connection))
+        {
+            /* These APIs shouldn't block, so don't bother releasing the GIL. */
+            DBPROCESS* dbproc = Connection_DBPROCESS(connection);
+            const char* database = dbname(dbproc);
+
+            result = SlowLog_set_item(info, "spid", PyLong_FromLong((long)dbspid(dbproc)));
+            if (0 == result)
+            {
+                result = SlowLog_set_item(info, "database",
+                                          PyUnicode_DecodeUTF8(database, (Py_ssize_t)strlen(database), NULL));
+            }
+            if (0 == result)
+            {
+                result = SlowLog_set_item(info, "messages", Connection_messages(connection));
+            }
+        }
+        else
+        {
+            result = PyDict_SetItemString(info, "spid", Py_None);
+            if (0 == result)
+            {
+                result = PyDict_SetItemString(info, "database", Py_None);
+            }
+            if (0 == result)
+            {
+                result = PyDict_SetItemString(info, "messages", Py_None);
+            }
+        }
+    }
+    if (0 == result)
+    {
+        result = SlowLog_set_item(info, "first_row_time", PyFloat_FromDouble(NS_TO_S(query->first_row)));
+    }
+    if (0 == result)
+    {
+        result = SlowLog_set_item(info, "total_time", PyFloat_FromDouble(NS_TO_S(elapsed)));
+    }
+    if (0 == result)
+    {
+        result = SlowLog_set_item(info, "rows", PyLong_FromSsize_t(rows));
+    }
+    if (0 == result)
+    {
+        result = PyDict_SetItemString(info, "error", (error) ? Py_True : Py_False);
+    }
+
+    if (0 != result)
+    {
+        Py_DECREF(info);
+        return NULL;
+    }
+    return info;
+}
+
+void SlowLog_report(const struct SlowQuery* query, struct Connection* connection,
+                    uint64_t elapsed, Py_ssize_t rows, bool error)
+{
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+
+    PyObject* callback = SlowLog_callback;
+    bool logger = s_logger;
+    PyObject* info;
+    PyObject* result = NULL;
+
+    /* The callback may reconfigure the slow query log. */
+    Py_INCREF(callback);
+
+    /* Preserve the statement's exception, if any. */
+    PyErr_Fetch(&type, &value, &traceback);
+
+    info = SlowLog_build(query, connection, elapsed, rows, error);
+    if (info)
+    {
+        if (logger)
+        {
+            result = PyObject_CallFunction(callback, "sO", s_message, info);
+        }
+        else
+        {
+            result = PyObject_CallFunctionObjArgs(callback, info, NULL);
+        }
+        Py_DECREF(info);
+    }
+    if (result)
+    {
+        Py_DECREF(result);
+    }
+    else
+    {
+        PyErr_WriteUnraisable(callback);
+    }
+
+    Py_DECREF(callback);
+
+    PyErr_Restore(type, value, traceback);
+}
@@ -0,0 +1,606 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include "include/pop_warnings.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/histogram.h"
+#include "include/macros.h"
+#include "include/statements.h"
+#include "include/tds.h"
+
+/* The maximum length of the normalized SQL text kept for each statement. */
+#define STATEMENTS_TEXT_MAX 4096
+
+#define STATEMENTS_NONE ((size_t)-1)
+
+/* 64-bit FNV-1a parameters. */
+#define FNV_OFFSET_BASIS UINT64_C(14695981039346656037)
+#define FNV_PRIME UINT64_C(1099511628211)
+
+struct StatementEntry
+{
+    uint64_t fingerprint;
+
+    /* The index of the next entry in the same hash bucket, or STATEMENTS_NONE. */
+    size_t next;
+
+    /* The position of the entry in the eviction heap. */
+    size_t heapix;
+
+    enum StatementKind kind;
+
+    /* The normalized SQL text or procedure name. */
+    char* text;
+    size_t ntext;
+
+    uint64_t calls;
+    uint64_t errors;
+    uint64_t rows;
+
+    /* The execution times, in nanoseconds. */
+    struct Histogram latency;
+};
+
+struct StatementTable
+{
+    size_t maxsize;
+    size_t nentries;
+
+    /* The index of the first entry in each hash bucket. */
+    size_t* buckets;
+    size_t nbuckets; /* a power of 2 */
+
+    struct StatementEntry* entries;
+
+    /*
+        A binary min-heap of entry indices ordered by call count, the root of
+        which is the least frequently executed statement, evicted first.
+    */
+    size_t* heap;
+
+    /* A buffer of STATEMENTS_TEXT_MAX bytes to normalize new statements into. */
+    char* scratch;
+};
+
+struct StatementTable* Statements_table = NULL;
+
+
+/* The state of the normalization of a statement's text. */
+struct Normalizer
+{
+    uint64_t hash;
+
+    /* The normalized text. This may be NULL if only the hash is required. */
+    char* text;
+    size_t ntext;
+
+    /* The last character emitted, or '\0' if none. */
+    char last;
+
+    /* Should whitespace be emitted before the next character? */
+    bool space;
+};
+
+/* Can `c` be part of an identifier, variable or parameter name? */
+static bool is_identifier_char(char c)
+{
+    return isalnum((unsigned char)c) || ('_' == c) || ('@' == c) || ('#' == c) ||
+           ('$' == c) || (':' == c) || ((unsigned char)c >= 0x80);
+}
+
+static void Normalizer_append(struct Normalizer* normalizer, char c, bool hash)
+{
+    if (hash)
+    {
+        normalizer->hash = (normalizer->hash ^ (uint64_t)(unsigned char)c) * FNV_PRIME;
+    }
+    if (normalizer->text && (normalizer->ntext < STATEMENTS_TEXT_MAX))
+    {
+        normalizer->text[normalizer->ntext++] = c;
+    }
+}
+
+static void Normalizer_emit(struct Normalizer* normalizer, char c)
+{
+    if (normalizer->space)
+    {
+        normalizer->space = false;
+        if (normalizer->last)
+        {
+            /*
+                Whitespace is only significant between two words, e.g.
+                `id = 1` and `id=1` have the same fingerprint.
+            */
+            Normalizer_append(normalizer, ' ',
+                              is_identifier_char(normalizer->last) && is_identifier_char(c));
+        }
+    }
+
+    Normalizer_append(normalizer, c, true);
+    normalizer->last = c;
+}
+
+/* Copy a quoted identifier, e.g. [name] or "name", verbatim. */
+static const char* Normalizer_identifier(struct Normalizer* normalizer, const char* sql, char close)
+{
+    Normalizer_emit(normalizer, *sql++);
+    while (*sql)
+    {
+        Normalizer_emit(normalizer, *sql);
+        if (close == *sql++)
+        {
+            if (close != *sql)
+            {
+                break;
+            }
+            /* An escaped closing character. */
+            Normalizer_emit(normalizer, *sql++);
+        }
+    }
+    return sql;
+}
+
+static void Normalizer_normalize(struct Normalizer* normalizer, enum StatementKind kind, const char* sql)
+{
+    normalizer->hash = (FNV_OFFSET_BASIS ^ (uint64_t)kind) * FNV_PRIME;
+    normalizer->ntext = 0;
+    normalizer->last = '\0';
+    normalizer->space = false;
+
+    while (*sql)
+    {
+        char c = *sql;
+        bool token = (normalizer->space || !is_identifier_char(normalizer->last));
+
+        if (StatementKind_procedure == kind)
+        {
+            Normalizer_emit(normalizer, (char)tolower((unsigned char)c));
+            sql++;
+        }
+        else if (isspace((unsigned char)c))
+        {
+            normalizer->space = true;
+            sql++;
+        }
+        else if (('-' == c) && ('-' == sql[1]))
+        {
+            while (*sql && ('\n' != *sql))
+            {
+                sql++;
+            }
+            normalizer->space = true;
+        }
+        else if (('/' == c) && ('*' == sql[1]))
+        {
+            /* Comments may be nested. */
+            size_t depth = 1;
+            sql += 2;
+            while (*sql && depth)
+            {
+                if (('/' == sql[0]) && ('*' == sql[1]))
+                {
+                    depth++;
+                    sql += 2;
+                }
+                else if (('*' == sql[0]) && ('/' == sql[1]))
+                {
+                    depth--;
+                    sql += 2;
+                }
+                else
+                {
+                    sql++;
+                }
+            }
+            normalizer->space = true;
+        }
+        else if (('\'' == c) || (token && (('N' == c) || ('n' == c)) && ('\'' == sql[1])))
+        {
+            /* A string literal. */
+            sql += ('\'' == c) ? 1 : 2;
+            while (*sql)
+            {
+                if ('\'' == *sql++)
+                {
+                    if ('\'' != *sql)
+                    {
+                        break;
+                    }
+                    sql++;
+                }
+            }
+            Normalizer_emit(normalizer, '?');
+        }
+        else if ('[' == c)
+        {
+            sql = Normalizer_identifier(normalizer, sql, ']');
+        }
+        else if ('"' == c)
+        {
+            sql = Normalizer_identifier(normalizer, sql, '"');
+        }
+        else if (token && isdigit((unsigned char)c))
+        {
+            /* A numeric or binary literal. */
+            if (('0' == c) && (('x' == sql[1]) || ('X' == sql[1])))
+            {
+                sql += 2;
+                while (isxdigit((unsigned char)*sql))
+                {
+                    sql++;
+                }
+            }
+            else
+            {
+                while (isdigit((unsigned char)*sql) || ('.' == *sql))
+                {
+                    sql++;
+                }
+                if ((('e' == *sql) || ('E' == *sql)) &&
+                    (isdigit((unsigned char)sql[1]) ||
+                     ((('+' == sql[1]) || ('-' == sql[1])) && isdigit((unsigned char)sql[2]))))
+                {
+                    sql += 2;
+                    while (isdigit((unsigned char)*sql))
+                    {
+                        sql++;
+                    }
+                }
+            }
+            Normalizer_emit(normalizer, '?');
+        }
+        else
+        {
+            Normalizer_emit(normalizer, (char)tolower((unsigned char)c));
+            sql++;
+        }
+    }
+}
+
+uint64_t Statements_fingerprint(enum StatementKind kind, const char* text)
+{
+    struct Normalizer normalizer;
+    normalizer.text = NULL;
+
+    Normalizer_normalize(&normalizer, kind, text);
+
+    /* 0 is reserved to indicate no statement. */
+    return (normalizer.hash) ? normalizer.hash : 1;
+}
+
+
+static struct StatementEntry* StatementTable_find(struct StatementTable* table, uint64_t fingerprint)
+{
+    size_t ix = table->buckets[fingerprint & (table->nbuckets - 1)];
+    while (STATEMENTS_NONE != ix)
+    {
+        if (fingerprint == table->entries[ix].fingerprint)
+        {
+            return &table->entries[ix];
+        }
+        ix = table->entries[ix].next;
+    }
+    return NULL;
+}
+
+static void StatementTable_heap_set(struct StatementTable* table, size_t heapix, size_t ix)
+{
+    table->heap[heapix] = ix;
+    table->entries[ix].heapix = heapix;
+}
+
+/* Move an entry towards the root of the heap until its parent has fewer calls. */
+static void StatementTable_sift_up(struct StatementTable* table, size_t heapix)
+{
+    size_t ix = table->heap[heapix];
+    while (heapix > 0)
+    {
+        size_t parent = (heapix - 1) / 2;
+        if (table->entries[table->heap[parent]].calls <= table->entries[ix].calls)
+        {
+            break;
+        }
+        StatementTable_heap_set(table, heapix, table->heap[parent]);
+        heapix = parent;
+    }
+    StatementTable_heap_set(table, heapix, ix);
+}
+
+/* Move an entry away from the root of the heap until its children have more calls. */
+static void StatementTable_sift_down(struct StatementTable* table, size_t heapix)
+{
+    size_t ix = table->heap[heapix];
+    for (;;)
+    {
+        size_t child = (2 * heapix) + 1;
+        if (child >= table->nentries)
+        {
+            break;
+        }
+        if ((child + 1 < table->nentries) &&
+            (table->entries[table->heap[child + 1]].calls < table->entries[table->heap[child]].calls))
+        {
+            child++;
+        }
+        if (table->entries[ix].calls <= table->entries[table->heap[child]].calls)
+        {
+            break;
+        }
+        StatementTable_heap_set(table, heapix, table->heap[child]);
+        heapix = child;
+    }
+    StatementTable_heap_set(table, heapix, ix);
+}
+
+/*
+    Remove the least frequently executed statement from the table to make
+    room for a new statement. The free entry remains at the root of the heap.
+
+    @return The index of the free entry.
+*/
+static size_t StatementTable_evict(struct StatementTable* table)
+{
+    size_t evict = table->heap[0];
+    size_t* link;
+
+    /* Unlink the entry from its bucket. */
+    link = &table->buckets[table->entries[evict].fingerprint & (table->nbuckets - 1)];
+    while (evict != *link)
+    {
+        link = &table->entries[*link].next;
+    }
+    *link = table->entries[evict].next;
+
+    tds_mem_free(table->entries[evict].text);
+    return evict;
+}
+
+static void StatementTable_clear(struct StatementTable* table)
+{
+    size_t ix;
+    for (ix = 0; ix < table->nentries; ++ix)
+    {
+        tds_mem_free(table->entries[ix].text);
+    }
+    table->nentries = 0;
+    for (ix = 0; ix < table->nbuckets; ++ix)
+    {
+        table->buckets[ix] = STATEMENTS_NONE;
+    }
+}
+
+static void StatementTable_free(struct StatementTable* table)
+{
+    if (table)
+    {
+        StatementTable_clear(table);
+        tds_mem_free(table->buckets);
+        tds_mem_free(table->entries);
+        tds_mem_free(table->heap);
+        tds_mem_free(table->scratch);
+        tds_mem_free(table);
+    }
+}
+
+void Statements_record(uint64_t fingerprint, enum StatementKind kind, const char* text,
+                       uint64_t elapsed, Py_ssize_t rows, bool error)
+{
+    struct StatementTable* table = Statements_table;
+    struct StatementEntry* entry = StatementTable_find(table, fingerprint);
+    if (!entry)
+    {
+        struct Normalizer normalizer;
+        char* copy;
+        size_t ix;
+        size_t heapix;
+        size_t* bucket;
+
+        normalizer.text = table->scratch;
+        Normalizer_normalize(&normalizer, kind, text);
+
+        copy = tds_mem_malloc((normalizer.ntext) ? normalizer.ntext : 1);
+        if (!copy)
+        {
+            return;
+        }
+        memcpy(copy, normalizer.text, normalizer.ntext);
+
+        if (table->nentries < table->maxsize)
+        {
+            ix = heapix = table->nentries++;
+        }
+        else
+        {
+            ix = StatementTable_evict(table);
+            heapix = 0;
+        }
+        entry = &table->entries[ix];
+        memset(entry, 0, sizeof(*entry));
+
+        entry->fingerprint = fingerprint;
+        entry->kind = kind;
+        entry->text = copy;
+        entry->ntext = normalizer.ntext;
+
+        bucket = &table->buckets[fingerprint & (table->nbuckets - 1)];
+        entry->next = *bucket;
+        *bucket = ix;
+
+        /* An entry with no calls belongs at the root. */
+        StatementTable_heap_set(table, heapix, ix);
+        StatementTable_sift_up(table, heapix);
+    }
+
+    entry->calls++;
+    StatementTable_sift_down(table, entry->heapix);
+    if (error)
+    {
+        entry->errors++;
+    }
+    if (rows > 0)
+    {
+        entry->rows += (uint64_t)rows;
+    }
+    Histogram_record(&entry->latency, elapsed);
+}
+
+void Statements_add_rows(uint64_t fingerprint, size_t rows)
+{
+    if (Statements_table)
+    {
+        struct StatementEntry* entry = StatementTable_find(Statements_table, fingerprint);
+        if (entry)
+        {
+            entry->rows += rows;
+        }
+    }
+}
+
+int Statements_set_maxsize(size_t maxsize)
+{
+    struct StatementTable* table = NULL;
+
+    if (maxsize)
+    {
+        size_t ix;
+
+        table = tds_mem_calloc(1, sizeof(struct StatementTable));
+        if (!table)
+        {
+            PyErr_NoMemory();
+            return -1;
+        }
+
+        table->maxsize = maxsize;
+        table->nbuckets = 1;
+        while (table->nbuckets < maxsize)
+        {
+            table->nbuckets <<= 1;
+        }
+
+        table->buckets = tds_mem_malloc(table->nbuckets * sizeof(size_t));
+        table->entries = tds_mem_malloc(maxsize * sizeof(struct StatementEntry));
+        table->heap = tds_mem_malloc(maxsize * sizeof(size_t));
+        table->scratch = tds_mem_malloc(STATEMENTS_TEXT_MAX);
+        if (!table->buckets || !table->entries || !table->heap || !table->scratch)
+        {
+            StatementTable_free(table);
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (ix = 0; ix < table->nbuckets; ++ix)
+        {
+            table->buckets[ix] = STATEMENTS_NONE;
+        }
+    }
+
+    StatementTable_free(Statements_table);
+    Statements_table = table;
+    return 0;
+}
+
+/* Order statements by descending total execution time. */
+static int StatementEntry_compare(const void* lhs, const void* rhs)
+{
+    const struct StatementEntry* left = *(const struct StatementEntry* const*)lhs;
+    const struct StatementEntry* right = *(const struct StatementEntry* const*)rhs;
+    if (left->latency.sum != right->latency.sum)
+    {
+        return (left->latency.sum > right->latency.sum) ? -1 : 1;
+    }
+    return 0;
+}
+
+/* Convert nanoseconds to seconds. */
+#define NS_TO_S(_ns) ((double)(_ns) / 1000000000.0)
+
+PyObject* Statements_get(bool reset)
+{
+    struct StatementTable* table = Statements_table;
+    struct StatementEntry** entries = NULL;
+    PyObject* stats;
+    size_t ix;
+
+    if (!table)
+    {
+        return PyList_New(0);
+    }
+
+    do
+    {
+        stats = PyList_New((Py_ssize_t)table->nentries);
+        if (!stats)
+        {
+            break;
+        }
+
+        entries = tds_mem_malloc((table->nentries ? table->nentries : 1) * sizeof(struct StatementEntry*));
+        if (!entries)
+        {
+            PyErr_NoMemory();
+            break;
+        }
+        for (ix = 0; ix < table->nentries; ++ix)
+        {
+            entries[ix] = &table->entries[ix];
+        }
+        qsort(entries, table->nentries, sizeof(struct StatementEntry*), StatementEntry_compare);
+
+        for (ix = 0; ix < table->nentries; ++ix)
+        {
+            const struct StatementEntry* entry = entries[ix];
+            PyObject* query = PyUnicode_DecodeUTF8(entry->text, (Py_ssize_t)entry->ntext, "replace");
+            PyObject* item;
+            if (!query)
+            {
+                break;
+            }
+
+            item = Py_BuildValue(
+                "{s:K,s:s,s:N,s:K,s:K,s:K,s:d,s:d,s:d,s:d,s:d}",
+                "fingerprint", (unsigned PY_LONG_LONG)entry->fingerprint,
+                "kind", (StatementKind_procedure == entry->kind) ? "procedure" : "sql",
+                "query", query, /* query reference stolen by Py_BuildValue */
+                "calls", (unsigned PY_LONG_LONG)entry->calls,
+                "errors", (unsigned PY_LONG_LONG)entry->errors,
+                "rows", (unsigned PY_LONG_LONG)entry->rows,
+                "total_time", NS_TO_S(entry->latency.sum),
+                "mean_time", NS_TO_S(entry->latency.sum) / (double)entry->calls,
+                "min_time", NS_TO_S(entry->latency.min),
+                "max_time", NS_TO_S(entry->latency.max),
+                "p99_time", NS_TO_S(Histogram_percentile(&entry->latency, 99.0))
+            );
+            if (!item)
+            {
+                break;
+            }
+            PyList_SET_ITEM(stats, (Py_ssize_t)ix, item); /* item reference stolen by PyList_SET_ITEM */
+        }
+        if (PyErr_Occurred())
+        {
+            break;
+        }
+
+        tds_mem_free(entries);
+
+        if (reset)
+        {
+            StatementTable_clear(table);
+        }
+        return stats;
+    }
+    while (0);
+
+    tds_mem_free(entries);
+    Py_XDECREF(stats);
+    return NULL;
+}
+
+void Statements_free(void)
+{
+    StatementTable_free(Statements_table);
+    Statements_table = NULL;
+}
@@ -4,13 +4,21 @@
 #include <ctpublic.h>
 #include "include/pop_warnings.h"
 
+#include "include/bench.h"
 #include "include/c99int.h"
 #include "include/connection.h"
 #include "include/cursor.h"
+#include "include/latency.h"
 #include "include/macros.h"
+#include "include/mem.h"
 #include "include/parameter.h"
+#include "include/pool.h"
 #include "include/pyutils.h"
+#include "include/resultcache.h"
+#include "include/slowlog.h"
+#include "include/statements.h"
 #include "include/tds.h"
+#include "include/trace.h"
 #include "include/type.h"
 
 #ifdef __GNUC__
@@ -207,7 +215,7 @@ static const char s_tds_connect_doc[] =
 /**
    https://www.python.org/dev/peps/pep-0249/#connect
 */
-static PyObject* tds_connect(PyObject* self, PyObject* args, PyObject* kwargs)
+PyObject* tds_connect(PyObject* self, PyObject* args, PyObject* kwargs)
 {
     static char* s_kwlist[] =
     {
@@ -502,21 +510,541 @@ static PyObject* tds_Binary(PyObject* self, PyObject* args)
     return SqlBinary_create(self, args, NULL);
 }
 
+static const char s_tds_execute_parallel_doc[] =
+    "execute_parallel(queries)\n"
+    "\n"
+    "Execute SQL statements on multiple connections concurrently.\n"
+    "\n"
+    "Each statement is sent to its connection in turn. The responses are\n"
+    "then read, and the rows of each statement's first result set buffered,\n"
+    "concurrently on native threads which do not hold the GIL. The total\n"
+    "time taken approaches that of the slowest statement rather than the\n"
+    "sum of all of them. Row values are converted to Python objects on the\n"
+    "calling thread as they are accessed.\n"
+    "\n"
+    "Statements are executed as by :py:meth:`ctds.Cursor.execute`. A\n"
+    "connection may only be used by one statement.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param queries: The statements to execute, as\n"
+    "    `(connection, sql[, parameters])` tuples.\n"
+    ":type queries: list(tuple(ctds.Connection, str, tuple))\n"
+    ":return: For each statement, in order, the rows of its first result\n"
+    "    set, :py:data:`None` if it has no result set, or the exception\n"
+    "    raised by the statement.\n"
+    ":rtype: list(ctds.RowList)\n";
+
+static PyObject* tds_execute_parallel(PyObject* self, PyObject* args)
+{
+    PyObject* queries;
+    if (!PyArg_ParseTuple(args, "O", &queries))
+    {
+        return NULL;
+    }
+    return Cursor_execute_parallel(queries);
+    UNUSED(self);
+}
+
+static const char s_tds_set_trace_hooks_doc[] =
+    "set_trace_hooks(on_start, on_end)\n"
+    "\n"
+    "Set the functions called when database operations start and end, e.g.\n"
+    "to report them to an application performance monitoring service.\n"
+    "\n"
+    "The hooks are called for :py:meth:`ctds.Cursor.execute`,\n"
+    ":py:meth:`ctds.Cursor.executemany`, :py:meth:`ctds.Cursor.callproc`,\n"
+    ":py:meth:`ctds.Cursor.execute_async`, :py:meth:`ctds.Connection.bulk_insert`\n"
+    "and each read of rows by the :py:meth:`ctds.Cursor.fetchone`,\n"
+    ":py:meth:`ctds.Cursor.fetchmany` and :py:meth:`ctds.Cursor.fetchall`\n"
+    "methods, including iteration of the cursor. Statements executed by\n"
+    ":py:meth:`ctds.Cursor.execute_async` are traced from when they are sent\n"
+    "until their response is read. Statements executed by\n"
+    ":py:func:`ctds.execute_parallel` are not traced.\n"
+    "\n"
+    "`on_start` is called as `on_start(operation, sql, spid)`, where\n"
+    "`operation` is one of `'execute'`, `'executemany'`, `'callproc'`,\n"
+    "`'execute_async'`, `'bulk_insert'` or `'fetch'`, `sql` is the SQL\n"
+    "statement, stored procedure name or table name (:py:data:`None` for\n"
+    "fetches), and `spid` is the connection's :py:attr:`ctds.Connection.spid`.\n"
+    "Its return value is passed to `on_end`.\n"
+    "\n"
+    "`on_end` is called as `on_end(token, rows, elapsed, error)`, where\n"
+    "`token` is the value returned by `on_start`, `rows` is the number of\n"
+    "rows affected, inserted or fetched (-1 if unknown), `elapsed` is the\n"
+    "duration of the operation in nanoseconds, and `error` is the exception\n"
+    "raised by the operation, or :py:data:`None`.\n"
+    "\n"
+    "Exceptions raised by the hooks are reported using\n"
+    ":py:func:`sys.unraisablehook` and do not affect the operation. When no\n"
+    "hooks are set, tracing adds no measurable overhead.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param on_start: The function called when an operation starts, or\n"
+    "    :py:data:`None`.\n"
+    ":type on_start: callable\n"
+    ":param on_end: The function called when an operation ends, or\n"
+    "    :py:data:`None`.\n"
+    ":type on_end: callable\n";
+
+static PyObject* tds_set_trace_hooks(PyObject* self, PyObject* args)
+{
+    PyObject* on_start;
+    PyObject* on_end;
+    if (!PyArg_ParseTuple(args, "OO", &on_start, &on_end))
+    {
+        return NULL;
+    }
+    if (0 != Trace_set_hooks(on_start, on_end))
+    {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+    UNUSED(self);
+}
+
+static const char s_tds_set_statement_stats_doc[] =
+    "set_statement_stats(maxsize)\n"
+    "\n"
+    "Enable or disable the collection of client-side statement statistics,\n"
+    "read using :py:func:`ctds.statement_stats`. Any statistics already\n"
+    "collected are discarded.\n"
+    "\n"
+    "Statistics are kept for at most `maxsize` distinct statements. Once\n"
+    "full, the least frequently executed statement is replaced.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param int maxsize: The maximum number of statements to keep\n"
+    "    statistics for, or 0 to disable collection.\n";
+
+static PyObject* tds_set_statement_stats(PyObject* self, PyObject* args)
+{
+    Py_ssize_t maxsize;
+    if (!PyArg_ParseTuple(args, "n", &maxsize))
+    {
+        return NULL;
+    }
+    if (maxsize < 0)
+    {
+        PyErr_SetObject(PyExc_ValueError, PyTuple_GET_ITEM(args, 0));
+        return NULL;
+    }
+    if (0 != Statements_set_maxsize((size_t)maxsize))
+    {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+    UNUSED(self);
+}
+
+static const char s_tds_statement_stats_doc[] =
+    "statement_stats(reset=False)\n"
+    "\n"
+    "Get the client-side statistics of the statements executed using\n"
+    ":py:meth:`ctds.Cursor.execute`, :py:meth:`ctds.Cursor.executemany`,\n"
+    ":py:meth:`ctds.Cursor.callproc` and :py:meth:`ctds.Cursor.execute_async`\n"
+    "on all connections, once enabled using :py:func:`ctds.set_statement_stats`.\n"
+    "\n"
+    "Statements are grouped by a fingerprint of their normalized SQL text,\n"
+    "with comments removed, whitespace collapsed and literal values replaced\n"
+    "with `?`, or of the stored procedure name. Statistics are returned in\n"
+    "descending order of total execution time, as dicts with the keys:\n"
+    "\n"
+    "* ``fingerprint``: The statement's fingerprint.\n"
+    "* ``kind``: `'sql'` for SQL statements or `'procedure'` for stored\n"
+    "  procedure calls.\n"
+    "* ``query``: The normalized SQL text, truncated to 4096 bytes, or the\n"
+    "  stored procedure name.\n"
+    "* ``calls``: The number of times the statement was executed.\n"
+    "* ``errors``: The number of executions which raised an error.\n"
+    "* ``rows``: The number of rows affected by the statement or fetched\n"
+    "  from its results.\n"
+    "* ``total_time``, ``mean_time``, ``min_time``, ``max_time``,\n"
+    "  ``p99_time``: Statistics of the time, in seconds, taken to execute\n"
+    "  the statement, until the server's first response was read. The time\n"
+    "  spent fetching rows is not included. ``p99_time`` is estimated to\n"
+    "  within 12.5%. Statements executed by :py:meth:`ctds.Cursor.execute_async`\n"
+    "  are timed from when they are sent until their response is read.\n"
+    "\n"
+    "Results served from the connection's :py:attr:`ctds.Connection.result_cache`\n"
+    "and statements executed by :py:func:`ctds.execute_parallel` are not\n"
+    "included.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param bool reset: Reset the statistics once read.\n"
+    ":return: The statistics of each statement.\n"
+    ":rtype: list(dict)\n";
+
+static PyObject* tds_statement_stats(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "reset",
+        NULL
+    };
+    PyObject* reset = Py_False;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O!", s_kwlist, &PyBool_Type, &reset))
+    {
+        return NULL;
+    }
+    return Statements_get(Py_True == reset);
+    UNUSED(self);
+}
+
+static const char s_tds_latency_histograms_doc[] =
+    "latency_histograms(reset=False)\n"
+    "\n"
+    "Get histograms of the latencies of database operations on all\n"
+    "connections in the process, keyed by operation:\n"
+    "\n"
+    "* ``login``: The time taken to log in to the server when opening a\n"
+    "  connection.\n"
+    "* ``round_trip``: The time from sending a request to the server,\n"
+    "  including SQL batches, stored procedure calls and bulk insert\n"
+    "  batches, until its first response was read.\n"
+    "* ``fetch``: The time spent fetching all rows of a result set. Result\n"
+    "  sets which are not read in full are not included.\n"
+    "* ``pool_acquire``: The time taken by :py:meth:`ctds.Pool.acquire`.\n"
+    "\n"
+    "Each histogram is a dict with the ``count`` of values recorded, their\n"
+    "``sum``, ``min`` and ``max``, the ``p50``, ``p90``, ``p99`` and\n"
+    "``p999`` percentiles, and the non-empty ``buckets``, as\n"
+    "`(upper_bound, count)` tuples. Values are counted in logarithmic\n"
+    "buckets, so percentiles are estimated to within 12.5%. All times are\n"
+    "in seconds.\n"
+    "\n"
+    "See :py:func:`ctds.prometheus_metrics` to export the histograms in\n"
+    "the `Prometheus`_ text format.\n"
+    "\n"
+    ".. _Prometheus: https://prometheus.io\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param bool reset: Reset the histograms once read.\n"
+    ":return: The histogram of each operation.\n"
+    ":rtype: dict\n";
+
+static PyObject* tds_latency_histograms(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "reset",
+        NULL
+    };
+    PyObject* reset = Py_False;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O!", s_kwlist, &PyBool_Type, &reset))
+    {
+        return NULL;
+    }
+    return Latency_get(Py_True == reset);
+    UNUSED(self);
+}
+
+static const char s_tds_set_slow_query_log_doc[] =
+    "set_slow_query_log(threshold_ms, callback, values=False)\n"
+    "\n"
+    "Report statements executed using :py:meth:`ctds.Cursor.execute`,\n"
+    ":py:meth:`ctds.Cursor.executemany`, :py:meth:`ctds.Cursor.callproc` and\n"
+    ":py:meth:`ctds.Cursor.execute_async` on any connection which take longer\n"
+    "than a threshold. A statement's time includes the time spent fetching its\n"
+    "result set; the statement is reported once the result set has been read,\n"
+    "or discarded by executing another statement or closing the cursor.\n"
+    "Statements executed by :py:func:`ctds.execute_parallel` are not reported.\n"
+    "\n"
+    "`callback` is either called with a dict describing the statement, or\n"
+    "is a :py:class:`logging.Logger` the statement is logged to as a\n"
+    "warning. The dict has the keys:\n"
+    "\n"
+    "* ``operation``: `'execute'`, `'executemany'`, `'callproc'` or\n"
+    "  `'execute_async'`.\n"
+    "* ``sql``: The SQL statement or stored procedure name.\n"
+    "* ``parameter_types``: The type names of the parameters, as a tuple or\n"
+    "  dict matching the parameters, or :py:data:`None`.\n"
+    "* ``parameters``: The parameters, if `values` is set, otherwise\n"
+    "  :py:data:`None`.\n"
+    "* ``spid``, ``database``: The connection's :py:attr:`ctds.Connection.spid`\n"
+    "  and :py:attr:`ctds.Connection.database`.\n"
+    "* ``messages``: The :py:attr:`ctds.Connection.messages` from the\n"
+    "  statement.\n"
+    "* ``first_row_time``: The time, in seconds, until the server's first\n"
+    "  response.\n"
+    "* ``total_time``: The total time, in seconds.\n"
+    "* ``rows``: The number of rows affected or fetched, or -1 if unknown.\n"
+    "* ``error``: Did the statement raise an error?\n"
+    "\n"
+    "Exceptions raised by the callback are reported using\n"
+    ":py:func:`sys.unraisablehook` and do not affect the statement. Timing\n"
+    "statements costs a clock read when the statement starts and ends.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param float threshold_ms: The time, in milliseconds, above which a\n"
+    "    statement is reported.\n"
+    ":param callback: The function or logger to report slow statements to,\n"
+    "    or :py:data:`None` to disable the slow query log.\n"
+    ":type callback: callable or logging.Logger\n"
+    ":param bool values: Should parameter values be reported? Values may\n"
+    "    contain sensitive data.\n";
+
+static PyObject* tds_set_slow_query_log(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "threshold_ms",
+        "callback",
+        "values",
+        NULL
+    };
+    double threshold;
+    PyObject* callback;
+    PyObject* values = Py_False;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dO|O!", s_kwlist, &threshold, &callback, &PyBool_Type, &values))
+    {
+        return NULL;
+    }
+    if (!(threshold >= 0))
+    {
+        /* The threshold may have been passed by keyword. */
+        PyObject* value = PyFloat_FromDouble(threshold);
+        if (value)
+        {
+            PyErr_SetObject(PyExc_ValueError, value);
+            Py_DECREF(value);
+        }
+        return NULL;
+    }
+    if (0 != SlowLog_set((uint64_t)(threshold * 1000000.0), callback, (Py_True == values)))
+    {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+    UNUSED(self);
+}
+
+static const char s_tds_memory_stats_doc[] =
+    "memory_stats(reset=False)\n"
+    "\n"
+    "Get the native memory allocated by ctds in the process, outside of\n"
+    "Python's allocator and so not seen by :py:mod:`tracemalloc`, keyed\n"
+    "by subsystem:\n"
+    "\n"
+    "* ``rows``: Result set rows buffered by :py:class:`ctds.RowList`,\n"
+    "  :py:class:`ctds.ResultCache` and :py:attr:`ctds.Cursor.prefetch`.\n"
+    "* ``parameters``: Converted parameters and the SQL built from them.\n"
+    "* ``messages``: Messages and errors reported by the server.\n"
+    "* ``bulk``: Rows staged by :py:meth:`ctds.Connection.bulk_insert`.\n"
+    "* ``other``: All other allocations.\n"
+    "* ``total``: All allocations.\n"
+    "\n"
+    "The usage of each is a dict with the ``current`` and ``peak`` bytes\n"
+    "allocated.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param bool reset: Reset the peak usage to the current usage once read.\n"
+    ":return: The memory usage of each subsystem.\n"
+    ":rtype: dict\n";
+
+static PyObject* tds_memory_stats(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "reset",
+        NULL
+    };
+    PyObject* reset = Py_False;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O!", s_kwlist, &PyBool_Type, &reset))
+    {
+        return NULL;
+    }
+    return Memory_get(Py_True == reset);
+    UNUSED(self);
+}
+
+static const char s_tds_set_memory_limit_doc[] =
+    "set_memory_limit(limit)\n"
+    "\n"
+    "Limit the native memory allocated by ctds in the process, as reported\n"
+    "by :py:func:`ctds.memory_stats`, so large result sets fail fast rather\n"
+    "than exhausting the process' memory.\n"
+    "\n"
+    "Once the limit is exceeded, fetching further rows raises\n"
+    ":py:exc:`MemoryError`, except that rows already read by\n"
+    ":py:meth:`ctds.Cursor.fetchmany` are returned first. Rows fetched by\n"
+    ":py:meth:`ctds.Cursor.fetchall` with a `max_memory` budget are instead\n"
+    "spilled to its temporary file. Rows already buffered are not affected.\n"
+    "\n"
+    "If :py:meth:`ctds.Cursor.fetchall` exceeds the limit after reading\n"
+    "some rows, those rows are discarded and further fetches from the\n"
+    "result set raise :py:exc:`ctds.InterfaceError`, rather than returning\n"
+    "partial results.\n"
+    "\n"
+    ".. versionadded:: 1.15\n"
+    "\n"
+    ":param int limit: The limit, in bytes, or :py:data:`None` to remove the\n"
+    "    limit.\n";
+
+static PyObject* tds_set_memory_limit(PyObject* self, PyObject* args)
+{
+    PyObject* limit;
+    size_t value = 0;
+    if (!PyArg_ParseTuple(args, "O", &limit))
+    {
+        return NULL;
+    }
+
+    if (Py_None != limit)
+    {
+        if (!(
+#if PY_MAJOR_VERSION < 3
+                 PyInt_Check(limit) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+                 PyLong_Check(limit)
+           ) || PyBool_Check(limit))
+        {
+            PyErr_SetObject(PyExc_TypeError, limit);
+            return NULL;
+        }
+#if PY_MAJOR_VERSION < 3
+        if (PyInt_Check(limit))
+        {
+            Py_ssize_t ivalue = PyInt_AsSsize_t(limit);
+            value = (ivalue > 0) ? (size_t)ivalue : 0;
+        }
+        else
+#endif /* if PY_MAJOR_VERSION < 3 */
+        {
+            value = PyLong_AsSize_t(limit);
+        }
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+        if (0 == value)
+        {
+            PyErr_SetObject(PyExc_ValueError, limit);
+            return NULL;
+        }
+    }
+
+    Memory_set_limit(value);
+    Py_RETURN_NONE;
+    UNUSED(self);
+}
+
+static const char s_tds__bench_convert_doc[] =
+    "_bench_convert(tdstype, data, n=1, converter=None)\n"
+    "\n"
+    "Convert raw column data to a Python object `n` times, as done when\n"
+    "fetching rows, without a database.\n"
+    "\n"
+    "This is an internal API, used to benchmark the conversions.\n"
+    "\n"
+    ":param int tdstype: The TDS type of the data.\n"
+    ":param data: The raw data, or a sequence of raw values which are\n"
+    "    converted in turn. :py:data:`None` is a NULL value. Values of\n"
+    "    fixed-width types, e.g. :py:data:`ctds.INT`, must be of the type's\n"
+    "    width.\n"
+    ":type data: bytes or list(bytes)\n"
+    ":param int n: The number of conversions.\n"
+    ":param str converter: The name of a built-in converter to use, e.g.\n"
+    "    `'float'`, or :py:data:`None` for the default conversion.\n"
+    ":return: The elapsed time, in seconds, and the last value converted.\n"
+    ":rtype: tuple(float, object)\n";
+
+static PyObject* tds__bench_convert(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "tdstype",
+        "data",
+        "n",
+        "converter",
+        NULL
+    };
+    int tdstype;
+    PyObject* data;
+    Py_ssize_t n = 1;
+    PyObject* converter = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iO|nO", s_kwlist, &tdstype, &data, &n, &converter))
+    {
+        return NULL;
+    }
+    if (n < 1)
+    {
+        PyErr_Format(PyExc_ValueError, "%ld", (long)n);
+        return NULL;
+    }
+    return Bench_convert((enum TdsType)tdstype, data, n, converter);
+    UNUSED(self);
+}
+
+static const char s_tds__bench_parameter_doc[] =
+    "_bench_parameter(value, n=1)\n"
+    "\n"
+    "Convert a Python object to its TDS representation `n` times, as done\n"
+    "when binding a statement parameter, without a database.\n"
+    "\n"
+    "This is an internal API, used to benchmark the conversions.\n"
+    "\n"
+    ":param object value: The value, which may be wrapped in a SQL type,\n"
+    "    e.g. :py:class:`ctds.SqlVarChar`.\n"
+    ":param int n: The number of conversions.\n"
+    ":return: The elapsed time, in seconds, and the SQL type of the\n"
+    "    parameter.\n"
+    ":rtype: tuple(float, str)\n";
+
+static PyObject* tds__bench_parameter(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    static char* s_kwlist[] =
+    {
+        "value",
+        "n",
+        NULL
+    };
+    PyObject* value;
+    Py_ssize_t n = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", s_kwlist, &value, &n))
+    {
+        return NULL;
+    }
+    if (n < 1)
+    {
+        PyErr_Format(PyExc_ValueError, "%ld", (long)n);
+        return NULL;
+    }
+    return Bench_convert_parameter(value, n);
+    UNUSED(self);
+}
+
 #if defined(__GNUC__) && (__GNUC__ > 7)
 #  pragma GCC diagnostic push
 #  pragma GCC diagnostic ignored "-Wcast-function-type"
 #endif /* if defined(__GNUC__) && (__GNUC__ > 7) */
 
 static PyMethodDef s_tds_methods[] = {
-    { "connect",            (PyCFunction)tds_connect, METH_VARARGS | METH_KEYWORDS, s_tds_connect_doc },
-    { "Date",               tds_Date,                 METH_VARARGS,                 s_tds_Date_doc },
-    { "Time",               tds_Time,                 METH_VARARGS,                 s_tds_Time_doc },
-    { "Timestamp",          tds_Timestamp,            METH_VARARGS,                 s_tds_Timestamp_doc },
-    { "DateFromTicks",      tds_DateFromTicks,        METH_VARARGS,                 s_tds_DateFromTicks_doc },
-    { "TimeFromTicks",      tds_TimeFromTicks,        METH_VARARGS,                 s_tds_TimeFromTicks_doc },
-    { "TimestampFromTicks", tds_TimestampFromTicks,   METH_VARARGS,                 s_tds_TimestampFromTicks_doc },
-    { "Binary",             tds_Binary,               METH_VARARGS,                 s_tds_Binary_doc },
-    { NULL,                 NULL,                     0,                            NULL }
+    { "connect",             (PyCFunction)tds_connect,            METH_VARARGS | METH_KEYWORDS, s_tds_connect_doc },
+    { "Date",                tds_Date,                            METH_VARARGS,                 s_tds_Date_doc },
+    { "Time",                tds_Time,                            METH_VARARGS,                 s_tds_Time_doc },
+    { "Timestamp",           tds_Timestamp,                       METH_VARARGS,                 s_tds_Timestamp_doc },
+    { "DateFromTicks",       tds_DateFromTicks,                   METH_VARARGS,                 s_tds_DateFromTicks_doc },
+    { "TimeFromTicks",       tds_TimeFromTicks,                   METH_VARARGS,                 s_tds_TimeFromTicks_doc },
+    { "TimestampFromTicks",  tds_TimestampFromTicks,              METH_VARARGS,                 s_tds_TimestampFromTicks_doc },
+    { "Binary",              tds_Binary,                          METH_VARARGS,                 s_tds_Binary_doc },
+    { "execute_parallel",    tds_execute_parallel,                METH_VARARGS,                 s_tds_execute_parallel_doc },
+    { "set_trace_hooks",     tds_set_trace_hooks,                 METH_VARARGS,                 s_tds_set_trace_hooks_doc },
+    { "set_statement_stats", tds_set_statement_stats,             METH_VARARGS,                 s_tds_set_statement_stats_doc },
+    { "statement_stats",     (PyCFunction)tds_statement_stats,    METH_VARARGS | METH_KEYWORDS, s_tds_statement_stats_doc },
+    { "latency_histograms",  (PyCFunction)tds_latency_histograms, METH_VARARGS | METH_KEYWORDS, s_tds_latency_histograms_doc },
+    { "set_slow_query_log",  (PyCFunction)tds_set_slow_query_log, METH_VARARGS | METH_KEYWORDS, s_tds_set_slow_query_log_doc },
+    { "memory_stats",        (PyCFunction)tds_memory_stats,       METH_VARARGS | METH_KEYWORDS, s_tds_memory_stats_doc },
+    { "set_memory_limit",    tds_set_memory_limit,                METH_VARARGS,                 s_tds_set_memory_limit_doc },
+    { "_bench_convert",      (PyCFunction)tds__bench_convert,     METH_VARARGS | METH_KEYWORDS, s_tds__bench_convert_doc },
+    { "_bench_parameter",    (PyCFunction)tds__bench_parameter,   METH_VARARGS | METH_KEYWORDS, s_tds__bench_parameter_doc },
+    { NULL,                  NULL,                                0,                            NULL }
 };
 
 #if defined(__GNUC__) && (__GNUC__ > 7)
@@ -532,6 +1060,9 @@ static void tds_free(void* ctx)
     PyDateTimeType_free();
     PyDecimalType_free();
     PyUuidType_free();
+    Trace_free();
+    Statements_free();
+    SlowLog_free();
 
     Py_XDECREF(PyExc_tds_Warning);
     Py_XDECREF(PyExc_tds_Error);
@@ -851,11 +1382,15 @@ PyMODINIT_FUNC PyInit__tds(void)
     if (0 != PyModule_AddObject(module, "Connection", (PyObject*)ConnectionType_init())) FAIL_MODULE_INIT;
     if (0 != PyModule_AddObject(module, "Cursor", (PyObject*)CursorType_init())) FAIL_MODULE_INIT;
     if (0 != PyModule_AddObject(module, "Parameter", (PyObject*)ParameterType_init())) FAIL_MODULE_INIT;
+    if (0 != PyModule_AddObject(module, "Pool", (PyObject*)PoolType_init())) FAIL_MODULE_INIT;
+    if (0 != PyModule_AddObject(module, "ResultCache", (PyObject*)ResultCacheType_init())) FAIL_MODULE_INIT;
     if (0 != PyModule_AddObject(module, "RowList", (PyObject*)RowListType_init())) FAIL_MODULE_INIT;
     if (0 != PyModule_AddObject(module, "Row", (PyObject*)RowType_init())) FAIL_MODULE_INIT;
 
     if (0 != SqlTypes_init()) FAIL_MODULE_INIT;
 
+    if (0 != Trace_init()) FAIL_MODULE_INIT;
+
     /* Add SQL type wrappers (in alphabetical order). */
 #define SQL_TYPE_INIT(_type) \
         if (0 != PyModule_AddObject(module, "Sql" #_type, (PyObject*)Sql ## _type ## Type_init())) FAIL_MODULE_INIT
@@ -0,0 +1,172 @@
+#include "include/push_warnings.h"
+#include <Python.h>
+#include <sybdb.h>
+#include "include/pop_warnings.h"
+
+#include "include/clock.h"
+#include "include/connection.h"
+#include "include/trace.h"
+
+PyObject* Trace_hooks = NULL;
+
+/* The Python names of each operation, indexed by `enum TraceOperation`. */
+static PyObject* s_operations[TraceOperation_count];
+
+int Trace_init(void)
+{
+    static const char* s_names[TraceOperation_count] =
+    {
+        "execute",
+        "executemany",
+        "callproc",
+        "bulk_insert",
+        "fetch",
+        "execute_async"
+    };
+
+    size_t ix;
+    for (ix = 0; ix < TraceOperation_count; ++ix)
+    {
+        if (!s_operations[ix])
+        {
+#if PY_MAJOR_VERSION < 3
+            s_operations[ix] = PyString_FromString(s_names[ix]);
+#else /* if PY_MAJOR_VERSION < 3 */
+            s_operations[ix] = PyUnicode_FromString(s_names[ix]);
+#endif /* else if PY_MAJOR_VERSION < 3 */
+            if (!s_operations[ix])
+            {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+void Trace_free(void)
+{
+    size_t ix;
+    for (ix = 0; ix < TraceOperation_count; ++ix)
+    {
+        Py_CLEAR(s_operations[ix]);
+    }
+    Py_CLEAR(Trace_hooks);
+}
+
+int Trace_set_hooks(PyObject* on_start, PyObject* on_end)
+{
+    PyObject* hooks = NULL;
+    PyObject* previous;
+
+    if ((Py_None != on_start) && !PyCallable_Check(on_start))
+    {
+        PyErr_SetObject(PyExc_TypeError, on_start);
+        return -1;
+    }
+    if ((Py_None != on_end) && !PyCallable_Check(on_end))
+    {
+        PyErr_SetObject(PyExc_TypeError, on_end);
+        return -1;
+    }
+
+    if ((Py_None != on_start) || (Py_None != on_end))
+    {
+        hooks = PyTuple_Pack(2, on_start, on_end);
+        if (!hooks)
+        {
+            return -1;
+        }
+    }
+
+    /*
+        Operations in progress hold their own reference to the previous
+        hooks. The global is replaced before releasing them, as doing so may
+        run arbitrary code, e.g. a finalizer which traces a query.
+    */
+    previous = Trace_hooks;
+    Trace_hooks = hooks;
+    Py_XDECREF(previous);
+    return 0;
+}
+
+void Trace_begin(struct TraceSpan* span, enum TraceOperation operation,
+                 PyObject* sql, struct Connection* connection)
+{
+    PyObject* on_start;
+
+    Py_INCREF(Trace_hooks);
+    span->hooks = Trace_hooks;
+    span->token = NULL;
+
+    on_start = PyTuple_GET_ITEM(span->hooks, 0);
+    if (Py_None != on_start)
+    {
+        PyObject* spid;
+        if (!connection || Connection_closed(connection))
+        {
+            Py_INCREF(Py_None);
+            spid = Py_None;
+        }
+        else
+        {
+            spid = PyLong_FromLong((long)dbspid(Connection_DBPROCESS(connection)));
+        }
+        if (spid)
+        {
+            span->token = PyObject_CallFunctionObjArgs(on_start,
+                                                       s_operations[operation],
+                                                       (sql) ? sql : Py_None,
+                                                       spid,
+                                                       NULL);
+            Py_DECREF(spid);
+        }
+        if (!span->token)
+        {
+            PyErr_WriteUnraisable(on_start);
+        }
+    }
+
+    /* Exclude the time spent in the hook. */
+    span->start = Clock_monotonic_ns();
+}
+
+void Trace_end(struct TraceSpan* span, Py_ssize_t rows)
+{
+    uint64_t elapsed = Clock_monotonic_ns() - span->start;
+    PyObject* on_end = PyTuple_GET_ITEM(span->hooks, 1);
+
+    if (Py_None != on_end)
+    {
+        PyObject* type;
+        PyObject* value;
+        PyObject* traceback;
+        PyObject* result;
+
+        /* Pass the operation's exception, if any, to the hook without clearing it. */
+        PyErr_Fetch(&type, &value, &traceback);
+        if (type)
+        {
+            PyErr_NormalizeException(&type, &value, &traceback);
+        }
+
+        result = PyObject_CallFunction(on_end,
+                                       "OnKO",
+                                       (span->token) ? span->token : Py_None,
+                                       rows,
+                                       (unsigned PY_LONG_LONG)elapsed,
+                                       (value) ? value : Py_None);
+        if (result)
+        {
+            Py_DECREF(result);
+        }
+        else
+        {
+            PyErr_WriteUnraisable(on_end);
+        }
+
+        PyErr_Restore(type, value, traceback);
+    }
+
+    Py_XDECREF(span->token);
+    Py_DECREF(span->hooks);
+}
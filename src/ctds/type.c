@@ -919,11 +919,18 @@ int SqlTypes_init(void)
     return -1;
 }
 
+/*
+    Note: DB-Lib converts (N)CHAR, (N)VARCHAR and (N)TEXT data to the client
+    character set (UTF-8) as the row is read from the wire and reports the
+    column types as their non-N equivalents. The raw UTF-16 data for NCHAR
+    columns is never available via `dbdata`, so all textual data is decoded
+    here from UTF-8.
+*/
 static PyObject* SQLCHAR_topython(enum TdsType tdstype, const void* data, size_t ndata)
 {
     if (!data) Py_RETURN_NONE;
 
-    return PyUnicode_DecodeUTF8((const char*)data, (Py_ssize_t)ndata, "strict");
+    return unicode_from_utf8((const char*)data, (Py_ssize_t)ndata);
 
     UNUSED(tdstype);
 }
@@ -933,30 +940,29 @@ static PyObject* SQLINT_topython(enum TdsType tdstype, const void* data, size_t
     PY_LONG_LONG value;
     if (!ndata) Py_RETURN_NONE;
 
-    switch (tdstype)
+    /*
+        Switch on the width rather than the type, which also handles
+        TDSINTN values of any width.
+    */
+    switch (ndata)
     {
-        case TDSTINYINT:
+        case 1:
         {
-            assert(1 == ndata);
-
             /* TDSTINYINT type is unsigned. */
             return PyLong_FromUnsignedLong(*((uint8_t*)data));
         }
-        case TDSSMALLINT:
+        case 2:
         {
-            assert(2 == ndata);
             value = *((int16_t*)data);
             break;
         }
-        case TDSINT:
+        case 4:
         {
-            assert(4 == ndata);
             value = *((int32_t*)data);
             break;
         }
-        case TDSBIGINT:
+        case 8:
         {
-            assert(8 == ndata);
             value = *((int64_t*)data);
             break;
         }
@@ -1217,6 +1223,224 @@ sql_topython sql_topython_lookup(enum TdsType tdstype)
     return NULL;
 }
 
+/*
+    Built-in native converters, selectable by name as an alternative to the
+    default conversion for a type, e.g. `{ ctds.DECIMAL: 'float' }`.
+*/
+
+static PyObject* SQLCHAR_tobytes(enum TdsType tdstype, const void* data, size_t ndata)
+{
+    if (!data) Py_RETURN_NONE;
+
+    /* Return the raw, UTF-8-encoded bytes. */
+    return PyBytes_FromStringAndSize((const char*)data, (Py_ssize_t)ndata);
+
+    UNUSED(tdstype);
+}
+
+static PyObject* NUMERIC_tofloat(enum TdsType tdstype, const void* data, size_t ndata)
+{
+    DBFLT8 value;
+    DBINT size;
+
+    if (!ndata) Py_RETURN_NONE;
+
+    size = dbconvert(NULL,
+                     tdstype,
+                     data,
+                     (DBINT)ndata,
+                     SYBFLT8,
+                     (BYTE*)&value,
+                     (DBINT)sizeof(value));
+    if (-1 == size)
+    {
+        PyErr_Format(PyExc_RuntimeError, "failed to convert NUMERIC to FLOAT");
+        return NULL;
+    }
+    return PyFloat_FromDouble(value);
+}
+
+static PyObject* MONEY_tofloat(enum TdsType tdstype, const void* data, size_t ndata)
+{
+    /*
+        MONEY values are stored as a 64-bit integer (split into high and low
+        32-bit words) and SMALLMONEY as a 32-bit integer, both in
+        ten-thousandths of the monetary unit.
+    */
+    PY_LONG_LONG value;
+    if (!ndata) Py_RETURN_NONE;
+
+    if (8 == ndata)
+    {
+        int32_t high;
+        uint32_t low;
+        memcpy(&high, data, sizeof(high));
+        memcpy(&low, (const char*)data + sizeof(high), sizeof(low));
+        value = ((PY_LONG_LONG)high * 0x100000000LL) + (PY_LONG_LONG)low;
+    }
+    else
+    {
+        int32_t smallmoney;
+        assert(4 == ndata);
+        memcpy(&smallmoney, data, sizeof(smallmoney));
+        value = smallmoney;
+    }
+
+    return PyFloat_FromDouble((double)value / 10000.0);
+
+    UNUSED(tdstype);
+}
+
+static PyObject* GUID_tostr(enum TdsType tdstype, const void* data, size_t ndata)
+{
+    /*
+        The first three groups of a SQL Server uniqueidentifier are stored in
+        host byte order, the remaining bytes in network byte order.
+    */
+    char str[ARRAYSIZE("00000000-0000-0000-0000-000000000000")];
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t data1;
+    uint16_t data2, data3;
+    int written;
+
+    if (!ndata) Py_RETURN_NONE;
+
+    assert(16 == ndata);
+    memcpy(&data1, &bytes[0], sizeof(data1));
+    memcpy(&data2, &bytes[4], sizeof(data2));
+    memcpy(&data3, &bytes[6], sizeof(data3));
+
+    written = PyOS_snprintf(str,
+                            sizeof(str),
+                            "%08lx-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+                            (unsigned long)data1,
+                            (unsigned int)data2,
+                            (unsigned int)data3,
+                            bytes[8], bytes[9],
+                            bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]);
+
+    return PyUnicode_FromStringAndSize(str, (Py_ssize_t)written);
+
+    UNUSED(tdstype);
+}
+
+static const struct {
+    const char* name;
+    enum TdsType tdstype;
+    sql_topython topython;
+} s_native_converters[] = {
+    { "bytes", TDSCHAR,          SQLCHAR_tobytes },
+    { "bytes", TDSVARCHAR,       SQLCHAR_tobytes },
+    { "bytes", TDSTEXT,          SQLCHAR_tobytes },
+    { "bytes", TDSXML,           SQLCHAR_tobytes },
+    { "bytes", TDSGUID,          SQLBINARY_topython },
+
+    { "float", TDSDECIMAL,       NUMERIC_tofloat },
+    { "float", TDSNUMERIC,       NUMERIC_tofloat },
+    { "float", TDSSMALLMONEY,    MONEY_tofloat },
+    { "float", TDSMONEY,         MONEY_tofloat },
+    { "float", TDSMONEYN,        MONEY_tofloat },
+
+    { "str",   TDSGUID,          GUID_tostr },
+};
+
+int sql_topython_native_lookup(PyObject* name, enum TdsType tdstype, sql_topython* topython)
+{
+    int found = -1;
+    const char* str;
+    size_t ix;
+
+#if PY_MAJOR_VERSION < 3
+    PyObject* utf8 = NULL;
+    if (PyUnicode_Check(name))
+    {
+        utf8 = PyUnicode_AsUTF8String(name);
+        str = (utf8) ? PyString_AS_STRING(utf8) : NULL;
+    }
+    else
+    {
+        str = PyString_AsString(name);
+    }
+#else /* if PY_MAJOR_VERSION < 3 */
+    str = PyUnicode_AsUTF8(name);
+#endif /* else if PY_MAJOR_VERSION < 3 */
+
+    *topython = NULL;
+    if (str)
+    {
+        for (ix = 0; ix < ARRAYSIZE(s_native_converters); ++ix)
+        {
+            if (0 == strcmp(str, s_native_converters[ix].name))
+            {
+                found = 0;
+                if (tdstype == s_native_converters[ix].tdstype)
+                {
+                    *topython = s_native_converters[ix].topython;
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        /* Names which cannot be encoded are simply unknown. */
+        PyErr_Clear();
+    }
+
+#if PY_MAJOR_VERSION < 3
+    Py_XDECREF(utf8);
+#endif /* if PY_MAJOR_VERSION < 3 */
+
+    return found;
+}
+
+int converters_validate(PyObject* converters)
+{
+    PyObject* key;
+    PyObject* value;
+    Py_ssize_t pos = 0;
+
+    if (!PyDict_Check(converters))
+    {
+        PyErr_SetObject(PyExc_TypeError, converters);
+        return -1;
+    }
+
+    while (PyDict_Next(converters, &pos, &key, &value))
+    {
+        if (
+#if PY_MAJOR_VERSION < 3
+            !PyString_Check(key) && !PyInt_Check(key) &&
+#endif /* if PY_MAJOR_VERSION < 3 */
+            !PyUnicode_Check(key) && !PyLong_Check(key))
+        {
+            PyErr_SetObject(PyExc_TypeError, key);
+            return -1;
+        }
+
+        if (
+#if PY_MAJOR_VERSION < 3
+            PyString_Check(value) ||
+#endif /* if PY_MAJOR_VERSION < 3 */
+            PyUnicode_Check(value))
+        {
+            sql_topython topython;
+            if (0 != sql_topython_native_lookup(value, TDSUNKNOWN, &topython))
+            {
+                PyErr_SetObject(PyExc_ValueError, value);
+                return -1;
+            }
+        }
+        else if (!PyCallable_Check(value))
+        {
+            PyErr_SetObject(PyExc_TypeError, value);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 #if !defined(CTDS_USE_UTF16)
 
 #ifdef _MSC_VER
@@ -87,6 +87,48 @@ class TestConnectionPool(unittest.TestCase):
             ]
         )
 
+    def test_reset(self):
+        mock_dbapi2 = mock.MagicMock()
+
+        pool = ConnectionPool(mock_dbapi2, {}, reset=True)
+
+        conn = pool.acquire()
+        pool.release(conn)
+
+        mock_dbapi2.assert_has_calls(
+            [
+                mock.call.connect(),
+                mock.call.connect().rollback(),
+                mock.call.connect().reset(),
+            ]
+        )
+
+        # The connection is returned to the pool after the reset.
+        self.assertEqual(id(conn), id(pool.acquire()))
+
+    def test_reset_exception(self): # pylint: disable=no-self-use
+        class MockDBAPI2Error(Exception):
+            pass
+
+        mock_dbapi2 = mock.MagicMock()
+        type(mock_dbapi2).Error = \
+            mock.PropertyMock(return_value=MockDBAPI2Error)
+
+        pool = ConnectionPool(mock_dbapi2, {}, reset=True)
+        mock_dbapi2.connect.return_value.reset.side_effect = MockDBAPI2Error
+
+        pool.release(pool.acquire())
+
+        # Verify the connection is closed on reset error.
+        mock_dbapi2.assert_has_calls(
+            [
+                mock.call.connect(),
+                mock.call.connect().rollback(),
+                mock.call.connect().reset(),
+                mock.call.connect().close(),
+            ]
+        )
+
     def test_contextmanager(self):
         mock_dbapi2 = mock.MagicMock()
         pool = ConnectionPool(mock_dbapi2, {}, maxsize=10)
@@ -0,0 +1,54 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+class TestConnectionConverters(TestExternalDatabase):
+    '''Unit tests related to the Connection.converters property.
+    '''
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Connection.converters.__doc__,
+            '''\
+The default output converters for :py:class:`ctds.Cursor` objects
+created by this connection, or :py:data:`None`.
+See :py:attr:`ctds.Cursor.converters`. As for the cursor's converters,
+the :py:class:`dict` is copied when set and when read.
+
+.. versionadded:: 1.15
+
+:rtype: dict
+'''
+        )
+
+    def test_getset(self):
+        with self.connect() as connection:
+            self.assertEqual(connection.converters, None)
+            converters = {ctds.DECIMAL: 'float'}
+            connection.converters = converters
+            self.assertEqual(connection.converters, converters)
+
+            # Changes to the dict after assignment are not used.
+            converters[ctds.DECIMAL] = 'unknown'
+            self.assertEqual(connection.converters, {ctds.DECIMAL: 'float'})
+
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT CONVERT(DECIMAL(3, 1), 1.5)')
+                self.assertEqual(tuple(cursor.fetchone()), (1.5,))
+
+            connection.converters = None
+            self.assertEqual(connection.converters, None)
+
+    def test_invalid(self):
+        with self.connect() as connection:
+            for converters, exception in (
+                    ('float', TypeError),
+                    ({ctds.DECIMAL: object()}, TypeError),
+                    ({ctds.DECIMAL: 'unknown'}, ValueError),
+            ):
+                try:
+                    connection.converters = converters
+                except exception:
+                    self.assertEqual(connection.converters, None)
+                else:
+                    self.fail('.converters did not fail as expected') # pragma: nocover
@@ -0,0 +1,33 @@
+import ctds
+
+from .base import TestExternalDatabase
+from .compat import long_
+
+class TestConnectionFileno(TestExternalDatabase):
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Connection.fileno.__doc__,
+            '''\
+fileno()
+
+Get the file descriptor of the connection's socket. This allows the
+connection to be monitored for readability, e.g. by an event loop.
+
+.. versionadded:: 1.15
+
+:return: The file descriptor.
+:rtype: int
+'''
+        )
+
+    def test_fileno(self):
+        with self.connect() as connection:
+            fileno = connection.fileno()
+            self.assertTrue(isinstance(fileno, long_))
+            self.assertTrue(fileno >= 0)
+
+    def test_closed(self):
+        connection = self.connect()
+        connection.close()
+        self.assertRaises(ctds.InterfaceError, connection.fileno)
@@ -0,0 +1,80 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+class TestConnectionInTransaction(TestExternalDatabase):
+    '''Unit tests related to the Connection.in_transaction attribute.
+    '''
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Connection.in_transaction.__doc__,
+            '''\
+Whether a transaction may be pending on the connection, i.e. auto-commit
+is disabled and a statement has been executed since the last
+:py:meth:`.commit` or :py:meth:`.rollback`. If not, :py:meth:`.commit`
+and :py:meth:`.rollback` return without a round trip to the server.
+
+.. note::
+
+    Transactions started explicitly, e.g. using `BEGIN TRANSACTION`, while
+    auto-commit is enabled are not tracked.
+
+.. versionadded:: 1.15
+
+:rtype: bool
+'''
+        )
+
+    def test_read(self):
+        with self.connect(autocommit=False) as connection:
+            self.assertEqual(connection.in_transaction, False)
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT @@TRANCOUNT')
+                self.assertEqual(cursor.fetchone()[0], 0)
+                self.assertEqual(connection.in_transaction, True)
+
+                connection.commit()
+                self.assertEqual(connection.in_transaction, False)
+
+                cursor.callproc('sp_who', ())
+                self.assertEqual(connection.in_transaction, True)
+
+                connection.rollback()
+                self.assertEqual(connection.in_transaction, False)
+
+        self.assertEqual(connection.in_transaction, False)
+
+    def test_read_autocommit(self):
+        with self.connect(autocommit=True) as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+                self.assertEqual(connection.in_transaction, False)
+
+                connection.autocommit = False
+                cursor.execute('SELECT 1')
+                self.assertEqual(connection.in_transaction, True)
+
+                connection.autocommit = True
+                self.assertEqual(connection.in_transaction, False)
+
+    def test_rollback(self):
+        with self.connect(autocommit=False) as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('CREATE TABLE {0} (i INT)'.format(self.test_rollback.__name__))
+                self.assertEqual(connection.in_transaction, True)
+
+                connection.rollback()
+                self.assertEqual(connection.in_transaction, False)
+
+                cursor.execute('SELECT OBJECT_ID(N\'{0}\')'.format(self.test_rollback.__name__))
+                self.assertEqual(cursor.fetchone()[0], None)
+
+    def test_write(self):
+        with self.connect() as connection:
+            try:
+                connection.in_transaction = True
+            except AttributeError:
+                pass
+            else:
+                self.fail('.in_transaction did not fail as expected') # pragma: nocover
@@ -0,0 +1,161 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+class TestConnectionReset(TestExternalDatabase):
+    '''Unit tests related to the Connection.reset() method.
+    '''
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Connection.reset.__doc__,
+            '''\
+reset()
+
+Reset the connection's session state to that after it was opened. Any
+pending transaction is rolled back, session options changed by ``SET``
+statements are restored and the initial database is restored.
+
+No request is made to the server by this method. Instead, the reset is
+sent ahead of the next SQL batch executed on the connection, avoiding
+an additional round trip. A separate batch is used if the next command
+is a stored procedure call or bulk insert, if the reset must change the
+database, or if the SQL must be the first statement in its batch, e.g.
+``CREATE PROCEDURE``.
+
+.. note:: Unlike the ``sp_reset_connection`` stored procedure, temporary
+    tables are not dropped.
+
+.. versionadded:: 1.15
+
+:returns: :py:data:`None`
+'''
+        )
+
+    def test_closed(self):
+        connection = self.connect()
+        connection.close()
+        self.assertRaises(ctds.InterfaceError, connection.reset)
+
+    def test_reset(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('''
+                    SET NOCOUNT ON;
+                    SET XACT_ABORT ON;
+                    SET ROWCOUNT 1;
+                    SET TRANSACTION ISOLATION LEVEL SERIALIZABLE;
+                ''')
+                self.assertEqual(connection.reset(), None)
+
+                cursor.execute('''
+                    SELECT
+                        @@OPTIONS & 512,
+                        @@OPTIONS & 16384,
+                        transaction_isolation_level
+                    FROM sys.dm_exec_sessions
+                    WHERE session_id = @@SPID
+                    UNION ALL
+                    SELECT 0, 0, 0
+                ''')
+                # ROWCOUNT is reset, NOCOUNT (512) and XACT_ABORT (16384) are
+                # off and the isolation level is READ COMMITTED (2).
+                self.assertEqual(
+                    [tuple(row) for row in cursor.fetchall()],
+                    [(0, 0, 2), (0, 0, 0)]
+                )
+
+    def test_reset_transaction(self):
+        with self.connect(autocommit=True) as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('BEGIN TRANSACTION')
+                connection.reset()
+                cursor.execute('SELECT @@TRANCOUNT')
+                self.assertEqual(cursor.fetchone()[0], 0)
+
+    def test_reset_autocommit(self):
+        with self.connect(autocommit=False) as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+                self.assertEqual(connection.in_transaction, True)
+
+                connection.reset()
+
+                # The transaction is pending until the reset is executed.
+                self.assertEqual(connection.in_transaction, True)
+                connection.commit()
+                self.assertEqual(connection.in_transaction, False)
+
+                # Implicit transactions remain enabled.
+                cursor.execute('SELECT @@OPTIONS & 2')
+                self.assertEqual(cursor.fetchone()[0], 2)
+                self.assertEqual(connection.in_transaction, True)
+            connection.rollback()
+
+    def test_reset_database(self):
+        with self.connect() as connection:
+            database = connection.database
+            connection.use('master')
+            self.assertEqual(connection.database, 'master')
+
+            connection.reset()
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT DB_NAME()')
+                self.assertEqual(cursor.fetchone()[0], database)
+                self.assertEqual(connection.messages, [])
+            self.assertEqual(connection.database, database)
+
+    def test_reset_use(self):
+        with self.connect() as connection:
+            database = connection.database
+            connection.use('master')
+            connection.reset()
+
+            # The reset is sent before changing the database.
+            connection.use('master')
+            self.assertEqual(connection.database, 'master')
+            connection.use(database)
+
+    def test_reset_create(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SET NOCOUNT ON')
+                connection.reset()
+
+                # CREATE PROCEDURE must be the first statement in the batch.
+                cursor.execute('''
+                    -- A comment.
+                    CREATE PROCEDURE #ResetCreate AS SELECT @@OPTIONS & 512
+                ''')
+                cursor.callproc('#ResetCreate', ())
+                self.assertEqual(cursor.fetchone()[0], 0)
+
+    def test_reset_callproc(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('''
+                    CREATE PROCEDURE #ResetCallproc AS SELECT 1 UNION ALL SELECT 2
+                ''')
+                cursor.execute('SET ROWCOUNT 1')
+                connection.reset()
+                cursor.callproc('#ResetCallproc', ())
+                self.assertEqual(len(cursor.fetchall()), 2)
+
+    def test_reset_error(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SET NOCOUNT ON')
+                connection.reset()
+
+                # The batch fails to compile, so the reset is sent again.
+                self.assertRaises(ctds.ProgrammingError, cursor.execute, 'SELEC 1')
+                cursor.execute('SELECT @@OPTIONS & 512')
+                self.assertEqual(cursor.fetchone()[0], 0)
+
+    def test_reset_temp_table(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('CREATE TABLE #ResetTempTable (Value INT)')
+                connection.reset()
+                cursor.execute('SELECT OBJECT_ID(\'tempdb..#ResetTempTable\')')
+                self.assertNotEqual(cursor.fetchone()[0], None)
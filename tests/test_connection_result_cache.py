@@ -0,0 +1,41 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+class TestConnectionResultCache(TestExternalDatabase):
+    '''Unit tests related to the Connection.result_cache property.
+    '''
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Connection.result_cache.__doc__,
+            '''\
+The :py:class:`ctds.ResultCache` used to cache the results of
+:py:meth:`ctds.Cursor.execute` calls on this connection, or
+:py:data:`None`.
+
+.. versionadded:: 1.15
+
+:rtype: ctds.ResultCache
+'''
+        )
+
+    def test_getset(self):
+        with self.connect() as connection:
+            self.assertEqual(connection.result_cache, None)
+            cache = ctds.ResultCache()
+            connection.result_cache = cache
+            self.assertTrue(connection.result_cache is cache)
+
+            connection.result_cache = None
+            self.assertEqual(connection.result_cache, None)
+
+    def test_invalid(self):
+        with self.connect() as connection:
+            for result_cache in ({}, object(), 1):
+                try:
+                    connection.result_cache = result_cache
+                except TypeError:
+                    self.assertEqual(connection.result_cache, None)
+                else:
+                    self.fail('.result_cache did not fail as expected') # pragma: nocover
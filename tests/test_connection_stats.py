@@ -0,0 +1,134 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+class TestConnectionStats(TestExternalDatabase):
+    '''Unit tests related to the Connection.stats attribute and
+    Connection.reset_stats() method.
+    '''
+
+    KEYS = (
+        'round_trips',
+        'bytes_sent',
+        'bytes_received',
+        'rows',
+        'send_time',
+        'response_time',
+        'fetch_time',
+        'conversion_time',
+    )
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Connection.stats.__doc__,
+            '''\
+A snapshot of the connection's cumulative performance counters, for
+telling apart time spent on the network, in the server and converting
+results. The counters are kept since the connection was opened or
+last reset using :py:meth:`.reset_stats`.
+
+* ``round_trips``: The number of requests sent to the server and
+  awaited, including SQL batches, stored procedure calls and bulk
+  insert batches.
+* ``bytes_sent``: The bytes of SQL text and parameter data sent. This
+  excludes TDS protocol overhead and encoding.
+* ``bytes_received``: The bytes of column data received.
+* ``rows``: The number of rows fetched.
+* ``send_time``: The time, in seconds, spent sending requests.
+* ``response_time``: The time, in seconds, spent waiting for the
+  server to respond to requests.
+* ``fetch_time``: The time, in seconds, spent reading rows.
+* ``conversion_time``: The time, in seconds, spent converting column
+  data to Python objects, if enabled using :py:attr:`.time_conversions`.
+  Rows fetched from the connection continue to add to this after the
+  connection is closed.
+
+.. versionadded:: 1.15
+
+:rtype: dict
+'''
+        )
+        self.assertEqual(
+            ctds.Connection.reset_stats.__doc__,
+            '''\
+reset_stats()
+
+Reset the connection's performance counters, :py:attr:`.stats`, to zero.
+
+.. versionadded:: 1.15
+
+:returns: :py:data:`None`
+'''
+        )
+
+    def test_read(self):
+        with self.connect() as connection:
+            stats = connection.stats
+            self.assertEqual(sorted(stats.keys()), sorted(self.KEYS))
+
+            connection.reset_stats()
+            self.assertEqual(connection.stats, dict((key, 0) for key in self.KEYS))
+
+            connection.time_conversions = True
+
+            with connection.cursor() as cursor:
+                cursor.execute("SELECT 1 AS Value UNION ALL SELECT 2 UNION ALL SELECT 3")
+                rows = cursor.fetchall()
+                self.assertEqual([row[0] for row in rows], [1, 2, 3])
+
+            stats = connection.stats
+            self.assertEqual(stats['round_trips'], 1)
+            self.assertTrue(stats['bytes_sent'] > 0)
+            self.assertEqual(stats['bytes_received'], 3 * 4)
+            self.assertEqual(stats['rows'], 3)
+            for key in ('send_time', 'response_time', 'fetch_time', 'conversion_time'):
+                self.assertTrue(stats[key] > 0, key)
+
+        # Counters remain available after the connection is closed.
+        self.assertEqual(connection.stats['rows'], 3)
+
+    def test_snapshot(self):
+        with self.connect() as connection:
+            stats = connection.stats
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+            self.assertNotEqual(connection.stats, stats)
+
+    def test_callproc(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('CREATE PROCEDURE #StatsCallproc @Value INT AS SELECT @Value')
+                connection.reset_stats()
+                cursor.callproc('#StatsCallproc', (1,))
+                self.assertEqual(cursor.fetchall()[0][0], 1)
+
+            stats = connection.stats
+            self.assertEqual(stats['round_trips'], 1)
+            self.assertEqual(stats['bytes_sent'], len('#StatsCallproc') + 4)
+            self.assertEqual(stats['rows'], 1)
+
+    def test_commit(self):
+        with self.connect(autocommit=False) as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+            connection.reset_stats()
+            connection.commit()
+            self.assertEqual(connection.stats['round_trips'], 1)
+
+            # No round trip is made without a pending transaction.
+            connection.commit()
+            self.assertEqual(connection.stats['round_trips'], 1)
+
+    def test_reset_stats(self):
+        with self.connect() as connection:
+            connection.time_conversions = True
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+                row = cursor.fetchone()
+
+            connection.reset_stats()
+            self.assertEqual(row[0], 1)
+
+            # Converting rows read before the reset is counted after it.
+            self.assertTrue(connection.stats['conversion_time'] > 0)
+            self.assertEqual(connection.stats['rows'], 0)
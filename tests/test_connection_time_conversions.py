@@ -0,0 +1,52 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+class TestConnectionTimeConversions(TestExternalDatabase):
+    '''Unit tests related to the Connection.time_conversions attribute.
+    '''
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Connection.time_conversions.__doc__,
+            '''\
+Whether the time spent converting column data to Python objects is
+added to the ``conversion_time`` of :py:attr:`.stats`. Timing costs
+two clock reads for each value converted, which may exceed the cost of
+the conversion itself, so it is disabled by default. It applies to the
+result sets of statements executed once it is enabled.
+
+.. versionadded:: 1.15
+
+:rtype: bool
+'''
+        )
+
+    def test_typeerror(self):
+        with self.connect() as connection:
+            for value in (None, 1, 'True'):
+                try:
+                    connection.time_conversions = value
+                except TypeError:
+                    pass
+                else:
+                    self.fail('.time_conversions did not fail as expected') # pragma: nocover
+            self.assertEqual(connection.time_conversions, False)
+
+    def test_getset(self):
+        with self.connect() as connection:
+            self.assertEqual(connection.time_conversions, False)
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1 AS Value UNION ALL SELECT 2')
+                self.assertEqual([row[0] for row in cursor.fetchall()], [1, 2])
+            self.assertEqual(connection.stats['conversion_time'], 0)
+
+            connection.time_conversions = True
+            self.assertEqual(connection.time_conversions, True)
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1 AS Value UNION ALL SELECT 2')
+                self.assertEqual([row[0] for row in cursor.fetchall()], [1, 2])
+            self.assertTrue(connection.stats['conversion_time'] > 0)
+
+            connection.time_conversions = False
+            self.assertEqual(connection.time_conversions, False)
@@ -0,0 +1,183 @@
+from decimal import Decimal
+import uuid
+
+import ctds
+
+from .base import TestExternalDatabase
+from .compat import long_, unicode_
+
+class TestCursorConverters(TestExternalDatabase):
+    '''Unit tests related to the Cursor.converters property.
+    '''
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Cursor.converters.__doc__,
+            '''\
+A :py:class:`dict` of output converters to apply to result set values,
+or :py:data:`None`. Converters are keyed by either a column name or a
+TDS type code, e.g. :py:data:`ctds.DECIMAL`. Converters registered by
+column name take precedence.
+
+A converter is either a callable, which is called with each
+non-:py:data:`None` value after the default conversion, or the name of a
+built-in converter, which replaces the default conversion:
+
+* ``'bytes'``: :py:data:`ctds.CHAR`, :py:data:`ctds.VARCHAR`,
+  :py:data:`ctds.TEXT`, **XML** and :py:data:`ctds.GUID` values as raw
+  :py:class:`bytes`.
+* ``'float'``: :py:data:`ctds.DECIMAL`, :py:data:`ctds.NUMERIC` and
+  :py:data:`ctds.MONEY` values as :py:class:`float`.
+* ``'str'``: :py:data:`ctds.GUID` values as :py:class:`str`.
+
+Converters are resolved once per result set and called as each value is
+first read from its :py:class:`ctds.Row`, so any exception a converter
+raises is raised by the column access. The :py:class:`dict` is
+copied when set and when read, so changes to it have no effect until it
+is assigned again.
+
+.. versionadded:: 1.15
+
+:rtype: dict
+'''
+        )
+
+    def test_getset(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                self.assertEqual(cursor.converters, None)
+                converters = {ctds.INT: str, 'Name': 'bytes'}
+                cursor.converters = converters
+                self.assertEqual(cursor.converters, converters)
+                self.assertFalse(cursor.converters is converters)
+                cursor.converters = None
+                self.assertEqual(cursor.converters, None)
+
+    def test_connection_default(self):
+        with self.connect() as connection:
+            converters = {ctds.INT: str}
+            connection.converters = converters
+            with connection.cursor() as cursor:
+                self.assertEqual(cursor.converters, converters)
+
+    def test_invalid(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                for converters, exception in (
+                        ([], TypeError),
+                        ({1.0: str}, TypeError),
+                        ({ctds.INT: 1}, TypeError),
+                        ({ctds.INT: 'unknown'}, ValueError),
+                ):
+                    try:
+                        cursor.converters = converters
+                    except exception:
+                        self.assertEqual(cursor.converters, None)
+                    else:
+                        self.fail('.converters did not fail as expected') # pragma: nocover
+
+    def test_copied(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                converters = {ctds.INT: str}
+                cursor.converters = converters
+
+                # Invalid converters added after assignment are not used.
+                converters[ctds.INT] = 'unknown'
+                cursor.converters[ctds.INT] = 1
+                self.assertEqual(cursor.converters, {ctds.INT: str})
+
+                cursor.execute('SELECT CONVERT(INT, 1)')
+                self.assertEqual(tuple(cursor.fetchone()), ('1',))
+
+    def test_callable(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.converters = {
+                    ctds.INT: lambda value: value * 2,
+                    'Renamed': unicode_.upper,
+                }
+                cursor.execute(
+                    '''
+                    SELECT
+                        CONVERT(INT, 21) AS Int,
+                        CONVERT(INT, NULL) AS IntNull,
+                        CONVERT(BIGINT, 21) AS BigInt,
+                        CONVERT(VARCHAR(10), 'abc') AS Renamed,
+                        CONVERT(INT, 1) AS Other
+                    '''
+                )
+                self.assertEqual(
+                    tuple(cursor.fetchone()),
+                    (42, None, long_(21), unicode_('ABC'), 2)
+                )
+
+                # The column name takes precedence over the type.
+                cursor.converters = {ctds.INT: str, 'Int': lambda value: value + 1}
+                cursor.execute('SELECT CONVERT(INT, 1) AS Int, CONVERT(INT, 1) AS Other')
+                self.assertEqual(tuple(cursor.fetchone()), (2, '1'))
+
+    def test_callable_error(self):
+        def converter(value):
+            raise ValueError(value)
+
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.converters = {ctds.INT: converter}
+                cursor.execute('SELECT CONVERT(INT, 1)')
+
+                # Values are converted when read from the row.
+                row = cursor.fetchone()
+                for _ in range(2):
+                    try:
+                        row[0] # pylint: disable=pointless-statement
+                    except ValueError as ex:
+                        self.assertEqual(ex.args, (1,))
+                    else:
+                        self.fail('row[0] did not fail as expected') # pragma: nocover
+
+    def test_native(self):
+        value = uuid.uuid1()
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.converters = {
+                    ctds.DECIMAL: 'float',
+                    ctds.NUMERIC: 'float',
+                    ctds.MONEY: 'float',
+                    ctds.GUID: 'str',
+                    'Bytes': 'bytes',
+                }
+                cursor.execute(
+                    '''
+                    SELECT
+                        CONVERT(DECIMAL(10, 4), 123.4567) AS Decimal,
+                        CONVERT(DECIMAL(10, 4), NULL) AS DecimalNull,
+                        CONVERT(MONEY, -1234.5678) AS Money,
+                        CONVERT(UNIQUEIDENTIFIER, :0) AS Guid,
+                        CONVERT(VARCHAR(10), 'abc') AS Bytes,
+                        CONVERT(VARCHAR(10), 'abc') AS String
+                    ''',
+                    (value,)
+                )
+                self.assertEqual(
+                    tuple(cursor.fetchone()),
+                    (123.4567, None, -1234.5678, unicode_(value), b'abc', unicode_('abc'))
+                )
+
+                cursor.converters = None
+                cursor.execute('SELECT CONVERT(DECIMAL(10, 4), 123.4567)')
+                self.assertEqual(tuple(cursor.fetchone()), (Decimal('123.4567'),))
+
+    def test_native_unsupported(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.converters = {ctds.INT: 'str'}
+                try:
+                    cursor.execute('SELECT CONVERT(INT, 1) AS Int')
+                except ctds.NotSupportedError as ex:
+                    self.assertEqual(
+                        str(ex),
+                        'converter is not supported for type {0} of column "Int"'.format(ctds.INT)
+                    )
+                else:
+                    self.fail('.execute() did not fail as expected') # pragma: nocover
@@ -16,17 +16,25 @@ class TestCursorExecute(TestExternalDatabase): # pylint: disable=too-many-public
         self.assertEqual(
             ctds.Cursor.execute.__doc__,
             '''\
-execute(sql, parameters=None)
+execute(sql, parameters=None, cache=False)
 
 Prepare and execute a database operation.
 Parameters may be provided as sequence and will be bound to variables
 specified in the SQL statement. Parameter notation is specified by
 :py:const:`ctds.paramstyle`.
 
+If `cache` is :py:data:`True` and the connection has a
+:py:attr:`ctds.Connection.result_cache`, the results of a read-only
+query are served from, or added to, the cache.
+
 :pep:`0249#execute`
 
+.. versionadded:: 1.15
+    The `cache` parameter.
+
 :param str sql: The SQL statement to execute.
 :param tuple parameters: Optional variables to bind.
+:param bool cache: Use the connection's result cache.
 '''
         )
 
@@ -0,0 +1,275 @@
+import time
+
+import ctds
+
+from .base import TestExternalDatabase
+from .compat import PY35
+
+if PY35: # pragma: nocover
+    import asyncio # pylint: disable=import-error
+
+
+class TestCursorExecuteAsync(TestExternalDatabase):
+
+    def setUp(self):
+        TestExternalDatabase.setUp(self)
+        if not PY35: # pragma: nocover
+            self.skipTest('asyncio is not supported')
+        self.loop = asyncio.new_event_loop()
+        asyncio.set_event_loop(self.loop)
+
+    def tearDown(self):
+        if PY35: # pragma: nocover
+            asyncio.set_event_loop(None)
+            self.loop.close()
+        TestExternalDatabase.tearDown(self)
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Cursor.execute_async.__doc__,
+            '''\
+execute_async(sql, parameters=None)
+
+Prepare and execute a database operation without blocking an
+:py:mod:`asyncio` event loop while waiting for the server's response.
+The statement is sent immediately and the returned awaitable completes
+once the server has responded. The response is read in the event loop's
+default executor. Parameters are bound as in :py:meth:`.execute`.
+
+If the awaitable is cancelled, or the connection is used for another
+operation before it completes, the statement is cancelled.
+
+.. note:: Only one statement may be outstanding on a connection at a
+    time. The cursor must not be used until the returned awaitable
+    completes.
+
+.. note:: Requires Python 3.5 or later and an event loop supporting
+    :py:meth:`asyncio.loop.add_reader`. The
+    :py:class:`asyncio.ProactorEventLoop`, the default on Windows, is
+    not supported and raises :py:exc:`NotImplementedError`.
+
+.. versionadded:: 1.15
+
+:param str sql: The SQL statement to execute.
+:param tuple parameters: Optional variables to bind.
+:return: An awaitable which completes when the statement has executed.
+:rtype: asyncio.Future
+'''
+        )
+        self.assertEqual(
+            ctds.Cursor.fetch_async.__doc__,
+            '''\
+fetch_async(size=None)
+
+Fetch rows of a query result without blocking an :py:mod:`asyncio`
+event loop. The rows are fetched by :py:meth:`.fetchmany` or, if `size`
+is not specified, :py:meth:`.fetchall`, run in the event loop's default
+executor.
+
+.. note:: Requires Python 3.5 or later.
+
+.. versionadded:: 1.15
+
+:param int size: The maximum number of rows to fetch. By default all
+    remaining rows are fetched.
+:return: An awaitable resolving to a sequence of result rows.
+:rtype: asyncio.Future
+'''
+        )
+
+    def _run(self, awaitable):
+        return self.loop.run_until_complete(awaitable)
+
+    def test_closed(self):
+        with self.connect() as connection:
+            cursor = connection.cursor()
+            cursor.close()
+            self.assertRaises(ctds.InterfaceError, cursor.execute_async, 'SELECT 1')
+            self.assertRaises(ctds.InterfaceError, cursor.fetch_async)
+
+    def test_execute(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                future = cursor.execute_async(
+                    'SELECT :0 AS Value UNION ALL SELECT :1',
+                    (1, 2)
+                )
+                self.assertEqual(self._run(future), None)
+                self.assertEqual(
+                    [column[0] for column in cursor.description],
+                    ['Value']
+                )
+
+                rows = self._run(cursor.fetch_async(1))
+                self.assertEqual([tuple(row) for row in rows], [(1,)])
+
+                rows = self._run(cursor.fetch_async())
+                self.assertEqual([tuple(row) for row in rows], [(2,)])
+
+    def test_error(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                future = cursor.execute_async("RAISERROR (N'async failure', 12, 1)")
+                try:
+                    self._run(future)
+                except ctds.ProgrammingError as ex:
+                    self.assertEqual(str(ex), 'async failure')
+                else:
+                    self.fail('.execute_async() did not fail as expected') # pragma: nocover
+
+                # The connection is usable after the failure.
+                self._run(cursor.execute_async('SELECT 1'))
+                self.assertEqual(tuple(cursor.fetchone()), (1,))
+
+    def test_statement_stats(self):
+        ctds.set_statement_stats(100)
+        try:
+            with self.connect() as connection:
+                with connection.cursor() as cursor:
+                    sql = "WAITFOR DELAY '00:00:00.250'; SELECT 1 UNION ALL SELECT 2"
+                    self._run(cursor.execute_async(sql))
+                    self.assertEqual(len(cursor.fetchall()), 2)
+
+            # The statement is timed until its response was read.
+            stats = ctds.statement_stats()
+            self.assertEqual(len(stats), 1)
+            self.assertEqual(stats[0]['calls'], 1)
+            self.assertEqual(stats[0]['errors'], 0)
+            self.assertEqual(stats[0]['rows'], 2)
+            self.assertTrue(stats[0]['total_time'] >= 0.25)
+        finally:
+            ctds.set_statement_stats(0)
+
+    def test_slow_query_log(self):
+        queries = []
+        ctds.set_slow_query_log(0, queries.append)
+        try:
+            with self.connect() as connection:
+                with connection.cursor() as cursor:
+                    sql = "WAITFOR DELAY '00:00:00.250'; SELECT :0"
+                    self._run(cursor.execute_async(sql, (1,)))
+                    self.assertEqual(queries, [])
+                    self.assertEqual(len(cursor.fetchall()), 1)
+
+                    self.assertEqual(len(queries), 1)
+                    self.assertEqual(queries[0]['operation'], 'execute_async')
+                    self.assertEqual(queries[0]['sql'], sql)
+                    self.assertEqual(queries[0]['parameter_types'], ('int',))
+                    self.assertEqual(queries[0]['rows'], 1)
+                    self.assertEqual(queries[0]['error'], False)
+                    self.assertTrue(0.25 <= queries[0]['first_row_time'] <= queries[0]['total_time'])
+
+                    # Abandoned statements are reported as failed.
+                    future = cursor.execute_async("WAITFOR DELAY '00:00:01'; SELECT 1")
+                    with connection.cursor() as other:
+                        other.execute('SELECT 2')
+                    self.assertRaises(ctds.InterfaceError, self._run, future)
+                    self.assertEqual(queries[1]['operation'], 'execute_async')
+                    self.assertEqual(queries[1]['error'], True)
+        finally:
+            ctds.set_slow_query_log(0, None)
+
+    def test_trace_hooks(self):
+        events = []
+        def on_start(operation, sql, spid):
+            events.append((operation, sql, spid))
+            return len(events) - 1
+        def on_end(token, rows, elapsed, error):
+            events.append((token, rows, elapsed, error))
+
+        ctds.set_trace_hooks(on_start, on_end)
+        try:
+            with self.connect() as connection:
+                with connection.cursor() as cursor:
+                    sql = "WAITFOR DELAY '00:00:00.250'; SELECT 1"
+                    future = cursor.execute_async(sql)
+                    self.assertEqual(events, [('execute_async', sql, connection.spid)])
+                    self._run(future)
+
+                    # The trace ends once the response is read.
+                    self.assertEqual(len(events), 2)
+                    token, _, elapsed, error = events[1]
+                    self.assertEqual(token, 0)
+                    self.assertTrue(elapsed >= 250 * 1000 * 1000)
+                    self.assertEqual(error, None)
+                    del events[:]
+
+                    # Abandoned statements are traced with the error.
+                    future = cursor.execute_async("WAITFOR DELAY '00:00:01'; SELECT 1")
+                    with connection.cursor() as other:
+                        other.execute('SELECT 2')
+                    self.assertRaises(ctds.InterfaceError, self._run, future)
+                    self.assertEqual(events[0][0], 'execute_async')
+                    ended = [event for event in events if event[0] == 0]
+                    self.assertEqual(len(ended), 1)
+                    self.assertEqual(ended[0][1], -1)
+                    self.assertTrue(isinstance(ended[0][3], ctds.InterfaceError))
+        finally:
+            ctds.set_trace_hooks(None, None)
+
+    def test_cancel(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                future = cursor.execute_async("WAITFOR DELAY '00:00:05'; SELECT 1")
+                self.loop.call_later(0.1, future.cancel)
+                start = time.time()
+                self.assertRaises(asyncio.CancelledError, self._run, future)
+                self.assertTrue(time.time() - start < 5)
+
+                # The statement was cancelled and the connection is usable.
+                cursor.execute('SELECT 2')
+                self.assertEqual(tuple(cursor.fetchone()), (2,))
+
+    def test_superseded(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                future = cursor.execute_async("WAITFOR DELAY '00:00:01'; SELECT 1")
+                with connection.cursor() as other:
+                    other.execute('SELECT 2')
+                    self.assertEqual(tuple(other.fetchone()), (2,))
+                try:
+                    self._run(future)
+                except ctds.InterfaceError as ex:
+                    self.assertEqual(str(ex), 'statement cancelled by another operation')
+                else:
+                    self.fail('.execute_async() did not fail as expected') # pragma: nocover
+
+    def test_proactor(self):
+        proactor = getattr(asyncio, 'ProactorEventLoop', None)
+        if proactor is None:
+            self.skipTest('ProactorEventLoop is only available on Windows')
+        loop = proactor() # pragma: nocover
+        try: # pragma: nocover
+            asyncio.set_event_loop(loop)
+            with self.connect() as connection:
+                with connection.cursor() as cursor:
+                    self.assertRaises(NotImplementedError, cursor.execute_async, 'SELECT 1')
+
+                    # The statement was not sent.
+                    cursor.execute('SELECT 1')
+                    self.assertEqual(tuple(cursor.fetchone()), (1,))
+        finally: # pragma: nocover
+            asyncio.set_event_loop(self.loop)
+            loop.close()
+
+    def test_concurrent(self):
+        delay = 2
+        connections = [self.connect() for _ in range(3)]
+        try:
+            cursors = [connection.cursor() for connection in connections]
+            start = time.time()
+            futures = [
+                cursor.execute_async("WAITFOR DELAY '00:00:0{0}'; SELECT :0".format(delay), (index,))
+                for index, cursor in enumerate(cursors)
+            ]
+            self._run(asyncio.gather(*futures))
+            elapsed = time.time() - start
+
+            # The statements ran concurrently rather than one after another.
+            self.assertTrue(elapsed < delay * len(cursors))
+            for index, cursor in enumerate(cursors):
+                self.assertEqual(tuple(cursor.fetchone()), (index,))
+                cursor.close()
+        finally:
+            for connection in connections:
+                connection.close()
@@ -9,13 +9,23 @@ class TestCursorFetchAll(TestExternalDatabase):
         self.assertEqual(
             ctds.Cursor.fetchall.__doc__,
             '''\
-fetchall()
+fetchall(max_memory=None)
 
 Fetch all (remaining) rows of a query result, returning them as a
 sequence of sequences.
 
 :pep:`0249#fetchall`
 
+If `max_memory` is specified, at most `max_memory` bytes of raw row data
+are buffered in memory. Any remaining rows are written to an anonymous
+temporary file, which is memory-mapped and read from as the rows are
+accessed.
+
+.. versionadded:: 1.15
+    The `max_memory` parameter.
+
+:param int max_memory: The maximum number of bytes of raw row data to
+    buffer in memory. By default all rows are buffered in memory.
 :return: A sequence of result rows.
 :rtype: ctds.RowList
 '''
@@ -102,3 +112,48 @@ sequence of sequences.
                 self.assertEqual(cursor.nextset(), True)
                 self.assertEqual([tuple(row) for row in cursor.fetchall()], [(1,), (2,), (3,)])
                 self.assertEqual(cursor.nextset(), None)
+
+    def test_max_memory(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                query = '''
+                    DECLARE @{0} TABLE(i INT, s VARCHAR(100), b VARBINARY(10));
+                    INSERT INTO @{0}(i, s, b) VALUES
+                        (1, 'one', 0x01),
+                        (2, NULL, NULL),
+                        (3, '', 0x),
+                        (4, REPLICATE('four', 25), 0x04040404);
+                    SELECT * FROM @{0} ORDER BY i;
+                '''.format(self.test_max_memory.__name__)
+                expected = [
+                    (1, 'one', b'\x01'),
+                    (2, None, None),
+                    (3, '', b''),
+                    (4, 'four' * 25, b'\x04\x04\x04\x04'),
+                ]
+                for max_memory in (0, 1, 200, 2 ** 32, None):
+                    cursor.execute(query)
+                    rows = cursor.fetchall(max_memory=max_memory)
+                    self.assertEqual(len(rows), len(expected))
+                    self.assertEqual([tuple(row) for row in rows], expected)
+
+                    # Spilled rows remain valid after the cursor moves on.
+                    cursor.execute(query)
+                    rows = cursor.fetchall(max_memory=max_memory)
+                    cursor.execute('SELECT 1')
+                    self.assertEqual([tuple(row) for row in reversed(rows)], expected[::-1])
+
+                    cursor.execute(query)
+                    self.assertEqual(
+                        [tuple(row) for row in cursor.fetchall(max_memory=max_memory).drain()],
+                        expected
+                    )
+
+    def test_max_memory_invalid(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+                for max_memory in ('1', 1.0, True):
+                    self.assertRaises(TypeError, cursor.fetchall, max_memory=max_memory)
+                self.assertRaises((OverflowError, ValueError), cursor.fetchall, max_memory=-1)
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [(1,)])
@@ -0,0 +1,200 @@
+import ctds
+
+from .base import TestExternalDatabase
+from .compat import int_, long_, PY3
+
+class TestCursorPrefetch(TestExternalDatabase):
+    '''Unit tests related to the Cursor.prefetch property.
+    '''
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.Cursor.prefetch.__doc__,
+            '''\
+The number of batches of :py:attr:`.arraysize` rows to read ahead of
+the caller. When non-zero, rows of a result set are read from the
+server in a background thread, without holding the GIL, while the
+previously read rows are processed. At most `prefetch` batches of rows
+are buffered. Prefetching is disabled if 0, the default.
+
+Prefetching starts on the first fetch from a result set. Any rows read
+ahead are discarded when the cursor next uses the connection. If another
+cursor on the same connection uses it before the result set is read in
+full, the next fetch raises :py:exc:`ctds.InterfaceError` rather than
+silently skipping the discarded rows.
+
+.. versionadded:: 1.15
+
+:rtype: int
+'''
+        )
+
+    def test_getset(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                self.assertEqual(cursor.prefetch, 0)
+                for prefetch in (
+                        int_(3),
+                        long_(3),
+                        0,
+                ):
+                    cursor.prefetch = prefetch
+                    self.assertEqual(cursor.prefetch, prefetch)
+
+    def test_invalid(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                for prefetch in (
+                        None,
+                        True,
+                        False,
+                        '',
+                        b'1234'
+                ):
+                    try:
+                        cursor.prefetch = prefetch
+                    except TypeError:
+                        self.assertEqual(cursor.prefetch, 0)
+                    else:
+                        self.fail('.prefetch did not fail as expected') # pragma: nocover
+                if PY3:
+                    try:
+                        cursor.prefetch = -1
+                    except OverflowError:
+                        self.assertEqual(cursor.prefetch, 0)
+                    else:
+                        self.fail('.prefetch did not fail as expected') # pragma: nocover
+                else: # pragma: nocover
+                    pass
+
+    QUERY = '''
+        WITH Numbers(Number) AS (
+            SELECT 1
+            UNION ALL
+            SELECT Number + 1 FROM Numbers WHERE Number < {0}
+        )
+        SELECT Number, CONVERT(VARCHAR(10), Number) AS String FROM Numbers
+        OPTION (MAXRECURSION 0);
+    '''
+
+    def test_fetch(self):
+        nrows = 1000
+        expected = [(number, str(number)) for number in range(1, nrows + 1)]
+        with self.connect() as connection:
+            for arraysize, prefetch in ((1, 1), (7, 2), (100, 4), (nrows * 2, 1)):
+                with connection.cursor() as cursor:
+                    cursor.arraysize = arraysize
+                    cursor.prefetch = prefetch
+                    cursor.execute(self.QUERY.format(nrows))
+
+                    rows = [tuple(cursor.fetchone())]
+                    rows.extend(tuple(row) for row in cursor.fetchmany(13))
+                    rows.extend(tuple(row) for row in cursor)
+                    self.assertEqual(rows, expected)
+                    self.assertEqual(cursor.fetchall(), [])
+                    self.assertEqual(cursor.nextset(), None)
+
+    def test_fetchall_max_memory(self):
+        nrows = 500
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.arraysize = 10
+                cursor.prefetch = 2
+                cursor.execute(self.QUERY.format(nrows))
+                rows = cursor.fetchall(max_memory=1024)
+                self.assertEqual(
+                    [tuple(row) for row in rows],
+                    [(number, str(number)) for number in range(1, nrows + 1)]
+                )
+
+    def test_partial(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.arraysize = 10
+                cursor.prefetch = 3
+                cursor.execute(
+                    self.QUERY.format(1000) + 'SELECT 2 AS Second;'
+                )
+                self.assertEqual(tuple(cursor.fetchone()), (1, '1'))
+
+                # Any rows read ahead are discarded.
+                self.assertTrue(cursor.nextset())
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [(2,)])
+
+                cursor.execute(self.QUERY.format(100))
+                self.assertEqual(tuple(cursor.fetchone()), (1, '1'))
+
+            # Another cursor may use the connection while rows are read ahead.
+            with connection.cursor() as cursor:
+                cursor.prefetch = 1
+                cursor.execute(self.QUERY.format(1000))
+                self.assertEqual(tuple(cursor.fetchone()), (1, '1'))
+
+                with connection.cursor() as other:
+                    other.execute('SELECT 3')
+                    self.assertEqual([tuple(row) for row in other.fetchall()], [(3,)])
+
+                # The discarded rows are not silently skipped.
+                for fetch in (cursor.fetchone, cursor.fetchmany, cursor.fetchall):
+                    try:
+                        fetch()
+                    except ctds.InterfaceError as ex:
+                        self.assertEqual(
+                            str(ex),
+                            'prefetched rows discarded by another operation on the connection'
+                        )
+                    else:
+                        self.fail('.{0}() did not fail as expected'.format(fetch.__name__)) # pragma: nocover
+
+                # Executing again resets the cursor.
+                cursor.execute(self.QUERY.format(10))
+                self.assertEqual(len(cursor.fetchall()), 10)
+
+            # Result sets read in full are not affected.
+            with connection.cursor() as cursor:
+                cursor.prefetch = 1
+                cursor.execute(self.QUERY.format(10))
+                self.assertEqual(len(cursor.fetchall()), 10)
+
+                with connection.cursor() as other:
+                    other.execute('SELECT 3')
+                    self.assertEqual([tuple(row) for row in other.fetchall()], [(3,)])
+
+                self.assertEqual(cursor.fetchall(), [])
+
+            connection.commit()
+
+    def test_error(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.arraysize = 10
+                cursor.prefetch = 2
+                # Errors reported to the reader thread are raised by the fetch.
+                cursor.execute(
+                    '''
+                    WITH Numbers(Number) AS (
+                        SELECT 1
+                        UNION ALL
+                        SELECT Number + 1 FROM Numbers WHERE Number < 1000
+                    )
+                    SELECT 1 / (Number - 500) FROM Numbers
+                    OPTION (MAXRECURSION 0);
+                    '''
+                )
+                try:
+                    cursor.fetchall()
+                except ctds.DatabaseError as ex:
+                    self.assertEqual(str(ex), 'Divide by zero error encountered.')
+                else:
+                    self.fail('.fetchall() did not fail as expected') # pragma: nocover
+
+    def test_close(self):
+        connection = self.connect()
+        cursor = connection.cursor()
+        cursor.prefetch = 2
+        cursor.execute(self.QUERY.format(1000))
+        self.assertEqual(tuple(cursor.fetchone()), (1, '1'))
+
+        # Closing the connection stops the background reader.
+        connection.close()
+        cursor.close()
@@ -1,3 +1,5 @@
+import ctds
+
 from .base import TestExternalDatabase
 from .compat import long_, unicode_
 
@@ -170,3 +172,38 @@ class TestCursorRow(TestExternalDatabase):
             4: 'another unnamed',
             'Col4': 4,
         })
+
+    def test_lazy(self):
+        converted = []
+        def converter(value):
+            converted.append(value)
+            return value
+
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.converters = {ctds.INT: converter}
+                cursor.execute(
+                    '''
+                    SELECT
+                        CONVERT(INT, 1) AS Col1,
+                        CONVERT(INT, 2) AS Col2,
+                        CONVERT(INT, 3) AS Col3,
+                        CONVERT(INT, 4) AS Col4
+                    '''
+                )
+                rows = cursor.fetchall()
+
+        # Columns are only converted when first accessed.
+        row = rows[0]
+        self.assertEqual(converted, [])
+
+        self.assertEqual(row[1], 2)
+        self.assertEqual(row.Col4, 4)
+        self.assertEqual(converted, [2, 4])
+
+        # Converted values are cached.
+        self.assertEqual(row['Col2'], 2)
+        self.assertEqual(converted, [2, 4])
+
+        self.assertEqual(tuple(row), (1, 2, 3, 4))
+        self.assertEqual(converted, [2, 4, 1, 3])
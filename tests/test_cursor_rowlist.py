@@ -56,3 +56,55 @@ only created when the data is actually accessed.
             # The row object should always be the same instance.
             self.assertTrue(isinstance(row, ctds.Row))
             self.assertEqual(id(row), id(rows[index]))
+
+    def test_drain___doc__(self):
+        self.assertEqual(
+            ctds.RowList.drain.__doc__,
+            '''\
+drain()
+
+Get an iterator which consumes the rows in the list. Each row is removed
+from the list as it is returned, allowing its memory to be released once
+the caller no longer references it. Accessing a consumed row from the
+list raises :py:exc:`ctds.InterfaceError`.
+
+This is useful for processing large result sets in a single pass without
+retaining all rows in memory.
+
+.. versionadded:: 1.15
+
+:return: An iterator of the rows in the list.
+'''
+        )
+
+    def test_drain(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute(
+                    '''
+                    DECLARE @{0} TABLE(i INT);
+                        INSERT INTO @{0}(i) VALUES (1),(2),(3),(4),(5),(6);
+                    SELECT * FROM @{0};
+                    '''.format(self.test_drain.__name__)
+                )
+                rows = cursor.fetchall()
+
+        # Access a row prior to draining.
+        first = rows[0]
+
+        drain = rows.drain()
+        self.assertTrue(iter(drain) is drain)
+        self.assertTrue(next(drain) is first)
+        self.assertEqual([tuple(row) for row in drain], [(2,), (3,), (4,), (5,), (6,)])
+        self.assertEqual(len(rows), 6)
+
+        for index in range(len(rows)):
+            try:
+                rows[index]
+            except ctds.InterfaceError as ex:
+                self.assertEqual('row has been consumed', str(ex))
+            else:
+                self.fail('InterfaceError was not raised for index {0}'.format(index)) # pragma: nocover
+
+        # Subsequent drains return no rows.
+        self.assertEqual(list(rows.drain()), [])
@@ -0,0 +1,109 @@
+import io
+
+import ctds
+from ctds.extract import ColumnarSink, CsvSink
+
+from .base import TestExternalDatabase
+from .compat import PY3
+
+
+class TestParallelExtract(TestExternalDatabase):
+    '''Unit tests related to the ctds.parallel_extract() function.
+    '''
+
+    SQL = '''
+        WITH Numbers(Number) AS (
+            SELECT 1
+            UNION ALL
+            SELECT Number + 1 FROM Numbers WHERE Number < 1000
+        )
+        SELECT Number, CONVERT(VARCHAR(10), Number) AS String
+        FROM Numbers
+        WHERE Number >= :0 AND Number < :1
+        OPTION (MAXRECURSION 0);
+    '''
+
+    RANGES = [(low, low + 100) for low in range(1, 1001, 100)]
+
+    def connect_kwargs(self):
+        kwargs = dict(
+            (key, self.get_option(key, type_))
+            for key, type_ in (
+                ('server', str),
+                ('database', str),
+                ('instance', str),
+                ('password', str),
+                ('port', int),
+                ('user', str),
+            )
+            if self.get_option(key) is not None
+        )
+        kwargs['appname'] = 'egg.tds.unittest'
+        return kwargs
+
+    def test_callback(self):
+        batches = []
+        count = ctds.parallel_extract(
+            self.connect_kwargs(),
+            self.SQL,
+            self.RANGES,
+            workers=3,
+            sink=lambda key_range, rows: batches.append((key_range, [tuple(row) for row in rows])),
+            batch_size=30
+        )
+        self.assertEqual(count, 1000)
+
+        rows = []
+        for key_range, batch in batches:
+            self.assertTrue(0 < len(batch) <= 30)
+            for row in batch:
+                self.assertTrue(key_range[0] <= row[0] < key_range[1])
+            rows.extend(batch)
+        self.assertEqual(
+            sorted(rows),
+            [(number, str(number)) for number in range(1, 1001)]
+        )
+
+    def test_no_sink(self):
+        count = ctds.parallel_extract(self.connect_kwargs(), self.SQL, self.RANGES)
+        self.assertEqual(count, 1000)
+
+    def test_no_ranges(self):
+        count = ctds.parallel_extract(self.connect_kwargs(), self.SQL, [], workers=2)
+        self.assertEqual(count, 0)
+
+    def test_columnar(self):
+        sink = ColumnarSink()
+        ctds.parallel_extract(self.connect_kwargs(), self.SQL, self.RANGES, workers=2, sink=sink)
+        self.assertEqual(sorted(sink.columns), ['Number', 'String'])
+        self.assertEqual(sorted(sink.columns['Number']), list(range(1, 1001)))
+        self.assertEqual(
+            sorted(zip(sink.columns['Number'], sink.columns['String'])),
+            [(number, str(number)) for number in range(1, 1001)]
+        )
+
+    def test_csv(self):
+        stream = io.StringIO() if PY3 else io.BytesIO()
+        ctds.parallel_extract(self.connect_kwargs(), self.SQL, [(1, 4)], sink=CsvSink(stream))
+        self.assertEqual(stream.getvalue().splitlines(), ['1,1', '2,2', '3,3'])
+
+    def test_invalid_workers(self):
+        self.assertRaises(ValueError, ctds.parallel_extract, self.connect_kwargs(), self.SQL, self.RANGES, workers=0)
+
+    def test_error(self):
+        def sink(key_range, rows): # pylint: disable=unused-argument
+            raise RuntimeError('sink failure')
+
+        try:
+            ctds.parallel_extract(self.connect_kwargs(), self.SQL, self.RANGES, workers=2, sink=sink)
+        except RuntimeError as ex:
+            self.assertEqual(str(ex), 'sink failure')
+        else:
+            self.fail('.parallel_extract() did not fail as expected') # pragma: nocover
+
+        try:
+            ctds.parallel_extract(self.connect_kwargs(), 'SELECT * FROM NoSuchTable WHERE :0 < :1', self.RANGES)
+        except ctds.DatabaseError as ex:
+            self.assertTrue('NoSuchTable' in str(ex))
+        else:
+            self.fail('.parallel_extract() did not fail as expected') # pragma: nocover
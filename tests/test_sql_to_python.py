@@ -101,6 +101,25 @@ class TestSQLToPython(TestExternalDatabase): # pylint: disable=too-many-public-m
             )
         )
 
+    def test_char_ascii(self):
+        # Exercise the ASCII fast path across machine word boundaries.
+        values = []
+        for length in (1, 7, 8, 9, 15, 16, 17, 31, 32, 33):
+            values.append(unicode_('x' * length))
+            for index in (0, length // 2, length - 1):
+                values.append(unicode_('x' * index) + unichr_(189) + unicode_('x' * (length - index - 1)))
+
+        self.cursor.execute(
+            'SELECT ' + ', '.join(
+                'CONVERT(NVARCHAR(MAX), 0x{0})'.format(hexlify(value.encode('utf-16le')).decode('ascii'))
+                for value in values
+            )
+        )
+        self.assertEqual(
+            tuple(self.cursor.fetchone()),
+            tuple(values)
+        )
+
     def test_nchar(self):
         non_ucs2_emoji = unichr_(127802) if self.UCS4_SUPPORTED else self.UNICODE_REPLACEMENT
         self.cursor.execute(
@@ -0,0 +1,132 @@
+from decimal import Decimal
+import datetime
+import struct
+import unittest
+import uuid
+
+import ctds
+from ctds import _bench
+
+# pylint: disable=no-name-in-module,wrong-import-order
+from _tds import TDSINTN
+
+from .compat import unicode_
+
+
+class TestTdsBench(unittest.TestCase):
+    '''Unit tests for the internal type conversion benchmark entry points.
+    '''
+
+    def assertConverts(self, tdstype, data, expected, converter=None): # pylint: disable=invalid-name
+        elapsed, value = _bench.convert(tdstype, data, 10, converter)
+        self.assertTrue(elapsed >= 0)
+        self.assertEqual(value, expected)
+
+    def test_convert_integers(self):
+        self.assertConverts(ctds.TINYINT, b'\xff', 255)
+        self.assertConverts(ctds.SMALLINT, struct.pack('<h', -12345), -12345)
+        self.assertConverts(ctds.INT, struct.pack('<i', -123456789), -123456789)
+        self.assertConverts(ctds.BIGINT, struct.pack('<q', -(2 ** 40)), -(2 ** 40))
+        self.assertConverts(TDSINTN, struct.pack('<h', -12345), -12345)
+        self.assertConverts(TDSINTN, struct.pack('<q', 2 ** 40), 2 ** 40)
+
+    def test_convert_bit(self):
+        self.assertConverts(ctds.BIT, b'\x01', True)
+        self.assertConverts(ctds.BIT, b'\x00', False)
+
+    def test_convert_float(self):
+        self.assertConverts(ctds.FLOAT, struct.pack('<d', 3.14159), 3.14159)
+        self.assertConverts(ctds.REAL, struct.pack('<f', 2.5), 2.5)
+
+    def test_convert_money(self):
+        self.assertConverts(ctds.MONEY, struct.pack('<iI', 0, 1234567), Decimal('123.4567'))
+        self.assertConverts(ctds.SMALLMONEY, struct.pack('<i', -1234567), -123.4567, converter='float')
+
+    def test_convert_datetime(self):
+        self.assertConverts(
+            ctds.DATETIME,
+            struct.pack('<iI', 1, 300 * 61),
+            datetime.datetime(1900, 1, 2, 0, 1, 1)
+        )
+
+    def test_convert_strings(self):
+        self.assertConverts(ctds.VARCHAR, b'hola \xc2\xa9', unicode_(b'hola \xc2\xa9', encoding='utf-8'))
+        self.assertConverts(ctds.VARCHAR, b'hola \xc2\xa9', b'hola \xc2\xa9', converter='bytes')
+        self.assertConverts(ctds.VARBINARY, b'\x00\x01\x02', b'\x00\x01\x02')
+
+    def test_convert_guid(self):
+        value = uuid.UUID('01234567-89ab-cdef-0123-456789abcdef')
+        self.assertConverts(ctds.GUID, value.bytes_le, value)
+        self.assertConverts(ctds.GUID, value.bytes_le, unicode_(value), converter='str')
+
+    def test_convert_sequence(self):
+        # Values are converted in turn; the last conversion is returned.
+        data = [struct.pack('<i', 1), None, struct.pack('<i', 3)]
+        self.assertEqual(_bench.convert(ctds.INT, data, 3)[1], 3)
+        self.assertEqual(_bench.convert(ctds.INT, data, 5)[1], None)
+        self.assertEqual(_bench.convert(ctds.INT, tuple(data), 1)[1], 1)
+
+    def test_convert_errors(self):
+        self.assertRaises(ctds.NotSupportedError, _bench.convert, ctds.VOID, b'')
+        self.assertRaises(ValueError, _bench.convert, ctds.INT, b'\x00' * 4, 1, 'unknown')
+        self.assertRaises(ctds.NotSupportedError, _bench.convert, ctds.INT, b'\x00' * 4, 1, 'float')
+        self.assertRaises(ValueError, _bench.convert, ctds.INT, b'\x00' * 4, 0)
+        self.assertRaises(ValueError, _bench.convert, ctds.INT, [])
+        self.assertRaises(TypeError, _bench.convert, ctds.INT, [1])
+        self.assertRaises(TypeError, _bench.convert, ctds.INT, 1)
+        self.assertRaises(RuntimeError, _bench.convert, TDSINTN, b'\x00' * 3)
+
+    def test_convert_width(self):
+        for tdstype, width in (
+                (ctds.BIT, 1),
+                (ctds.TINYINT, 1),
+                (ctds.SMALLINT, 2),
+                (ctds.INT, 4),
+                (ctds.BIGINT, 8),
+                (ctds.REAL, 4),
+                (ctds.FLOAT, 8),
+                (ctds.SMALLMONEY, 4),
+                (ctds.MONEY, 8),
+                (ctds.DATETIME, 8),
+                (ctds.GUID, 16),
+        ):
+            for data in (b'\x00' * (width - 1), b'\x00' * (width + 1), [None, b'\x00' * (width + 1)]):
+                try:
+                    _bench.convert(tdstype, data)
+                except ValueError as ex:
+                    self.assertEqual(str(ex), 'invalid width {0} for type {1}'.format(
+                        len(data[-1] if isinstance(data, list) else data),
+                        tdstype
+                    ))
+                else:
+                    self.fail('.convert() did not fail as expected') # pragma: nocover
+            _bench.convert(tdstype, [None, b'\x00' * width])
+
+        # The width of variable-width types is not checked.
+        self.assertConverts(ctds.VARBINARY, b'\x00' * 3, b'\x00' * 3)
+
+    def test_convert_parameter(self):
+        for value, sqltype in (
+                (unicode_('four'), ('NVARCHAR(4)', 'VARCHAR(4)')),
+                (True, ('BIT',)),
+                (5, ('TINYINT',)),
+                (-5, ('SMALLINT',)),
+                (2 ** 20, ('INT',)),
+                (2 ** 40, ('BIGINT',)),
+                (b'\x00\x01', ('VARBINARY(2)',)),
+                (bytearray(b'\x00'), ('VARBINARY(1)',)),
+                (1.5, ('FLOAT',)),
+                (Decimal('123.45'), ('DECIMAL(5,2)',)),
+                (uuid.uuid4(), ('CHAR(36)',)),
+                (None, ('VARCHAR(1)',)),
+                (ctds.SqlVarBinary(b'\x00', size=10), ('VARBINARY(10)',)),
+                (ctds.SqlInt(5), ('INT',)),
+        ):
+            elapsed, result = _bench.convert_parameter(value, n=10)
+            self.assertTrue(elapsed >= 0)
+            self.assertTrue(result in sqltype, (value, result))
+
+    def test_convert_parameter_errors(self):
+        self.assertRaises(ctds.InterfaceError, _bench.convert_parameter, object())
+        self.assertRaises(OverflowError, _bench.convert_parameter, 2 ** 70)
+        self.assertRaises(ValueError, _bench.convert_parameter, 1, 0)
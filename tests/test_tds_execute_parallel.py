@@ -0,0 +1,120 @@
+import time
+
+import ctds
+
+from .base import TestExternalDatabase
+
+class TestTdsExecuteParallel(TestExternalDatabase):
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.execute_parallel.__doc__,
+            '''\
+execute_parallel(queries)
+
+Execute SQL statements on multiple connections concurrently.
+
+Each statement is sent to its connection in turn. The responses are
+then read, and the rows of each statement's first result set buffered,
+concurrently on native threads which do not hold the GIL. The total
+time taken approaches that of the slowest statement rather than the
+sum of all of them. Row values are converted to Python objects on the
+calling thread as they are accessed.
+
+Statements are executed as by :py:meth:`ctds.Cursor.execute`. A
+connection may only be used by one statement.
+
+.. versionadded:: 1.15
+
+:param queries: The statements to execute, as
+    `(connection, sql[, parameters])` tuples.
+:type queries: list(tuple(ctds.Connection, str, tuple))
+:return: For each statement, in order, the rows of its first result
+    set, :py:data:`None` if it has no result set, or the exception
+    raised by the statement.
+:rtype: list(ctds.RowList)
+'''
+        )
+
+    def test_empty(self):
+        self.assertEqual(ctds.execute_parallel([]), [])
+
+    def test_invalid(self):
+        with self.connect() as connection:
+            for queries in (
+                    None,
+                    1,
+                    [None],
+                    [(connection,)],
+                    [(connection, 'SELECT 1', (), None)],
+                    [(None, 'SELECT 1')],
+                    [[connection, 'SELECT 1']],
+            ):
+                self.assertRaises(TypeError, ctds.execute_parallel, queries)
+
+            try:
+                ctds.execute_parallel([(connection, 'SELECT 1'), (connection, 'SELECT 2')])
+            except ValueError as ex:
+                self.assertEqual(str(ex), 'connection used by more than one query at index 1')
+            else:
+                self.fail('.execute_parallel() did not fail as expected') # pragma: nocover
+
+    def test_results(self):
+        connections = [self.connect() for _ in range(4)]
+        try:
+            results = ctds.execute_parallel([
+                (connections[0], 'SELECT :0 AS Value UNION ALL SELECT :1', (1, 2)),
+                (connections[1], 'SELECT 1 WHERE 1 = 0'),
+                (connections[2], 'DECLARE @Unused INT;'),
+                (connections[3], "RAISERROR (N'some custom error %s', 12, 111, 'hello!');"),
+            ])
+            self.assertEqual(len(results), 4)
+
+            self.assertTrue(isinstance(results[0], ctds.RowList))
+            self.assertEqual([tuple(row) for row in results[0]], [(1,), (2,)])
+            self.assertEqual(results[0][0]['Value'], 1)
+
+            self.assertTrue(isinstance(results[1], ctds.RowList))
+            self.assertEqual(len(results[1]), 0)
+
+            self.assertEqual(results[2], None)
+
+            self.assertTrue(isinstance(results[3], ctds.ProgrammingError))
+            self.assertEqual(str(results[3]), 'some custom error hello!')
+
+            # The connections are usable afterwards.
+            for connection in connections:
+                with connection.cursor() as cursor:
+                    cursor.execute('SELECT 1')
+                    self.assertEqual(tuple(cursor.fetchone()), (1,))
+        finally:
+            for connection in connections:
+                connection.close()
+
+    def test_closed(self):
+        connection = self.connect()
+        connection.close()
+        results = ctds.execute_parallel([(connection, 'SELECT 1')])
+        self.assertTrue(isinstance(results[0], ctds.InterfaceError))
+        self.assertEqual(str(results[0]), 'connection closed')
+
+    def test_concurrent(self):
+        delay = 2
+        connections = [self.connect() for _ in range(3)]
+        try:
+            start = time.time()
+            results = ctds.execute_parallel([
+                (connection, "WAITFOR DELAY '00:00:0{0}'; SELECT :0".format(delay), (index,))
+                for index, connection in enumerate(connections)
+            ])
+            elapsed = time.time() - start
+
+            # The statements ran concurrently rather than one after another.
+            self.assertTrue(elapsed < delay * len(connections))
+            self.assertEqual(
+                [[tuple(row) for row in result] for result in results],
+                [[(index,)] for index in range(len(connections))]
+            )
+        finally:
+            for connection in connections:
+                connection.close()
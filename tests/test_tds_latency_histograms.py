@@ -0,0 +1,155 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+
+class TestTdsLatencyHistograms(TestExternalDatabase):
+    '''Unit tests related to the ctds.latency_histograms() and
+    ctds.prometheus_metrics() functions.
+    '''
+
+    OPERATIONS = ('login', 'round_trip', 'fetch', 'pool_acquire')
+
+    KEYS = set(('count', 'sum', 'min', 'max', 'p50', 'p90', 'p99', 'p999', 'buckets'))
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.latency_histograms.__doc__,
+            '''\
+latency_histograms(reset=False)
+
+Get histograms of the latencies of database operations on all
+connections in the process, keyed by operation:
+
+* ``login``: The time taken to log in to the server when opening a
+  connection.
+* ``round_trip``: The time from sending a request to the server,
+  including SQL batches, stored procedure calls and bulk insert
+  batches, until its first response was read.
+* ``fetch``: The time spent fetching all rows of a result set. Result
+  sets which are not read in full are not included.
+* ``pool_acquire``: The time taken by :py:meth:`ctds.Pool.acquire`.
+
+Each histogram is a dict with the ``count`` of values recorded, their
+``sum``, ``min`` and ``max``, the ``p50``, ``p90``, ``p99`` and
+``p999`` percentiles, and the non-empty ``buckets``, as
+`(upper_bound, count)` tuples. Values are counted in logarithmic
+buckets, so percentiles are estimated to within 12.5%. All times are
+in seconds.
+
+See :py:func:`ctds.prometheus_metrics` to export the histograms in
+the `Prometheus`_ text format.
+
+.. _Prometheus: https://prometheus.io
+
+.. versionadded:: 1.15
+
+:param bool reset: Reset the histograms once read.
+:return: The histogram of each operation.
+:rtype: dict
+'''
+        )
+
+    def test_typeerror(self):
+        self.assertRaises(TypeError, ctds.latency_histograms, reset=1)
+
+    def test_reset(self):
+        ctds.latency_histograms(reset=True)
+        histograms = ctds.latency_histograms()
+        self.assertEqual(set(histograms.keys()), set(self.OPERATIONS))
+        for histogram in histograms.values():
+            self.assertEqual(set(histogram.keys()), self.KEYS)
+            self.assertEqual(histogram['count'], 0)
+            self.assertEqual(histogram['sum'], 0)
+            self.assertEqual(histogram['p99'], 0)
+            self.assertEqual(histogram['buckets'], [])
+
+    def test_histograms(self):
+        ctds.latency_histograms(reset=True)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1 UNION ALL SELECT 2')
+                self.assertEqual(len(cursor.fetchall()), 2)
+
+        histograms = ctds.latency_histograms()
+        self.assertEqual(histograms['login']['count'], 1)
+        self.assertTrue(histograms['round_trip']['count'] >= 1)
+        self.assertEqual(histograms['fetch']['count'], 1)
+        self.assertEqual(histograms['pool_acquire']['count'], 0)
+
+        for operation in ('login', 'round_trip', 'fetch'):
+            histogram = histograms[operation]
+            self.assertTrue(0 < histogram['min'] <= histogram['p50'] <= histogram['p99'] <= histogram['max'])
+            self.assertTrue(histogram['sum'] >= histogram['max'])
+            self.assertEqual(sum(count for _, count in histogram['buckets']), histogram['count'])
+            bounds = [bound for bound, _ in histogram['buckets']]
+            self.assertEqual(bounds, sorted(bounds))
+            self.assertTrue(bounds[-1] >= histogram['max'])
+
+    def test_fetch_partial(self):
+        ctds.latency_histograms(reset=True)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1 UNION ALL SELECT 2')
+                self.assertEqual(cursor.fetchone()[0], 1)
+                self.assertEqual(ctds.latency_histograms()['fetch']['count'], 0)
+
+                self.assertEqual(len(cursor.fetchall()), 1)
+                self.assertEqual(cursor.fetchall(), [])
+                self.assertEqual(ctds.latency_histograms()['fetch']['count'], 1)
+
+    def test_pool_acquire(self):
+        params = dict(
+            (key, self.get_option(key, type_))
+            for key, type_ in (
+                ('server', str),
+                ('database', str),
+                ('instance', str),
+                ('password', str),
+                ('port', int),
+                ('user', str),
+            )
+            if self.get_option(key) is not None
+        )
+        params['appname'] = 'egg.tds.unittest'
+        pool = ctds.Pool(params)
+        try:
+            ctds.latency_histograms(reset=True)
+            for _ in range(2):
+                pool.release(pool.acquire())
+
+            histograms = ctds.latency_histograms()
+            self.assertEqual(histograms['pool_acquire']['count'], 2)
+            # Only the first acquire logs in; the second reuses the connection.
+            self.assertEqual(histograms['login']['count'], 1)
+        finally:
+            pool.close()
+
+    def test_prometheus_metrics(self):
+        ctds.latency_histograms(reset=True)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+
+        lines = ctds.prometheus_metrics(prefix='test').splitlines()
+        for operation in self.OPERATIONS:
+            name = 'test_{0}_duration_seconds'.format(operation)
+            self.assertTrue('# TYPE {0} histogram'.format(name) in lines)
+
+            buckets = [
+                int(line.rsplit(' ', 1)[1])
+                for line in lines
+                if line.startswith(name + '_bucket{')
+            ]
+            self.assertEqual(len(buckets), 34)
+            self.assertEqual(buckets, sorted(buckets))
+            self.assertTrue('{0}_count {1}'.format(name, buckets[-1]) in lines)
+
+        self.assertTrue('test_login_duration_seconds_count 1' in lines)
+        self.assertTrue('test_pool_acquire_duration_seconds_count 0' in lines)
+
+        # The histograms are not reset by default.
+        self.assertEqual(ctds.latency_histograms()['login']['count'], 1)
+
+        ctds.prometheus_metrics(reset=True)
+        self.assertEqual(ctds.latency_histograms()['login']['count'], 0)
@@ -0,0 +1,181 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+
+class TestTdsMemoryStats(TestExternalDatabase):
+    '''Unit tests related to the ctds.memory_stats() and
+    ctds.set_memory_limit() functions.
+    '''
+
+    SUBSYSTEMS = ('rows', 'parameters', 'messages', 'bulk', 'other', 'total')
+
+    QUERY = '''
+        WITH numbers(n) AS (
+            SELECT 1 UNION ALL SELECT n + 1 FROM numbers WHERE n < 100
+        )
+        SELECT n, REPLICATE('x', n) FROM numbers ORDER BY n;
+    '''
+
+    def tearDown(self):
+        ctds.set_memory_limit(None)
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.memory_stats.__doc__,
+            '''\
+memory_stats(reset=False)
+
+Get the native memory allocated by ctds in the process, outside of
+Python's allocator and so not seen by :py:mod:`tracemalloc`, keyed
+by subsystem:
+
+* ``rows``: Result set rows buffered by :py:class:`ctds.RowList`,
+  :py:class:`ctds.ResultCache` and :py:attr:`ctds.Cursor.prefetch`.
+* ``parameters``: Converted parameters and the SQL built from them.
+* ``messages``: Messages and errors reported by the server.
+* ``bulk``: Rows staged by :py:meth:`ctds.Connection.bulk_insert`.
+* ``other``: All other allocations.
+* ``total``: All allocations.
+
+The usage of each is a dict with the ``current`` and ``peak`` bytes
+allocated.
+
+.. versionadded:: 1.15
+
+:param bool reset: Reset the peak usage to the current usage once read.
+:return: The memory usage of each subsystem.
+:rtype: dict
+'''
+        )
+        self.assertEqual(
+            ctds.set_memory_limit.__doc__,
+            '''\
+set_memory_limit(limit)
+
+Limit the native memory allocated by ctds in the process, as reported
+by :py:func:`ctds.memory_stats`, so large result sets fail fast rather
+than exhausting the process' memory.
+
+Once the limit is exceeded, fetching further rows raises
+:py:exc:`MemoryError`, except that rows already read by
+:py:meth:`ctds.Cursor.fetchmany` are returned first. Rows fetched by
+:py:meth:`ctds.Cursor.fetchall` with a `max_memory` budget are instead
+spilled to its temporary file. Rows already buffered are not affected.
+
+If :py:meth:`ctds.Cursor.fetchall` exceeds the limit after reading
+some rows, those rows are discarded and further fetches from the
+result set raise :py:exc:`ctds.InterfaceError`, rather than returning
+partial results.
+
+.. versionadded:: 1.15
+
+:param int limit: The limit, in bytes, or :py:data:`None` to remove the
+    limit.
+'''
+        )
+
+    def test_typeerror(self):
+        self.assertRaises(TypeError, ctds.memory_stats, reset=1)
+        for limit in ('1', 1.0, True, object()):
+            self.assertRaises(TypeError, ctds.set_memory_limit, limit)
+
+    def test_valueerror(self):
+        for limit in (0, -1, -2 ** 70):
+            self.assertRaises((ValueError, OverflowError), ctds.set_memory_limit, limit)
+
+    def test_stats(self):
+        stats = ctds.memory_stats()
+        self.assertEqual(set(stats.keys()), set(self.SUBSYSTEMS))
+        for usage in stats.values():
+            self.assertEqual(set(usage.keys()), set(('current', 'peak')))
+            self.assertTrue(0 <= usage['current'] <= usage['peak'])
+        self.assertEqual(
+            stats['total']['current'],
+            sum(stats[subsystem]['current'] for subsystem in self.SUBSYSTEMS[:-1])
+        )
+
+    def test_rows(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                before = ctds.memory_stats(reset=True)['rows']
+                self.assertEqual(before['current'], before['peak'])
+
+                cursor.execute(self.QUERY)
+                rows = cursor.fetchall()
+                self.assertEqual(len(rows), 100)
+
+                during = ctds.memory_stats()['rows']
+                self.assertTrue(during['current'] > before['current'] + sum(range(101)))
+                self.assertTrue(during['peak'] >= during['current'])
+
+                del rows
+                after = ctds.memory_stats()['rows']
+                self.assertEqual(after['current'], before['current'])
+                self.assertEqual(after['peak'], during['peak'])
+
+    def test_limit(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute(self.QUERY)
+                self.assertEqual(tuple(cursor.fetchone()), (1, 'x'))
+
+                # The connection's own allocations exceed the limit.
+                ctds.set_memory_limit(1)
+                for fetch in (cursor.fetchone, cursor.fetchmany, cursor.fetchall):
+                    try:
+                        fetch()
+                    except MemoryError as ex:
+                        self.assertEqual(str(ex), 'memory limit set by ctds.set_memory_limit() exceeded')
+                    else:
+                        self.fail('.{0}() did not fail as expected'.format(fetch.__name__)) # pragma: nocover
+
+                # No rows are lost.
+                ctds.set_memory_limit(None)
+                self.assertEqual(tuple(cursor.fetchone()), (2, 'xx'))
+
+                # Rows are spilled once the limit is exceeded, if permitted.
+                ctds.set_memory_limit(1)
+                rows = cursor.fetchall(max_memory=2 ** 32)
+                self.assertEqual(
+                    [tuple(row) for row in rows],
+                    [(n, 'x' * n) for n in range(3, 101)]
+                )
+
+    def test_limit_exceeded_partway(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute(self.QUERY + 'SELECT 1;')
+
+                # The limit is exceeded once the first row is buffered.
+                ctds.set_memory_limit(ctds.memory_stats()['total']['current'] + 1)
+                try:
+                    cursor.fetchall()
+                except MemoryError as ex:
+                    self.assertEqual(str(ex), 'memory limit set by ctds.set_memory_limit() exceeded')
+                else:
+                    self.fail('.fetchall() did not fail as expected') # pragma: nocover
+
+                # The rows read were discarded, so partial results are not returned.
+                ctds.set_memory_limit(None)
+                for fetch in (cursor.fetchone, cursor.fetchmany, cursor.fetchall):
+                    try:
+                        fetch()
+                    except ctds.InterfaceError as ex:
+                        self.assertEqual(
+                            str(ex),
+                            'rows discarded when the memory limit set by ctds.set_memory_limit() was exceeded'
+                        )
+                    else:
+                        self.fail('.{0}() did not fail as expected'.format(fetch.__name__)) # pragma: nocover
+
+                # Following result sets are unaffected.
+                self.assertEqual(cursor.nextset(), True)
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [(1,)])
+
+    def test_limit_not_exceeded(self):
+        ctds.set_memory_limit(2 ** 40)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute(self.QUERY)
+                self.assertEqual(len(cursor.fetchall()), 100)
@@ -0,0 +1,299 @@
+import threading
+import time
+import unittest
+
+import ctds
+
+from .base import TestExternalDatabase
+from .compat import PY3
+
+
+class TestTdsPool(TestExternalDatabase):
+    '''Unit tests related to the ctds.Pool type.
+    '''
+
+    def params(self):
+        params = dict(
+            (key, self.get_option(key, type_))
+            for key, type_ in (
+                ('server', str),
+                ('database', str),
+                ('instance', str),
+                ('password', str),
+                ('port', int),
+                ('user', str),
+            )
+            if self.get_option(key) is not None
+        )
+        params['appname'] = 'egg.tds.unittest'
+        return params
+
+    @staticmethod
+    def wait_for(predicate, timeout=10):
+        end = time.time() + timeout
+        while not predicate() and time.time() < end:
+            time.sleep(0.01)
+        return predicate()
+
+    def test_typeerror(self):
+        for args, kwargs in (
+                ((None,), {}),
+                (({},), {'minsize': '1'}),
+                (({},), {'minsize': True}),
+                (({},), {'maxsize': 1.5}),
+                (({},), {'idlettl': '1'}),
+                (({},), {'prewarm': 1}),
+                (({},), {'reset': 1}),
+        ):
+            self.assertRaises(TypeError, ctds.Pool, *args, **kwargs)
+
+    def test_valueerror(self):
+        for kwargs, exception in (
+                ({'minsize': -1}, (OverflowError, ValueError)),
+                ({'maxsize': -1}, (OverflowError, ValueError)),
+                ({'minsize': 2, 'maxsize': 1}, ValueError),
+                ({'idlettl': -1}, ValueError),
+        ):
+            self.assertRaises(exception, ctds.Pool, {}, **kwargs)
+
+    def test_create(self):
+        pool = ctds.Pool({}, maxsize=5)
+        self.assertEqual(len(pool), 0)
+        self.assertEqual(pool.size, 0)
+        self.assertEqual(pool.minsize, 0)
+        self.assertEqual(pool.maxsize, 5)
+        self.assertEqual(pool.idlettl, None)
+        self.assertEqual(pool.reset, False)
+        self.assertEqual(pool.closed, False)
+        pool.close()
+        self.assertEqual(pool.closed, True)
+
+    def test_acquire_release(self):
+        pool = ctds.Pool(self.params())
+        try:
+            connection = pool.acquire()
+            self.assertTrue(isinstance(connection, ctds.Connection))
+            self.assertEqual(pool.size, 1)
+            self.assertEqual(len(pool), 0)
+
+            pool.release(connection)
+            self.assertEqual(pool.size, 1)
+            self.assertEqual(len(pool), 1)
+
+            self.assertTrue(pool.acquire() is connection)
+            pool.release(connection)
+        finally:
+            pool.close()
+
+        self.assertEqual(len(pool), 0)
+        self.assertEqual(pool.size, 0)
+        self.assertRaises(ctds.InterfaceError, connection.cursor)
+
+    def test_acquire_closed(self):
+        pool = ctds.Pool(self.params())
+        pool.close()
+        try:
+            pool.acquire()
+        except ctds.InterfaceError as ex:
+            self.assertEqual(str(ex), 'pool closed')
+        else:
+            self.fail('.acquire() did not fail as expected') # pragma: nocover
+
+    def test_release_typeerror(self):
+        pool = ctds.Pool(self.params())
+        self.assertRaises(TypeError, pool.release, None)
+        pool.close()
+
+    def test_release_foreign(self):
+        pool = ctds.Pool(self.params())
+        other = ctds.Pool(self.params())
+        try:
+            connection = other.acquire()
+            try:
+                pool.release(connection)
+            except ValueError as ex:
+                self.assertEqual(str(ex), 'connection not acquired from this pool')
+            else:
+                self.fail('.release() did not fail as expected') # pragma: nocover
+            self.assertEqual(pool.size, 0)
+            self.assertEqual(len(pool), 0)
+
+            # Connections cannot be released twice.
+            other.release(connection)
+            self.assertRaises(ValueError, other.release, connection)
+            self.assertEqual(other.size, 1)
+            self.assertEqual(len(other), 1)
+
+            with self.connect() as connection:
+                self.assertRaises(ValueError, pool.release, connection)
+            self.assertEqual(pool.size, 0)
+        finally:
+            pool.close()
+            other.close()
+
+    def test_release_rollback(self):
+        pool = ctds.Pool(self.params())
+        try:
+            connection = pool.acquire()
+            with connection.cursor() as cursor:
+                cursor.execute('BEGIN TRANSACTION')
+            pool.release(connection)
+
+            connection = pool.acquire()
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT @@TRANCOUNT')
+                self.assertEqual(cursor.fetchone()[0], 0)
+            pool.release(connection)
+        finally:
+            pool.close()
+
+    def test_release_reset(self):
+        pool = ctds.Pool(self.params(), reset=True)
+        try:
+            self.assertEqual(pool.reset, True)
+            connection = pool.acquire()
+            with connection.cursor() as cursor:
+                cursor.execute('SET NOCOUNT ON')
+            pool.release(connection)
+
+            connection = pool.acquire()
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT @@OPTIONS & 512')
+                self.assertEqual(cursor.fetchone()[0], 0)
+            pool.release(connection)
+        finally:
+            pool.close()
+
+    def test_release_closed_connection(self):
+        pool = ctds.Pool(self.params())
+        try:
+            connection = pool.acquire()
+            connection.close()
+            pool.release(connection)
+            self.assertEqual(pool.size, 0)
+            self.assertEqual(len(pool), 0)
+        finally:
+            pool.close()
+
+    def test_release_closed_pool(self):
+        pool = ctds.Pool(self.params())
+        connection = pool.acquire()
+        pool.close()
+        pool.release(connection)
+        self.assertEqual(pool.size, 0)
+        self.assertRaises(ctds.InterfaceError, connection.cursor)
+
+    def test_maxsize(self):
+        pool = ctds.Pool(self.params(), maxsize=1)
+        try:
+            connections = [pool.acquire() for _ in range(3)]
+            self.assertEqual(pool.size, 3)
+            for connection in connections:
+                pool.release(connection)
+            self.assertEqual(pool.size, 1)
+            self.assertEqual(len(pool), 1)
+        finally:
+            pool.close()
+
+    def test_idlettl_acquire(self):
+        pool = ctds.Pool(self.params(), idlettl=0.1)
+        try:
+            connection = pool.acquire()
+            pool.release(connection)
+            time.sleep(0.2)
+            self.assertFalse(pool.acquire() is connection)
+        finally:
+            pool.close()
+
+    @unittest.skipUnless(PY3, 'background maintenance requires Python 3')
+    def test_idlettl_background(self):
+        pool = ctds.Pool(self.params(), idlettl=0.1)
+        try:
+            connection = pool.acquire()
+            pool.release(connection)
+            self.assertTrue(self.wait_for(lambda: len(pool) == 0))
+            self.assertEqual(pool.size, 0)
+            self.assertRaises(ctds.InterfaceError, connection.cursor)
+        finally:
+            pool.close()
+
+    @unittest.skipUnless(PY3, 'background maintenance requires Python 3')
+    def test_minsize(self):
+        pool = ctds.Pool(self.params(), minsize=2)
+        try:
+            self.assertTrue(self.wait_for(lambda: len(pool) == 2))
+            self.assertEqual(pool.size, 2)
+
+            # Connections closed by the caller are replaced.
+            connection = pool.acquire()
+            connection.close()
+            pool.release(connection)
+            self.assertTrue(self.wait_for(lambda: len(pool) == 2))
+            self.assertEqual(pool.size, 2)
+        finally:
+            pool.close()
+
+    def test_prewarm(self):
+        pool = ctds.Pool(self.params(), minsize=4, prewarm=True)
+        try:
+            self.assertEqual(len(pool), 4)
+            self.assertEqual(pool.size, 4)
+            spids = set()
+            connections = [pool.acquire() for _ in range(4)]
+            for connection in connections:
+                spids.add(connection.spid)
+                pool.release(connection)
+            self.assertEqual(len(spids), 4)
+        finally:
+            pool.close()
+
+    def test_prewarm_error(self):
+        params = self.params()
+        params['password'] = self.get_option('password') + 'invalid'
+        try:
+            ctds.Pool(params, minsize=2, prewarm=True)
+        except ctds.OperationalError as ex:
+            self.assertEqual(str(ex), "Login failed for user '{0}'.".format(params['user']))
+        else:
+            self.fail('ctds.Pool() did not fail as expected') # pragma: nocover
+
+    @unittest.skipUnless(PY3, 'background maintenance requires Python 3')
+    def test_minsize_replace(self):
+        # The interval between scheduled maintenance is long for this pool, so
+        # the replacement must be opened as soon as the connection is closed.
+        pool = ctds.Pool(self.params(), minsize=1, prewarm=True)
+        try:
+            connection = pool.acquire()
+            connection.close()
+            pool.release(connection)
+            self.assertTrue(self.wait_for(lambda: len(pool) == 1, timeout=0.9))
+        finally:
+            pool.close()
+
+    def test_threads(self):
+        pool = ctds.Pool(self.params(), maxsize=4)
+        errors = []
+
+        def work():
+            try:
+                for _ in range(10):
+                    connection = pool.acquire()
+                    try:
+                        with connection.cursor() as cursor:
+                            cursor.execute('SELECT 1')
+                            self.assertEqual(cursor.fetchone()[0], 1)
+                    finally:
+                        pool.release(connection)
+            except Exception as ex: # pylint: disable=broad-except
+                errors.append(ex) # pragma: nocover
+
+        threads = [threading.Thread(target=work) for _ in range(8)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual(errors, [])
+        self.assertTrue(len(pool) <= 4)
+        self.assertEqual(pool.size, len(pool))
+        pool.close()
@@ -0,0 +1,295 @@
+import time
+
+import ctds
+
+from .base import TestExternalDatabase
+
+
+class TestTdsResultCache(TestExternalDatabase):
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.ResultCache.__doc__,
+            '''\
+ResultCache(max_memory=None, ttl=None)
+
+A client-side cache of the results of :py:meth:`ctds.Cursor.execute`.
+Assign a cache to :py:attr:`ctds.Connection.result_cache` and pass
+``cache=True`` to :py:meth:`ctds.Cursor.execute` to serve repeated
+executions of the same statement, with the same parameters, by the same
+login on the same server and database from the cache rather than the
+server.
+
+The raw result data is cached, so cached results are converted to Python
+objects with the converters of the executing cursor. Only read-only
+queries, i.e. ``SELECT`` statements without ``INTO`` or ``OUTPUT``
+clauses or output parameters, which produce a single result set are
+cached, and only once all of its rows have been fetched.
+
+.. warning::
+
+    A statement served from the cache is not executed. Only use a cache
+    for statements without side effects, such as calls to functions
+    which modify state.
+
+.. versionadded:: 1.15
+
+:param int max_memory: The maximum size, in bytes, of all cached results.
+    The least recently used results are evicted to remain within this
+    limit. By default the size is unlimited.
+:param float ttl: The time, in seconds, to cache results for. By default
+    results do not expire.
+'''
+        )
+
+    def test_invalidate___doc__(self):
+        self.assertEqual(
+            ctds.ResultCache.invalidate.__doc__,
+            '''\
+invalidate(sql=None)
+
+Remove cached results. If `sql` is specified, only the results of
+statements with that SQL text are removed, regardless of their
+parameters.
+
+:param str sql: The SQL text of the results to remove.
+'''
+        )
+
+    def test_create(self):
+        cache = ctds.ResultCache()
+        self.assertEqual(cache.max_memory, None)
+        self.assertEqual(cache.ttl, None)
+        self.assertEqual(cache.memory, 0)
+        self.assertEqual(cache.hits, 0)
+        self.assertEqual(cache.misses, 0)
+        self.assertEqual(len(cache), 0)
+
+        cache = ctds.ResultCache(max_memory=1024, ttl=30)
+        self.assertEqual(cache.max_memory, 1024)
+        self.assertEqual(cache.ttl, 30.0)
+
+    def test_create_invalid(self):
+        for kwargs, exception in (
+                ({'max_memory': '1'}, TypeError),
+                ({'max_memory': 1.0}, TypeError),
+                ({'max_memory': -1}, (OverflowError, ValueError)),
+                ({'ttl': '1'}, TypeError),
+                ({'ttl': -1}, ValueError),
+        ):
+            self.assertRaises(exception, ctds.ResultCache, **kwargs)
+
+    def test_hit(self):
+        cache = ctds.ResultCache()
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                for _ in range(3):
+                    cursor.execute(
+                        "SELECT 1 AS a, 'one' AS b, NULL AS c UNION ALL SELECT 2, '', NULL",
+                        cache=True
+                    )
+                    self.assertEqual(
+                        [c[0] for c in cursor.description],
+                        ['a', 'b', 'c']
+                    )
+                    self.assertEqual(tuple(cursor.fetchone()), (1, 'one', None))
+                    self.assertEqual([tuple(row) for row in cursor.fetchall()], [(2, '', None)])
+                    self.assertEqual(cursor.fetchone(), None)
+                    self.assertEqual(cursor.nextset(), None)
+
+                self.assertEqual(cache.misses, 1)
+                self.assertEqual(cache.hits, 2)
+                self.assertEqual(len(cache), 1)
+                self.assertTrue(cache.memory > 0)
+
+    def test_parameters(self):
+        cache = ctds.ResultCache()
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                for parameters, expected in (
+                        ((1,), 1),
+                        ((2,), 2),
+                        ((1,), 1),
+                        ((True,), True),
+                        ((1,), 1),
+                ):
+                    cursor.execute('SELECT :0', parameters, cache=True)
+                    self.assertEqual(tuple(cursor.fetchone()), (expected,))
+                    self.assertEqual(type(cursor.fetchall()), ctds.RowList)
+
+                self.assertEqual(cache.misses, 3)
+                self.assertEqual(cache.hits, 2)
+
+                # Unhashable parameters are never cached.
+                cursor.execute('SELECT :0', (ctds.Parameter(1),), cache=True)
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [(1,)])
+                self.assertEqual(cache.misses, 3)
+
+    def test_read_only(self):
+        cache = ctds.ResultCache()
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                for sql in (
+                        'SELECT 1',
+                        '  -- INSERT\n/* DELETE /* nested */ */ select 2',
+                        "SELECT 'INSERT INTO' AS [UPDATE], 3 AS \"DELETE\"",
+                        'WITH a(b) AS (SELECT 4) SELECT b FROM a',
+                ):
+                    cursor.execute(sql, cache=True)
+                    cursor.fetchall()
+                    self.assertEqual(cursor.rowcount, 1)
+                    self.assertEqual(cursor.nextset(), None)
+                self.assertEqual(len(cache), 4)
+
+    def test_identity(self):
+        cache = ctds.ResultCache()
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT DB_NAME()', cache=True)
+                cursor.fetchall()
+
+            # Results of other connections by the same login are shared.
+            with self.connect() as other:
+                other.result_cache = cache
+                with other.cursor() as cursor:
+                    cursor.execute('SELECT DB_NAME()', cache=True)
+                    cursor.fetchall()
+                    self.assertEqual(cache.hits, 1)
+
+                    # Results are keyed by database.
+                    cursor.execute('USE tempdb')
+                    cursor.execute('SELECT DB_NAME()', cache=True)
+                    self.assertEqual([tuple(row) for row in cursor.fetchall()], [('tempdb',)])
+                    self.assertEqual(cache.hits, 1)
+                    self.assertEqual(len(cache), 2)
+
+    def test_converters(self):
+        cache = ctds.ResultCache()
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1.5 AS a', cache=True)
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [(1.5,)])
+
+                cursor.converters = {'a': str}
+                cursor.execute('SELECT 1.5 AS a', cache=True)
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [('1.5',)])
+                self.assertEqual(cache.hits, 1)
+
+    def test_not_cached(self):
+        cache = ctds.ResultCache()
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                # Partially fetched results are not cached.
+                cursor.execute('SELECT 1 UNION ALL SELECT 2', cache=True)
+                cursor.fetchone()
+                self.assertEqual(len(cache), 0)
+
+                # Multiple result sets are not cached.
+                cursor.execute('SELECT 1; SELECT 2;', cache=True)
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [(1,)])
+                self.assertEqual(len(cache), 0)
+                self.assertEqual(cursor.nextset(), True)
+                self.assertEqual([tuple(row) for row in cursor.fetchall()], [(2,)])
+                self.assertEqual(cursor.nextset(), None)
+                self.assertEqual(len(cache), 0)
+
+                # Results are only cached if requested.
+                cursor.execute('SELECT 4')
+                cursor.fetchall()
+                self.assertEqual(len(cache), 0)
+
+                # Statements which are not read-only queries are not cached.
+                for sql in (
+                        'SELECT 5 AS a INTO #not_cached',
+                        'SELECT a FROM #not_cached',
+                        'SELECT 5; EXEC sp_who',
+                        'WITH a(b) AS (SELECT 1) SELECT b FROM a; PRINT 1',
+                        'EXEC(\'SELECT 6\')',
+                ):
+                    cursor.execute(sql, cache=True)
+                    while True:
+                        if cursor.description is not None:
+                            cursor.fetchall()
+                        if not cursor.nextset():
+                            break
+                    self.assertEqual(len(cache), 0, sql)
+
+                # Only cursor.execute() is cached.
+                cursor.executemany('SELECT :0', [(1,), (2,)])
+                cursor.fetchall()
+                self.assertEqual(len(cache), 0)
+
+                # Spilled results are not cached.
+                cursor.execute('SELECT 3', cache=True)
+                cursor.fetchall(max_memory=0)
+                self.assertEqual(len(cache), 0)
+
+    def test_max_memory(self):
+        with self.connect() as connection:
+            connection.result_cache = ctds.ResultCache()
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1', cache=True)
+                cursor.fetchall()
+                size = connection.result_cache.memory
+
+            cache = ctds.ResultCache(max_memory=size * 2)
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                for value in (1, 2, 1, 3):
+                    cursor.execute('SELECT {0}'.format(value), cache=True)
+                    cursor.fetchall()
+
+                # 2 is the least recently used result and was evicted.
+                self.assertEqual(len(cache), 2)
+                self.assertEqual(cache.memory, size * 2)
+                for value in (1, 3, 2):
+                    cursor.execute('SELECT {0}'.format(value), cache=True)
+                    cursor.fetchall()
+                self.assertEqual(cache.hits, 3)
+                self.assertEqual(cache.misses, 4)
+
+                # Results larger than the cache are not cached.
+                cursor.execute('SELECT REPLICATE(\'x\', {0})'.format(size * 2), cache=True)
+                cursor.fetchall()
+                self.assertEqual(len(cache), 2)
+
+    def test_ttl(self):
+        cache = ctds.ResultCache(ttl=0.5)
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                for _ in range(2):
+                    cursor.execute('SELECT 1', cache=True)
+                    cursor.fetchall()
+                self.assertEqual(cache.hits, 1)
+
+                time.sleep(0.6)
+                cursor.execute('SELECT 1', cache=True)
+                cursor.fetchall()
+                self.assertEqual(cache.hits, 1)
+                self.assertEqual(cache.misses, 2)
+
+    def test_invalidate(self):
+        cache = ctds.ResultCache()
+        with self.connect() as connection:
+            connection.result_cache = cache
+            with connection.cursor() as cursor:
+                for parameters in ((1,), (2,)):
+                    cursor.execute('SELECT :0', parameters, cache=True)
+                    cursor.fetchall()
+                cursor.execute('SELECT 3', cache=True)
+                cursor.fetchall()
+                self.assertEqual(len(cache), 3)
+
+                cache.invalidate(sql='SELECT :0')
+                self.assertEqual(len(cache), 1)
+
+                cache.invalidate()
+                self.assertEqual(len(cache), 0)
+                self.assertEqual(cache.memory, 0)
@@ -0,0 +1,236 @@
+import logging
+
+import ctds
+
+from .base import TestExternalDatabase
+
+
+class TestTdsSlowQueryLog(TestExternalDatabase):
+    '''Unit tests related to the ctds.set_slow_query_log() function.
+    '''
+
+    KEYS = set((
+        'operation',
+        'sql',
+        'parameter_types',
+        'parameters',
+        'spid',
+        'database',
+        'messages',
+        'first_row_time',
+        'total_time',
+        'rows',
+        'error',
+    ))
+
+    def tearDown(self):
+        ctds.set_slow_query_log(0, None)
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.set_slow_query_log.__doc__,
+            '''\
+set_slow_query_log(threshold_ms, callback, values=False)
+
+Report statements executed using :py:meth:`ctds.Cursor.execute`,
+:py:meth:`ctds.Cursor.executemany`, :py:meth:`ctds.Cursor.callproc` and
+:py:meth:`ctds.Cursor.execute_async` on any connection which take longer
+than a threshold. A statement's time includes the time spent fetching its
+result set; the statement is reported once the result set has been read,
+or discarded by executing another statement or closing the cursor.
+Statements executed by :py:func:`ctds.execute_parallel` are not reported.
+
+`callback` is either called with a dict describing the statement, or
+is a :py:class:`logging.Logger` the statement is logged to as a
+warning. The dict has the keys:
+
+* ``operation``: `'execute'`, `'executemany'`, `'callproc'` or
+  `'execute_async'`.
+* ``sql``: The SQL statement or stored procedure name.
+* ``parameter_types``: The type names of the parameters, as a tuple or
+  dict matching the parameters, or :py:data:`None`.
+* ``parameters``: The parameters, if `values` is set, otherwise
+  :py:data:`None`.
+* ``spid``, ``database``: The connection's :py:attr:`ctds.Connection.spid`
+  and :py:attr:`ctds.Connection.database`.
+* ``messages``: The :py:attr:`ctds.Connection.messages` from the
+  statement.
+* ``first_row_time``: The time, in seconds, until the server's first
+  response.
+* ``total_time``: The total time, in seconds.
+* ``rows``: The number of rows affected or fetched, or -1 if unknown.
+* ``error``: Did the statement raise an error?
+
+Exceptions raised by the callback are reported using
+:py:func:`sys.unraisablehook` and do not affect the statement. Timing
+statements costs a clock read when the statement starts and ends.
+
+.. versionadded:: 1.15
+
+:param float threshold_ms: The time, in milliseconds, above which a
+    statement is reported.
+:param callback: The function or logger to report slow statements to,
+    or :py:data:`None` to disable the slow query log.
+:type callback: callable or logging.Logger
+:param bool values: Should parameter values be reported? Values may
+    contain sensitive data.
+'''
+        )
+
+    def test_typeerror(self):
+        for args, kwargs in (
+                (('0', None), {}),
+                ((0, object()), {}),
+                ((0, None), {'values': 1}),
+        ):
+            self.assertRaises(TypeError, ctds.set_slow_query_log, *args, **kwargs)
+
+    def test_valueerror(self):
+        self.assertRaises(ValueError, ctds.set_slow_query_log, -1, None)
+        self.assertRaises(ValueError, ctds.set_slow_query_log, threshold_ms=-0.5, callback=None)
+
+    def test_execute(self):
+        queries = []
+        ctds.set_slow_query_log(0, queries.append)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT :0 AS Value UNION ALL SELECT :1', (1, 'two'))
+                self.assertEqual(queries, [])
+
+                self.assertEqual(len(cursor.fetchall()), 2)
+                self.assertEqual(len(queries), 1)
+                query = queries[0]
+                self.assertEqual(set(query.keys()), self.KEYS)
+                self.assertEqual(query['operation'], 'execute')
+                self.assertEqual(query['sql'], 'SELECT :0 AS Value UNION ALL SELECT :1')
+                self.assertEqual(query['parameter_types'], ('int', 'str'))
+                self.assertEqual(query['parameters'], None)
+                self.assertEqual(query['spid'], connection.spid)
+                self.assertEqual(query['database'], connection.database)
+                self.assertEqual(query['messages'], [])
+                self.assertEqual(query['rows'], 2)
+                self.assertEqual(query['error'], False)
+                self.assertTrue(0 < query['first_row_time'] <= query['total_time'])
+
+    def test_execute_no_resultset(self):
+        queries = []
+        ctds.set_slow_query_log(0, queries.append, values=True)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute("PRINT :0", ('hello',))
+                self.assertEqual(len(queries), 1)
+                query = queries[0]
+                self.assertEqual(query['parameters'], ('hello',))
+                self.assertEqual(len(query['messages']), 1)
+                self.assertEqual(query['messages'][0]['description'], 'hello')
+
+    def test_execute_unread(self):
+        queries = []
+        ctds.set_slow_query_log(0, queries.append)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1 UNION ALL SELECT 2')
+                self.assertEqual(cursor.fetchone()[0], 1)
+                self.assertEqual(queries, [])
+
+                # Executing another statement ends the first.
+                cursor.execute('SELECT 3')
+                self.assertEqual(len(queries), 1)
+                self.assertEqual(queries[0]['sql'], 'SELECT 1 UNION ALL SELECT 2')
+                self.assertEqual(queries[0]['rows'], 1)
+
+            # As does closing the cursor.
+            self.assertEqual(len(queries), 2)
+            self.assertEqual(queries[1]['sql'], 'SELECT 3')
+            self.assertEqual(queries[1]['rows'], 0)
+
+    def test_execute_error(self):
+        queries = []
+        ctds.set_slow_query_log(0, queries.append)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                self.assertRaises(ctds.ProgrammingError, cursor.execute, 'SELECT * FROM DoesNotExist')
+                self.assertEqual(len(queries), 1)
+                self.assertEqual(queries[0]['error'], True)
+                self.assertEqual(queries[0]['rows'], -1)
+
+    def test_executemany(self):
+        queries = []
+        ctds.set_slow_query_log(0, queries.append, values=True)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('CREATE TABLE #Test (Value INT)')
+                cursor.executemany('INSERT INTO #Test VALUES (:0)', [(1,), (2,)])
+                self.assertEqual(len(queries), 2)
+                self.assertEqual(queries[1]['operation'], 'executemany')
+                self.assertEqual(queries[1]['parameter_types'], None)
+                self.assertEqual(queries[1]['parameters'], None)
+
+    def test_callproc(self):
+        queries = []
+        ctds.set_slow_query_log(0, queries.append)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                sproc = self.test_callproc.__name__
+                with self.stored_procedure(cursor, sproc, '''
+                        @pValue INT
+                    AS
+                        SELECT @pValue;
+                    '''):
+                    del queries[:]
+                    cursor.callproc(sproc, {'@pValue': 1})
+                    self.assertEqual(cursor.fetchall()[0][0], 1)
+                    self.assertEqual(len(queries), 1)
+                    self.assertEqual(queries[0]['operation'], 'callproc')
+                    self.assertEqual(queries[0]['sql'], sproc)
+                    self.assertEqual(queries[0]['parameter_types'], {'@pValue': 'int'})
+                    self.assertEqual(queries[0]['rows'], 1)
+
+    def test_threshold(self):
+        queries = []
+        ctds.set_slow_query_log(60 * 1000, queries.append)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+                cursor.fetchall()
+                self.assertEqual(queries, [])
+
+                ctds.set_slow_query_log(100, queries.append)
+                cursor.execute("WAITFOR DELAY '00:00:00.200'")
+                self.assertEqual(len(queries), 1)
+                self.assertTrue(queries[0]['total_time'] >= 0.1)
+
+    def test_logger(self):
+        records = []
+
+        class Handler(logging.Handler):
+            def emit(self, record):
+                records.append(record)
+
+        logger = logging.getLogger('ctds.test.slow')
+        logger.propagate = False
+        handler = Handler()
+        logger.addHandler(handler)
+        try:
+            ctds.set_slow_query_log(0, logger)
+            with self.connect() as connection:
+                with connection.cursor() as cursor:
+                    cursor.execute('SELECT 1 AS Value')
+                    cursor.fetchall()
+            self.assertEqual(len(records), 1)
+            self.assertEqual(records[0].levelno, logging.WARNING)
+            message = records[0].getMessage()
+            self.assertTrue(message.startswith('slow execute on spid {0} ('.format(connection.spid)))
+            self.assertTrue(message.endswith(', 1 rows): SELECT 1 AS Value'))
+        finally:
+            logger.removeHandler(handler)
+
+    def test_callback_error(self):
+        def callback(query):
+            raise RuntimeError(query)
+
+        ctds.set_slow_query_log(0, callback)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+                self.assertEqual(cursor.fetchall()[0][0], 1)
@@ -0,0 +1,196 @@
+import ctds
+
+from .base import TestExternalDatabase
+
+
+class TestTdsStatementStats(TestExternalDatabase):
+    '''Unit tests related to the ctds.set_statement_stats() and
+    ctds.statement_stats() functions.
+    '''
+
+    KEYS = set((
+        'fingerprint',
+        'kind',
+        'query',
+        'calls',
+        'errors',
+        'rows',
+        'total_time',
+        'mean_time',
+        'min_time',
+        'max_time',
+        'p99_time',
+    ))
+
+    def setUp(self):
+        TestExternalDatabase.setUp(self)
+        ctds.set_statement_stats(100)
+
+    def tearDown(self):
+        ctds.set_statement_stats(0)
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.set_statement_stats.__doc__,
+            '''\
+set_statement_stats(maxsize)
+
+Enable or disable the collection of client-side statement statistics,
+read using :py:func:`ctds.statement_stats`. Any statistics already
+collected are discarded.
+
+Statistics are kept for at most `maxsize` distinct statements. Once
+full, the least frequently executed statement is replaced.
+
+.. versionadded:: 1.15
+
+:param int maxsize: The maximum number of statements to keep
+    statistics for, or 0 to disable collection.
+'''
+        )
+        self.assertEqual(
+            ctds.statement_stats.__doc__,
+            '''\
+statement_stats(reset=False)
+
+Get the client-side statistics of the statements executed using
+:py:meth:`ctds.Cursor.execute`, :py:meth:`ctds.Cursor.executemany`,
+:py:meth:`ctds.Cursor.callproc` and :py:meth:`ctds.Cursor.execute_async`
+on all connections, once enabled using :py:func:`ctds.set_statement_stats`.
+
+Statements are grouped by a fingerprint of their normalized SQL text,
+with comments removed, whitespace collapsed and literal values replaced
+with `?`, or of the stored procedure name. Statistics are returned in
+descending order of total execution time, as dicts with the keys:
+
+* ``fingerprint``: The statement's fingerprint.
+* ``kind``: `'sql'` for SQL statements or `'procedure'` for stored
+  procedure calls.
+* ``query``: The normalized SQL text, truncated to 4096 bytes, or the
+  stored procedure name.
+* ``calls``: The number of times the statement was executed.
+* ``errors``: The number of executions which raised an error.
+* ``rows``: The number of rows affected by the statement or fetched
+  from its results.
+* ``total_time``, ``mean_time``, ``min_time``, ``max_time``,
+  ``p99_time``: Statistics of the time, in seconds, taken to execute
+  the statement, until the server's first response was read. The time
+  spent fetching rows is not included. ``p99_time`` is estimated to
+  within 12.5%. Statements executed by :py:meth:`ctds.Cursor.execute_async`
+  are timed from when they are sent until their response is read.
+
+Results served from the connection's :py:attr:`ctds.Connection.result_cache`
+and statements executed by :py:func:`ctds.execute_parallel` are not
+included.
+
+.. versionadded:: 1.15
+
+:param bool reset: Reset the statistics once read.
+:return: The statistics of each statement.
+:rtype: list(dict)
+'''
+        )
+
+    def test_typeerror(self):
+        self.assertRaises(TypeError, ctds.set_statement_stats, None)
+        self.assertRaises(TypeError, ctds.set_statement_stats, '1')
+        self.assertRaises(TypeError, ctds.statement_stats, reset=1)
+
+    def test_valueerror(self):
+        self.assertRaises(ValueError, ctds.set_statement_stats, -1)
+
+    def test_disabled(self):
+        ctds.set_statement_stats(0)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+        self.assertEqual(ctds.statement_stats(), [])
+
+    def test_normalized(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                for sql in (
+                        'SELECT 1 AS Value, \'one\' AS Name',
+                        'select 2 as Value,N\'two\' as Name -- comment',
+                        '''
+                        SELECT /* comment */ 3 AS Value,
+                            \'thr\'\'ee\' AS Name
+                        ''',
+                ):
+                    cursor.execute(sql)
+                    self.assertEqual(len(cursor.fetchall()), 1)
+
+        stats = ctds.statement_stats()
+        self.assertEqual(len(stats), 1)
+        self.assertEqual(set(stats[0].keys()), self.KEYS)
+        self.assertEqual(stats[0]['kind'], 'sql')
+        self.assertEqual(stats[0]['query'], 'select ? as value, ? as name')
+        self.assertEqual(stats[0]['calls'], 3)
+        self.assertEqual(stats[0]['errors'], 0)
+        self.assertEqual(stats[0]['rows'], 3)
+        self.assertTrue(0 < stats[0]['min_time'] <= stats[0]['mean_time'] <= stats[0]['max_time'])
+        self.assertTrue(stats[0]['min_time'] <= stats[0]['p99_time'] <= stats[0]['max_time'])
+        self.assertTrue(stats[0]['total_time'] >= stats[0]['max_time'])
+
+    def test_parameters(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                for value in range(5):
+                    cursor.execute('SELECT :0', (value,))
+                    self.assertEqual(cursor.fetchone()[0], value)
+                cursor.executemany('SELECT :0', [(1,), (2,)])
+
+        stats = ctds.statement_stats()
+        self.assertEqual(len(stats), 1)
+        self.assertEqual(stats[0]['query'], 'select :0')
+        self.assertEqual(stats[0]['calls'], 6)
+
+    def test_errors(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                self.assertRaises(ctds.ProgrammingError, cursor.execute, 'SELECT * FROM DoesNotExist')
+
+        stats = ctds.statement_stats()
+        self.assertEqual(len(stats), 1)
+        self.assertEqual(stats[0]['calls'], 1)
+        self.assertEqual(stats[0]['errors'], 1)
+
+    def test_callproc(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                sproc = self.test_callproc.__name__
+                with self.stored_procedure(cursor, sproc, 'AS SELECT 1 UNION ALL SELECT 2'):
+                    ctds.statement_stats(reset=True)
+                    for _ in range(2):
+                        cursor.callproc(sproc, ())
+                        self.assertEqual(len(cursor.fetchall()), 2)
+                    stats = ctds.statement_stats()
+
+        self.assertEqual(len(stats), 1)
+        self.assertEqual(stats[0]['kind'], 'procedure')
+        self.assertEqual(stats[0]['query'], sproc.lower())
+        self.assertEqual(stats[0]['calls'], 2)
+        self.assertEqual(stats[0]['rows'], 4)
+
+    def test_reset(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+        self.assertEqual(len(ctds.statement_stats(reset=True)), 1)
+        self.assertEqual(ctds.statement_stats(), [])
+
+    def test_maxsize(self):
+        ctds.set_statement_stats(2)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                for _ in range(3):
+                    cursor.execute('SELECT 1 AS A')
+                for _ in range(2):
+                    cursor.execute('SELECT 1 AS B')
+                cursor.execute('SELECT 1 AS C')
+
+        # The least frequently executed statement is replaced.
+        self.assertEqual(
+            [stats['query'] for stats in sorted(ctds.statement_stats(), key=lambda stats: stats['calls'])],
+            ['select ? as c', 'select ? as a']
+        )
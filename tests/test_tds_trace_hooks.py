@@ -0,0 +1,217 @@
+import sys
+import unittest
+
+import ctds
+
+from .base import TestExternalDatabase
+
+
+class TestTdsTraceHooks(TestExternalDatabase):
+    '''Unit tests related to the ctds.set_trace_hooks() function.
+    '''
+
+    def setUp(self):
+        TestExternalDatabase.setUp(self)
+        self.events = []
+
+    def tearDown(self):
+        ctds.set_trace_hooks(None, None)
+
+    def on_start(self, operation, sql, spid):
+        token = object()
+        self.events.append(('start', token, operation, sql, spid))
+        return token
+
+    def on_end(self, token, rows, elapsed, error):
+        self.events.append(('end', token, rows, elapsed, error))
+
+    def trace(self):
+        ctds.set_trace_hooks(self.on_start, self.on_end)
+
+    def assert_traced(self, operation, sql, spid, rows, error=None):
+        self.assertEqual(len(self.events), 2)
+        start, end = self.events
+        self.assertEqual(start[0], 'start')
+        self.assertEqual(start[2:], (operation, sql, spid))
+        self.assertEqual(end[0], 'end')
+        self.assertTrue(end[1] is start[1])
+        self.assertEqual(end[2], rows)
+        self.assertTrue(end[3] > 0)
+        if error is None:
+            self.assertEqual(end[4], None)
+        else:
+            self.assertTrue(isinstance(end[4], error))
+        del self.events[:]
+
+    def test___doc__(self):
+        self.assertEqual(
+            ctds.set_trace_hooks.__doc__,
+            '''\
+set_trace_hooks(on_start, on_end)
+
+Set the functions called when database operations start and end, e.g.
+to report them to an application performance monitoring service.
+
+The hooks are called for :py:meth:`ctds.Cursor.execute`,
+:py:meth:`ctds.Cursor.executemany`, :py:meth:`ctds.Cursor.callproc`,
+:py:meth:`ctds.Cursor.execute_async`, :py:meth:`ctds.Connection.bulk_insert`
+and each read of rows by the :py:meth:`ctds.Cursor.fetchone`,
+:py:meth:`ctds.Cursor.fetchmany` and :py:meth:`ctds.Cursor.fetchall`
+methods, including iteration of the cursor. Statements executed by
+:py:meth:`ctds.Cursor.execute_async` are traced from when they are sent
+until their response is read. Statements executed by
+:py:func:`ctds.execute_parallel` are not traced.
+
+`on_start` is called as `on_start(operation, sql, spid)`, where
+`operation` is one of `'execute'`, `'executemany'`, `'callproc'`,
+`'execute_async'`, `'bulk_insert'` or `'fetch'`, `sql` is the SQL
+statement, stored procedure name or table name (:py:data:`None` for
+fetches), and `spid` is the connection's :py:attr:`ctds.Connection.spid`.
+Its return value is passed to `on_end`.
+
+`on_end` is called as `on_end(token, rows, elapsed, error)`, where
+`token` is the value returned by `on_start`, `rows` is the number of
+rows affected, inserted or fetched (-1 if unknown), `elapsed` is the
+duration of the operation in nanoseconds, and `error` is the exception
+raised by the operation, or :py:data:`None`.
+
+Exceptions raised by the hooks are reported using
+:py:func:`sys.unraisablehook` and do not affect the operation. When no
+hooks are set, tracing adds no measurable overhead.
+
+.. versionadded:: 1.15
+
+:param on_start: The function called when an operation starts, or
+    :py:data:`None`.
+:type on_start: callable
+:param on_end: The function called when an operation ends, or
+    :py:data:`None`.
+:type on_end: callable
+'''
+        )
+
+    def test_typeerror(self):
+        for args in (
+                (None,),
+                (1, None),
+                (None, 'on_end'),
+        ):
+            self.assertRaises(TypeError, ctds.set_trace_hooks, *args)
+
+    def test_disabled(self):
+        self.trace()
+        ctds.set_trace_hooks(None, None)
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1')
+                self.assertEqual(cursor.fetchone()[0], 1)
+        self.assertEqual(self.events, [])
+
+    def test_execute(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                self.trace()
+                sql = 'SELECT 1 UNION ALL SELECT 2'
+                cursor.execute(sql)
+                self.assert_traced('execute', sql, connection.spid, cursor.rowcount)
+
+                rows = cursor.fetchall()
+                self.assertEqual(len(rows), 2)
+                self.assert_traced('fetch', None, connection.spid, 2)
+
+    def test_execute_error(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                self.trace()
+                sql = 'SELECT * FROM DoesNotExist'
+                self.assertRaises(ctds.ProgrammingError, cursor.execute, sql)
+                self.assert_traced('execute', sql, connection.spid, -1, ctds.ProgrammingError)
+
+    def test_executemany(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                self.trace()
+                sql = 'SELECT :0'
+                cursor.executemany(sql, [(1,), (2,)])
+                self.assert_traced('executemany', sql, connection.spid, cursor.rowcount)
+
+    def test_callproc(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                sproc = self.test_callproc.__name__
+                with self.stored_procedure(cursor, sproc, 'AS SELECT 1'):
+                    self.trace()
+                    cursor.callproc(sproc, ())
+                    self.assert_traced('callproc', sproc, connection.spid, -1)
+                    ctds.set_trace_hooks(None, None)
+
+    def test_bulk_insert(self):
+        with self.connect(autocommit=False) as connection:
+            try:
+                with connection.cursor() as cursor:
+                    cursor.execute(
+                        '''
+                        CREATE TABLE {0}
+                        (
+                            Value INT
+                        )
+                        '''.format(self.test_bulk_insert.__name__)
+                    )
+
+                self.trace()
+                inserted = connection.bulk_insert(
+                    self.test_bulk_insert.__name__,
+                    [(ix,) for ix in range(10)]
+                )
+                self.assertEqual(inserted, 10)
+                self.assert_traced(
+                    'bulk_insert',
+                    self.test_bulk_insert.__name__,
+                    connection.spid,
+                    10
+                )
+            finally:
+                connection.rollback()
+
+    def test_iteration(self):
+        with self.connect() as connection:
+            with connection.cursor() as cursor:
+                cursor.execute('SELECT 1 UNION ALL SELECT 2')
+                self.trace()
+                self.assertEqual([row[0] for row in cursor], [1, 2])
+
+        # Each row is fetched separately, followed by the end of the result set.
+        self.assertEqual(
+            [event[2] for event in self.events if event[0] == 'end'],
+            [1, 1, 0]
+        )
+
+    def test_closed(self):
+        with self.connect() as connection:
+            cursor = connection.cursor()
+        self.trace()
+        self.assertRaises(ctds.InterfaceError, cursor.execute, 'SELECT 1')
+        self.assert_traced('execute', 'SELECT 1', None, -1, ctds.InterfaceError)
+
+    @unittest.skipUnless(hasattr(sys, 'unraisablehook'), 'requires sys.unraisablehook')
+    def test_hook_error(self):
+        unraisable = []
+
+        def on_start(operation, sql, spid): # pylint: disable=unused-argument
+            raise RuntimeError('on_start')
+
+        def on_end(token, rows, elapsed, error): # pylint: disable=unused-argument
+            raise RuntimeError('on_end')
+
+        hook = sys.unraisablehook
+        sys.unraisablehook = lambda unraisable_: unraisable.append(unraisable_.exc_value)
+        try:
+            ctds.set_trace_hooks(on_start, on_end)
+            with self.connect() as connection:
+                with connection.cursor() as cursor:
+                    cursor.execute('SELECT 1')
+                    self.assertEqual(cursor.fetchone()[0], 1)
+        finally:
+            sys.unraisablehook = hook
+
+        self.assertEqual([str(ex) for ex in unraisable], ['on_start', 'on_end'] * 2)